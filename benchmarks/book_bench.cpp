@@ -3,22 +3,56 @@
 ///
 /// Measures three things against an in-memory ITCH buffer (file I/O excluded):
 ///  - BM_BookRebuild: full multi-symbol book reconstruction through BookManager.
+///  - BM_BookRebuildTyped: the same rebuild driven by Parser::parse_with, which
+///    skips the Message variant and never decodes message types the book ignores.
+///  - BM_BookRebuildOverlay: the same rebuild from overlay views through
+///    BookManager::process(const MessageView&), which reads only the fields each
+///    book update needs and never decodes a message.
+///  - BM_BookRebuildVisit: the same through overlay::visit, which also skips the
+///    type switch of process.
+///  - BM_BookRebuildDense: BM_BookRebuildVisit with the shared order index in
+///    OrderIndexMode::dense.
+///  - BM_OrderIndexHashed / BM_OrderIndexDense: the feed's order reference
+///    inserts, lookups, and erases replayed against a bare OrderIndex in each
+///    mode, isolating the index from the rest of the book.
+///  - BM_OrderIndexGrowthLatency: the latency of each insert and erase while a
+///    hashed OrderIndex grows to millions of live orders, reported as p50,
+///    p99.9, p99.99, and max counters; a stalling table growth shows in the tail.
+///    Each operation keeps its fastest time over the iterations, which filters
+///    out preemption but not a stall, since growth repeats at the same operation.
+///  - BM_L3BookDeepLadder: adds and deletes spread over thousands of penny
+///    price levels a side on one L3Book whose prices drift, the deep, wide book
+///    in which a sorted level vector pays a memmove for every new or emptied level.
+///  - BM_L3BookExecuteCancel: partial executions, partial cancels, and deletes
+///    against resting orders in a populated L3Book, each delete replaced by a
+///    fresh add; the post-add operations that reach an order's level.
 ///  - BM_EagerTouch: eager parse touching one field per message (the baseline).
 ///  - BM_OverlayTouch: lazy overlay framing touching the same one field, which
 ///    should be cheaper because the other fields are never decoded.
+///  - BM_OverlayVisit: the same through overlay::visit, which calls the handler
+///    with each frame's concrete view instead of through a std::function.
+///  - BM_TransformInPlace: rewrites every frame's tracking number and locate
+///    through overlay::transform, in place in the buffer.
+///  - BM_TransformReencode: the same rewrite done by decoding every message,
+///    changing the struct, and re-encoding it with encode_frame.
 ///
 /// Usage:
 ///   ./book_bench <path_to_itch_data_file> [google benchmark options]
 
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <span>
 #include <string>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
 #include "itch/book/book_manager.hpp"
+#include "itch/encoder.hpp"
 #include "itch/overlay.hpp"
 #include "itch/parser.hpp"
 
@@ -59,6 +93,60 @@ class BookBenchmark : public benchmark::Fixture {
     }
 };
 
+// One order-reference operation of the feed: an insert (`A`, `F`), lookup
+// (`E`, `C`, `X`), erase (`D`), or erase-and-insert (`U`).
+struct IndexOp {
+    char          type {0};
+    std::uint64_t reference_number {0};
+    std::uint64_t new_reference_number {0};
+};
+
+auto index_ops(std::span<const std::byte> data) -> std::vector<IndexOp> {
+    std::vector<IndexOp> ops;
+    itch::overlay::visit(data, [&ops](const auto& view) {
+        using View = std::remove_cvref_t<decltype(view)>;
+        if constexpr (std::is_same_v<View, itch::overlay::OrderReplaceView>) {
+            ops.push_back(IndexOp {
+                View::TYPE,
+                view.original_order_reference_number(),
+                view.new_order_reference_number(),
+            });
+        } else if constexpr (requires { view.order_reference_number(); }) {
+            ops.push_back(IndexOp {View::TYPE, view.order_reference_number(), 0});
+        }
+    });
+    return ops;
+}
+
+auto replay_index(
+    benchmark::State& state, std::span<const IndexOp> ops, itch::book::OrderIndexMode mode
+) -> void {
+    for ([[maybe_unused]] auto iter : state) {
+        itch::book::OrderIndex index {mode};
+        std::uint64_t          found = 0;
+        for (std::uint32_t slot = 0; const auto& operation : ops) {
+            switch (operation.type) {
+                case 'A':
+                case 'F':
+                    index.insert(operation.reference_number, slot++);
+                    break;
+                case 'D':
+                    index.erase(operation.reference_number);
+                    break;
+                case 'U':
+                    index.erase(operation.reference_number);
+                    index.insert(operation.new_reference_number, slot++);
+                    break;
+                default:
+                    found += index.find(operation.reference_number);
+                    break;
+            }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * ops.size()));
+}
+
 }  // namespace
 
 BENCHMARK_F(BookBenchmark, BM_BookRebuild)(benchmark::State& state) {
@@ -75,6 +163,246 @@ BENCHMARK_F(BookBenchmark, BM_BookRebuild)(benchmark::State& state) {
     state.SetBytesProcessed(static_cast<std::int64_t>(total_bytes));
 }
 
+BENCHMARK_F(BookBenchmark, BM_BookRebuildTyped)(benchmark::State& state) {
+    std::size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        itch::Parser            parser;
+        itch::book::BookManager manager;
+        parser.parse_with(std::span<const std::byte> {itch_data}, manager);
+        benchmark::DoNotOptimize(manager.book_count());
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(total_bytes));
+}
+
+BENCHMARK_F(BookBenchmark, BM_BookRebuildOverlay)(benchmark::State& state) {
+    std::size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        itch::book::BookManager manager;
+        itch::overlay::for_each_message(
+            std::span<const std::byte> {itch_data},
+            [&](const itch::overlay::MessageView& view) { manager.process(view); }
+        );
+        benchmark::DoNotOptimize(manager.book_count());
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(total_bytes));
+}
+
+BENCHMARK_F(BookBenchmark, BM_BookRebuildVisit)(benchmark::State& state) {
+    std::size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        itch::book::BookManager manager;
+        itch::overlay::visit(std::span<const std::byte> {itch_data}, manager);
+        benchmark::DoNotOptimize(manager.book_count());
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(total_bytes));
+}
+
+BENCHMARK_F(BookBenchmark, BM_BookRebuildDense)(benchmark::State& state) {
+    std::size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        itch::book::BookManager manager {itch::book::OrderIndexMode::dense};
+        itch::overlay::visit(std::span<const std::byte> {itch_data}, manager);
+        benchmark::DoNotOptimize(manager.book_count());
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(total_bytes));
+}
+
+BENCHMARK_F(BookBenchmark, BM_OrderIndexHashed)(benchmark::State& state) {
+    replay_index(state, index_ops(itch_data), itch::book::OrderIndexMode::hashed);
+}
+
+BENCHMARK_F(BookBenchmark, BM_OrderIndexDense)(benchmark::State& state) {
+    replay_index(state, index_ops(itch_data), itch::book::OrderIndexMode::dense);
+}
+
+// Sequential reference numbers, as a feed issues them, with every other order
+// deleted 1,000 orders later; the live set grows to half of the adds.
+auto BM_OrderIndexGrowthLatency(benchmark::State& state) -> void {
+    using Clock                    = std::chrono::steady_clock;
+    constexpr std::uint64_t DELAY  = 1000;
+    const auto              adds   = static_cast<std::uint64_t>(state.range(0));
+    const auto              timed  = [](auto&& operation) -> std::int64_t {
+        const auto start = Clock::now();
+        operation();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    };
+    std::vector<std::int64_t> latencies;
+    std::vector<std::int64_t> pass;
+    latencies.reserve(2 * adds);
+    pass.reserve(2 * adds);
+    for ([[maybe_unused]] auto iter : state) {
+        pass.clear();
+        itch::book::OrderIndex index;
+        for (std::uint64_t ref = 1; ref <= adds; ++ref) {
+            pass.push_back(timed([&] { index.insert(ref, static_cast<std::uint32_t>(ref)); }));
+            if (ref > DELAY && (ref - DELAY) % 2 == 0) {
+                pass.push_back(timed([&] { index.erase(ref - DELAY); }));
+            }
+        }
+        benchmark::DoNotOptimize(index.size());
+        if (latencies.empty()) {
+            latencies = pass;
+        } else {
+            std::ranges::transform(latencies, pass, latencies.begin(), [](auto lhs, auto rhs) {
+                return std::min(lhs, rhs);
+            });
+        }
+    }
+    std::ranges::sort(latencies);
+    const auto percentile = [&latencies](double fraction) {
+        const auto rank = static_cast<double>(latencies.size() - 1) * fraction;
+        return static_cast<double>(latencies[static_cast<std::size_t>(rank)]);
+    };
+    state.counters["p50_ns"]   = percentile(0.5);
+    state.counters["p999_ns"]  = percentile(0.999);
+    state.counters["p9999_ns"] = percentile(0.9999);
+    state.counters["max_ns"]   = static_cast<double>(latencies.back());
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * latencies.size()));
+}
+BENCHMARK(BM_OrderIndexGrowthLatency)
+    ->Arg(std::int64_t {1} << 23)
+    ->Iterations(5)
+    ->Unit(benchmark::kMillisecond);
+
+// A synthetic deep book: adds land uniformly on `state.range(0)` penny levels a
+// side around a mid that drifts up by a cent every 64 operations, and deletes
+// pick a random resting order, keeping about four orders a level live.
+auto BM_L3BookDeepLadder(benchmark::State& state) -> void {
+    struct BookOp {
+        std::uint64_t    reference_number;
+        std::uint32_t    price;  ///< 0 for a delete.
+        itch::book::Side side;
+    };
+    const auto                 levels = static_cast<std::uint32_t>(state.range(0));
+    const std::uint32_t        live   = levels * 8;
+    std::uint64_t              seed   = 42;
+    std::vector<BookOp>        ops;
+    std::vector<std::uint64_t> resting;
+    auto next = [&seed] {
+        seed = (seed * 6364136223846793005ULL) + 1442695040888963407ULL;
+        return static_cast<std::uint32_t>(seed >> 33);
+    };
+    for (std::uint64_t ref = 1; ops.size() < 2'000'000;) {
+        if (resting.size() < live && (resting.size() < live / 2 || next() % 2 == 0)) {
+            const auto mid   = static_cast<std::uint32_t>(1'000'000 + (ops.size() / 64 * 100));
+            const bool buy   = next() % 2 == 0;
+            const auto tick  = 1 + (next() % levels);
+            const auto price = buy ? mid - (tick * 100) : mid + (tick * 100);
+            ops.push_back({ref, price, buy ? itch::book::Side::buy : itch::book::Side::sell});
+            resting.push_back(ref++);
+        } else {
+            const std::size_t victim = next() % resting.size();
+            ops.push_back({resting[victim], 0, itch::book::Side::buy});
+            resting[victim] = resting.back();
+            resting.pop_back();
+        }
+    }
+    for ([[maybe_unused]] auto iter : state) {
+        itch::book::L3Book book {"DEEP"};
+        for (const BookOp& operation : ops) {
+            if (operation.price != 0) {
+                book.add_order(operation.reference_number, operation.side, 100, operation.price);
+            } else {
+                book.delete_order(operation.reference_number);
+            }
+        }
+        benchmark::DoNotOptimize(book.bbo());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * ops.size()));
+}
+BENCHMARK(BM_L3BookDeepLadder)->Arg(64)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+// `state.range(0)` resting orders of 1,000 shares spread over 256 penny levels
+// a side. Each step picks a random resting order and executes or cancels up to
+// 50 of its shares, or deletes it; an order that leaves the book is replaced by
+// a fresh add so the book keeps its size. The initial adds are not timed.
+auto BM_L3BookExecuteCancel(benchmark::State& state) -> void {
+    enum class Kind : std::uint8_t { add, execute, reduce, remove };
+    struct BookOp {
+        Kind             kind;
+        itch::book::Side side;
+        std::uint32_t    shares;
+        std::uint32_t    price;
+        std::uint64_t    reference_number;
+    };
+    struct Resting {
+        std::uint64_t reference_number;
+        std::uint32_t shares;
+    };
+    constexpr std::uint32_t LEVELS = 256;
+    const auto              orders = static_cast<std::size_t>(state.range(0));
+    std::uint64_t           seed   = 7;
+    std::uint64_t           ref    = 1;
+    std::vector<BookOp>     setup;
+    std::vector<BookOp>     ops;
+    std::vector<Resting>    resting;
+    auto next = [&seed] {
+        seed = (seed * 6364136223846793005ULL) + 1442695040888963407ULL;
+        return static_cast<std::uint32_t>(seed >> 33);
+    };
+    auto add_order = [&](std::vector<BookOp>& out) {
+        const bool buy   = next() % 2 == 0;
+        const auto tick  = 1 + (next() % LEVELS);
+        const auto price = buy ? 1'000'000 - (tick * 100) : 1'000'000 + (tick * 100);
+        const auto side  = buy ? itch::book::Side::buy : itch::book::Side::sell;
+        out.push_back({Kind::add, side, 1000, price, ref});
+        resting.push_back({ref++, 1000});
+    };
+    while (resting.size() < orders) {
+        add_order(setup);
+    }
+    while (ops.size() < 2'000'000) {
+        Resting&            order = resting[next() % resting.size()];
+        const std::uint32_t roll  = next() % 8;
+        const std::uint32_t size  = 1 + (next() % 50);
+        const Kind kind = roll < 4 ? Kind::execute : roll < 6 ? Kind::reduce : Kind::remove;
+        ops.push_back({kind, itch::book::Side::buy, size, 0, order.reference_number});
+        if (kind != Kind::remove && size < order.shares) {
+            order.shares -= size;
+            continue;
+        }
+        order = resting.back();
+        resting.pop_back();
+        add_order(ops);
+    }
+    for ([[maybe_unused]] auto iter : state) {
+        state.PauseTiming();
+        itch::book::L3Book book {"FLOW"};
+        for (const BookOp& operation : setup) {
+            book.add_order(
+                operation.reference_number, operation.side, operation.shares, operation.price
+            );
+        }
+        state.ResumeTiming();
+        for (const BookOp& operation : ops) {
+            switch (operation.kind) {
+                case Kind::add:
+                    book.add_order(
+                        operation.reference_number,
+                        operation.side,
+                        operation.shares,
+                        operation.price
+                    );
+                    break;
+                case Kind::execute:
+                    book.execute_order(operation.reference_number, operation.shares);
+                    break;
+                case Kind::reduce:
+                    book.reduce_order(operation.reference_number, operation.shares);
+                    break;
+                case Kind::remove: book.delete_order(operation.reference_number); break;
+            }
+        }
+        benchmark::DoNotOptimize(book.bbo());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * ops.size()));
+}
+BENCHMARK(BM_L3BookExecuteCancel)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
 BENCHMARK_F(BookBenchmark, BM_EagerTouch)(benchmark::State& state) {
     std::size_t total_bytes = 0;
     for ([[maybe_unused]] auto iter : state) {
@@ -105,6 +433,58 @@ BENCHMARK_F(BookBenchmark, BM_OverlayTouch)(benchmark::State& state) {
     state.SetBytesProcessed(static_cast<std::int64_t>(total_bytes));
 }
 
+BENCHMARK_F(BookBenchmark, BM_OverlayVisit)(benchmark::State& state) {
+    std::size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        std::uint64_t sink = 0;
+        itch::overlay::visit(std::span<const std::byte> {itch_data}, [&](const auto& view) {
+            sink += view.stock_locate();
+        });
+        benchmark::DoNotOptimize(sink);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(total_bytes));
+}
+
+BENCHMARK_F(BookBenchmark, BM_TransformInPlace)(benchmark::State& state) {
+    std::size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        std::uint16_t sequence = 0;
+        itch::overlay::transform(itch_data, [&](auto& view) {
+            view.set_tracking_number(sequence++);
+            view.set_stock_locate(static_cast<std::uint16_t>(view.stock_locate() ^ 1U));
+        });
+        benchmark::DoNotOptimize(itch_data.data());
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(total_bytes));
+}
+
+BENCHMARK_F(BookBenchmark, BM_TransformReencode)(benchmark::State& state) {
+    itch::Parser           parser;
+    std::vector<std::byte> output;
+    output.reserve(itch_data.size());
+    std::size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        std::uint16_t sequence = 0;
+        output.clear();
+        parser.parse(std::span<const std::byte> {itch_data}, [&](itch::Message msg) {
+            std::visit(
+                [&](auto& decoded) {
+                    decoded.tracking_number = sequence++;
+                    decoded.stock_locate    = static_cast<std::uint16_t>(decoded.stock_locate ^ 1U);
+                },
+                msg
+            );
+            const auto frame = itch::encode_frame(msg);
+            output.insert(output.end(), frame.begin(), frame.end());
+        });
+        benchmark::DoNotOptimize(output.data());
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(total_bytes));
+}
+
 auto main(int argc, char** argv) -> int {
     if (argc < 2) {
         std::cerr << "Usage: ./book_bench <path_to_itch_data_file> [benchmark options]\n";
@@ -5,8 +5,9 @@
 /// This file defines a set of benchmarks to evaluate the performance of the
 /// ITCH message parser implemented in the Parser class. It uses the Google
 /// Benchmark library to measure execution time and throughput for different
-/// parsing strategies, including callback-based parsing, collecting all parsed
-/// messages, and filtering specific message types.
+/// parsing strategies, including callback-based parsing, statically dispatched
+/// handler-based parsing, collecting all parsed messages, and filtering specific
+/// message types.
 ///
 /// The benchmark fixture `ParserBenchmark` is responsible for loading the ITCH
 /// data file into memory once per benchmark run, ensuring that file I/O does
@@ -24,13 +25,29 @@
 
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
+#include <array>
 #include <fstream>
 #include <iostream>
+#include <span>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "itch/basic_parser.hpp"
+#include "itch/columnar.hpp"
+#include "itch/detail/decode.hpp"
+#include "itch/detail/simd_decode.hpp"
+#include "itch/io/decompress.hpp"
+#include "itch/message_arena.hpp"
+#include "itch/parallel_parser.hpp"
 #include "itch/parser.hpp"
+#include "itch/streaming_parser.hpp"
+
+#ifdef ITCH_WITH_ZLIB
+#define ZLIB_CONST
+#include <zlib.h>
+#endif
 
 namespace data {
 // NOLINTNEXTLINE
@@ -97,6 +114,140 @@ BENCHMARK_F(ParserBenchmark, BM_ParseWithCallback)(benchmark::State& state) {
     state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
 }
 
+// Same work as BM_ParseWithCallback, but through parse_with: every message is
+// handed to a generic handler as its concrete struct, with no Message variant
+// and no std::function in between.
+BENCHMARK_F(ParserBenchmark, BM_ParseWithHandler)(benchmark::State& state) {
+    size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        size_t message_count = 0;
+        auto   handler       = [&](const auto& msg) {
+            benchmark::DoNotOptimize(msg);
+            ++message_count;
+        };
+        parser.parse_with(std::as_bytes(std::span {itch_data}), handler);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+// BM_ParseWithCallback through the unchecked frame loop for trusted input; the
+// Validated variant adds one upfront validation pass over the buffer.
+auto parse_trusted(
+    benchmark::State& state, itch::Parser& parser, const std::vector<char>& data, bool validate
+) -> void {
+    size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        size_t message_count = 0;
+        auto   callback      = [&](const itch::Message& msg) {
+            benchmark::DoNotOptimize(&msg);
+            ++message_count;
+        };
+        parser.parse(itch::TrustedInput {validate}, std::as_bytes(std::span {data}), callback);
+        total_bytes += data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+BENCHMARK_F(ParserBenchmark, BM_ParseTrusted)(benchmark::State& state) {
+    parse_trusted(state, parser, itch_data, false);
+}
+
+BENCHMARK_F(ParserBenchmark, BM_ParseTrustedValidated)(benchmark::State& state) {
+    parse_trusted(state, parser, itch_data, true);
+}
+
+// BM_ParseWithHandler through the unchecked frame loop.
+BENCHMARK_F(ParserBenchmark, BM_ParseWithHandlerTrusted)(benchmark::State& state) {
+    size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        size_t message_count = 0;
+        auto   handler       = [&](const auto& msg) {
+            benchmark::DoNotOptimize(msg);
+            ++message_count;
+        };
+        parser.parse_with(itch::TrustedInput {}, std::as_bytes(std::span {itch_data}), handler);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+// The work of BM_ParseWithHandler through type-bucketed batches: each batch of
+// frames is counting-sorted by type and decoded one type at a time into a span,
+// so the per-frame indirect decoder call of BM_ParseWithCallback and
+// BM_ParseWithHandler, mispredicted whenever the type changes, goes away. With
+// a Google Benchmark built against libpfm, compare them with
+// --benchmark_perf_counters=BRANCH-MISSES.
+BENCHMARK_F(ParserBenchmark, BM_ParseBucketed)(benchmark::State& state) {
+    size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        size_t message_count = 0;
+        auto   handler       = [&](auto messages) {
+            for (const auto& msg : messages) {
+                benchmark::DoNotOptimize(msg);
+            }
+            message_count += messages.size();
+        };
+        parser.parse_bucketed(std::as_bytes(std::span {itch_data}), handler);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+// The book builder's ten message types through the full parser and a type
+// filter: the callback still receives the 23-way Message variant.
+BENCHMARK_F(ParserBenchmark, BM_ParseBookTypesFiltered)(benchmark::State& state) {
+    size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        size_t message_count = 0;
+        parser.parse(
+            std::as_bytes(std::span {itch_data}),
+            [&](const itch::Message& msg) {
+                benchmark::DoNotOptimize(&msg);
+                ++message_count;
+            },
+            itch::BookParser::TYPES
+        );
+        benchmark::DoNotOptimize(message_count);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+// The same types through BookParser: decoders and the result variant exist for
+// those ten types only.
+BENCHMARK_F(ParserBenchmark, BM_BookParser)(benchmark::State& state) {
+    size_t           total_bytes = 0;
+    itch::BookParser book_parser;
+    for ([[maybe_unused]] auto iter : state) {
+        size_t message_count = 0;
+        book_parser.parse(
+            std::as_bytes(std::span {itch_data}),
+            [&](const itch::BookParser::Message& msg) {
+                benchmark::DoNotOptimize(&msg);
+                ++message_count;
+            }
+        );
+        benchmark::DoNotOptimize(message_count);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+// A handler that only accepts Add Orders: every other type is length-skipped
+// without being decoded.
+BENCHMARK_F(ParserBenchmark, BM_ParseWithHandlerAddOrdersOnly)(benchmark::State& state) {
+    size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        std::uint64_t shares  = 0;
+        auto          handler = [&](const itch::AddOrderMessage& msg) { shares += msg.shares; };
+        parser.parse_with(std::as_bytes(std::span {itch_data}), handler);
+        benchmark::DoNotOptimize(shares);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
 BENCHMARK_F(ParserBenchmark, BM_ParseAndCollectAll)(benchmark::State& state) {
     size_t total_bytes = 0;
     for ([[maybe_unused]] auto iter : state) {
@@ -107,6 +258,97 @@ BENCHMARK_F(ParserBenchmark, BM_ParseAndCollectAll)(benchmark::State& state) {
     state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
 }
 
+// A narrow universe: every 10th of the file's securities kept by locate, all
+// other frames dropped on the raw locate before decode.
+BENCHMARK_F(ParserBenchmark, BM_ParseLocateFilter)(benchmark::State& state) {
+    size_t             total_bytes = 0;
+    itch::LocateFilter universe;
+    for (std::uint16_t locate = 1; locate <= 500; locate += 10) {
+        universe.allow(locate);
+    }
+    parser.set_locate_filter(universe);
+    for ([[maybe_unused]] auto iter : state) {
+        std::uint64_t count = 0;
+        parser.parse(std::as_bytes(std::span {itch_data}), [&](const itch::Message&) { ++count; });
+        benchmark::DoNotOptimize(count);
+        total_bytes += itch_data.size();
+    }
+    parser.clear_locate_filter();
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+// The file delivered in 1400-byte pieces, as from a socket, so a frame is split
+// across pieces every few dozen messages.
+BENCHMARK_F(ParserBenchmark, BM_StreamingParseMtuPieces)(benchmark::State& state) {
+    constexpr std::size_t PIECE       = 1400;
+    size_t                total_bytes = 0;
+    std::uint64_t         count       = 0;
+    itch::StreamingParser streaming {[&](const itch::Message&) { ++count; }};
+    const auto            bytes = std::as_bytes(std::span {itch_data});
+    for ([[maybe_unused]] auto iter : state) {
+        for (std::size_t offset = 0; offset < bytes.size(); offset += PIECE) {
+            streaming.feed(bytes.subspan(offset, std::min(PIECE, bytes.size() - offset)));
+        }
+        streaming.finish();
+        benchmark::DoNotOptimize(count);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+// Collecting the whole file into a MessageArena, the compact alternative to
+// BM_ParseAndCollectAll's std::vector<Message>.
+BENCHMARK_F(ParserBenchmark, BM_ParseIntoArena)(benchmark::State& state) {
+    size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        itch::MessageArena arena;
+        parser.parse(std::as_bytes(std::span {itch_data}), arena);
+        benchmark::DoNotOptimize(arena.size());
+        state.counters["ArenaMB"] = static_cast<double>(arena.bytes_reserved()) / (1024.0 * 1024.0);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+// Columnar decode plus a scan over one column, against the same scan over a
+// collected vector of variants (BM_ParseAndCollectAll pays the collection alone).
+BENCHMARK_F(ParserBenchmark, BM_ParseColumnarSumAddShares)(benchmark::State& state) {
+    size_t              total_bytes = 0;
+    itch::ColumnarBatch batch {static_cast<std::size_t>(64 * 1024)};
+    for ([[maybe_unused]] auto iter : state) {
+        std::uint64_t shares = 0;
+        itch::parse_columnar(
+            parser,
+            std::as_bytes(std::span {itch_data}),
+            batch,
+            [&](const itch::ColumnarBatch& full) {
+                for (const auto value : full.columns<itch::AddOrderMessage>().shares) {
+                    shares += value;
+                }
+            }
+        );
+        benchmark::DoNotOptimize(shares);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+BENCHMARK_F(ParserBenchmark, BM_ParseVectorSumAddShares)(benchmark::State& state) {
+    size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        std::uint64_t shares   = 0;
+        const auto    messages = parser.parse(itch_data.data(), itch_data.size());
+        for (const auto& message : messages) {
+            if (const auto* add = std::get_if<itch::AddOrderMessage>(&message)) {
+                shares += add->shares;
+            }
+        }
+        benchmark::DoNotOptimize(shares);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
 BENCHMARK_F(ParserBenchmark, BM_ParseAndFilter)(benchmark::State& state) {
     size_t total_bytes = 0;
     for ([[maybe_unused]] auto iter : state) {
@@ -117,6 +359,218 @@ BENCHMARK_F(ParserBenchmark, BM_ParseAndFilter)(benchmark::State& state) {
     state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
 }
 
+// Streams the file through the chunked std::istream overload, so the measured
+// figure includes the read I/O and the one chunk copy per byte.
+BENCHMARK_F(ParserBenchmark, BM_ParseFromStream)(benchmark::State& state) {
+    size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        std::ifstream file(data::g_data_filename, std::ios::binary);
+        size_t        message_count = 0;
+        parser.parse(file, [&](const itch::Message&) { ++message_count; });
+        benchmark::DoNotOptimize(message_count);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+#ifdef ITCH_WITH_ZLIB
+
+// The data file gzip-compressed (at the fastest level) once per run and shared
+// by the compressed-input benchmarks below.
+auto gzipped(const std::vector<char>& raw) -> const std::vector<std::byte>& {
+    static const std::vector<std::byte> compressed = [&raw] {
+        z_stream stream {};
+        deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY);
+        std::vector<std::byte> out(deflateBound(&stream, static_cast<uLong>(raw.size())));
+        stream.next_in   = static_cast<const Bytef*>(static_cast<const void*>(raw.data()));
+        stream.avail_in  = static_cast<uInt>(raw.size());
+        stream.next_out  = static_cast<Bytef*>(static_cast<void*>(out.data()));
+        stream.avail_out = static_cast<uInt>(out.size());
+        deflate(&stream, Z_FINISH);
+        out.resize(stream.total_out);
+        deflateEnd(&stream);
+        return out;
+    }();
+    return compressed;
+}
+
+// Parses the gzip-compressed file through the decompression ring. Bytes are
+// counted uncompressed, so the figure compares directly with BM_ParseWithCallback
+// and with BM_GunzipOnly, its ceiling.
+BENCHMARK_DEFINE_F(ParserBenchmark, BM_ParseGzip)(benchmark::State& state) {
+    const auto& compressed  = gzipped(itch_data);
+    size_t      total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        size_t message_count = 0;
+        parser.parse_compressed(compressed, [&](const itch::Message&) { ++message_count; });
+        benchmark::DoNotOptimize(message_count);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+    state.counters["CompressedMB"] = static_cast<double>(compressed.size()) / MEGABYTE;
+}
+
+// Decompression alone, through the same ring, with a consumer that takes every
+// block whole.
+BENCHMARK_DEFINE_F(ParserBenchmark, BM_GunzipOnly)(benchmark::State& state) {
+    const auto& compressed  = gzipped(itch_data);
+    size_t      total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        itch::io::for_each_decompressed_block(
+            compressed, itch::io::Compression::gzip, [](std::span<const std::byte> block) {
+                benchmark::DoNotOptimize(block.data());
+                return block.size();
+            }
+        );
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+// Decompression runs on its own thread, so both are timed in wall-clock time.
+BENCHMARK_REGISTER_F(ParserBenchmark, BM_ParseGzip)->UseRealTime();
+BENCHMARK_REGISTER_F(ParserBenchmark, BM_GunzipOnly)->UseRealTime();
+
+#endif
+
+// The bitmap filter rejects every non-Add-Order frame on its type byte, so only
+// the kept frames are decoded and passed through the callback.
+BENCHMARK_F(ParserBenchmark, BM_ParseTypeFilterAddOrdersOnly)(benchmark::State& state) {
+    size_t                        total_bytes = 0;
+    const itch::MessageTypeFilter filter {"A"};
+    for ([[maybe_unused]] auto iter : state) {
+        std::uint64_t shares   = 0;
+        auto          callback = [&](const itch::Message& msg) {
+            shares += std::get<itch::AddOrderMessage>(msg).shares;
+        };
+        parser.parse(itch_data.data(), itch_data.size(), callback, filter);
+        benchmark::DoNotOptimize(shares);
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+// Two-phase parallel decode: one length-prefix walk to cut frame-aligned
+// chunks, then the chunks decoded concurrently with per-thread callbacks. The
+// argument is the worker thread count.
+BENCHMARK_DEFINE_F(ParserBenchmark, BM_ParallelParse)(benchmark::State& state) {
+    size_t               total_bytes = 0;
+    itch::ParallelParser parallel {static_cast<std::size_t>(state.range(0))};
+    const auto           span = std::as_bytes(std::span {itch_data});
+    // One counter per chunk, spaced a cache line apart so workers do not share.
+    constexpr std::size_t      STRIDE = 8;
+    std::vector<std::uint64_t> counts(
+        parallel.thread_count() * itch::ParallelParser::CHUNKS_PER_THREAD * STRIDE
+    );
+    for ([[maybe_unused]] auto iter : state) {
+        parallel.parse(span, [&](std::size_t chunk, const itch::Message& msg) {
+            benchmark::DoNotOptimize(&msg);
+            ++counts[chunk * STRIDE];
+        });
+        benchmark::DoNotOptimize(counts.data());
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+// Phase one alone: the cost of the length-prefix walk that cuts the chunks.
+BENCHMARK_F(ParserBenchmark, BM_ParallelIndexFrames)(benchmark::State& state) {
+    size_t     total_bytes = 0;
+    const auto span        = std::as_bytes(std::span {itch_data});
+    for ([[maybe_unused]] auto iter : state) {
+        auto index = itch::ParallelParser::index_frames(span, 32);
+        benchmark::DoNotOptimize(index.chunks.data());
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+// BM_ParseWithCallback pinned to one decode kernel (0 = scalar, 1 = ssse3,
+// 2 = avx2), to compare the SIMD order-flow decoders against the field-by-field
+// path on the file's own message mix.
+BENCHMARK_DEFINE_F(ParserBenchmark, BM_ParseDecodeKernel)(benchmark::State& state) {
+    const auto kernel = static_cast<itch::DecodeKernel>(state.range(0));
+    if (!itch::decode_kernel_supported(kernel)) {
+        state.SkipWithError("Decode kernel not supported by this CPU.");
+        return;
+    }
+    parser.set_decode_kernel(kernel);
+    state.SetLabel(std::string {itch::to_string(kernel)});
+
+    size_t total_bytes = 0;
+    for ([[maybe_unused]] auto iter : state) {
+        parser.parse(itch_data.data(), itch_data.size(), [](const itch::Message& msg) {
+            benchmark::DoNotOptimize(&msg);
+        });
+        total_bytes += itch_data.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(total_bytes));
+}
+
+// The decode kernels alone, without framing or a callback: the first 4096
+// order-flow frames of the file (its own A/D/E/X/U mix, in file order, small
+// enough to stay in cache) decoded through one kernel's function for each type.
+BENCHMARK_DEFINE_F(ParserBenchmark, BM_DecodeOrderFlow)(benchmark::State& state) {
+    using Decoder     = itch::Message (*)(const char*);
+    const auto kernel = static_cast<itch::DecodeKernel>(state.range(0));
+    if (!itch::decode_kernel_supported(kernel)) {
+        state.SkipWithError("Decode kernel not supported by this CPU.");
+        return;
+    }
+    state.SetLabel(std::string {itch::to_string(kernel)});
+
+    std::array<Decoder, 256> decoders {};
+    auto                     add = [&]<typename MsgType>(char type) {
+        Decoder decoder = [](const char* frame) -> itch::Message {
+            return itch::detail::decode_typed<MsgType>(frame);
+        };
+        if constexpr (itch::detail::HAS_SIMD_KERNEL<MsgType>) {
+            if (kernel == itch::DecodeKernel::ssse3) {
+                decoder = &itch::detail::decode_ssse3<MsgType>;
+            } else if (kernel == itch::DecodeKernel::avx2) {
+                decoder = &itch::detail::decode_avx2<MsgType>;
+            }
+        }
+        decoders[static_cast<unsigned char>(type)] = decoder;
+    };
+    add.operator()<itch::AddOrderMessage>('A');
+    add.operator()<itch::OrderDeleteMessage>('D');
+    add.operator()<itch::OrderExecutedMessage>('E');
+    add.operator()<itch::OrderCancelMessage>('X');
+    add.operator()<itch::OrderReplaceMessage>('U');
+
+    constexpr std::size_t    FRAMES = 4096;
+    std::vector<const char*> frames;
+    for (std::size_t offset = 0; offset + 2 <= itch_data.size() && frames.size() < FRAMES;) {
+        const auto  length = static_cast<std::size_t>(
+            (static_cast<unsigned char>(itch_data[offset]) << 8U) |
+            static_cast<unsigned char>(itch_data[offset + 1])
+        );
+        const char* frame  = itch_data.data() + offset + 2;
+        if (length != 0 && decoders[static_cast<unsigned char>(frame[0])] != nullptr) {
+            frames.push_back(frame);
+        }
+        offset += 2 + length;
+    }
+
+    for ([[maybe_unused]] auto iter : state) {
+        for (const char* frame : frames) {
+            auto message = decoders[static_cast<unsigned char>(frame[0])](frame);
+            benchmark::DoNotOptimize(message);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * frames.size()));
+}
+
+BENCHMARK_REGISTER_F(ParserBenchmark, BM_ParallelParse)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
+BENCHMARK_REGISTER_F(ParserBenchmark, BM_ParseDecodeKernel)->DenseRange(0, 2);
+BENCHMARK_REGISTER_F(ParserBenchmark, BM_DecodeOrderFlow)->DenseRange(0, 2);
+
 int main(int argc, char** argv) {
     if (argc < 2) {
         std::cerr << "Usage: ./parser_bench <path_to_itch_data_file> [google "
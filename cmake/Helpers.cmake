@@ -12,6 +12,9 @@ option(${PROJECT_NAME}_BUILD_FUZZERS "Build libFuzzer targets (Clang only)" OFF)
 option(${PROJECT_NAME}_BUILD_TOOLS "Build the itch-tool command-line utility" OFF)
 option(${PROJECT_NAME}_BUILD_PYTHON "Build the pybind11 Python bindings" OFF)
 option(${PROJECT_NAME}_WITH_ARROW "Enable Apache Arrow / Parquet export" OFF)
+option(${PROJECT_NAME}_WITH_ZLIB "Enable reading gzip-compressed input (zlib)" OFF)
+option(${PROJECT_NAME}_WITH_ZSTD "Enable reading zstd-compressed input (libzstd)" OFF)
+option(${PROJECT_NAME}_WITH_STATS "Collect per-type counters and decode latency in Parser" OFF)
 
 set(${PROJECT_NAME}_PROJECT_ENV "DEV" CACHE STRING "Development environment")
 set_property(CACHE ${PROJECT_NAME}_PROJECT_ENV PROPERTY STRINGS "DEV" "PROD")
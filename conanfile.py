@@ -23,8 +23,12 @@ class ItchConan(ConanFile):
     )
     topics = ("nasdaq", "itch", "market-data", "order-book", "hft", "finance")
     settings = "os", "compiler", "build_type", "arch"
-    options = {"with_arrow": [True, False]}
-    default_options = {"with_arrow": False}
+    options = {
+        "with_arrow": [True, False],
+        "with_zlib": [True, False],
+        "with_zstd": [True, False],
+    }
+    default_options = {"with_arrow": False, "with_zlib": False, "with_zstd": False}
     exports_sources = (
         "CMakeLists.txt",
         "VERSION.txt",
@@ -41,6 +45,10 @@ class ItchConan(ConanFile):
     def requirements(self):
         if self.options.with_arrow:
             self.requires("arrow/15.0.0")
+        if self.options.with_zlib:
+            self.requires("zlib/1.3.1")
+        if self.options.with_zstd:
+            self.requires("zstd/1.5.5")
 
     def layout(self):
         cmake_layout(self)
@@ -48,6 +56,8 @@ class ItchConan(ConanFile):
     def generate(self):
         toolchain = CMakeToolchain(self)
         toolchain.variables["ITCH_WITH_ARROW"] = self.options.with_arrow
+        toolchain.variables["ITCH_WITH_ZLIB"] = self.options.with_zlib
+        toolchain.variables["ITCH_WITH_ZSTD"] = self.options.with_zstd
         toolchain.generate()
 
     def build(self):
@@ -1,5 +1,6 @@
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <exception>
 #include <span>
 
@@ -9,6 +10,11 @@
 // dispatch path. Truncation is reported by `parse` as an exception, which is an
 // expected outcome on random input and is swallowed; any crash, overread, or
 // sanitizer report on this path is a genuine bug.
+//
+// The same bytes then go through `TrustedInput {.validate = true}`, which must
+// be just as safe on hostile input: `Parser::validate` has to reject anything
+// the unchecked loop cannot handle, and the checked fallback must deliver the
+// same messages as `parse`.
 extern "C" auto LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) -> int {
     itch::Parser parser;
 
@@ -17,10 +23,22 @@ extern "C" auto LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t siz
     const auto* bytes = static_cast<const std::byte*>(static_cast<const void*>(data));
     const std::span<const std::byte> buffer {bytes, size};
 
+    std::size_t checked = 0;
     try {
-        parser.parse(buffer, [](const itch::Message&) noexcept {});
+        parser.parse(buffer, [&checked](const itch::Message&) noexcept { ++checked; });
     } catch (const std::exception&) {
         // Truncated input is expected and benign for the fuzzer.
     }
+
+    std::size_t              trusted = 0;
+    const itch::TrustedInput validated {.validate = true};
+    try {
+        parser.parse(validated, buffer, [&trusted](const itch::Message&) noexcept { ++trusted; });
+    } catch (const std::exception&) {
+        // As above: only the checked fallback throws, on truncation.
+    }
+    if (trusted != checked) {
+        std::abort();
+    }
     return 0;
 }
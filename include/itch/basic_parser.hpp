@@ -0,0 +1,216 @@
+#pragma once
+
+/// @file
+/// @brief A parser specialized at compile time to a fixed subset of message
+///        types.
+///
+/// `Parser` instantiates a decoder for every ITCH message type and delivers a
+/// `Message` variant sized and visited for all of them, even when a process
+/// only ever looks at a handful. `BasicParser<Types...>` generates its dispatch
+/// table, its decoders, and its result variant from `Types` alone: frames of
+/// any other type are length-skipped without being decoded, no code is emitted
+/// for their decoders, and callers visit a variant of just the types they
+/// asked for.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "itch/detail/decode.hpp"
+#include "itch/detail/wire.hpp"
+#include "itch/filter.hpp"
+#include "itch/messages.hpp"
+#include "itch/parser.hpp"
+
+namespace itch {
+
+namespace detail {
+
+/// @brief Whether `MsgType` is a message struct of the registry, i.e. its type
+///        byte is known and maps to its own wire size.
+template <typename MsgType>
+inline constexpr bool IS_REGISTERED_MESSAGE =
+    WIRE_SIZE_TABLE[static_cast<unsigned char>(MsgType {}.message_type)] == WIRE_SIZE<MsgType>;
+
+/// @brief Whether the message structs in a pack all have distinct type bytes.
+template <typename... Types>
+consteval auto distinct_message_types() -> bool {
+    std::array<bool, 256> seen {};
+    bool                  distinct = true;
+    (
+        [&] {
+            auto& slot = seen[static_cast<unsigned char>(Types {}.message_type)];
+            distinct   = distinct && !slot;
+            slot       = true;
+        }(),
+        ...
+    );
+    return distinct;
+}
+
+}  // namespace detail
+
+/// @brief A parser that decodes only the message types `Types...`.
+///
+/// The framing, diagnostics, locate filter, and statistics are those of the
+/// embedded `Parser` (see `parser()`), so malformed and unknown frames are
+/// reported exactly as `Parser` reports them. Frames of registered types
+/// outside `Types` are length-skipped like frames rejected by a
+/// `MessageTypeFilter`.
+///
+/// @tparam Types The message structs to decode, e.g. `AddOrderMessage`; each
+///         must be a registered ITCH message and appear once.
+template <typename... Types>
+class BasicParser {
+    static_assert(sizeof...(Types) > 0, "BasicParser needs at least one message type.");
+    static_assert(
+        (detail::IS_REGISTERED_MESSAGE<Types> && ...),
+        "BasicParser types must be ITCH message structs."
+    );
+    static_assert(
+        detail::distinct_message_types<Types...>(), "BasicParser types must not repeat."
+    );
+
+   public:
+    /// @brief The decoded result: a variant over `Types` only.
+    using Message = std::variant<Types...>;
+
+    /// @brief The callback invoked with each decoded message.
+    using Callback = std::function<void(const Message&)>;
+
+    /// @brief The type bytes of `Types`, as a filter.
+    static constexpr MessageTypeFilter TYPES = [] {
+        MessageTypeFilter filter;
+        (filter.allow(Types {}.message_type), ...);
+        return filter;
+    }();
+
+    /// @brief Parses a buffer, invoking a callback for each message of `Types`.
+    ///
+    /// @param data The buffer containing ITCH data.
+    /// @param callback A function to be called for each decoded message.
+    /// @throw std::runtime_error if the buffer ends in the middle of a message.
+    auto parse(std::span<const std::byte> data, const Callback& callback) -> void {
+        run(data, [&callback](const char* frame) {
+            callback(DECODERS[static_cast<unsigned char>(frame[0])](frame));
+        });
+    }
+
+    /// @brief Parses every message of `Types` in a buffer into a vector.
+    ///
+    /// @param data The buffer containing ITCH data.
+    /// @return The decoded messages in feed order.
+    /// @throw std::runtime_error if the buffer ends in the middle of a message.
+    auto parse(std::span<const std::byte> data) -> std::vector<Message> {
+        std::vector<Message> messages;
+        run(data, [&messages](const char* frame) {
+            messages.push_back(DECODERS[static_cast<unsigned char>(frame[0])](frame));
+        });
+        return messages;
+    }
+
+    /// @brief Parses a buffer, calling `handler` with each message of `Types`
+    ///        as its concrete struct, with no variant in between.
+    ///
+    /// Types the handler cannot be invoked with are skipped after framing, as
+    /// `Parser::parse_with` does.
+    ///
+    /// @tparam Handler A callable invocable as `handler(const MsgType&)` for
+    ///         the types it accepts.
+    /// @param data The buffer containing ITCH data.
+    /// @param handler The handler to call.
+    /// @throw std::runtime_error if the buffer ends in the middle of a message.
+    template <typename Handler>
+    auto parse_with(std::span<const std::byte> data, Handler&& handler) -> void {
+        using HandlerType = std::remove_reference_t<Handler>;
+        run(data, [&handler](const char* frame) {
+            const auto thunk = HANDLERS<HandlerType>[static_cast<unsigned char>(frame[0])];
+            if (thunk != nullptr) {
+                thunk(frame, handler);
+            }
+        });
+    }
+
+    /// @brief The embedded parser, for diagnostics, the error callback, the
+    ///        locate filter, and statistics.
+    ///
+    /// @return Reference to the embedded `Parser`.
+    [[nodiscard]] auto parser() noexcept -> Parser& { return m_parser; }
+
+    /// @brief The embedded parser, for diagnostics.
+    ///
+    /// @return Const reference to the embedded `Parser`.
+    [[nodiscard]] auto parser() const noexcept -> const Parser& { return m_parser; }
+
+   private:
+    using Decoder = Message (*)(const char*);
+
+    template <typename Handler>
+    using HandlerThunk = void (*)(const char*, Handler&);
+
+    /// @brief The subset's decoders, indexed by type byte; null outside `Types`.
+    static constexpr auto DECODERS = [] {
+        std::array<Decoder, 256> table {};
+        ((table[static_cast<unsigned char>(Types {}.message_type)] =
+              [](const char* frame) -> Message { return detail::decode_typed<Types>(frame); }),
+         ...);
+        return table;
+    }();
+
+    /// @brief The subset's typed dispatch for one handler type.
+    template <typename Handler>
+    static constexpr auto HANDLERS = [] {
+        std::array<HandlerThunk<Handler>, 256> table {};
+        (
+            [&table] {
+                if constexpr (std::is_invocable_v<Handler&, const Types&>) {
+                    table[static_cast<unsigned char>(Types {}.message_type)] =
+                        [](const char* frame, Handler& handler) {
+                            const Types msg = detail::decode_typed<Types>(frame);
+                            handler(msg);
+                        };
+                }
+            }(),
+            ...
+        );
+        return table;
+    }();
+
+    /// @brief Frames `data`, handing each frame of `Types` to `on_frame`.
+    template <typename FrameHandler>
+    auto run(std::span<const std::byte> data, FrameHandler&& on_frame) -> void {
+        const auto error = m_parser.frame_loop(
+            detail::as_char_ptr(data), data.size(), TYPES, std::forward<FrameHandler>(on_frame)
+        );
+        if (error.has_value()) {
+            throw std::runtime_error("Incomplete message at end of buffer.");
+        }
+    }
+
+    Parser m_parser {};
+};
+
+/// @brief The message types an order-book builder consumes: the stock
+///        directory, order flow, and trades.
+using BookParser = BasicParser<
+    StockDirectoryMessage,
+    AddOrderMessage,
+    AddOrderMPIDAttributionMessage,
+    OrderExecutedMessage,
+    OrderExecutedWithPriceMessage,
+    OrderCancelMessage,
+    OrderDeleteMessage,
+    OrderReplaceMessage,
+    NonCrossTradeMessage,
+    CrossTradeMessage>;
+
+}  // namespace itch
@@ -21,6 +21,7 @@
 
 #include "itch/book/l3_book.hpp"
 #include "itch/messages.hpp"
+#include "itch/overlay.hpp"
 #include "itch/tape.hpp"
 
 namespace itch::book {
@@ -28,25 +29,129 @@ namespace itch::book {
 /// @brief Maintains a full-market set of order books from a single pass over the
 ///        feed.
 ///
-/// Every order, execution, cancel, delete, and replace message carries a stock
-/// locate code; the manager routes each message to that security's `L3Book` in
-/// O(1) through a flat, locate-indexed table, reconstructing every symbol on the
-/// feed at once rather than a single pre-selected one. It optionally restricts
-/// work to a chosen universe of symbols, emits best-bid/offer change events as
-/// they happen, and extracts the trade tape.
+/// Every add order carries a stock locate code; the manager routes it to that
+/// security's `L3Book` in O(1) through a flat, locate-indexed table,
+/// reconstructing every symbol on the feed at once rather than a single
+/// pre-selected one. Order reference numbers are unique feed-wide, so all books
+/// share one `OrderIndex` from reference number to (locate, pool slot), and
+/// executions, cancels, deletes, and replaces find their book through it rather
+/// than through the locate they carry. It optionally restricts work to a
+/// chosen universe of symbols, emits best-bid/offer change events as they
+/// happen, and extracts the trade tape.
 class BookManager {
    public:
     /// @brief Invoked when a book's best bid or offer changes.
     using BboCallback = std::function<void(const L3Book& book, const Bbo& bbo)>;
 
     /// @brief Constructs an empty manager with no books tracked yet.
-    BookManager() = default;
+    /// @param index_mode How the shared order index stores reference numbers;
+    ///        `OrderIndexMode::dense` suits a full feed, whose reference
+    ///        numbers are issued nearly in sequence.
+    explicit BookManager(OrderIndexMode index_mode = OrderIndexMode::hashed)
+        : m_orders {std::make_unique<OrderIndex>(index_mode)} {}
 
     /// @brief Processes one parsed ITCH message, updating the relevant book and
     ///        emitting BBO/trade events as appropriate.
     /// @param message The parsed ITCH message to apply.
     auto process(const Message& message) -> void;
 
+    /// @brief Processes one raw frame through its overlay view, reading only the
+    ///        fields the book update needs straight from the wire bytes.
+    ///
+    /// Equivalent to `process(const Message&)` on the decoded frame, without the
+    /// decode or the `Message` variant. The view overloads below also make the
+    /// manager a handler for `overlay::visit`, which skips the type switch too.
+    /// @param view A view over a well-formed frame, e.g. from
+    ///        `overlay::for_each_message`.
+    auto process(const overlay::MessageView& view) -> void;
+
+    /// @brief Applies a decoded Add Order. Together with the overloads below,
+    ///        this makes the manager a handler for `Parser::parse_with`, which
+    ///        skips the `Message` variant and never decodes the message types
+    ///        the manager has no overload for.
+    /// @param add The decoded add-order message.
+    auto operator()(const AddOrderMessage& add) -> void { handle_add_order(add); }
+
+    /// @brief Applies a decoded MPID-attributed Add Order.
+    /// @param add The decoded add-order message.
+    auto operator()(const AddOrderMPIDAttributionMessage& add) -> void { handle_add_order(add); }
+
+    /// @brief Applies a decoded Order Executed.
+    /// @param exec The decoded order-executed message.
+    auto operator()(const OrderExecutedMessage& exec) -> void { handle_order_executed(exec); }
+
+    /// @brief Applies a decoded Order Executed With Price.
+    /// @param exec The decoded order-executed-with-price message.
+    auto operator()(const OrderExecutedWithPriceMessage& exec) -> void {
+        handle_order_executed_with_price(exec);
+    }
+
+    /// @brief Applies a decoded Order Cancel.
+    /// @param cancel The decoded order-cancel message.
+    auto operator()(const OrderCancelMessage& cancel) -> void { handle_order_cancel(cancel); }
+
+    /// @brief Applies a decoded Order Delete.
+    /// @param del The decoded order-delete message.
+    auto operator()(const OrderDeleteMessage& del) -> void { handle_order_delete(del); }
+
+    /// @brief Applies a decoded Order Replace.
+    /// @param replace The decoded order-replace message.
+    auto operator()(const OrderReplaceMessage& replace) -> void { handle_order_replace(replace); }
+
+    /// @brief Applies a decoded Non-Cross Trade.
+    /// @param trade The decoded non-cross-trade message.
+    auto operator()(const NonCrossTradeMessage& trade) -> void { handle_non_cross_trade(trade); }
+
+    /// @brief Applies a decoded Cross Trade.
+    /// @param cross The decoded cross-trade message.
+    auto operator()(const CrossTradeMessage& cross) -> void { handle_cross_trade(cross); }
+
+    /// @brief Applies a decoded Stock Directory.
+    /// @param directory The decoded stock-directory message.
+    auto operator()(const StockDirectoryMessage& directory) -> void {
+        handle_stock_directory(directory);
+    }
+
+    /// @brief Applies an Add Order read from its overlay view.
+    /// @param add The add-order view.
+    auto operator()(const overlay::AddOrderView& add) -> void;
+
+    /// @brief Applies an MPID-attributed Add Order read from its overlay view.
+    /// @param add The add-order view.
+    auto operator()(const overlay::AddOrderMPIDAttributionView& add) -> void;
+
+    /// @brief Applies an Order Executed read from its overlay view.
+    /// @param exec The order-executed view.
+    auto operator()(const overlay::OrderExecutedView& exec) -> void;
+
+    /// @brief Applies an Order Executed With Price read from its overlay view.
+    /// @param exec The order-executed-with-price view.
+    auto operator()(const overlay::OrderExecutedWithPriceView& exec) -> void;
+
+    /// @brief Applies an Order Cancel read from its overlay view.
+    /// @param cancel The order-cancel view.
+    auto operator()(const overlay::OrderCancelView& cancel) -> void;
+
+    /// @brief Applies an Order Delete read from its overlay view.
+    /// @param del The order-delete view.
+    auto operator()(const overlay::OrderDeleteView& del) -> void;
+
+    /// @brief Applies an Order Replace read from its overlay view.
+    /// @param replace The order-replace view.
+    auto operator()(const overlay::OrderReplaceView& replace) -> void;
+
+    /// @brief Applies a Non-Cross Trade read from its overlay view.
+    /// @param trade The non-cross-trade view.
+    auto operator()(const overlay::NonCrossTradeView& trade) -> void;
+
+    /// @brief Applies a Cross Trade read from its overlay view.
+    /// @param cross The cross-trade view.
+    auto operator()(const overlay::CrossTradeView& cross) -> void;
+
+    /// @brief Applies a Stock Directory read from its overlay view.
+    /// @param directory The stock-directory view.
+    auto operator()(const overlay::StockDirectoryView& directory) -> void;
+
     /// @brief Installs the best-bid/offer change callback (empty clears it).
     /// @param callback Invoked whenever a tracked book's best bid or offer
     ///        changes.
@@ -87,8 +192,9 @@ class BookManager {
 
    private:
     struct BookEntry {
-        L3Book book;
-        Bbo    last_bbo {};
+        L3Book        book;
+        Bbo           last_bbo {};
+        std::uint16_t stock_locate {0};
     };
 
     /// @brief Returns the entry for a locate, creating it if the symbol is
@@ -105,6 +211,13 @@ class BookManager {
     ///         exists.
     [[nodiscard]] auto entry(std::uint16_t stock_locate) const -> BookEntry*;
 
+    /// @brief Returns the entry whose book holds a resting order, found through
+    ///        the shared order index.
+    /// @param reference_number Exchange order reference number of the order.
+    /// @return Pointer to the entry holding the order, or nullptr if no tracked
+    ///         book does.
+    [[nodiscard]] auto entry_for_order(std::uint64_t reference_number) const -> BookEntry*;
+
     /// @brief Emits a BBO event if the book's top has changed since last seen.
     /// @param target The book entry to check and, if changed, report.
     auto emit_bbo_if_changed(BookEntry& target) -> void;
@@ -159,6 +272,9 @@ class BookManager {
     /// @param directory The parsed stock-directory message.
     auto handle_stock_directory(const StockDirectoryMessage& directory) -> void;
 
+    /// Reference number -> (locate, pool slot) for every book; heap-held so the
+    /// books' pointers to it survive a move of the manager.
+    std::unique_ptr<OrderIndex>             m_orders;
     std::vector<std::unique_ptr<BookEntry>> m_books_by_locate;   ///< Indexed by locate.
     std::vector<std::string>                m_symbol_by_locate;  ///< Locate -> symbol.
     std::unordered_set<std::string>         m_universe;          ///< Empty == track all.
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "itch/book/order_index.hpp"
+#include "itch/book/price_ladder.hpp"
 #include "itch/price.hpp"
 
 namespace itch::book {
@@ -65,16 +66,54 @@ struct Bbo {
 /// Unlike the original `LimitOrderBook`, which stored each order in a
 /// `std::shared_ptr` inside a `std::list` and each price level in a `std::map`,
 /// this engine holds orders in a reusable object pool (a flat vector with a free
-/// list) linked into intrusive FIFO queues, and keeps each side's price levels in
-/// a flat, sorted vector. There is no per-order heap allocation, no atomic
-/// refcount, and no per-level node allocation on the hot path; order lookup by
-/// reference number is O(1) and the best bid/offer is the front of a ladder.
+/// list) linked into intrusive FIFO queues, and keeps price levels in a second
+/// pool indexed by a tick-addressed `PriceLadder` per side. There is no per-order
+/// heap allocation, no atomic refcount, and no per-level node allocation on the
+/// hot path; order lookup by reference number, level lookup by price, and the
+/// best bid/offer are all O(1).
 class L3Book {
    public:
     /// @brief Constructs a book, optionally tagged with its stock symbol.
     /// @param symbol The ticker symbol to associate with the book (may be
     ///        empty).
-    explicit L3Book(std::string symbol = {});
+    /// @param index_mode How the book's order index stores reference numbers.
+    explicit L3Book(std::string symbol = {}, OrderIndexMode index_mode = OrderIndexMode::hashed);
+
+    /// @brief Constructs a book that keeps its order lookups in an index shared
+    ///        with other books, as `BookManager` does for a whole feed.
+    ///
+    /// The book only ever sees the entries it inserted under `owner`; the index
+    /// must outlive the book.
+    /// @param symbol The ticker symbol to associate with the book.
+    /// @param shared_index The index shared by every book on the feed.
+    /// @param owner The tag that marks this book's entries in `shared_index`.
+    L3Book(std::string symbol, OrderIndex& shared_index, std::uint16_t owner);
+
+    /// @brief Copy-constructs a book as an independent snapshot.
+    ///
+    /// A copy of a book that shares an index does not alias it: the copy gets a
+    /// private index, in the shared index's mode, rebuilt from its own pool, so
+    /// updating the copy never touches the source's orders.
+    /// @param other The book to copy.
+    L3Book(const L3Book& other);
+
+    /// @brief Move-constructs a book, taking over its index or index share.
+    /// @param other The book to move from.
+    L3Book(L3Book&& other) noexcept = default;
+
+    /// @brief Copy-assigns a book as an independent snapshot, like the copy
+    ///        constructor.
+    /// @param other The book to copy.
+    /// @return Reference to this book.
+    auto operator=(const L3Book& other) -> L3Book&;
+
+    /// @brief Move-assigns a book, taking over its index or index share.
+    /// @param other The book to move from.
+    /// @return Reference to this book.
+    auto operator=(L3Book&& other) noexcept -> L3Book& = default;
+
+    /// @brief Destroys the book.
+    ~L3Book() = default;
 
     /// @brief Sets the stock symbol associated with this book.
     /// @param symbol The ticker symbol to associate with the book.
@@ -176,7 +215,9 @@ class L3Book {
 
     /// @brief Whether the book has no resting orders on either side.
     /// @return True if no orders are resting on either side, false otherwise.
-    [[nodiscard]] auto empty() const noexcept -> bool { return m_index.empty(); }
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return m_bid_ladder.empty() && m_ask_ladder.empty();
+    }
 
    private:
     /// @brief Sentinel index meaning "no node".
@@ -188,28 +229,45 @@ class L3Book {
         std::uint32_t shares {0};
         std::uint32_t price {0};
         Side          side {Side::buy};
-        std::uint32_t next {NIL};  ///< Next order in level FIFO, or next free node.
-        std::uint32_t prev {NIL};  ///< Previous order in level FIFO.
+        std::uint32_t next {NIL};   ///< Next order in level FIFO, or next free node.
+        std::uint32_t prev {NIL};   ///< Previous order in level FIFO.
+        std::uint32_t level {NIL};  ///< The level the order rests at.
     };
 
     /// @brief One price level holding the head/tail of an intrusive FIFO queue.
+    ///
+    /// A level keeps its pool index for as long as it has orders, so each
+    /// `OrderNode` records it and later updates skip the price lookup.
     struct Level {
         std::uint32_t price {0};
         std::uint64_t total_shares {0};
         std::uint32_t order_count {0};
-        std::uint32_t head {NIL};
+        std::uint32_t head {NIL};  ///< Oldest order in the FIFO, or next free level.
         std::uint32_t tail {NIL};
     };
 
-    /// @brief The mutable level ladder for a side.
+    /// @brief The mutable price ladder for a side.
     /// @param side The side whose ladder to return.
-    /// @return Reference to the vector of price levels for `side`.
-    [[nodiscard]] auto side_levels(Side side) noexcept -> std::vector<Level>&;
+    /// @return Reference to the ladder of level indices for `side`.
+    [[nodiscard]] auto side_ladder(Side side) noexcept -> PriceLadder&;
 
-    /// @brief The level ladder for a side.
+    /// @brief The price ladder for a side.
     /// @param side The side whose ladder to return.
-    /// @return Const reference to the vector of price levels for `side`.
-    [[nodiscard]] auto side_levels(Side side) const noexcept -> const std::vector<Level>&;
+    /// @return Const reference to the ladder of level indices for `side`.
+    [[nodiscard]] auto side_ladder(Side side) const noexcept -> const PriceLadder&;
+
+    /// @brief The index holding this book's orders: the shared one if any,
+    ///        otherwise the book's own.
+    /// @return Reference to the index to look orders up in.
+    [[nodiscard]] auto index() noexcept -> OrderIndex& {
+        return m_shared_index != nullptr ? *m_shared_index : m_index;
+    }
+
+    /// @brief The index holding this book's orders.
+    /// @return Const reference to the index to look orders up in.
+    [[nodiscard]] auto index() const noexcept -> const OrderIndex& {
+        return m_shared_index != nullptr ? *m_shared_index : m_index;
+    }
 
     /// @brief Allocates a node from the free list (or grows the pool) and
     ///        returns its index.
@@ -220,6 +278,15 @@ class L3Book {
     /// @param node_index The pool index of the node to free.
     auto free_node(std::uint32_t node_index) -> void;
 
+    /// @brief Allocates a level from the free list (or grows the level pool)
+    ///        and returns its index.
+    /// @return The pool index of the newly allocated level.
+    auto allocate_level() -> std::uint32_t;
+
+    /// @brief Returns a level to the free list.
+    /// @param level_index The pool index of the level to free.
+    auto free_level(std::uint32_t level_index) -> void;
+
     /// @brief Finds the index of the level at `price` on `side`, or NIL if
     ///        absent.
     /// @param side The side to search.
@@ -227,25 +294,30 @@ class L3Book {
     /// @return The index of the matching level, or `NIL` if none exists.
     [[nodiscard]] auto find_level(Side side, std::uint32_t price) const -> std::uint32_t;
 
-    /// @brief Finds, or inserts in sorted order, the level at `price`;
-    ///        returns its index.
+    /// @brief Finds, or creates and enters into the side's ladder, the level
+    ///        at `price`; returns its index.
     /// @param side The side to search or insert into.
     /// @param price The raw (unscaled) limit price to find or create.
     /// @return The index of the existing or newly created level.
     auto find_or_create_level(Side side, std::uint32_t price) -> std::uint32_t;
 
-    /// @brief Unlinks a node from its level FIFO and removes the level if it
-    ///        empties.
+    /// @brief Unlinks a node from the level FIFO it records and frees the
+    ///        level if it empties.
     /// @param node_index The pool index of the node to unlink.
     auto unlink_node(std::uint32_t node_index) -> void;
 
     std::string            m_symbol;
     std::vector<OrderNode> m_pool;
     std::uint32_t          m_free_head {NIL};
-    std::vector<Level>     m_bids;  ///< Sorted high to low; front is the best bid.
-    std::vector<Level>     m_asks;  ///< Sorted low to high; front is the best ask.
-    // Reference-number -> pool index for O(1), allocation-free order lookup.
-    OrderIndex m_index;
+    std::vector<Level>     m_levels;  ///< Level pool for both sides.
+    std::uint32_t          m_free_level {NIL};
+    PriceLadder            m_bid_ladder {LadderDirection::highest_first};
+    PriceLadder            m_ask_ladder {LadderDirection::lowest_first};
+    // Reference-number -> pool index for O(1), allocation-free order lookup;
+    // unused (and never allocated) when the book shares a feed-wide index.
+    OrderIndex    m_index;
+    OrderIndex*   m_shared_index {nullptr};
+    std::uint16_t m_owner {0};  ///< This book's tag in the index.
 };
 
 }  // namespace itch::book
@@ -2,21 +2,32 @@
 
 /// @file
 /// @brief Allocation-light, open-addressed hash map from order reference
-///        number to order-pool index.
+///        number to order-pool index and owning book.
 ///
 /// This header declares `OrderIndex`, the lookup structure `L3Book` uses to
 /// resolve an ITCH order reference number to its slot in the order pool in
 /// O(1) without the per-insert/per-erase heap allocations of
-/// `std::unordered_map`.
+/// `std::unordered_map`. Each entry also records a 16-bit owner, so one index
+/// can be shared by every book on a feed (`BookManager` tags entries with the
+/// stock locate). A dense mode maps reference numbers, which ITCH issues almost
+/// sequentially, straight into a paged array instead of hashing them.
 ///
 /// @author Bertin Balouki SIMYELI
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace itch::book {
 
+/// @brief How an `OrderIndex` stores its keys.
+enum class OrderIndexMode : std::uint8_t {
+    hashed,  ///< Open-addressed hash table only.
+    dense,   ///< Paged direct-mapped array, with the hash table for outliers.
+};
+
 /// @brief A flat, open-addressed hash map from order reference number to pool
 ///        index, used for O(1) order lookup without per-order heap allocation.
 ///
@@ -25,36 +36,110 @@ namespace itch::book {
 /// the book's cost and defeats the allocation-free goal. This map stores its slots
 /// in a single contiguous vector, probes linearly (cache friendly), and uses
 /// backward-shift deletion so heavy add/cancel churn does not accumulate
-/// tombstones. It only allocates when it grows.
+/// tombstones. It only allocates when it grows; the table itself is allocated
+/// on the first insert, so an index that is never used costs nothing.
+///
+/// Growth is incremental. Zeroing a doubled table and re-inserting millions of
+/// live orders in one go would stall the insert that triggers it for tens of
+/// milliseconds. Instead, once the table passes 60% load, one insert in
+/// `STAGING_INTERVAL` zeroes the next `STAGING_STEP` slots of its successor,
+/// and once it is swapped in the outgrown table is kept beside it while every
+/// insert or erase moves the next `MIGRATION_STEP` of its slots across.
+/// Lookups check both tables until the move completes. Freeing the outgrown
+/// table in one go would stall again, for several milliseconds at a few
+/// million slots, so it is retired instead: each later insert or erase hands
+/// the next `RELEASE_STEP_BYTES` of its pages back to the OS, and the vector
+/// is freed once none are left.
+///
+/// The hash scatters the near-sequential reference numbers of a session across
+/// the table, so consecutive orders land on unrelated cache lines. In
+/// `OrderIndexMode::dense` a key is instead stored at `key - base` in an array
+/// of fixed-size pages, `base` being the first key inserted rounded down to a
+/// page: a lookup is two dependent loads, and orders that arrive together sit
+/// together. Pages are allocated on first use and freed once their last key is
+/// erased. The page directory only grows `DENSE_SLACK_PAGES` at a time: a key
+/// whose page lies further past the highest page allocated so far, or below
+/// `base`, goes to the hash table, so one stray reference number cannot
+/// stretch the directory across the gap to it. Such a key stays hashed until
+/// the pages catch up with it and it is written again.
 class OrderIndex {
    public:
     /// @brief Sentinel returned by `find` when a key is absent.
     static constexpr std::uint32_t NPOS = 0xFFFFFFFFU;
 
-    /// @brief Constructs an empty map with the initial table capacity
-    ///        pre-allocated.
-    OrderIndex() { rehash(INITIAL_CAPACITY); }
+    /// @brief The value and owner stored for a key.
+    struct Entry {
+        std::uint32_t value {NPOS};  ///< Pool index, or `NPOS` if the key is absent.
+        std::uint16_t owner {0};     ///< Owner tag given to `insert`.
+    };
+
+    /// @brief Keys per dense page.
+    static constexpr std::size_t DENSE_PAGE_SIZE = std::size_t {1} << 12;
+
+    /// @brief How many pages above `base` the dense array may span.
+    static constexpr std::size_t MAX_DENSE_PAGES = std::size_t {1} << 20;
+
+    /// @brief How many pages past the end of the page directory a key may land
+    ///        and still be stored densely.
+    static constexpr std::size_t DENSE_SLACK_PAGES = 16;
+
+    /// @brief Constructs an empty map; the table is allocated on first insert.
+    /// @param mode How the map stores its keys.
+    explicit OrderIndex(OrderIndexMode mode = OrderIndexMode::hashed) noexcept : m_mode {mode} {}
+
+    /// @brief How the map stores its keys.
+    /// @return The mode the map was constructed with.
+    [[nodiscard]] auto mode() const noexcept -> OrderIndexMode { return m_mode; }
 
     /// @brief The number of stored keys.
     /// @return The count of stored keys.
-    [[nodiscard]] auto size() const noexcept -> std::size_t { return m_count; }
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return m_count + m_dense_count; }
 
     /// @brief Whether the map holds no keys.
     /// @return True if the map holds no keys, false otherwise.
-    [[nodiscard]] auto empty() const noexcept -> bool { return m_count == 0; }
+    [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0; }
+
+    /// @brief The number of dense pages currently allocated.
+    /// @return The count of live pages (always 0 in hashed mode).
+    [[nodiscard]] auto dense_page_count() const noexcept -> std::size_t { return m_live_pages; }
+
+    /// @brief The number of pages the dense page directory spans, live or not.
+    /// @return The directory length (always 0 in hashed mode).
+    [[nodiscard]] auto dense_page_span() const noexcept -> std::size_t { return m_pages.size(); }
+
+    /// @brief Returns the value and owner stored for `key`.
+    /// @param key The order reference number to look up.
+    /// @return The stored entry, whose `value` is `NPOS` if `key` is absent.
+    [[nodiscard]] auto lookup(std::uint64_t key) const noexcept -> Entry {
+        if (const std::size_t page = dense_page(key); page != NO_PAGE) {
+            if (page < m_pages.size() && !m_pages[page].empty()) {
+                const DenseSlot& slot = m_pages[page][(key - m_base) & DENSE_PAGE_MASK];
+                if (slot.value != NPOS || page < m_far_page) {
+                    return Entry {slot.value, slot.owner};
+                }
+            } else if (page < m_far_page) {
+                return Entry {};
+            }
+        }
+        return hash_lookup(key);
+    }
 
     /// @brief Returns the value for `key`, or `NPOS` if absent.
     /// @param key The order reference number to look up.
     /// @return The stored pool index for `key`, or `NPOS` if absent.
     [[nodiscard]] auto find(std::uint64_t key) const noexcept -> std::uint32_t {
-        std::size_t slot = hash(key) & m_mask;
-        while (m_slots[slot].used) {
-            if (m_slots[slot].key == key) {
-                return m_slots[slot].value;
-            }
-            slot = (slot + 1) & m_mask;
-        }
-        return NPOS;
+        return lookup(key).value;
+    }
+
+    /// @brief Returns the value for `key` if it is stored under `owner`.
+    /// @param key The order reference number to look up.
+    /// @param owner The owner tag the entry must carry.
+    /// @return The stored pool index for `key`, or `NPOS` if `key` is absent
+    ///         or belongs to another owner.
+    [[nodiscard]] auto find(std::uint64_t key, std::uint16_t owner) const noexcept
+        -> std::uint32_t {
+        const Entry found = lookup(key);
+        return found.owner == owner ? found.value : NPOS;
     }
 
     /// @brief Whether `key` is present.
@@ -64,56 +149,315 @@ class OrderIndex {
         return find(key) != NPOS;
     }
 
-    /// @brief Inserts or overwrites the value for `key`.
+    /// @brief Inserts or overwrites the value and owner for `key`.
     /// @param key The order reference number to insert or update.
     /// @param value The pool index to associate with `key`.
-    auto insert(std::uint64_t key, std::uint32_t value) -> void {
-        if ((m_count + 1) * LOAD_FACTOR_DEN >= m_slots.size() * LOAD_FACTOR_NUM) {
-            rehash(m_slots.size() * 2);
+    /// @param owner An opaque tag identifying the entry's owner, e.g. the
+    ///        stock locate of the book holding the order.
+    auto insert(std::uint64_t key, std::uint32_t value, std::uint16_t owner = 0) -> void {
+        if (m_mode == OrderIndexMode::dense && !m_based) {
+            m_base  = key & ~std::uint64_t {DENSE_PAGE_MASK};
+            m_based = true;
         }
-        std::size_t slot = hash(key) & m_mask;
-        while (m_slots[slot].used) {
-            if (m_slots[slot].key == key) {
-                m_slots[slot].value = value;
+        if (const std::size_t page = dense_page(key); page != NO_PAGE) {
+            if (page < m_pages.size() + DENSE_SLACK_PAGES) {
+                dense_insert(page, key, value, owner);
                 return;
             }
-            slot = (slot + 1) & m_mask;
+            m_far_page = std::min(m_far_page, page);
         }
-        m_slots[slot] = Slot {key, value, true};
-        ++m_count;
+        hash_insert(key, value, owner);
     }
 
     /// @brief Removes `key` if present, repairing the probe chain in place.
     /// @param key The order reference number to remove.
     auto erase(std::uint64_t key) -> void {
-        std::size_t slot = hash(key) & m_mask;
-        while (m_slots[slot].used) {
-            if (m_slots[slot].key == key) {
-                remove_at(slot);
+        if (const std::size_t page = dense_page(key); page != NO_PAGE) {
+            if (dense_erase(page, key) || page < m_far_page) {
                 return;
             }
-            slot = (slot + 1) & m_mask;
         }
+        hash_erase(key);
     }
 
-    /// @brief Drops all keys (retaining capacity).
+    /// @brief Drops all keys, retaining the hash table's capacity and
+    ///        freeing every dense page.
     auto clear() -> void {
         for (auto& slot : m_slots) {
             slot.used = false;
         }
         m_count = 0;
+        end_migration();
+        m_retired    = std::vector<Slot> {};
+        m_released   = 0;
+        m_next_slots = std::vector<Slot> {};
+        m_pages.clear();
+        m_page_live.clear();
+        m_dense_count = 0;
+        m_live_pages  = 0;
+        m_far_page    = NO_PAGE;
     }
 
    private:
     struct Slot {
         std::uint64_t key {0};
         std::uint32_t value {0};
+        std::uint16_t owner {0};
         bool          used {false};
+        bool          erased {false};  ///< Erased while its table was being migrated.
+    };
+
+    struct DenseSlot {
+        std::uint32_t value {NPOS};
+        std::uint16_t owner {0};
     };
 
     static constexpr std::size_t INITIAL_CAPACITY = 1024;
     static constexpr std::size_t LOAD_FACTOR_NUM  = 7;  // Grow past 70% load.
     static constexpr std::size_t LOAD_FACTOR_DEN  = 10;
+    // Old slots moved per insert or erase. A table of N slots is moved within
+    // N / 8 operations, while refilling its successor takes 0.7 N inserts.
+    static constexpr std::size_t MIGRATION_STEP   = 8;
+    // Successor slots zeroed by one insert in `STAGING_INTERVAL` past
+    // `STAGING_LOAD_NUM` load: the 10% of inserts left before growth zero 3.2
+    // times the slots needed. Zeroing 64 KiB at a time puts the page faults on
+    // few inserts, where 512 bytes per insert faulted on one in eight.
+    static constexpr std::size_t STAGING_STEP     = 4096;
+    static constexpr std::size_t STAGING_INTERVAL = 128;
+    static constexpr std::size_t STAGING_LOAD_NUM = 6;
+    // Retired table bytes returned to the OS per insert or erase, a multiple
+    // of the page size: releasing 64 KiB costs a few microseconds, where
+    // freeing a 128 MiB table at once takes about 7 ms.
+    static constexpr std::size_t RELEASE_STEP_BYTES = std::size_t {1} << 16;
+    static constexpr std::size_t DENSE_PAGE_BITS  = 12;
+    static constexpr std::size_t DENSE_PAGE_MASK  = DENSE_PAGE_SIZE - 1;
+    static constexpr std::size_t NO_PAGE          = static_cast<std::size_t>(-1);
+    static constexpr std::size_t NO_SLOT          = static_cast<std::size_t>(-1);
+
+    static_assert(DENSE_PAGE_SIZE == std::size_t {1} << DENSE_PAGE_BITS);
+
+    /// @brief The dense page `key` would belong in, or `NO_PAGE` if it is always
+    ///        stored in the hash table (hashed mode, no base yet, or out of
+    ///        range). Pages at or past `m_far_page` may hold keys in either.
+    /// @param key The order reference number to classify.
+    /// @return The page number relative to `base`, or `NO_PAGE`.
+    [[nodiscard]] auto dense_page(std::uint64_t key) const noexcept -> std::size_t {
+        if (!m_based || key < m_base) {
+            return NO_PAGE;
+        }
+        const std::uint64_t page = (key - m_base) >> DENSE_PAGE_BITS;
+        return page < MAX_DENSE_PAGES ? static_cast<std::size_t>(page) : NO_PAGE;
+    }
+
+    /// @brief Stores `key` in its dense page, allocating the page if needed.
+    /// @param page The page `key` belongs in.
+    /// @param key The order reference number to insert or update.
+    /// @param value The pool index to associate with `key`.
+    /// @param owner The entry's owner tag.
+    auto dense_insert(std::size_t page, std::uint64_t key, std::uint32_t value, std::uint16_t owner)
+        -> void {
+        if (page >= m_pages.size()) {
+            m_pages.resize(page + 1);
+            m_page_live.resize(page + 1, 0);
+        }
+        auto& target = m_pages[page];
+        if (target.empty()) {
+            target.resize(DENSE_PAGE_SIZE);
+            ++m_live_pages;
+        }
+        DenseSlot& slot = target[(key - m_base) & DENSE_PAGE_MASK];
+        if (slot.value == NPOS) {
+            if (page >= m_far_page) {
+                hash_erase(key);  // Hashed while its page was out of reach.
+            }
+            ++m_page_live[page];
+            ++m_dense_count;
+        }
+        slot = DenseSlot {value, owner};
+    }
+
+    /// @brief Clears `key` from its dense page, freeing the page once empty.
+    /// @param page The page `key` belongs in.
+    /// @param key The order reference number to remove.
+    /// @return True if `key` was stored in the page, false otherwise.
+    auto dense_erase(std::size_t page, std::uint64_t key) -> bool {
+        if (page >= m_pages.size() || m_pages[page].empty()) {
+            return false;
+        }
+        DenseSlot& slot = m_pages[page][(key - m_base) & DENSE_PAGE_MASK];
+        if (slot.value == NPOS) {
+            return false;
+        }
+        slot = DenseSlot {};
+        --m_dense_count;
+        if (--m_page_live[page] == 0) {
+            m_pages[page] = std::vector<DenseSlot> {};  // Releases the page.
+            --m_live_pages;
+        }
+        return true;
+    }
+
+    /// @brief Looks `key` up in the hash table.
+    /// @param key The order reference number to look up.
+    /// @return The stored entry, whose `value` is `NPOS` if `key` is absent.
+    [[nodiscard]] auto hash_lookup(std::uint64_t key) const noexcept -> Entry {
+        if (m_count == 0) {
+            return Entry {};
+        }
+        std::size_t slot = hash(key) & m_mask;
+        while (m_slots[slot].used) {
+            if (m_slots[slot].key == key) {
+                return Entry {m_slots[slot].value, m_slots[slot].owner};
+            }
+            slot = (slot + 1) & m_mask;
+        }
+        if (const std::size_t old = find_unmigrated(key); old != NO_SLOT) {
+            return Entry {m_old_slots[old].value, m_old_slots[old].owner};
+        }
+        return Entry {};
+    }
+
+    /// @brief Inserts or overwrites `key` in the hash table.
+    /// @param key The order reference number to insert or update.
+    /// @param value The pool index to associate with `key`.
+    /// @param owner The entry's owner tag.
+    auto hash_insert(std::uint64_t key, std::uint32_t value, std::uint16_t owner) -> void {
+        migrate(MIGRATION_STEP);
+        release();
+        if ((m_count + 1) * LOAD_FACTOR_DEN >= m_slots.size() * LOAD_FACTOR_NUM) {
+            grow();
+        } else if (m_count % STAGING_INTERVAL == 0 &&
+                   m_count * LOAD_FACTOR_DEN >= m_slots.size() * STAGING_LOAD_NUM) {
+            stage(STAGING_STEP);
+        }
+        std::size_t slot = hash(key) & m_mask;
+        while (m_slots[slot].used) {
+            if (m_slots[slot].key == key) {
+                m_slots[slot].value = value;
+                m_slots[slot].owner = owner;
+                return;
+            }
+            slot = (slot + 1) & m_mask;
+        }
+        if (const std::size_t old = find_unmigrated(key); old != NO_SLOT) {
+            m_old_slots[old].erased = true;  // Superseded by the new table's entry.
+            --m_count;
+        }
+        m_slots[slot] = Slot {key, value, owner, true, false};
+        ++m_count;
+    }
+
+    /// @brief Removes `key` from the hash table if present, repairing the
+    ///        probe chain in place.
+    /// @param key The order reference number to remove.
+    auto hash_erase(std::uint64_t key) -> void {
+        if (m_count == 0) {
+            return;
+        }
+        migrate(MIGRATION_STEP);
+        release();
+        std::size_t slot = hash(key) & m_mask;
+        while (m_slots[slot].used) {
+            if (m_slots[slot].key == key) {
+                remove_at(slot);
+                return;
+            }
+            slot = (slot + 1) & m_mask;
+        }
+        if (const std::size_t old = find_unmigrated(key); old != NO_SLOT) {
+            m_old_slots[old].erased = true;
+            --m_count;
+        }
+    }
+
+    /// @brief The slot of `key` in the table being migrated, if it has not
+    ///        been moved or erased yet.
+    ///
+    /// The old table is never written during the move except to flag erased
+    /// slots, so its probe chains stay intact; a key found below the migration
+    /// cursor has already been moved, so its entry is the new table's, if any.
+    /// @param key The order reference number to look up.
+    /// @return The key's slot in the old table, or `NO_SLOT`.
+    [[nodiscard]] auto find_unmigrated(std::uint64_t key) const noexcept -> std::size_t {
+        if (m_old_slots.empty()) {
+            return NO_SLOT;
+        }
+        std::size_t slot = hash(key) & m_old_mask;
+        while (m_old_slots[slot].used) {
+            if (m_old_slots[slot].key == key) {
+                const bool live = slot >= m_migrated && !m_old_slots[slot].erased;
+                return live ? slot : NO_SLOT;
+            }
+            slot = (slot + 1) & m_old_mask;
+        }
+        return NO_SLOT;
+    }
+
+    /// @brief Moves up to `count` slots of the old table into the new one,
+    ///        releasing the old table once all of them have moved.
+    /// @param count The number of old slots to visit.
+    auto migrate(std::size_t count) -> void {
+        if (m_old_slots.empty()) {
+            return;
+        }
+        const std::size_t stop = std::min(m_old_slots.size(), m_migrated + count);
+        for (; m_migrated < stop; ++m_migrated) {
+            const Slot& moving = m_old_slots[m_migrated];
+            if (moving.used && !moving.erased) {
+                std::size_t slot = hash(moving.key) & m_mask;
+                while (m_slots[slot].used) {
+                    slot = (slot + 1) & m_mask;
+                }
+                m_slots[slot] = Slot {moving.key, moving.value, moving.owner, true, false};
+            }
+        }
+        if (m_migrated == m_old_slots.size()) {
+            end_migration();
+        }
+    }
+
+    /// @brief Retires the old table once its slots have all moved, leaving
+    ///        its memory to `release`.
+    auto end_migration() -> void {
+        if (!m_old_slots.empty()) {
+            m_retired  = std::move(m_old_slots);
+            m_released = 0;
+        }
+        m_old_slots = std::vector<Slot> {};
+        m_old_mask  = 0;
+        m_migrated  = 0;
+    }
+
+    /// @brief Returns the retired table's pages up to the next
+    ///        `RELEASE_STEP_BYTES` boundary to the OS, freeing the table once
+    ///        all of them are back.
+    ///
+    /// Chunks end on absolute boundaries so no page straddles two of them, and
+    /// by the end freeing the table only unmaps an empty range; neither step
+    /// costs more than a few microseconds.
+    auto release() -> void {
+        if (m_retired.empty()) {
+            return;
+        }
+        auto* const       data     = reinterpret_cast<std::byte*>(m_retired.data());
+        const auto        address  = reinterpret_cast<std::uintptr_t>(data) + m_released;
+        const std::size_t boundary = RELEASE_STEP_BYTES - (address & (RELEASE_STEP_BYTES - 1));
+        const std::size_t total    = m_retired.size() * sizeof(Slot);
+        const std::size_t stop     = std::min(total, m_released + boundary);
+        release_pages(data + m_released, stop - m_released);
+        m_released = stop;
+        if (m_released == total) {
+            m_retired  = std::vector<Slot> {};
+            m_released = 0;
+        }
+    }
+
+    /// @brief Hands the whole pages inside `[data, data + size)` back to the
+    ///        OS; their contents are discarded. A no-op where the platform
+    ///        offers no way to do so.
+    /// @param data The start of the range.
+    /// @param size The length of the range in bytes.
+    static auto release_pages(std::byte* data, std::size_t size) noexcept -> void;
 
     /// @brief Computes a finalizing hash mix (splitmix64) of a key so dense,
     ///        sequential reference numbers spread across the table instead of
@@ -153,24 +497,58 @@ class OrderIndex {
         }
     }
 
-    /// @brief Grows (or initializes) the table to `new_capacity` and
-    ///        re-inserts every previously stored key.
-    /// @param new_capacity The new table capacity, must be a power of two.
-    auto rehash(std::size_t new_capacity) -> void {
-        std::vector<Slot> old = std::move(m_slots);
-        m_slots.assign(new_capacity, Slot {});
-        m_mask  = new_capacity - 1;
-        m_count = 0;
-        for (const auto& slot : old) {
-            if (slot.used) {
-                insert(slot.key, slot.value);
-            }
+    /// @brief Zeroes up to `count` more slots of the doubled successor table,
+    ///        reserving its memory (untouched) on the first call.
+    /// @param count The number of successor slots to zero.
+    auto stage(std::size_t count) -> void {
+        const std::size_t capacity = m_slots.size() * 2;
+        if (m_next_slots.capacity() < capacity) {
+            m_next_slots.reserve(capacity);
+        }
+        m_next_slots.resize(std::min(capacity, m_next_slots.size() + count));
+    }
+
+    /// @brief Allocates the first table, or swaps in the doubled successor and
+    ///        starts migrating the current table into it.
+    ///
+    /// Any staging, migration, or release still under way is finished first;
+    /// at the steps above none ever is.
+    auto grow() -> void {
+        m_retired  = std::vector<Slot> {};
+        m_released = 0;
+        if (m_slots.empty()) {
+            m_slots.assign(INITIAL_CAPACITY, Slot {});
+            m_mask = INITIAL_CAPACITY - 1;
+            return;
         }
+        migrate(m_old_slots.size());
+        stage(m_slots.size() * 2);
+        m_old_slots  = std::move(m_slots);
+        m_old_mask   = m_mask;
+        m_migrated   = 0;
+        m_slots      = std::move(m_next_slots);
+        m_mask       = m_slots.size() - 1;
+        m_next_slots = std::vector<Slot> {};
     }
 
-    std::vector<Slot> m_slots;
-    std::size_t       m_count {0};
-    std::size_t       m_mask {0};
+    std::vector<Slot>                   m_slots;
+    std::size_t                         m_count {0};  ///< Keys in both hash tables.
+    std::size_t                         m_mask {0};
+    std::vector<Slot>                   m_old_slots;  ///< Outgrown table, while migrating.
+    std::size_t                         m_old_mask {0};
+    std::size_t                         m_migrated {0};  ///< Old slots below this have moved.
+    std::vector<Slot>                   m_retired;  ///< Migrated-out table, being released.
+    std::size_t                         m_released {0};  ///< Retired bytes already released.
+    std::vector<Slot>                   m_next_slots;  ///< Successor, zeroed ahead of growth.
+    OrderIndexMode                      m_mode {OrderIndexMode::hashed};
+    std::vector<std::vector<DenseSlot>> m_pages;      ///< Indexed by page; empty if dead.
+    std::vector<std::uint32_t>          m_page_live;  ///< Keys stored in each page.
+    std::uint64_t                       m_base {0};
+    bool                                m_based {false};  ///< Whether `m_base` is set.
+    std::size_t                         m_dense_count {0};
+    std::size_t                         m_live_pages {0};
+    std::size_t                         m_far_page {NO_PAGE};  ///< Lowest page a key was hashed
+                                                               ///< from for being out of reach.
 };
 
 }  // namespace itch::book
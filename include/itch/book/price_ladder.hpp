@@ -0,0 +1,388 @@
+#pragma once
+
+/// @file
+/// @brief Tick-indexed price ladder with a hierarchical occupancy bitmap,
+///        mapping one side's prices to price-level handles.
+///
+/// This header declares `PriceLadder`, the structure `L3Book` uses to find the
+/// level at a price, the best level, and the next level down the book in O(1),
+/// without the mid-vector inserts and erases of a sorted ladder.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace itch::book {
+
+/// @brief Which end of a `PriceLadder` holds its best price.
+enum class LadderDirection : std::uint8_t {
+    highest_first,  ///< Bids: the highest price is the best.
+    lowest_first,   ///< Asks: the lowest price is the best.
+};
+
+/// @brief A map from price to level handle for one side of a book, indexed
+///        directly by tick offset from a moving anchor.
+///
+/// A sorted vector of levels pays an O(n) memmove for every level created or
+/// emptied inside the book and a binary search for every lookup, which adds up
+/// on deep, wide books. This ladder instead stores the handle of the level at
+/// each tick of a window of `window_size()` ticks, ordered best first, so a
+/// price's slot is its tick offset from the window's anchor. A three-level
+/// occupancy bitmap (one bit per tick, one per nonzero bitmap word, and one per
+/// nonzero summary word) finds the best level and the next level after any
+/// tick with a few `countr_zero` calls.
+///
+/// Prices under $1 tick by $0.0001 and prices from $1 up by $0.01, the
+/// Regulation NMS quoting increments, so a window covers the same number of
+/// quotable prices at any price level. A level whose price is off those ticks,
+/// or too far from the best price for the window to reach, is kept in a small
+/// sorted overflow vector instead.
+///
+/// The window follows the market. A price better than the window re-anchors it
+/// 128 ticks (a quarter of `INITIAL_WINDOW`) better than that price, a worse
+/// price within `MAX_WINDOW` ticks widens it, and when its last level empties
+/// it re-anchors on the best overflow level. Each of these rebuilds the window
+/// in O(window + levels), which prices only trigger by drifting a sizeable part
+/// of a window. A rebuild sizes the window to the levels it then covers, so a
+/// window widened for a far level shrinks back once that level has gone.
+class PriceLadder {
+   public:
+    /// @brief Sentinel returned by `find` and `best` when there is no level.
+    static constexpr std::uint32_t NIL = 0xFFFFFFFFU;
+
+    /// @brief Ticks covered by a window when it is first allocated.
+    static constexpr std::size_t INITIAL_WINDOW = 512;
+
+    /// @brief The widest window, in ticks; the bitmap summary fits one word.
+    static constexpr std::size_t MAX_WINDOW = std::size_t {1} << 18;
+
+    /// @brief Constructs an empty ladder; the window is allocated on first insert.
+    /// @param direction Which end of the ladder holds its best price.
+    explicit PriceLadder(LadderDirection direction = LadderDirection::lowest_first) noexcept
+        : m_direction {direction} {}
+
+    /// @brief The number of levels in the ladder.
+    /// @return The count of stored prices.
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+        return m_window_count + m_overflow.size();
+    }
+
+    /// @brief Whether the ladder holds no levels.
+    /// @return True if the ladder holds no levels, false otherwise.
+    [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0; }
+
+    /// @brief The number of ticks the window currently covers.
+    /// @return The window size (0 before the first insert).
+    [[nodiscard]] auto window_size() const noexcept -> std::size_t { return m_slots.size(); }
+
+    /// @brief The handle of the level at `price`, or `NIL` if there is none.
+    /// @param price The raw (unscaled) price to look up.
+    /// @return The stored handle, or `NIL`.
+    [[nodiscard]] auto find(std::uint32_t price) const noexcept -> std::uint32_t {
+        if (const std::size_t slot = window_slot(price); slot != NO_SLOT) {
+            return m_slots[slot];
+        }
+        const auto iter = overflow_position(price);
+        return iter != m_overflow.end() && iter->first == price ? iter->second : NIL;
+    }
+
+    /// @brief Adds the level at `price`, which must not be in the ladder yet.
+    /// @param price The raw (unscaled) price of the new level.
+    /// @param handle The level handle to store for `price`.
+    auto insert(std::uint32_t price, std::uint32_t handle) -> void {
+        const std::uint64_t rank = to_rank(price);
+        if (rank != NO_RANK && !in_window(rank)) {
+            follow(rank);
+        }
+        if (rank != NO_RANK && in_window(rank)) {
+            occupy(static_cast<std::size_t>(rank - m_anchor), handle);
+            return;
+        }
+        m_overflow.insert(overflow_position(price), {price, handle});
+    }
+
+    /// @brief Removes the level at `price`, if present.
+    /// @param price The raw (unscaled) price of the level to remove.
+    auto erase(std::uint32_t price) -> void {
+        if (const std::size_t slot = window_slot(price); slot != NO_SLOT) {
+            if (m_slots[slot] != NIL) {
+                vacate(slot);
+                if (m_window_count == 0 && !m_overflow.empty()) {
+                    reanchor_on_overflow();
+                }
+            }
+            return;
+        }
+        const auto iter = overflow_position(price);
+        if (iter != m_overflow.end() && iter->first == price) {
+            m_overflow.erase(iter);
+        }
+    }
+
+    /// @brief The handle of the best level, or `NIL` if the ladder is empty.
+    /// @return The best level's handle, or `NIL`.
+    [[nodiscard]] auto best() const noexcept -> std::uint32_t {
+        const std::size_t slot = first_slot();
+        if (m_overflow.empty()) {
+            return slot != NO_SLOT ? m_slots[slot] : NIL;
+        }
+        if (slot == NO_SLOT || order_key(m_overflow.front().first) < order_key(price_at(slot))) {
+            return m_overflow.front().second;
+        }
+        return m_slots[slot];
+    }
+
+    /// @brief Calls `visitor` with each level's handle, best first, until it
+    ///        returns false.
+    /// @tparam Visitor Callable as `bool(std::uint32_t handle)`.
+    /// @param visitor Invoked once per level; returns whether to continue.
+    template <typename Visitor>
+    auto for_each(Visitor&& visitor) const -> void {
+        std::size_t slot     = first_slot();
+        std::size_t overflow = 0;
+        while (slot != NO_SLOT || overflow < m_overflow.size()) {
+            const bool from_window =
+                overflow == m_overflow.size() ||
+                (slot != NO_SLOT &&
+                 order_key(price_at(slot)) < order_key(m_overflow[overflow].first));
+            const std::uint32_t handle =
+                from_window ? m_slots[slot] : m_overflow[overflow].second;
+            if (from_window) {
+                slot = next_slot(slot + 1);
+            } else {
+                ++overflow;
+            }
+            if (!visitor(handle)) {
+                return;
+            }
+        }
+    }
+
+   private:
+    using OverflowLevel = std::pair<std::uint32_t, std::uint32_t>;  ///< Price, handle.
+
+    static constexpr std::uint64_t NO_RANK       = ~std::uint64_t {0};
+    static constexpr std::size_t   NO_SLOT       = static_cast<std::size_t>(-1);
+    static constexpr std::uint32_t DOLLAR        = 10'000;  ///< $1 at four implied decimals.
+    static constexpr std::uint32_t PENNY         = 100;     ///< $0.01 at four implied decimals.
+    static constexpr std::uint64_t MAX_TICK      = DOLLAR + ((0xFFFFFFFFULL - DOLLAR) / PENNY);
+    static constexpr std::size_t   WORD_BITS     = 64;
+    static constexpr std::uint64_t REANCHOR_GAP  = INITIAL_WINDOW / 4;
+
+    /// @brief The tick index of `price`, or `NO_RANK` if it is off-tick.
+    [[nodiscard]] static auto to_tick(std::uint32_t price) noexcept -> std::uint64_t {
+        if (price < DOLLAR) {
+            return price;
+        }
+        return (price - DOLLAR) % PENNY == 0 ? DOLLAR + ((price - DOLLAR) / PENNY) : NO_RANK;
+    }
+
+    /// @brief The rank of `price`: its tick counted from the best end, so a
+    ///        smaller rank is a better price. `NO_RANK` if it is off-tick.
+    [[nodiscard]] auto to_rank(std::uint32_t price) const noexcept -> std::uint64_t {
+        const std::uint64_t tick = to_tick(price);
+        if (tick == NO_RANK || m_direction == LadderDirection::lowest_first) {
+            return tick;
+        }
+        return MAX_TICK - tick;
+    }
+
+    /// @brief The price at window slot `slot`.
+    [[nodiscard]] auto price_at(std::size_t slot) const noexcept -> std::uint32_t {
+        const std::uint64_t rank = m_anchor + slot;
+        const std::uint64_t tick =
+            m_direction == LadderDirection::lowest_first ? rank : MAX_TICK - rank;
+        const std::uint64_t price = tick < DOLLAR ? tick : DOLLAR + ((tick - DOLLAR) * PENNY);
+        return static_cast<std::uint32_t>(price);
+    }
+
+    /// @brief A key that orders prices best first, for the overflow vector.
+    [[nodiscard]] auto order_key(std::uint32_t price) const noexcept -> std::uint32_t {
+        return m_direction == LadderDirection::lowest_first ? price : ~price;
+    }
+
+    [[nodiscard]] auto in_window(std::uint64_t rank) const noexcept -> bool {
+        return rank >= m_anchor && rank - m_anchor < m_slots.size();
+    }
+
+    /// @brief The window slot of `price`, or `NO_SLOT` if it is off-tick or
+    ///        outside the window.
+    [[nodiscard]] auto window_slot(std::uint32_t price) const noexcept -> std::size_t {
+        const std::uint64_t rank = to_rank(price);
+        return rank != NO_RANK && in_window(rank) ? static_cast<std::size_t>(rank - m_anchor)
+                                                  : NO_SLOT;
+    }
+
+    /// @brief The first overflow level not better than `price`.
+    [[nodiscard]] auto overflow_position(std::uint32_t price) const
+        -> std::vector<OverflowLevel>::const_iterator {
+        // NOLINTNEXTLINE(modernize-use-ranges)
+        return std::lower_bound(
+            m_overflow.begin(),
+            m_overflow.end(),
+            order_key(price),
+            [this](const OverflowLevel& level, std::uint32_t key) {
+                return order_key(level.first) < key;
+            }
+        );
+    }
+
+    /// @brief Moves or widens the window so that it covers `rank`, when the
+    ///        policy in the class comment allows it.
+    /// @param rank The rank of a new, on-tick price outside the window.
+    auto follow(std::uint64_t rank) -> void {
+        if (m_window_count == 0 || rank < m_anchor) {
+            const std::uint64_t anchor = anchor_below(rank);
+            rebuild(anchor, rank - anchor + 1);
+        } else if (rank - m_anchor < MAX_WINDOW) {
+            rebuild(m_anchor, rank - m_anchor + 1);
+        }
+    }
+
+    /// @brief Re-anchors an emptied window on the best on-tick overflow level.
+    auto reanchor_on_overflow() -> void {
+        for (const auto& [price, handle] : m_overflow) {
+            if (const std::uint64_t rank = to_rank(price); rank != NO_RANK) {
+                rebuild(anchor_below(rank), 1);
+                return;
+            }
+        }
+    }
+
+    [[nodiscard]] static auto anchor_below(std::uint64_t rank) noexcept -> std::uint64_t {
+        return rank > REANCHOR_GAP ? rank - REANCHOR_GAP : 0;
+    }
+
+    /// @brief The window size for a span of `ticks`: a power of two, at least
+    ///        `INITIAL_WINDOW` and at most `MAX_WINDOW`.
+    [[nodiscard]] static auto window_for(std::uint64_t ticks) noexcept -> std::size_t {
+        const std::uint64_t wanted = std::bit_ceil(std::min<std::uint64_t>(ticks, MAX_WINDOW));
+        return std::max(static_cast<std::size_t>(wanted), INITIAL_WINDOW);
+    }
+
+    /// @brief Re-lays the ladder out over a window from `anchor`, moving levels
+    ///        between the window and the overflow.
+    ///
+    /// The window spans `ticks` and every on-tick level that `MAX_WINDOW` ticks
+    /// from `anchor` reach, so a window widened for a far level shrinks once
+    /// that level is gone.
+    /// @param anchor The rank of the new window's first slot.
+    /// @param ticks The span from `anchor` the window must cover at least.
+    auto rebuild(std::uint64_t anchor, std::uint64_t ticks) -> void {
+        std::vector<OverflowLevel> levels = std::move(m_overflow);
+        for (std::size_t slot = first_slot(); slot != NO_SLOT; slot = next_slot(slot + 1)) {
+            levels.emplace_back(price_at(slot), m_slots[slot]);
+        }
+        for (const auto& level : levels) {
+            const std::uint64_t rank = to_rank(level.first);
+            if (rank != NO_RANK && rank >= anchor && rank - anchor < MAX_WINDOW) {
+                ticks = std::max(ticks, rank - anchor + 1);
+            }
+        }
+        const std::size_t size = window_for(ticks);
+        if (size < m_slots.size()) {  // Frees the wider window rather than keeping it.
+            m_slots   = std::vector<std::uint32_t> {};
+            m_bits    = std::vector<std::uint64_t> {};
+            m_summary = std::vector<std::uint64_t> {};
+        }
+        m_overflow.clear();
+        m_slots.assign(size, NIL);
+        m_bits.assign(size / WORD_BITS, 0);
+        m_summary.assign(std::max<std::size_t>(1, m_bits.size() / WORD_BITS), 0);
+        m_top          = 0;
+        m_anchor       = anchor;
+        m_window_count = 0;
+        for (const auto& [price, handle] : levels) {
+            if (const std::size_t slot = window_slot(price); slot != NO_SLOT) {
+                occupy(slot, handle);
+            } else {
+                m_overflow.emplace_back(price, handle);
+            }
+        }
+        // NOLINTNEXTLINE(modernize-use-ranges)
+        std::sort(m_overflow.begin(), m_overflow.end(), [this](const auto& lhs, const auto& rhs) {
+            return order_key(lhs.first) < order_key(rhs.first);
+        });
+    }
+
+    auto occupy(std::size_t slot, std::uint32_t handle) noexcept -> void {
+        const std::size_t word = slot / WORD_BITS;
+        m_slots[slot]                  = handle;
+        m_bits[word]                  |= std::uint64_t {1} << (slot % WORD_BITS);
+        m_summary[word / WORD_BITS]   |= std::uint64_t {1} << (word % WORD_BITS);
+        m_top                         |= std::uint64_t {1} << (word / WORD_BITS);
+        ++m_window_count;
+    }
+
+    auto vacate(std::size_t slot) noexcept -> void {
+        const std::size_t word = slot / WORD_BITS;
+        m_slots[slot]           = NIL;
+        m_bits[word]           &= ~(std::uint64_t {1} << (slot % WORD_BITS));
+        if (m_bits[word] == 0) {
+            m_summary[word / WORD_BITS] &= ~(std::uint64_t {1} << (word % WORD_BITS));
+            if (m_summary[word / WORD_BITS] == 0) {
+                m_top &= ~(std::uint64_t {1} << (word / WORD_BITS));
+            }
+        }
+        --m_window_count;
+    }
+
+    /// @brief The first occupied slot under summary word `summary`, which
+    ///        must be nonzero.
+    [[nodiscard]] auto first_in_summary(std::size_t summary) const noexcept -> std::size_t {
+        const std::size_t word =
+            (summary * WORD_BITS) + static_cast<std::size_t>(std::countr_zero(m_summary[summary]));
+        return (word * WORD_BITS) + static_cast<std::size_t>(std::countr_zero(m_bits[word]));
+    }
+
+    /// @brief The best occupied window slot, or `NO_SLOT`.
+    [[nodiscard]] auto first_slot() const noexcept -> std::size_t {
+        if (m_top == 0) {
+            return NO_SLOT;
+        }
+        return first_in_summary(static_cast<std::size_t>(std::countr_zero(m_top)));
+    }
+
+    /// @brief The first occupied window slot at or after `from`, or `NO_SLOT`.
+    [[nodiscard]] auto next_slot(std::size_t from) const noexcept -> std::size_t {
+        if (from >= m_slots.size()) {
+            return NO_SLOT;
+        }
+        std::size_t word = from / WORD_BITS;
+        if (const std::uint64_t bits = m_bits[word] & (~std::uint64_t {0} << (from % WORD_BITS))) {
+            return (word * WORD_BITS) + static_cast<std::size_t>(std::countr_zero(bits));
+        }
+        if (++word == m_bits.size()) {
+            return NO_SLOT;
+        }
+        std::size_t summary = word / WORD_BITS;
+        if (const std::uint64_t words =
+                m_summary[summary] & (~std::uint64_t {0} << (word % WORD_BITS))) {
+            const std::size_t next =
+                (summary * WORD_BITS) + static_cast<std::size_t>(std::countr_zero(words));
+            return (next * WORD_BITS) + static_cast<std::size_t>(std::countr_zero(m_bits[next]));
+        }
+        if (++summary == m_summary.size()) {
+            return NO_SLOT;
+        }
+        const std::uint64_t groups = m_top & (~std::uint64_t {0} << summary);
+        return groups != 0 ? first_in_summary(static_cast<std::size_t>(std::countr_zero(groups)))
+                           : NO_SLOT;
+    }
+
+    LadderDirection            m_direction {LadderDirection::lowest_first};
+    std::vector<std::uint32_t> m_slots;    ///< Level handle per tick of the window.
+    std::vector<std::uint64_t> m_bits;     ///< One bit per occupied slot.
+    std::vector<std::uint64_t> m_summary;  ///< One bit per nonzero `m_bits` word.
+    std::uint64_t              m_top {0};  ///< One bit per nonzero `m_summary` word.
+    std::uint64_t              m_anchor {0};  ///< Rank of slot 0.
+    std::size_t                m_window_count {0};
+    std::vector<OverflowLevel> m_overflow;  ///< Levels outside the window, best first.
+};
+
+}  // namespace itch::book
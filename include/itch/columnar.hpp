@@ -0,0 +1,606 @@
+#pragma once
+
+/// @file
+/// @brief Structure-of-arrays decode target: one set of typed column vectors
+///        per message type, filled a batch at a time.
+///
+/// A `std::vector<Message>` stores every message in a slot as large as the
+/// biggest variant alternative, so a scan over one field of one type (every Add
+/// Order price, say) strides over mostly unused bytes. `ColumnarBatch` instead
+/// appends each field of each message to its own contiguous column, so such a
+/// scan reads only that column and compiles to a vectorizable loop.
+/// `parse_columnar` fills a batch through `Parser::parse_with` and hands it to
+/// a callback each time it reaches its capacity.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "itch/messages.hpp"
+#include "itch/parser.hpp"
+
+namespace itch {
+
+/// @brief A fixed-width, space-padded stock symbol as stored in a column.
+using SymbolColumnValue = std::array<char, 8>;
+
+/// @brief The columns every message type shares: the common ITCH header.
+///
+/// Row `i` of every column of a column set belongs to the same message, and
+/// rows are in stream order within the set.
+struct HeaderColumns {
+    std::vector<std::uint16_t> stock_locate;     ///< Locate code identifying the security.
+    std::vector<std::uint16_t> tracking_number;  ///< Nasdaq internal tracking number.
+    std::vector<std::uint64_t> timestamp;        ///< Nanoseconds past midnight.
+
+    /// @brief The number of rows in the column set.
+    ///
+    /// @return The length of every column.
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return timestamp.size(); }
+
+    /// @brief Checks whether the column set holds no rows.
+    ///
+    /// @return `true` if every column is empty.
+    [[nodiscard]] auto empty() const noexcept -> bool { return timestamp.empty(); }
+
+   protected:
+    /// @brief Appends the header fields of one message.
+    ///
+    /// @tparam MsgType Any message struct.
+    /// @param msg The message whose header to append.
+    template <typename MsgType>
+    auto append_header(const MsgType& msg) -> void {
+        stock_locate.push_back(msg.stock_locate);
+        tracking_number.push_back(msg.tracking_number);
+        timestamp.push_back(msg.timestamp);
+    }
+
+    /// @brief Empties the header columns, keeping their capacity.
+    auto clear_header() noexcept -> void {
+        stock_locate.clear();
+        tracking_number.clear();
+        timestamp.clear();
+    }
+
+    /// @brief Copies a packed symbol field into a column value.
+    ///
+    /// @param stock The 8-byte, space-padded symbol field of a message.
+    /// @return The same bytes as a `SymbolColumnValue`.
+    [[nodiscard]] static auto symbol(const char* stock) noexcept -> SymbolColumnValue {
+        SymbolColumnValue value {};
+        std::memcpy(value.data(), stock, value.size());
+        return value;
+    }
+};
+
+/// @brief Columns of Add Order (`A`) messages.
+struct AddOrderColumns : HeaderColumns {
+    std::vector<std::uint64_t>     order_reference_number;  ///< Day-unique order reference.
+    std::vector<char>              buy_sell_indicator;      ///< 'B' buy, 'S' sell.
+    std::vector<std::uint32_t>     shares;                  ///< Displayed share quantity.
+    std::vector<SymbolColumnValue> stock;                   ///< Stock symbol.
+    std::vector<std::uint32_t>     price;                   ///< Display price (4 decimals).
+
+    /// @brief Appends one message as a row.
+    ///
+    /// @param msg The message to append.
+    auto append(const AddOrderMessage& msg) -> void {
+        append_header(msg);
+        order_reference_number.push_back(msg.order_reference_number);
+        buy_sell_indicator.push_back(msg.buy_sell_indicator);
+        shares.push_back(msg.shares);
+        stock.push_back(symbol(msg.stock));
+        price.push_back(msg.price);
+    }
+
+    /// @brief Empties every column, keeping their capacity.
+    auto clear() noexcept -> void {
+        clear_header();
+        order_reference_number.clear();
+        buy_sell_indicator.clear();
+        shares.clear();
+        stock.clear();
+        price.clear();
+    }
+};
+
+/// @brief Columns of Add Order with MPID Attribution (`F`) messages.
+struct AddOrderMPIDColumns : HeaderColumns {
+    std::vector<std::uint64_t>       order_reference_number;  ///< Day-unique order reference.
+    std::vector<char>                buy_sell_indicator;      ///< 'B' buy, 'S' sell.
+    std::vector<std::uint32_t>       shares;                  ///< Displayed share quantity.
+    std::vector<SymbolColumnValue>   stock;                   ///< Stock symbol.
+    std::vector<std::uint32_t>       price;                   ///< Display price (4 decimals).
+    std::vector<std::array<char, 4>> attribution;             ///< Market participant (MPID).
+
+    /// @brief Appends one message as a row.
+    ///
+    /// @param msg The message to append.
+    auto append(const AddOrderMPIDAttributionMessage& msg) -> void {
+        append_header(msg);
+        order_reference_number.push_back(msg.order_reference_number);
+        buy_sell_indicator.push_back(msg.buy_sell_indicator);
+        shares.push_back(msg.shares);
+        stock.push_back(symbol(msg.stock));
+        price.push_back(msg.price);
+        std::array<char, 4> mpid {};
+        std::memcpy(mpid.data(), msg.attribution, mpid.size());
+        attribution.push_back(mpid);
+    }
+
+    /// @brief Empties every column, keeping their capacity.
+    auto clear() noexcept -> void {
+        clear_header();
+        order_reference_number.clear();
+        buy_sell_indicator.clear();
+        shares.clear();
+        stock.clear();
+        price.clear();
+        attribution.clear();
+    }
+};
+
+/// @brief Columns of Order Executed (`E`) messages.
+struct OrderExecutedColumns : HeaderColumns {
+    std::vector<std::uint64_t> order_reference_number;  ///< Reference of the executed order.
+    std::vector<std::uint32_t> executed_shares;         ///< Number of shares executed.
+    std::vector<std::uint64_t> match_number;            ///< Day-unique match number.
+
+    /// @brief Appends one message as a row.
+    ///
+    /// @param msg The message to append.
+    auto append(const OrderExecutedMessage& msg) -> void {
+        append_header(msg);
+        order_reference_number.push_back(msg.order_reference_number);
+        executed_shares.push_back(msg.executed_shares);
+        match_number.push_back(msg.match_number);
+    }
+
+    /// @brief Empties every column, keeping their capacity.
+    auto clear() noexcept -> void {
+        clear_header();
+        order_reference_number.clear();
+        executed_shares.clear();
+        match_number.clear();
+    }
+};
+
+/// @brief Columns of Order Executed with Price (`C`) messages.
+struct OrderExecutedWithPriceColumns : HeaderColumns {
+    std::vector<std::uint64_t> order_reference_number;  ///< Reference of the executed order.
+    std::vector<std::uint32_t> executed_shares;         ///< Number of shares executed.
+    std::vector<std::uint64_t> match_number;            ///< Day-unique match number.
+    std::vector<char>          printable;               ///< 'Y' printable to the tape, else 'N'.
+    std::vector<std::uint32_t> execution_price;         ///< Execution price (4 decimals).
+
+    /// @brief Appends one message as a row.
+    ///
+    /// @param msg The message to append.
+    auto append(const OrderExecutedWithPriceMessage& msg) -> void {
+        append_header(msg);
+        order_reference_number.push_back(msg.order_reference_number);
+        executed_shares.push_back(msg.executed_shares);
+        match_number.push_back(msg.match_number);
+        printable.push_back(msg.printable);
+        execution_price.push_back(msg.execution_price);
+    }
+
+    /// @brief Empties every column, keeping their capacity.
+    auto clear() noexcept -> void {
+        clear_header();
+        order_reference_number.clear();
+        executed_shares.clear();
+        match_number.clear();
+        printable.clear();
+        execution_price.clear();
+    }
+};
+
+/// @brief Columns of Order Cancel (`X`) messages.
+struct OrderCancelColumns : HeaderColumns {
+    std::vector<std::uint64_t> order_reference_number;  ///< Reference of the cancelled order.
+    std::vector<std::uint32_t> cancelled_shares;        ///< Number of shares cancelled.
+
+    /// @brief Appends one message as a row.
+    ///
+    /// @param msg The message to append.
+    auto append(const OrderCancelMessage& msg) -> void {
+        append_header(msg);
+        order_reference_number.push_back(msg.order_reference_number);
+        cancelled_shares.push_back(msg.cancelled_shares);
+    }
+
+    /// @brief Empties every column, keeping their capacity.
+    auto clear() noexcept -> void {
+        clear_header();
+        order_reference_number.clear();
+        cancelled_shares.clear();
+    }
+};
+
+/// @brief Columns of Order Delete (`D`) messages.
+struct OrderDeleteColumns : HeaderColumns {
+    std::vector<std::uint64_t> order_reference_number;  ///< Reference of the deleted order.
+
+    /// @brief Appends one message as a row.
+    ///
+    /// @param msg The message to append.
+    auto append(const OrderDeleteMessage& msg) -> void {
+        append_header(msg);
+        order_reference_number.push_back(msg.order_reference_number);
+    }
+
+    /// @brief Empties every column, keeping their capacity.
+    auto clear() noexcept -> void {
+        clear_header();
+        order_reference_number.clear();
+    }
+};
+
+/// @brief Columns of Order Replace (`U`) messages.
+struct OrderReplaceColumns : HeaderColumns {
+    std::vector<std::uint64_t> original_order_reference_number;  ///< Reference being replaced.
+    std::vector<std::uint64_t> new_order_reference_number;       ///< New reference number.
+    std::vector<std::uint32_t> shares;                           ///< New displayed quantity.
+    std::vector<std::uint32_t> price;                            ///< New price (4 decimals).
+
+    /// @brief Appends one message as a row.
+    ///
+    /// @param msg The message to append.
+    auto append(const OrderReplaceMessage& msg) -> void {
+        append_header(msg);
+        original_order_reference_number.push_back(msg.original_order_reference_number);
+        new_order_reference_number.push_back(msg.new_order_reference_number);
+        shares.push_back(msg.shares);
+        price.push_back(msg.price);
+    }
+
+    /// @brief Empties every column, keeping their capacity.
+    auto clear() noexcept -> void {
+        clear_header();
+        original_order_reference_number.clear();
+        new_order_reference_number.clear();
+        shares.clear();
+        price.clear();
+    }
+};
+
+/// @brief Columns of Trade (non-cross, `P`) messages.
+struct NonCrossTradeColumns : HeaderColumns {
+    std::vector<std::uint64_t>     order_reference_number;  ///< Non-displayed order reference.
+    std::vector<char>              buy_sell_indicator;      ///< 'B' buy, 'S' sell.
+    std::vector<std::uint32_t>     shares;                  ///< Number of shares traded.
+    std::vector<SymbolColumnValue> stock;                   ///< Stock symbol.
+    std::vector<std::uint32_t>     price;                   ///< Trade price (4 decimals).
+    std::vector<std::uint64_t>     match_number;            ///< Day-unique match number.
+
+    /// @brief Appends one message as a row.
+    ///
+    /// @param msg The message to append.
+    auto append(const NonCrossTradeMessage& msg) -> void {
+        append_header(msg);
+        order_reference_number.push_back(msg.order_reference_number);
+        buy_sell_indicator.push_back(msg.buy_sell_indicator);
+        shares.push_back(msg.shares);
+        stock.push_back(symbol(msg.stock));
+        price.push_back(msg.price);
+        match_number.push_back(msg.match_number);
+    }
+
+    /// @brief Empties every column, keeping their capacity.
+    auto clear() noexcept -> void {
+        clear_header();
+        order_reference_number.clear();
+        buy_sell_indicator.clear();
+        shares.clear();
+        stock.clear();
+        price.clear();
+        match_number.clear();
+    }
+};
+
+/// @brief Columns of Cross Trade (`Q`) messages.
+struct CrossTradeColumns : HeaderColumns {
+    std::vector<std::uint64_t>     shares;        ///< Number of shares matched in the cross.
+    std::vector<SymbolColumnValue> stock;         ///< Stock symbol.
+    std::vector<std::uint32_t>     cross_price;   ///< Cross price (4 decimals).
+    std::vector<std::uint64_t>     match_number;  ///< Day-unique match number.
+    std::vector<char>              cross_type;    ///< 'O', 'C', 'H', or 'I'.
+
+    /// @brief Appends one message as a row.
+    ///
+    /// @param msg The message to append.
+    auto append(const CrossTradeMessage& msg) -> void {
+        append_header(msg);
+        shares.push_back(msg.shares);
+        stock.push_back(symbol(msg.stock));
+        cross_price.push_back(msg.cross_price);
+        match_number.push_back(msg.match_number);
+        cross_type.push_back(msg.cross_type);
+    }
+
+    /// @brief Empties every column, keeping their capacity.
+    auto clear() noexcept -> void {
+        clear_header();
+        shares.clear();
+        stock.clear();
+        cross_price.clear();
+        match_number.clear();
+        cross_type.clear();
+    }
+};
+
+/// @brief Columns of Broken Trade (`B`) messages.
+struct BrokenTradeColumns : HeaderColumns {
+    std::vector<std::uint64_t> match_number;  ///< Match number of the broken execution.
+
+    /// @brief Appends one message as a row.
+    ///
+    /// @param msg The message to append.
+    auto append(const BrokenTradeMessage& msg) -> void {
+        append_header(msg);
+        match_number.push_back(msg.match_number);
+    }
+
+    /// @brief Empties every column, keeping their capacity.
+    auto clear() noexcept -> void {
+        clear_header();
+        match_number.clear();
+    }
+};
+
+/// @brief Header columns of every message type without a column set of its own
+///        (system, directory, and auction messages), tagged with the type byte.
+struct OtherColumns : HeaderColumns {
+    std::vector<char> message_type;  ///< The message type byte of each row.
+
+    /// @brief Appends the header of one message as a row.
+    ///
+    /// @tparam MsgType Any message struct.
+    /// @param msg The message to append.
+    template <typename MsgType>
+    auto append(const MsgType& msg) -> void {
+        append_header(msg);
+        message_type.push_back(msg.message_type);
+    }
+
+    /// @brief Empties every column, keeping their capacity.
+    auto clear() noexcept -> void {
+        clear_header();
+        message_type.clear();
+    }
+};
+
+namespace detail {
+
+/// @brief Maps a message struct to the column set it is appended to.
+template <typename MsgType>
+struct ColumnsOf {
+    using type = OtherColumns;
+};
+
+template <>
+struct ColumnsOf<AddOrderMessage> {
+    using type = AddOrderColumns;
+};
+
+template <>
+struct ColumnsOf<AddOrderMPIDAttributionMessage> {
+    using type = AddOrderMPIDColumns;
+};
+
+template <>
+struct ColumnsOf<OrderExecutedMessage> {
+    using type = OrderExecutedColumns;
+};
+
+template <>
+struct ColumnsOf<OrderExecutedWithPriceMessage> {
+    using type = OrderExecutedWithPriceColumns;
+};
+
+template <>
+struct ColumnsOf<OrderCancelMessage> {
+    using type = OrderCancelColumns;
+};
+
+template <>
+struct ColumnsOf<OrderDeleteMessage> {
+    using type = OrderDeleteColumns;
+};
+
+template <>
+struct ColumnsOf<OrderReplaceMessage> {
+    using type = OrderReplaceColumns;
+};
+
+template <>
+struct ColumnsOf<NonCrossTradeMessage> {
+    using type = NonCrossTradeColumns;
+};
+
+template <>
+struct ColumnsOf<CrossTradeMessage> {
+    using type = CrossTradeColumns;
+};
+
+template <>
+struct ColumnsOf<BrokenTradeMessage> {
+    using type = BrokenTradeColumns;
+};
+
+}  // namespace detail
+
+/// @brief The column set a message struct is appended to: its own typed set for
+///        order-flow and trade messages, `OtherColumns` for everything else.
+template <typename MsgType>
+using ColumnsFor = typename detail::ColumnsOf<MsgType>::type;
+
+/// @brief A batch of decoded messages stored column-wise, one column set per
+///        message type.
+///
+/// The batch is itself a `parse_with` handler: invoking it with a message struct
+/// appends that message to its column set. It never allocates once every column
+/// has grown to its working size, because `clear` keeps the capacity, so a
+/// single batch can be refilled for a whole session.
+class ColumnarBatch {
+   public:
+    /// @brief The capacity used when none (or zero) is given.
+    static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+    /// @brief Constructs an empty batch.
+    ///
+    /// @param capacity The number of messages (over all types) after which the
+    ///        batch counts as full; 0 selects `DEFAULT_CAPACITY`.
+    explicit ColumnarBatch(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /// @brief Appends one message to the column set of its type.
+    ///
+    /// @tparam MsgType Any message struct.
+    /// @param msg The message to append.
+    template <typename MsgType>
+    auto operator()(const MsgType& msg) -> void {
+        columns_in<MsgType>(*this).append(msg);
+        ++m_size;
+    }
+
+    /// @brief Appends one message, whatever its alternative, to its column set.
+    ///
+    /// @param message The message to append.
+    auto append(const Message& message) -> void;
+
+    /// @brief The column set messages of type `MsgType` are appended to.
+    ///
+    /// @tparam MsgType A message struct.
+    /// @return The column set for `MsgType` (the shared `OtherColumns` for types
+    ///         without their own).
+    template <typename MsgType>
+    [[nodiscard]] auto columns() const noexcept -> const ColumnsFor<MsgType>& {
+        return columns_in<MsgType>(*this);
+    }
+
+    /// @brief The number of messages in the batch, over all column sets.
+    ///
+    /// @return The sum of the row counts of every column set.
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+
+    /// @brief Checks whether the batch holds no messages.
+    ///
+    /// @return `true` if `size() == 0`.
+    [[nodiscard]] auto empty() const noexcept -> bool { return m_size == 0; }
+
+    /// @brief The number of messages after which the batch counts as full.
+    ///
+    /// @return The capacity given at construction.
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t { return m_capacity; }
+
+    /// @brief Checks whether the batch has reached its capacity.
+    ///
+    /// @return `true` if `size() >= capacity()`.
+    [[nodiscard]] auto full() const noexcept -> bool { return m_size >= m_capacity; }
+
+    /// @brief Empties every column set, keeping the columns' capacity.
+    auto clear() noexcept -> void;
+
+   private:
+    /// @brief The column set for `MsgType` in `self`, const or not.
+    ///
+    /// @tparam MsgType A message struct.
+    /// @tparam Self `ColumnarBatch` or `const ColumnarBatch`.
+    /// @param self The batch to select from.
+    /// @return The column set messages of type `MsgType` are appended to.
+    template <typename MsgType, typename Self>
+    static auto columns_in(Self& self) noexcept -> auto& {
+        using Columns = ColumnsFor<MsgType>;
+        if constexpr (std::is_same_v<Columns, AddOrderColumns>) {
+            return self.m_add_orders;
+        } else if constexpr (std::is_same_v<Columns, AddOrderMPIDColumns>) {
+            return self.m_add_orders_mpid;
+        } else if constexpr (std::is_same_v<Columns, OrderExecutedColumns>) {
+            return self.m_executions;
+        } else if constexpr (std::is_same_v<Columns, OrderExecutedWithPriceColumns>) {
+            return self.m_executions_with_price;
+        } else if constexpr (std::is_same_v<Columns, OrderCancelColumns>) {
+            return self.m_cancels;
+        } else if constexpr (std::is_same_v<Columns, OrderDeleteColumns>) {
+            return self.m_deletes;
+        } else if constexpr (std::is_same_v<Columns, OrderReplaceColumns>) {
+            return self.m_replaces;
+        } else if constexpr (std::is_same_v<Columns, NonCrossTradeColumns>) {
+            return self.m_trades;
+        } else if constexpr (std::is_same_v<Columns, CrossTradeColumns>) {
+            return self.m_cross_trades;
+        } else if constexpr (std::is_same_v<Columns, BrokenTradeColumns>) {
+            return self.m_broken_trades;
+        } else {
+            return self.m_other;
+        }
+    }
+
+    AddOrderColumns               m_add_orders;
+    AddOrderMPIDColumns           m_add_orders_mpid;
+    OrderExecutedColumns          m_executions;
+    OrderExecutedWithPriceColumns m_executions_with_price;
+    OrderCancelColumns            m_cancels;
+    OrderDeleteColumns            m_deletes;
+    OrderReplaceColumns           m_replaces;
+    NonCrossTradeColumns          m_trades;
+    CrossTradeColumns             m_cross_trades;
+    BrokenTradeColumns            m_broken_trades;
+    OtherColumns                  m_other;
+    std::size_t                   m_size {0};
+    std::size_t                   m_capacity;
+};
+
+/// @brief The signature of the callback `parse_columnar` hands each filled
+///        batch to.
+///
+/// @param const ColumnarBatch& The batch; it is cleared once the callback returns.
+using ColumnarBatchCallback = std::function<void(const ColumnarBatch&)>;
+
+/// @brief Parses messages from a byte span into column-wise batches.
+///
+/// Each message is decoded straight into `batch` by `parser.parse_with`,
+/// without a `Message` variant. Whenever the batch reaches its capacity it is
+/// handed to `on_batch` and then cleared, so the columns' storage is reused for
+/// the whole buffer; a final, partly filled batch is delivered the same way.
+/// Framing, validation, and diagnostics are identical to `Parser::parse`.
+///
+/// @param parser The parser to decode with.
+/// @param data A view over the contiguous buffer containing ITCH data.
+/// @param batch The batch to fill. It is cleared first and is empty again on
+///        return.
+/// @param on_batch Invoked with each filled batch, in stream order.
+/// @throw std::runtime_error if the buffer ends in the middle of a message
+///        (the batches completed before it have been delivered).
+auto parse_columnar(
+    Parser&                      parser,
+    std::span<const std::byte>   data,
+    ColumnarBatch&               batch,
+    const ColumnarBatchCallback& on_batch
+) -> void;
+
+/// @brief Parses messages from a byte span into column-wise batches of
+///        `batch_size` messages.
+///
+/// @param parser The parser to decode with.
+/// @param data A view over the contiguous buffer containing ITCH data.
+/// @param batch_size The number of messages per batch; 0 selects
+///        `ColumnarBatch::DEFAULT_CAPACITY`.
+/// @param on_batch Invoked with each filled batch, in stream order.
+/// @throw std::runtime_error if the buffer ends in the middle of a message.
+auto parse_columnar(
+    Parser&                      parser,
+    std::span<const std::byte>   data,
+    std::size_t                  batch_size,
+    const ColumnarBatchCallback& on_batch
+) -> void;
+
+}  // namespace itch
@@ -0,0 +1,60 @@
+#pragma once
+
+/// @file
+/// @brief Selection of the instruction-set-specific decode kernels.
+///
+/// The order-flow messages (`A`, `D`, `E`, `X`, `U`) make up nearly the whole
+/// of a TotalView session. On x86-64 they can be decoded by SIMD kernels that
+/// byte-swap and place every field of a frame with a few byte shuffles,
+/// instead of one load, swap, and store per field. Which kernel runs is a
+/// property of each `Parser`, defaulting to the best one the CPU supports.
+/// All kernels produce identical messages.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace itch {
+
+/// @brief The instruction set used to decode the order-flow message types.
+enum class DecodeKernel : std::uint8_t {
+    scalar,  ///< Field-by-field portable decode; the only kernel on non-x86 targets.
+    ssse3,   ///< 128-bit `pshufb` shuffles (SSSE3, implied by SSE4).
+    avx2,    ///< 256-bit `vpshufb` shuffles, two output lanes per instruction.
+};
+
+/// @brief The number of `DecodeKernel` enumerators.
+inline constexpr std::size_t DECODE_KERNEL_COUNT = 3;
+
+/// @brief Checks whether the running CPU (and OS) can execute a kernel.
+///
+/// The answer is computed once from CPUID and cached.
+///
+/// @param kernel The kernel to check.
+/// @return `true` if `kernel` can run here; always `true` for `scalar`.
+[[nodiscard]] auto decode_kernel_supported(DecodeKernel kernel) noexcept -> bool;
+
+/// @brief The fastest kernel the running CPU supports.
+///
+/// @return `avx2`, `ssse3`, or `scalar`, in that order of preference.
+[[nodiscard]] auto best_decode_kernel() noexcept -> DecodeKernel;
+
+/// @brief The kernel's name, for logs and benchmark labels.
+///
+/// @param kernel The kernel to name.
+/// @return `"scalar"`, `"ssse3"`, or `"avx2"`.
+[[nodiscard]] constexpr auto to_string(DecodeKernel kernel) noexcept -> std::string_view {
+    switch (kernel) {
+        case DecodeKernel::ssse3:
+            return "ssse3";
+        case DecodeKernel::avx2:
+            return "avx2";
+        case DecodeKernel::scalar:
+            break;
+    }
+    return "scalar";
+}
+
+}  // namespace itch
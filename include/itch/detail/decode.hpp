@@ -0,0 +1,353 @@
+#pragma once
+
+/// @file
+/// @brief Inline, per-message-type field decoders and the byte-unpacking
+///        utilities that back them.
+///
+/// The decoders live in a header, rather than in parser.cpp, so that the
+/// statically dispatched `Parser::parse_with` can instantiate them directly
+/// inside the caller's handler and let the compiler inline the whole
+/// frame-to-struct path. The type-erased `Parser::parse` overloads reach the
+/// very same functions through their compile-time dispatch table, so both
+/// entry points always agree on how a frame is decoded.
+///
+/// The `itch::utils` helpers are public and are re-exported by
+/// itch/parser.hpp; everything in `itch::detail` is an implementation detail.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#include "itch/messages.hpp"
+
+namespace itch {
+
+namespace utils {
+
+/// @brief Reverses the byte order of an integral value.
+///
+/// Prefers `std::byteswap` (C++23) and otherwise falls back to a well-defined
+/// `std::bit_cast` based reversal. This deliberately avoids reading an inactive
+/// union member, which is undefined behavior in C++ and a hazard on the parser
+/// hot path.
+///
+/// @tparam IntType The integral type to byte-swap.
+/// @param value The value whose byte order should be reversed.
+/// @return `value` with its byte order reversed.
+template <std::integral IntType>
+[[nodiscard]] constexpr auto swap_bytes(IntType value) noexcept -> IntType {
+#ifdef __cpp_lib_byteswap
+    return std::byteswap(value);
+#else
+    if constexpr (sizeof(IntType) == 1) {
+        return value;
+    } else {
+        auto bytes = std::bit_cast<std::array<std::byte, sizeof(IntType)>>(value);
+        std::ranges::reverse(bytes);
+        return std::bit_cast<IntType>(bytes);
+    }
+#endif
+}
+
+/// @brief Converts a big-endian (network order) value to the host byte order.
+///
+/// On little-endian hosts this swaps the bytes; on big-endian hosts it is a
+/// no-op. The choice is made at compile time via `std::endian`.
+///
+/// @tparam IntType The integral type to convert.
+/// @param value The big-endian value to convert.
+/// @return `value` converted to host byte order.
+template <std::integral IntType>
+[[nodiscard]] constexpr auto from_big_endian(IntType value) noexcept -> IntType {
+    if constexpr (std::endian::native == std::endian::little) {
+        return swap_bytes(value);
+    } else {
+        return value;
+    }
+}
+
+/// @brief Unpacks a value of type T from the buffer, advancing the offset.
+///        Handles endianness conversion for multi-byte integral types.
+///
+/// @tparam ValueType The type of value to unpack.
+/// @param buffer The buffer to read from.
+/// @param offset The byte offset to read from, advanced past the unpacked value.
+/// @return The unpacked value, converted to host byte order when applicable.
+template <typename ValueType>
+[[nodiscard]] inline auto unpack(const char* buffer, std::size_t& offset) -> ValueType {
+    ValueType value;
+    std::memcpy(&value, buffer + offset, sizeof(ValueType));
+    offset += sizeof(ValueType);
+
+    if constexpr (std::is_integral_v<ValueType> && sizeof(ValueType) > 1) {
+        return from_big_endian(value);
+    } else {
+        return value;
+    }
+}
+
+/// @brief Copies a fixed-width character field out of the buffer.
+///
+/// @param buffer The buffer to read from.
+/// @param offset The byte offset to read from, advanced past the copied field.
+/// @param dest The destination buffer to copy the field into.
+/// @param size The number of characters to copy.
+inline auto unpack_string(const char* buffer, std::size_t& offset, char* dest, std::size_t size)
+    -> void {
+    std::memcpy(dest, buffer + offset, size);
+    offset += size;
+}
+
+/// @brief Unpacks a 48-bit big-endian ITCH timestamp (2-byte high, 4-byte low).
+///
+/// @param buffer The buffer to read from.
+/// @param offset The byte offset to read from, advanced past the timestamp.
+/// @return The timestamp as nanoseconds past midnight.
+[[nodiscard]] inline auto unpack_timestamp(const char* buffer, std::size_t& offset)
+    -> std::uint64_t {
+    std::uint16_t high {};
+    std::uint32_t low {};
+    constexpr int LOWER_SHIFT = 32;
+    std::memcpy(&high, buffer + offset, sizeof(high));
+    offset += sizeof(high);
+    std::memcpy(&low, buffer + offset, sizeof(low));
+    offset += sizeof(low);
+    high = from_big_endian(high);
+    low  = from_big_endian(low);
+    return (static_cast<std::uint64_t>(high) << LOWER_SHIFT) | low;
+}
+}  // namespace utils
+
+namespace detail {
+
+/// @brief Views a byte span as the `const char*` the decoders work with.
+///
+/// @param data The byte span to view.
+/// @return A pointer to the first byte of `data`, as `const char*`.
+[[nodiscard]] inline auto as_char_ptr(std::span<const std::byte> data) noexcept -> const char* {
+    // char may alias std::byte; the house style forbids reinterpret_cast, so the
+    // void* hop is the intended form here.
+    const void* raw = data.data();
+    return static_cast<const char*>(raw);  // NOLINT(bugprone-casting-through-void)
+}
+
+// One `unpack_message` overload per message struct decodes the type-specific
+// body that follows the common header, advancing `offset` past each field.
+
+inline auto unpack_message(SystemEventMessage& msg, const char* buffer, size_t& offset) -> void {
+    msg.event_code = utils::unpack<char>(buffer, offset);
+}
+
+inline auto unpack_message(StockDirectoryMessage& msg, const char* buffer, size_t& offset) -> void {
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+    msg.market_category            = utils::unpack<char>(buffer, offset);
+    msg.financial_status_indicator = utils::unpack<char>(buffer, offset);
+    msg.round_lot_size             = utils::unpack<uint32_t>(buffer, offset);
+    msg.round_lots_only            = utils::unpack<char>(buffer, offset);
+    msg.issue_classification       = utils::unpack<char>(buffer, offset);
+
+    utils::unpack_string(buffer, offset, msg.issue_sub_type, 2);
+    msg.authenticity                   = utils::unpack<char>(buffer, offset);
+    msg.short_sale_threshold_indicator = utils::unpack<char>(buffer, offset);
+    msg.ipo_flag                       = utils::unpack<char>(buffer, offset);
+    msg.luld_ref                       = utils::unpack<char>(buffer, offset);
+    msg.etp_flag                       = utils::unpack<char>(buffer, offset);
+    msg.etp_leverage_factor            = utils::unpack<uint32_t>(buffer, offset);
+    msg.inverse_indicator              = utils::unpack<char>(buffer, offset);
+}
+
+inline auto unpack_message(StockTradingActionMessage& msg, const char* buffer, size_t& offset)
+    -> void {
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+    msg.trading_state = utils::unpack<char>(buffer, offset);
+    msg.reserved      = utils::unpack<char>(buffer, offset);
+    utils::unpack_string(buffer, offset, msg.reason, 4);
+}
+
+inline auto unpack_message(RegSHOMessage& msg, const char* buffer, size_t& offset) -> void {
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+    msg.reg_sho_action = utils::unpack<char>(buffer, offset);
+}
+
+inline auto unpack_message(
+    MarketParticipantPositionMessage& msg, const char* buffer, size_t& offset
+) -> void {
+    utils::unpack_string(buffer, offset, msg.mpid, 4);
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+    msg.primary_market_maker     = utils::unpack<char>(buffer, offset);
+    msg.market_maker_mode        = utils::unpack<char>(buffer, offset);
+    msg.market_participant_state = utils::unpack<char>(buffer, offset);
+}
+
+inline auto unpack_message(MWCBDeclineLevelMessage& msg, const char* buffer, size_t& offset)
+    -> void {
+    msg.level1 = utils::unpack<uint64_t>(buffer, offset);
+    msg.level2 = utils::unpack<uint64_t>(buffer, offset);
+    msg.level3 = utils::unpack<uint64_t>(buffer, offset);
+}
+
+inline auto unpack_message(MWCBStatusMessage& msg, const char* buffer, size_t& offset) -> void {
+    msg.breached_level = utils::unpack<char>(buffer, offset);
+}
+
+inline auto unpack_message(IPOQuotingPeriodUpdateMessage& msg, const char* buffer, size_t& offset)
+    -> void {
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+    msg.ipo_quotation_release_time      = utils::unpack<uint32_t>(buffer, offset);
+    msg.ipo_quotation_release_qualifier = utils::unpack<char>(buffer, offset);
+    msg.ipo_price                       = utils::unpack<uint32_t>(buffer, offset);
+}
+
+inline auto unpack_message(LULDAuctionCollarMessage& msg, const char* buffer, size_t& offset)
+    -> void {
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+    msg.auction_collar_reference_price = utils::unpack<uint32_t>(buffer, offset);
+    msg.upper_auction_collar_price     = utils::unpack<uint32_t>(buffer, offset);
+    msg.lower_auction_collar_price     = utils::unpack<uint32_t>(buffer, offset);
+    msg.auction_collar_extension       = utils::unpack<uint32_t>(buffer, offset);
+}
+
+inline auto unpack_message(OperationalHaltMessage& msg, const char* buffer, size_t& offset)
+    -> void {
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+    msg.market_code             = utils::unpack<char>(buffer, offset);
+    msg.operational_halt_action = utils::unpack<char>(buffer, offset);
+}
+
+inline auto unpack_message(AddOrderMessage& msg, const char* buffer, size_t& offset) -> void {
+    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
+    msg.buy_sell_indicator     = utils::unpack<char>(buffer, offset);
+    msg.shares                 = utils::unpack<uint32_t>(buffer, offset);
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+    msg.price = utils::unpack<uint32_t>(buffer, offset);
+}
+
+inline auto unpack_message(AddOrderMPIDAttributionMessage& msg, const char* buffer, size_t& offset)
+    -> void {
+    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
+    msg.buy_sell_indicator     = utils::unpack<char>(buffer, offset);
+    msg.shares                 = utils::unpack<uint32_t>(buffer, offset);
+
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+    msg.price = utils::unpack<uint32_t>(buffer, offset);
+    utils::unpack_string(buffer, offset, msg.attribution, 4);
+}
+
+inline auto unpack_message(OrderExecutedMessage& msg, const char* buffer, size_t& offset) -> void {
+    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
+    msg.executed_shares        = utils::unpack<uint32_t>(buffer, offset);
+    msg.match_number           = utils::unpack<uint64_t>(buffer, offset);
+}
+
+inline auto unpack_message(OrderExecutedWithPriceMessage& msg, const char* buffer, size_t& offset)
+    -> void {
+    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
+    msg.executed_shares        = utils::unpack<uint32_t>(buffer, offset);
+    msg.match_number           = utils::unpack<uint64_t>(buffer, offset);
+    msg.printable              = utils::unpack<char>(buffer, offset);
+    msg.execution_price        = utils::unpack<uint32_t>(buffer, offset);
+}
+
+inline auto unpack_message(OrderCancelMessage& msg, const char* buffer, size_t& offset) -> void {
+    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
+    msg.cancelled_shares       = utils::unpack<uint32_t>(buffer, offset);
+}
+
+inline auto unpack_message(OrderDeleteMessage& msg, const char* buffer, size_t& offset) -> void {
+    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
+}
+
+inline auto unpack_message(OrderReplaceMessage& msg, const char* buffer, size_t& offset) -> void {
+    msg.original_order_reference_number = utils::unpack<uint64_t>(buffer, offset);
+    msg.new_order_reference_number      = utils::unpack<uint64_t>(buffer, offset);
+    msg.shares                          = utils::unpack<uint32_t>(buffer, offset);
+    msg.price                           = utils::unpack<uint32_t>(buffer, offset);
+}
+
+inline auto unpack_message(NonCrossTradeMessage& msg, const char* buffer, size_t& offset) -> void {
+    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
+    msg.buy_sell_indicator     = utils::unpack<char>(buffer, offset);
+    msg.shares                 = utils::unpack<uint32_t>(buffer, offset);
+
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+
+    msg.price        = utils::unpack<uint32_t>(buffer, offset);
+    msg.match_number = utils::unpack<uint64_t>(buffer, offset);
+}
+
+inline auto unpack_message(CrossTradeMessage& msg, const char* buffer, size_t& offset) -> void {
+    msg.shares = utils::unpack<uint64_t>(buffer, offset);
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+
+    msg.cross_price  = utils::unpack<uint32_t>(buffer, offset);
+    msg.match_number = utils::unpack<uint64_t>(buffer, offset);
+    msg.cross_type   = utils::unpack<char>(buffer, offset);
+}
+
+inline auto unpack_message(BrokenTradeMessage& msg, const char* buffer, size_t& offset) -> void {
+    msg.match_number = utils::unpack<uint64_t>(buffer, offset);
+}
+
+inline auto unpack_message(NOIIMessage& msg, const char* buffer, size_t& offset) -> void {
+    msg.paired_shares       = utils::unpack<uint64_t>(buffer, offset);
+    msg.imbalance_shares    = utils::unpack<uint64_t>(buffer, offset);
+    msg.imbalance_direction = utils::unpack<char>(buffer, offset);
+
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+
+    msg.far_price                 = utils::unpack<uint32_t>(buffer, offset);
+    msg.near_price                = utils::unpack<uint32_t>(buffer, offset);
+    msg.current_reference_price   = utils::unpack<uint32_t>(buffer, offset);
+    msg.cross_type                = utils::unpack<char>(buffer, offset);
+    msg.price_variation_indicator = utils::unpack<char>(buffer, offset);
+}
+
+using RPIMsg = RetailPriceImprovementIndicatorMessage;
+inline auto unpack_message(RPIMsg& msg, const char* buffer, size_t& offset) -> void {
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+    msg.interest_flag = utils::unpack<char>(buffer, offset);
+}
+
+inline auto unpack_message(DLCRMessage& msg, const char* buffer, size_t& offset) -> void {
+    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
+    msg.open_eligibility_status  = utils::unpack<char>(buffer, offset);
+    msg.minimum_allowable_price  = utils::unpack<uint32_t>(buffer, offset);
+    msg.maximum_allowable_price  = utils::unpack<uint32_t>(buffer, offset);
+    msg.near_execution_price     = utils::unpack<uint32_t>(buffer, offset);
+    msg.near_execution_time      = utils::unpack<uint64_t>(buffer, offset);
+    msg.lower_price_range_collar = utils::unpack<uint32_t>(buffer, offset);
+    msg.upper_price_range_collar = utils::unpack<uint32_t>(buffer, offset);
+}
+
+/// @brief Decodes the common header and type-specific body of a message of
+///        type MsgType from a frame.
+///
+/// @tparam MsgType The message struct to decode into.
+/// @param buffer Pointer to the start of the frame (the type byte). The caller
+///        guarantees at least `WIRE_SIZE<MsgType>` readable bytes.
+/// @return The fully decoded, host-order message.
+template <typename MsgType>
+[[nodiscard]] inline auto decode_typed(const char* buffer) -> MsgType {
+    MsgType     msg;
+    std::size_t offset = 1;  // Skip the message type byte.
+
+    msg.stock_locate    = utils::unpack<std::uint16_t>(buffer, offset);
+    msg.tracking_number = utils::unpack<std::uint16_t>(buffer, offset);
+    msg.timestamp       = utils::unpack_timestamp(buffer, offset);
+
+    unpack_message(msg, buffer, offset);
+
+    return msg;
+}
+
+}  // namespace detail
+
+}  // namespace itch
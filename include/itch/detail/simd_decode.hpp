@@ -0,0 +1,66 @@
+#pragma once
+
+/// @file
+/// @brief Declarations of the SIMD decode kernels for the order-flow message
+///        types, for the parser's compile-time dispatch tables.
+///
+/// The kernels are defined, and explicitly instantiated for exactly the types
+/// in `HAS_SIMD_KERNEL`, in src/simd_decode.cpp. That translation unit compiles
+/// each kernel for its own instruction set through function target attributes,
+/// so the library as a whole needs no `-mavx2` and still runs on any x86-64
+/// CPU; the parser only calls a kernel after `decode_kernel_supported` says it
+/// may.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <type_traits>
+
+#include "itch/decode_kernel.hpp"
+#include "itch/messages.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ITCH_SIMD_X86 1
+#else
+#define ITCH_SIMD_X86 0
+#endif
+
+// GCC and Clang compile a function for an instruction set given per function;
+// MSVC emits any intrinsic without one. The attribute is part of the kernels'
+// declarations, not just their definitions, so the compiler knows it at every
+// point of use.
+#if ITCH_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define ITCH_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define ITCH_SIMD_TARGET(isa)
+#endif
+
+namespace itch::detail {
+
+/// @brief Whether `MsgType` has SIMD kernels on this target: the five
+///        order-flow types on x86-64, nothing elsewhere.
+template <typename MsgType>
+inline constexpr bool HAS_SIMD_KERNEL =
+    ITCH_SIMD_X86 != 0 &&
+    (std::is_same_v<MsgType, AddOrderMessage> || std::is_same_v<MsgType, OrderDeleteMessage> ||
+     std::is_same_v<MsgType, OrderExecutedMessage> || std::is_same_v<MsgType, OrderCancelMessage> ||
+     std::is_same_v<MsgType, OrderReplaceMessage>);
+
+/// @brief Decodes a frame with 128-bit byte shuffles (SSSE3).
+///
+/// @tparam MsgType A message type for which `HAS_SIMD_KERNEL` holds.
+/// @param frame Pointer to the frame's type byte; at least `WIRE_SIZE<MsgType>`
+///        bytes are readable. Nothing past them is read.
+/// @return The decoded message, identical to `decode_typed<MsgType>(frame)`.
+template <typename MsgType>
+ITCH_SIMD_TARGET("ssse3") auto decode_ssse3(const char* frame) -> Message;
+
+/// @brief Decodes a frame with 256-bit byte shuffles (AVX2).
+///
+/// @tparam MsgType A message type for which `HAS_SIMD_KERNEL` holds.
+/// @param frame Pointer to the frame's type byte; at least `WIRE_SIZE<MsgType>`
+///        bytes are readable. Nothing past them is read.
+/// @return The decoded message, identical to `decode_typed<MsgType>(frame)`.
+template <typename MsgType>
+ITCH_SIMD_TARGET("avx2") auto decode_avx2(const char* frame) -> Message;
+
+}  // namespace itch::detail
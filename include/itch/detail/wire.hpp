@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 
@@ -27,6 +28,21 @@ constexpr std::size_t TIMESTAMP_STRUCT_PADDING = sizeof(std::uint64_t) - 6;
 template <typename MsgType>
 constexpr std::size_t WIRE_SIZE = sizeof(MsgType) - TIMESTAMP_STRUCT_PADDING;
 
+/// @brief Converts the offset of a field within its message struct (as given
+///        by `offsetof`) to the field's offset within the wire frame.
+///
+/// The timestamp is the only field that is wider in the struct than on the
+/// wire, so every field after it sits `TIMESTAMP_STRUCT_PADDING` bytes earlier
+/// in the frame than in the struct.
+///
+/// @param struct_offset The field's byte offset within the packed struct.
+/// @return The field's byte offset within the frame, counted from the type byte.
+[[nodiscard]] consteval auto wire_offset(std::size_t struct_offset) -> std::size_t {
+    constexpr std::size_t TIMESTAMP_FIELD_OFFSET = 5;
+    return struct_offset > TIMESTAMP_FIELD_OFFSET ? struct_offset - TIMESTAMP_STRUCT_PADDING
+                                                  : struct_offset;
+}
+
 // Lock the padding assumption to the spec lengths so a future struct change that
 // breaks the derivation is caught at compile time rather than at runtime.
 static_assert(WIRE_SIZE<SystemEventMessage> == 12);
@@ -34,6 +50,8 @@ static_assert(WIRE_SIZE<StockDirectoryMessage> == 39);
 static_assert(WIRE_SIZE<AddOrderMessage> == 36);
 static_assert(WIRE_SIZE<NOIIMessage> == 50);
 static_assert(WIRE_SIZE<DLCRMessage> == 48);
+static_assert(wire_offset(offsetof(AddOrderMessage, order_reference_number)) == 11);
+static_assert(wire_offset(offsetof(NonCrossTradeMessage, match_number)) == 36);
 
 /// @brief Invokes `visitor.template operator()<MsgType>(type_byte)` once for each
 ///        ITCH 5.0 message type, in a fixed order.
@@ -71,4 +89,22 @@ constexpr auto for_each_message_type(Visitor&& visitor) -> void {
     visitor.template operator()<DLCRMessage>('O');
 }
 
+/// @brief Builds the type-byte-indexed table of expected wire sizes at compile
+///        time (zero marks an unknown type byte).
+///
+/// @return An array indexed by message-type byte, holding `WIRE_SIZE` for each
+///         registered message type and zero everywhere else.
+[[nodiscard]] consteval auto build_wire_size_table() -> std::array<std::uint16_t, 256> {
+    std::array<std::uint16_t, 256> table {};
+    auto                           add = [&table]<typename MsgType>(char type) {
+        table[static_cast<unsigned char>(type)] = static_cast<std::uint16_t>(WIRE_SIZE<MsgType>);
+    };
+    for_each_message_type(add);
+    return table;
+}
+
+/// @brief The expected wire size for every type byte, shared by every framing
+///        loop so they validate frame lengths identically.
+inline constexpr auto WIRE_SIZE_TABLE = build_wire_size_table();
+
 }  // namespace itch::detail
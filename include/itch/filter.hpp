@@ -0,0 +1,245 @@
+#pragma once
+
+/// @file
+/// @brief Pushdown filters the parser consults on the raw frame, before any
+///        field is decoded.
+///
+/// The message type byte and the stock locate sit at fixed positions in every
+/// ITCH frame, so a filtered parse only needs a bit test or two per frame to
+/// decide whether the frame is worth decoding at all. Frames that fail the test
+/// are length-skipped.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "itch/detail/decode.hpp"
+#include "itch/detail/wire.hpp"
+
+namespace itch {
+
+/// @brief A 256-entry bitmap of message type bytes to keep.
+///
+/// A default-constructed filter keeps nothing; `MessageTypeFilter::all()` keeps
+/// every type and is what the unfiltered entry points use. Membership is a
+/// single shift-and-mask on one of four 64-bit words.
+class MessageTypeFilter {
+   public:
+    /// @brief Constructs an empty filter that keeps no message types.
+    constexpr MessageTypeFilter() = default;
+
+    /// @brief Constructs a filter keeping each type byte listed in `types`.
+    ///
+    /// Commas are ignored, so both `"AEP"` and `"A,E,P"` are accepted.
+    ///
+    /// @param types The message type characters to keep.
+    constexpr explicit MessageTypeFilter(std::string_view types) {
+        for (const char type : types) {
+            if (type != ',') {
+                allow(type);
+            }
+        }
+    }
+
+    /// @brief Constructs a filter keeping each type byte listed in `types`.
+    ///
+    /// @param types The message type characters to keep (e.g., {'A', 'P'}).
+    explicit MessageTypeFilter(const std::vector<char>& types) {
+        for (const char type : types) {
+            allow(type);
+        }
+    }
+
+    /// @brief A filter that keeps every message type.
+    ///
+    /// @return A filter with all 256 bits set.
+    [[nodiscard]] static constexpr auto all() noexcept -> MessageTypeFilter {
+        MessageTypeFilter filter;
+        for (auto& word : filter.m_bits) {
+            word = ~std::uint64_t {0};
+        }
+        return filter;
+    }
+
+    /// @brief Adds a message type to the set of kept types.
+    ///
+    /// @param type The message type byte to keep.
+    /// @return A reference to this filter, for chaining.
+    constexpr auto allow(char type) noexcept -> MessageTypeFilter& {
+        const auto byte = static_cast<unsigned char>(type);
+        m_bits[byte >> WORD_SHIFT] |= std::uint64_t {1} << (byte & WORD_MASK);
+        return *this;
+    }
+
+    /// @brief Removes a message type from the set of kept types.
+    ///
+    /// @param type The message type byte to drop.
+    /// @return A reference to this filter, for chaining.
+    constexpr auto deny(char type) noexcept -> MessageTypeFilter& {
+        const auto byte = static_cast<unsigned char>(type);
+        m_bits[byte >> WORD_SHIFT] &= ~(std::uint64_t {1} << (byte & WORD_MASK));
+        return *this;
+    }
+
+    /// @brief Whether frames of the given type pass the filter.
+    ///
+    /// @param type The message type byte to test.
+    /// @return `true` if the type is kept.
+    [[nodiscard]] constexpr auto contains(char type) const noexcept -> bool {
+        const auto byte = static_cast<unsigned char>(type);
+        return ((m_bits[byte >> WORD_SHIFT] >> (byte & WORD_MASK)) & 1U) != 0;
+    }
+
+    /// @brief Whether the filter keeps no message types at all.
+    ///
+    /// @return `true` if every bit is clear.
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool {
+        for (const auto word : m_bits) {
+            if (word != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Two filters are equal when they keep exactly the same types.
+    [[nodiscard]] constexpr auto operator==(const MessageTypeFilter&) const noexcept
+        -> bool = default;
+
+   private:
+    static constexpr unsigned WORD_SHIFT = 6;
+    static constexpr unsigned WORD_MASK  = 63;
+
+    std::array<std::uint64_t, 4> m_bits {};
+};
+
+/// @brief A 65536-entry bitmap of stock locate codes to keep, optionally filled
+///        from the feed's own Stock Directory messages.
+///
+/// Frames whose locate is not in the set are dropped before decoding. Locate 0
+/// is not a security (system events and market-wide messages carry it), so
+/// those frames always pass. Since locates are assigned per day, a universe is
+/// usually given as symbols: each Stock Directory (`R`) frame for a watched
+/// symbol adds its locate to the set as it goes by, ahead of every message for
+/// that security. The filter therefore has state and is meant to be used for
+/// one feed, from its start. The bitmap is 8 KiB, so it stays in L1 while a
+/// day is scanned.
+class LocateFilter {
+   public:
+    /// @brief Constructs a filter that keeps only locate-0 (non-security) frames.
+    LocateFilter() = default;
+
+    /// @brief Constructs a filter that learns the locates of `symbols` from the
+    ///        feed's Stock Directory messages.
+    ///
+    /// @param symbols The ticker symbols to keep (e.g., {"AAPL", "MSFT"}).
+    /// @throw std::invalid_argument if a symbol is longer than 8 characters.
+    explicit LocateFilter(const std::vector<std::string>& symbols) {
+        for (const auto& symbol : symbols) {
+            watch(symbol);
+        }
+    }
+
+    /// @brief Adds a locate code to the set of kept locates.
+    ///
+    /// @param locate The stock locate to keep.
+    /// @return A reference to this filter, for chaining.
+    auto allow(std::uint16_t locate) noexcept -> LocateFilter& {
+        m_bits[locate >> WORD_SHIFT] |= std::uint64_t {1} << (locate & WORD_MASK);
+        return *this;
+    }
+
+    /// @brief Removes a locate code from the set of kept locates.
+    ///
+    /// @param locate The stock locate to drop.
+    /// @return A reference to this filter, for chaining.
+    auto deny(std::uint16_t locate) noexcept -> LocateFilter& {
+        m_bits[locate >> WORD_SHIFT] &= ~(std::uint64_t {1} << (locate & WORD_MASK));
+        return *this;
+    }
+
+    /// @brief Adds a symbol whose locate is learned from Stock Directory frames.
+    ///
+    /// @param symbol The ticker symbol, without padding.
+    /// @return A reference to this filter, for chaining.
+    /// @throw std::invalid_argument if `symbol` is longer than 8 characters.
+    auto watch(std::string_view symbol) -> LocateFilter& {
+        if (symbol.size() > SYMBOL_WIDTH) {
+            throw std::invalid_argument(
+                "Symbol '" + std::string {symbol} + "' is longer than 8 characters."
+            );
+        }
+        Symbol padded {};
+        padded.fill(' ');
+        std::ranges::copy(symbol, padded.begin());
+        const auto position = std::ranges::lower_bound(m_symbols, padded);
+        if (position == m_symbols.end() || *position != padded) {
+            m_symbols.insert(position, padded);
+        }
+        return *this;
+    }
+
+    /// @brief Whether frames for a locate pass the filter.
+    ///
+    /// @param locate The stock locate to test.
+    /// @return `true` if the locate is kept (always for locate 0).
+    [[nodiscard]] auto contains(std::uint16_t locate) const noexcept -> bool {
+        return locate == 0 || ((m_bits[locate >> WORD_SHIFT] >> (locate & WORD_MASK)) & 1U) != 0;
+    }
+
+    /// @brief Tests a well-formed raw frame against the filter, first learning
+    ///        the locate of a watched symbol from a Stock Directory frame.
+    ///
+    /// @param frame Pointer to the frame's type byte; the frame is at least as
+    ///        long as its type's wire size.
+    /// @return `true` if the frame should be decoded.
+    [[nodiscard]] auto admit(const char* frame) noexcept -> bool {
+        std::uint16_t locate {};
+        std::memcpy(&locate, frame + LOCATE_OFFSET, sizeof(locate));
+        locate = utils::from_big_endian(locate);
+        if (frame[0] == 'R' && !m_symbols.empty()) {
+            Symbol symbol {};
+            std::memcpy(symbol.data(), frame + DIRECTORY_SYMBOL_OFFSET, symbol.size());
+            if (std::ranges::binary_search(m_symbols, symbol)) {
+                allow(locate);
+            }
+        }
+        return contains(locate);
+    }
+
+    /// @brief The number of locates currently kept (locate 0 not counted).
+    ///
+    /// @return The population count of the bitmap.
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+        std::size_t count = 0;
+        for (const auto word : m_bits) {
+            count += static_cast<std::size_t>(std::popcount(word));
+        }
+        return count - (m_bits[0] & 1U);
+    }
+
+   private:
+    using Symbol = std::array<char, 8>;
+
+    static constexpr unsigned    WORD_SHIFT              = 6;
+    static constexpr unsigned    WORD_MASK               = 63;
+    static constexpr std::size_t SYMBOL_WIDTH            = 8;
+    static constexpr std::size_t LOCATE_OFFSET =
+        detail::wire_offset(offsetof(StockDirectoryMessage, stock_locate));
+    static constexpr std::size_t DIRECTORY_SYMBOL_OFFSET =
+        detail::wire_offset(offsetof(StockDirectoryMessage, stock));
+
+    std::array<std::uint64_t, 1024> m_bits {};
+    std::vector<Symbol>             m_symbols;  ///< Watched symbols, space padded, sorted.
+};
+
+}  // namespace itch
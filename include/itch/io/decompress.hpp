@@ -0,0 +1,109 @@
+#pragma once
+
+/// @file
+/// @brief Pipelined decompression of gzip and zstd archives into a ring of
+///        blocks consumed on the calling thread.
+///
+/// NASDAQ publishes day files gzip-compressed, and archives are usually kept
+/// compressed. Rather than inflating a multi-gigabyte temporary file first,
+/// `for_each_decompressed_block` runs the decompressor on a background thread
+/// that fills a small ring of large blocks while the caller consumes the
+/// previous ones, so parsing overlaps decompression and runs at the speed of
+/// the slower of the two. Bytes the consumer leaves at the end of a block (a
+/// frame cut by the block boundary) are carried to the front of the next one.
+///
+/// gzip needs the library built with `-DITCH_WITH_ZLIB=ON` and zstd with
+/// `-DITCH_WITH_ZSTD=ON`; `compression_supported` reports what this build has.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string_view>
+
+namespace itch::io {
+
+/// @brief The container formats an input may be compressed with.
+enum class Compression : std::uint8_t {
+    none,  ///< Not compressed (or not a recognized format).
+    gzip,  ///< gzip (RFC 1952), possibly several concatenated members.
+    zstd,  ///< Zstandard, possibly several concatenated frames.
+};
+
+/// @brief Identifies the compression of a buffer from its magic bytes.
+///
+/// @param data The start of the input (at least the first four bytes).
+/// @return The detected format, or `Compression::none`.
+[[nodiscard]] auto detect_compression(std::span<const std::byte> data) noexcept -> Compression;
+
+/// @brief Checks whether this build of the library can decompress a format.
+///
+/// @param compression The format to check.
+/// @return `true` if the format can be decompressed; always `true` for `none`.
+[[nodiscard]] auto compression_supported(Compression compression) noexcept -> bool;
+
+/// @brief The format's name, for messages.
+///
+/// @param compression The format to name.
+/// @return `"none"`, `"gzip"`, or `"zstd"`.
+[[nodiscard]] constexpr auto to_string(Compression compression) noexcept -> std::string_view {
+    switch (compression) {
+        case Compression::gzip:
+            return "gzip";
+        case Compression::zstd:
+            return "zstd";
+        case Compression::none:
+            break;
+    }
+    return "none";
+}
+
+/// @brief Sizing of the decompression ring.
+struct DecompressOptions {
+    /// Decompressed bytes per block. Larger blocks mean fewer hand-offs
+    /// between the threads.
+    std::size_t block_size = std::size_t {4} << 20U;
+
+    /// Blocks in the ring (at least 2): how far the decompressor may run ahead
+    /// of the consumer.
+    std::size_t blocks = 4;
+
+    /// The most bytes a consumer may leave unconsumed at the end of a block.
+    /// The default covers the largest possible ITCH frame.
+    std::size_t max_carry = sizeof(std::uint16_t) + 0xFFFFU;
+};
+
+/// @brief Consumes one block of decompressed data.
+///
+/// @param std::span<const std::byte> The bytes carried over from the previous
+///        block, followed by the newly decompressed ones.
+/// @return The number of bytes consumed from the front; the rest is carried
+///         over to the next block.
+using BlockConsumer = std::function<std::size_t(std::span<const std::byte>)>;
+
+/// @brief Decompresses a buffer on a background thread, handing the output to
+///        `consumer` block by block on the calling thread.
+///
+/// Blocks are delivered in order. The decompressor stops and the thread is
+/// joined before this function returns or throws, including when `consumer`
+/// throws.
+///
+/// @param compressed The whole compressed input, e.g. a `MappedFile`'s bytes.
+/// @param compression The format of `compressed` (see `detect_compression`).
+/// @param consumer Invoked with each block; returns the bytes it consumed.
+/// @param options Block size, ring depth, and carry limit.
+/// @return The number of bytes left unconsumed at the end of the stream.
+/// @throw std::runtime_error if the format is not supported by this build, the
+///        input is corrupt or truncated, or a consumer leaves more than
+///        `options.max_carry` bytes.
+/// @throw Rethrows anything thrown by `consumer`.
+auto for_each_decompressed_block(
+    std::span<const std::byte> compressed,
+    Compression                compression,
+    const BlockConsumer&       consumer,
+    const DecompressOptions&   options = {}
+) -> std::size_t;
+
+}  // namespace itch::io
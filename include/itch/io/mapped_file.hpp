@@ -0,0 +1,103 @@
+#pragma once
+
+/// @file
+/// @brief Read-only memory-mapped file input.
+///
+/// `MappedFile` maps a file into the address space and exposes it as a
+/// `std::span<const std::byte>`, so a day file can be handed straight to the
+/// parser, the overlay, or the pcap reader without being copied into a heap
+/// buffer first. Pages are faulted in on demand, so startup cost does not
+/// depend on the file size.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace itch::io {
+
+/// @brief Hints applied when a file is mapped. Every hint is best-effort: a
+///        platform or kernel that does not support one simply ignores it.
+struct MapOptions {
+    /// Advise the kernel that the mapping will be read front to back, so it
+    /// reads ahead aggressively and drops pages behind the reader
+    /// (`MADV_SEQUENTIAL` / `FILE_FLAG_SEQUENTIAL_SCAN`).
+    bool sequential = true;
+
+    /// Fault the whole file in while mapping (`MAP_POPULATE` on Linux), trading
+    /// a slower open for no page faults on the hot path.
+    bool populate = false;
+
+    /// Ask for transparent huge pages on the mapping (`MADV_HUGEPAGE` on
+    /// Linux), which cuts TLB misses on large sequential scans when the
+    /// filesystem supports it.
+    bool huge_pages = false;
+};
+
+/// @brief A read-only, move-only memory mapping of an entire file.
+///
+/// The mapping stays valid for the lifetime of the object; spans obtained from
+/// `bytes()` must not outlive it. An empty file yields an empty span without
+/// creating a mapping.
+class MappedFile {
+   public:
+    /// @brief Constructs an object that maps nothing.
+    MappedFile() noexcept = default;
+
+    /// @brief Maps the file at `path` read-only.
+    ///
+    /// @param path Filesystem path of the file to map.
+    /// @param options Access-pattern hints for the mapping.
+    /// @throw std::system_error if the file cannot be opened, sized, or mapped.
+    explicit MappedFile(const std::filesystem::path& path, MapOptions options = {});
+
+    MappedFile(const MappedFile&)                    = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+    /// @brief Takes over the mapping owned by `other`, leaving it empty.
+    ///
+    /// @param other The mapping to move from.
+    MappedFile(MappedFile&& other) noexcept;
+
+    /// @brief Releases the current mapping and takes over the one owned by
+    ///        `other`, leaving it empty.
+    ///
+    /// @param other The mapping to move from.
+    /// @return A reference to this object.
+    auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+    /// @brief Unmaps the file.
+    ~MappedFile();
+
+    /// @brief The mapped contents of the file.
+    ///
+    /// @return A view over every byte of the file.
+    [[nodiscard]] auto bytes() const noexcept -> std::span<const std::byte> {
+        return {m_data, m_size};
+    }
+
+    /// @brief A pointer to the first mapped byte, or null for an empty mapping.
+    ///
+    /// @return The start of the mapping.
+    [[nodiscard]] auto data() const noexcept -> const std::byte* { return m_data; }
+
+    /// @brief The size of the mapped file in bytes.
+    ///
+    /// @return The file size.
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+
+    /// @brief Whether the mapping holds no bytes (empty file, or moved from).
+    ///
+    /// @return `true` if `size()` is zero.
+    [[nodiscard]] auto empty() const noexcept -> bool { return m_size == 0; }
+
+   private:
+    /// @brief Unmaps the current mapping, if any, and resets to empty.
+    auto release() noexcept -> void;
+
+    const std::byte* m_data {nullptr};
+    std::size_t      m_size {0};
+};
+
+}  // namespace itch::io
@@ -0,0 +1,335 @@
+#pragma once
+
+/// @file
+/// @brief Compact, append-only storage for decoded messages of mixed types.
+///
+/// A `std::vector<Message>` spends `sizeof(Message)` bytes on every message,
+/// sized for the largest alternative, and copies everything it holds each time
+/// it grows. `MessageArena` instead stores each message back to back at its own
+/// packed struct size in fixed-size slabs, so a collected day takes roughly half
+/// the memory and nothing is ever moved once stored. Every message struct begins
+/// with its `message_type` byte, which doubles as the record's type tag.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "itch/detail/wire.hpp"
+#include "itch/messages.hpp"
+
+namespace itch {
+
+namespace detail {
+
+/// @brief The in-memory size of each message struct, indexed by type byte (0
+///        for unknown types). The structs are packed, so records need no
+///        padding between them.
+inline constexpr auto STRUCT_SIZE_TABLE = [] {
+    std::array<std::uint8_t, 256> table {};
+    for_each_message_type([&table]<typename MsgType>(char type) {
+        static_assert(alignof(MsgType) == 1, "Arena records must be packed.");
+        table[static_cast<unsigned char>(type)] = static_cast<std::uint8_t>(sizeof(MsgType));
+    });
+    return table;
+}();
+
+/// @brief The largest message struct, i.e. the largest arena record.
+inline constexpr std::size_t MAX_STRUCT_SIZE = [] {
+    std::size_t largest = 0;
+    for (const auto size : STRUCT_SIZE_TABLE) {
+        largest = size > largest ? size : largest;
+    }
+    return largest;
+}();
+
+/// @brief A dispatch entry calling a visitor with one record's typed struct.
+template <typename Visitor>
+using RecordThunk = void (*)(const std::byte*, Visitor&);
+
+/// @brief Builds, at compile time, the type-byte-indexed table that calls a
+///        visitor with an arena record as its concrete struct.
+///
+/// Slots for types the visitor cannot be invoked with stay null, so those
+/// records are skipped, as `Parser::parse_with` does with frames.
+///
+/// @tparam Visitor The (possibly const) visitor type.
+/// @return An array indexed by message-type byte.
+template <typename Visitor>
+consteval auto build_record_table() -> std::array<RecordThunk<Visitor>, 256> {
+    std::array<RecordThunk<Visitor>, 256> table {};
+    for_each_message_type([&table]<typename MsgType>(char type) {
+        if constexpr (std::is_invocable_v<Visitor&, const MsgType&>) {
+            table[static_cast<unsigned char>(type)] = [](const std::byte* record,
+                                                         Visitor&         visitor) {
+                visitor(*std::launder(static_cast<const MsgType*>(static_cast<const void*>(record)))
+                );
+            };
+        }
+    });
+    return table;
+}
+
+/// @brief The record dispatch table for a given visitor type.
+template <typename Visitor>
+inline constexpr auto RECORD_TABLE = build_record_table<Visitor>();
+
+}  // namespace detail
+
+/// @brief Append-only storage of decoded messages at their real struct size.
+///
+/// Messages are appended with `emplace` (or by using the arena as a
+/// `parse_with` handler, or through `Parser::parse(data, arena)`) and read back
+/// in insertion order, either by iterating over `Entry` handles or with
+/// `visit`. Storage comes in slabs of `slab_size` bytes; a full slab is never
+/// reallocated, so references returned by `emplace` and `Entry::get_if` stay valid
+/// until `clear` or destruction. `clear` keeps the slabs for reuse.
+class MessageArena {
+   public:
+    /// @brief The slab size used when none (or a too small one) is given: 1 MiB.
+    static constexpr std::size_t DEFAULT_SLAB_SIZE = std::size_t {1} << 20U;
+
+    /// @brief A handle on one stored message.
+    class Entry {
+       public:
+        /// @brief The message type byte of the record.
+        ///
+        /// @return The record's `message_type`, e.g. `'A'`.
+        [[nodiscard]] auto type() const noexcept -> char { return static_cast<char>(*m_record); }
+
+        /// @brief Checks whether the record holds a `MsgType`.
+        ///
+        /// @tparam MsgType A message struct.
+        /// @return `true` if the record's type byte is `MsgType`'s.
+        template <typename MsgType>
+        [[nodiscard]] auto holds() const noexcept -> bool {
+            return type() == MsgType {}.message_type;
+        }
+
+        /// @brief The record as a `MsgType`, if it is one.
+        ///
+        /// @tparam MsgType A message struct.
+        /// @return A pointer to the stored struct, or `nullptr` if the record
+        ///         holds another type.
+        template <typename MsgType>
+        [[nodiscard]] auto get_if() const noexcept -> const MsgType* {
+            if (!holds<MsgType>()) {
+                return nullptr;
+            }
+            return std::launder(static_cast<const MsgType*>(static_cast<const void*>(m_record)));
+        }
+
+        /// @brief Calls `visitor` with the record as its concrete struct.
+        ///
+        /// Does nothing if `visitor` cannot be invoked with that struct.
+        ///
+        /// @tparam Visitor A callable invocable as `visitor(const MsgType&)` for
+        ///         each message struct it accepts.
+        /// @param visitor The visitor to call.
+        template <typename Visitor>
+        auto visit(Visitor&& visitor) const -> void {
+            using VisitorType = std::remove_reference_t<Visitor>;
+            const auto thunk  = detail::RECORD_TABLE<VisitorType>[std::to_integer<unsigned char>(
+                *m_record
+            )];
+            if (thunk != nullptr) {
+                thunk(m_record, visitor);
+            }
+        }
+
+        /// @brief Copies the record into a `Message` variant.
+        ///
+        /// @return The stored message.
+        [[nodiscard]] auto to_message() const -> Message;
+
+       private:
+        friend class MessageArena;
+
+        explicit Entry(const std::byte* record) noexcept : m_record(record) {}
+
+        const std::byte* m_record;
+    };
+
+    /// @brief A forward iterator over the stored messages in insertion order.
+    class const_iterator {
+       public:
+        using iterator_concept  = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = Entry;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = Entry;
+
+        /// @brief Constructs a singular iterator.
+        const_iterator() = default;
+
+        /// @brief The message the iterator points at.
+        ///
+        /// @return A handle on the current record.
+        auto operator*() const noexcept -> Entry { return Entry {m_record}; }
+
+        /// @brief Advances to the next message.
+        ///
+        /// @return This iterator.
+        auto operator++() noexcept -> const_iterator& {
+            m_record += detail::STRUCT_SIZE_TABLE[std::to_integer<unsigned char>(*m_record)];
+            if (m_record == m_slab_end) {
+                advance_slab();
+            }
+            return *this;
+        }
+
+        /// @brief Advances to the next message.
+        ///
+        /// @return A copy of this iterator from before the increment.
+        auto operator++(int) noexcept -> const_iterator {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        /// @brief Compares two iterators over the same arena.
+        ///
+        /// @return `true` if both point at the same record (or both are at the end).
+        auto operator==(const const_iterator& other) const noexcept -> bool {
+            return m_record == other.m_record;
+        }
+
+       private:
+        friend class MessageArena;
+
+        const_iterator(const MessageArena* arena, std::size_t slab) noexcept;
+
+        /// @brief Moves to the first record of the next slab, or to the end.
+        auto advance_slab() noexcept -> void;
+
+        const MessageArena* m_arena {nullptr};
+        std::size_t         m_slab {0};
+        const std::byte*    m_record {nullptr};
+        const std::byte*    m_slab_end {nullptr};
+    };
+
+    /// @brief Constructs an empty arena; no slab is allocated until the first
+    ///        message is stored.
+    ///
+    /// @param slab_size The size of each slab in bytes. Values smaller than the
+    ///        largest message struct select `DEFAULT_SLAB_SIZE`.
+    explicit MessageArena(std::size_t slab_size = DEFAULT_SLAB_SIZE);
+
+    /// @brief Stores a copy of a message.
+    ///
+    /// @tparam MsgType A message struct.
+    /// @param msg The message to store.
+    /// @return The stored copy, valid until `clear` or destruction.
+    template <typename MsgType>
+    auto emplace(const MsgType& msg) -> const MsgType& {
+        static_assert(alignof(MsgType) == 1, "Arena records must be packed.");
+        if (m_slab_used + sizeof(MsgType) > m_slab_size) {
+            next_slab();
+        }
+        Slab&      slab   = m_slabs[m_active - 1];
+        std::byte* record = slab.data.get() + m_slab_used;
+        m_slab_used += sizeof(MsgType);
+        slab.used = m_slab_used;
+        ++m_size;
+        return *::new (static_cast<void*>(record)) MsgType(msg);
+    }
+
+    /// @brief Stores a copy of a message, for use as a `parse_with` handler.
+    ///
+    /// @tparam MsgType A message struct.
+    /// @param msg The message to store.
+    template <typename MsgType>
+    auto operator()(const MsgType& msg) -> void {
+        emplace(msg);
+    }
+
+    /// @brief Stores a copy of whichever struct a `Message` holds.
+    ///
+    /// @param message The message to store.
+    auto push_back(const Message& message) -> void;
+
+    /// @brief Calls `visitor` with every stored message, in insertion order, as
+    ///        its concrete struct.
+    ///
+    /// Messages of types `visitor` cannot be invoked with are skipped.
+    ///
+    /// @tparam Visitor A callable invocable as `visitor(const MsgType&)` for
+    ///         each message struct it accepts.
+    /// @param visitor The visitor to call.
+    template <typename Visitor>
+    auto visit(Visitor&& visitor) const -> void {
+        using VisitorType = std::remove_reference_t<Visitor>;
+        for (std::size_t slab = 0; slab < m_active; ++slab) {
+            const std::byte* record = m_slabs[slab].data.get();
+            const std::byte* end    = record + m_slabs[slab].used;
+            while (record != end) {
+                const auto type  = std::to_integer<unsigned char>(*record);
+                const auto thunk = detail::RECORD_TABLE<VisitorType>[type];
+                if (thunk != nullptr) {
+                    thunk(record, visitor);
+                }
+                record += detail::STRUCT_SIZE_TABLE[type];
+            }
+        }
+    }
+
+    /// @brief An iterator to the first stored message.
+    ///
+    /// @return `end()` if the arena is empty.
+    [[nodiscard]] auto begin() const noexcept -> const_iterator;
+
+    /// @brief The past-the-end iterator.
+    ///
+    /// @return An iterator equal to any iterator advanced past the last message.
+    [[nodiscard]] auto end() const noexcept -> const_iterator;
+
+    /// @brief The number of stored messages.
+    ///
+    /// @return The count of messages stored since construction or `clear`.
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+
+    /// @brief Checks whether no messages are stored.
+    ///
+    /// @return `true` if `size() == 0`.
+    [[nodiscard]] auto empty() const noexcept -> bool { return m_size == 0; }
+
+    /// @brief The bytes occupied by stored messages.
+    ///
+    /// @return The sum of the stored structs' sizes.
+    [[nodiscard]] auto bytes_used() const noexcept -> std::size_t;
+
+    /// @brief The bytes allocated for slabs, used or not.
+    ///
+    /// @return The slab count times the slab size.
+    [[nodiscard]] auto bytes_reserved() const noexcept -> std::size_t {
+        return m_slabs.size() * m_slab_size;
+    }
+
+    /// @brief Removes every message, keeping the slabs for reuse.
+    auto clear() noexcept -> void;
+
+   private:
+    /// @brief One fixed-size block of records.
+    struct Slab {
+        // NOLINTNEXTLINE(*-avoid-c-arrays)
+        std::unique_ptr<std::byte[]> data;  ///< `m_slab_size` bytes of storage.
+        std::size_t                  used;  ///< Bytes holding records, from the start.
+    };
+
+    /// @brief Makes the next slab current, allocating it if none is spare.
+    auto next_slab() -> void;
+
+    std::vector<Slab> m_slabs;
+    std::size_t       m_slab_size;
+    std::size_t       m_active {0};     ///< Slabs holding records; the last one is current.
+    std::size_t       m_slab_used;      ///< Bytes used in the current slab.
+    std::size_t       m_size {0};
+};
+
+}  // namespace itch
@@ -7,19 +7,27 @@
 /// that read fields lazily, converting each field from network byte order on
 /// access rather than eagerly decoding into a host-order struct. This contrasts
 /// with the eager `Parser` in parser.hpp, which decodes every field up front.
+/// There is one view per message type in the registry, and `visit` hands each
+/// frame to a handler as its concrete view without any type erasure.
 ///
 /// @author Bertin Balouki SIMYELI
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
 #include <functional>
 #include <span>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 
 #include "itch/detail/wire.hpp"
+#include "itch/io/mapped_file.hpp"
 #include "itch/parser.hpp"
+#include "itch/seek_index.hpp"
 
 namespace itch::overlay {
 
@@ -58,15 +66,60 @@ template <typename FieldType>
     return (static_cast<std::uint64_t>(high) << LOWER_SHIFT) | low;
 }
 
-/// @brief Views an 8-byte fixed-width stock field as a string_view (untrimmed).
+/// @brief Views a fixed-width text field (a stock symbol, MPID, or code) as a
+///        string_view (untrimmed).
 ///
 /// @param base Pointer to the start of the message frame.
-/// @param offset Byte offset of the stock field within the frame.
-/// @return An untrimmed view of the 8-byte stock symbol field.
-[[nodiscard]] inline auto read_stock(const std::byte* base, std::size_t offset) noexcept
-    -> std::string_view {
+/// @param offset Byte offset of the field within the frame.
+/// @param size Width of the field in bytes.
+/// @return An untrimmed view of the field.
+[[nodiscard]] inline auto read_text(
+    const std::byte* base, std::size_t offset, std::size_t size
+) noexcept -> std::string_view {
     const void* raw = base + offset;
-    return std::string_view {static_cast<const char*>(raw), 8};
+    return std::string_view {static_cast<const char*>(raw), size};
+}
+
+/// @brief Writes an integral field of width sizeof(T) at `offset`, converting to
+///        network (big-endian) order.
+///
+/// @tparam FieldType The type of the field to write.
+/// @param base Pointer to the start of the writable message frame.
+/// @param offset Byte offset of the field within the frame.
+/// @param value The host-order value to store.
+template <typename FieldType>
+inline auto write_field(std::byte* base, std::size_t offset, FieldType value) noexcept -> void {
+    if constexpr (std::is_integral_v<FieldType> && sizeof(FieldType) > 1) {
+        value = utils::from_big_endian(value);  // The swap is its own inverse.
+    }
+    std::memcpy(base + offset, &value, sizeof(FieldType));
+}
+
+/// @brief Writes a 48-bit ITCH timestamp at `offset`; bits above 48 are dropped.
+///
+/// @param base Pointer to the start of the writable message frame.
+/// @param offset Byte offset of the timestamp field within the frame.
+/// @param timestamp The timestamp, in nanoseconds past midnight.
+inline auto write_timestamp(std::byte* base, std::size_t offset, std::uint64_t timestamp) noexcept
+    -> void {
+    constexpr int LOWER_SHIFT = 32;
+    write_field(base, offset, static_cast<std::uint16_t>(timestamp >> LOWER_SHIFT));
+    write_field(base, offset + 2, static_cast<std::uint32_t>(timestamp));
+}
+
+/// @brief Writes a fixed-width text field, right padded with spaces and
+///        truncated to `size`.
+///
+/// @param base Pointer to the start of the writable message frame.
+/// @param offset Byte offset of the field within the frame.
+/// @param size Width of the field in bytes.
+/// @param text The text to store.
+inline auto write_text(
+    std::byte* base, std::size_t offset, std::size_t size, std::string_view text
+) noexcept -> void {
+    const std::size_t copied = std::min(text.size(), size);
+    std::memcpy(base + offset, text.data(), copied);
+    std::memset(base + offset + copied, ' ', size - copied);
 }
 
 // Common field offsets shared by every message after the 1-byte type.
@@ -145,186 +198,788 @@ class MessageView {
     std::size_t      m_size {0};
 };
 
-/// @brief Lazy view of an Add Order (`A`) message.
-class AddOrderView : public MessageView {
+/// @brief The base of the per-type views: a `MessageView` that knows the
+///        message struct it overlays.
+///
+/// Field offsets are not written by hand: each accessor takes its field's
+/// `offsetof` in the packed message struct and converts it to the wire offset
+/// at compile time (see `itch::detail::wire_offset`), so the views follow the
+/// same struct definitions as the eager decoder and the wire-size registry.
+///
+/// @tparam MsgType The message struct the view overlays.
+template <typename MsgType>
+class TypedView : public MessageView {
    public:
+    /// @brief The message struct this view overlays.
+    using struct_type = MsgType;
+
+    /// @brief The type byte of the frames this view overlays.
+    static constexpr char TYPE = MsgType {}.message_type;
+
     using MessageView::MessageView;
 
+    /// @brief Decodes the whole frame into its message struct, as `Parser`
+    ///        would.
+    /// @return The fully decoded, host-order message.
+    [[nodiscard]] auto decode() const -> MsgType {
+        const void* raw = m_data;
+        return itch::detail::decode_typed<MsgType>(static_cast<const char*>(raw));
+    }
+
+   protected:
+    /// @brief Reads the integral or character field at `StructOffset`.
+    ///
+    /// @tparam FieldType The type of the field to read.
+    /// @tparam StructOffset The field's `offsetof` in `MsgType`.
+    /// @return The field value, converted from big-endian.
+    template <typename FieldType, std::size_t StructOffset>
+    [[nodiscard]] auto field() const noexcept -> FieldType {
+        return read<FieldType>(itch::detail::wire_offset(StructOffset));
+    }
+
+    /// @brief Views the fixed-width text field at `StructOffset` (untrimmed).
+    ///
+    /// @tparam StructOffset The field's `offsetof` in `MsgType`.
+    /// @tparam Size The width of the field in bytes.
+    /// @return An untrimmed view of the field.
+    template <std::size_t StructOffset, std::size_t Size>
+    [[nodiscard]] auto text() const noexcept -> std::string_view {
+        return detail::read_text(m_data, itch::detail::wire_offset(StructOffset), Size);
+    }
+};
+
+/// @brief Lazy view of a System Event (`S`) message.
+class SystemEventView : public TypedView<SystemEventMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief 'O','S','Q','M','E','C' (see indicators::SYSTEM_EVENT_CODES).
+    /// @return 'O','S','Q','M','E','C' (see indicators::SYSTEM_EVENT_CODES).
+    [[nodiscard]] auto event_code() const noexcept -> char {
+        return field<char, offsetof(struct_type, event_code)>();
+    }
+};
+
+/// @brief Lazy view of a Stock Directory (`R`) message.
+class StockDirectoryView : public TypedView<StockDirectoryMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Stock symbol, right padded with spaces.
+    /// @return Stock symbol, right padded with spaces.
+    [[nodiscard]] auto stock() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, stock), 8>();
+    }
+
+    /// @brief Listing market (see indicators::MARKET_CATEGORY).
+    /// @return Listing market (see indicators::MARKET_CATEGORY).
+    [[nodiscard]] auto market_category() const noexcept -> char {
+        return field<char, offsetof(struct_type, market_category)>();
+    }
+
+    /// @brief Financial status of the issuer.
+    /// @return Financial status of the issuer.
+    [[nodiscard]] auto financial_status_indicator() const noexcept -> char {
+        return field<char, offsetof(struct_type, financial_status_indicator)>();
+    }
+
+    /// @brief Number of shares in a round lot.
+    /// @return Number of shares in a round lot.
+    [[nodiscard]] auto round_lot_size() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, round_lot_size)>();
+    }
+
+    /// @brief 'Y' if only round lots may be entered, else 'N'.
+    /// @return 'Y' if only round lots may be entered, else 'N'.
+    [[nodiscard]] auto round_lots_only() const noexcept -> char {
+        return field<char, offsetof(struct_type, round_lots_only)>();
+    }
+
+    /// @brief Security class (see indicators::ISSUE_CLASSIFICATION_VALUES).
+    /// @return Security class (see indicators::ISSUE_CLASSIFICATION_VALUES).
+    [[nodiscard]] auto issue_classification() const noexcept -> char {
+        return field<char, offsetof(struct_type, issue_classification)>();
+    }
+
+    /// @brief Security sub-type (see indicators::ISSUE_SUB_TYPE_VALUES).
+    /// @return Security sub-type (see indicators::ISSUE_SUB_TYPE_VALUES).
+    [[nodiscard]] auto issue_sub_type() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, issue_sub_type), 2>();
+    }
+
+    /// @brief 'P' production / 'T' test security.
+    /// @return 'P' production / 'T' test security.
+    [[nodiscard]] auto authenticity() const noexcept -> char {
+        return field<char, offsetof(struct_type, authenticity)>();
+    }
+
+    /// @brief Reg SHO threshold: 'Y','N',' '.
+    /// @return Reg SHO threshold: 'Y','N',' '.
+    [[nodiscard]] auto short_sale_threshold_indicator() const noexcept -> char {
+        return field<char, offsetof(struct_type, short_sale_threshold_indicator)>();
+    }
+
+    /// @brief 'Y' if a new IPO, 'N' if not, ' ' if not available.
+    /// @return 'Y' if a new IPO, 'N' if not, ' ' if not available.
+    [[nodiscard]] auto ipo_flag() const noexcept -> char {
+        return field<char, offsetof(struct_type, ipo_flag)>();
+    }
+
+    /// @brief LULD reference price tier.
+    /// @return LULD reference price tier.
+    [[nodiscard]] auto luld_ref() const noexcept -> char {
+        return field<char, offsetof(struct_type, luld_ref)>();
+    }
+
+    /// @brief 'Y' if an exchange-traded product, else 'N'.
+    /// @return 'Y' if an exchange-traded product, else 'N'.
+    [[nodiscard]] auto etp_flag() const noexcept -> char {
+        return field<char, offsetof(struct_type, etp_flag)>();
+    }
+
+    /// @brief Leverage factor of the ETP (if applicable).
+    /// @return Leverage factor of the ETP (if applicable).
+    [[nodiscard]] auto etp_leverage_factor() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, etp_leverage_factor)>();
+    }
+
+    /// @brief 'Y' if the ETP is an inverse product.
+    /// @return 'Y' if the ETP is an inverse product.
+    [[nodiscard]] auto inverse_indicator() const noexcept -> char {
+        return field<char, offsetof(struct_type, inverse_indicator)>();
+    }
+};
+
+/// @brief Lazy view of a Stock Trading Action (`H`) message.
+class StockTradingActionView : public TypedView<StockTradingActionMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Stock symbol, right padded with spaces.
+    /// @return Stock symbol, right padded with spaces.
+    [[nodiscard]] auto stock() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, stock), 8>();
+    }
+
+    /// @brief 'H','P','Q','T' (see indicators::TRADING_STATES).
+    /// @return 'H','P','Q','T' (see indicators::TRADING_STATES).
+    [[nodiscard]] auto trading_state() const noexcept -> char {
+        return field<char, offsetof(struct_type, trading_state)>();
+    }
+
+    /// @brief Reserved.
+    /// @return Reserved.
+    [[nodiscard]] auto reserved() const noexcept -> char {
+        return field<char, offsetof(struct_type, reserved)>();
+    }
+
+    /// @brief Trading-action reason code (see indicators::TRADING_ACTION_REASON_CODES).
+    /// @return Trading-action reason code (see indicators::TRADING_ACTION_REASON_CODES).
+    [[nodiscard]] auto reason() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, reason), 4>();
+    }
+};
+
+/// @brief Lazy view of a Reg SHO Short Sale Price Test Restriction (`Y`) message.
+class RegSHOView : public TypedView<RegSHOMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Stock symbol, right padded with spaces.
+    /// @return Stock symbol, right padded with spaces.
+    [[nodiscard]] auto stock() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, stock), 8>();
+    }
+
+    /// @brief '0' no restriction, '1' restriction in effect, '2' remains.
+    /// @return '0' no restriction, '1' restriction in effect, '2' remains.
+    [[nodiscard]] auto reg_sho_action() const noexcept -> char {
+        return field<char, offsetof(struct_type, reg_sho_action)>();
+    }
+};
+
+/// @brief Lazy view of a Market Participant Position (`L`) message.
+class MarketParticipantPositionView : public TypedView<MarketParticipantPositionMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Market participant identifier.
+    /// @return Market participant identifier.
+    [[nodiscard]] auto mpid() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, mpid), 4>();
+    }
+
+    /// @brief Stock symbol, right padded with spaces.
+    /// @return Stock symbol, right padded with spaces.
+    [[nodiscard]] auto stock() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, stock), 8>();
+    }
+
+    /// @brief 'Y' if the primary market maker, else 'N'.
+    /// @return 'Y' if the primary market maker, else 'N'.
+    [[nodiscard]] auto primary_market_maker() const noexcept -> char {
+        return field<char, offsetof(struct_type, primary_market_maker)>();
+    }
+
+    /// @brief Quotation mode (see indicators::MARKET_MAKER_MODE).
+    /// @return Quotation mode (see indicators::MARKET_MAKER_MODE).
+    [[nodiscard]] auto market_maker_mode() const noexcept -> char {
+        return field<char, offsetof(struct_type, market_maker_mode)>();
+    }
+
+    /// @brief State (see indicators::MARKET_PARTICIPANT_STATE).
+    /// @return State (see indicators::MARKET_PARTICIPANT_STATE).
+    [[nodiscard]] auto market_participant_state() const noexcept -> char {
+        return field<char, offsetof(struct_type, market_participant_state)>();
+    }
+};
+
+/// @brief Lazy view of an MWCB Decline Level (`V`) message.
+class MWCBDeclineLevelView : public TypedView<MWCBDeclineLevelMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Level 1 (5%) breach value, 8 implied decimals.
+    /// @return Level 1 (5%) breach value, 8 implied decimals.
+    [[nodiscard]] auto level1() const noexcept -> std::uint64_t {
+        return field<std::uint64_t, offsetof(struct_type, level1)>();
+    }
+
+    /// @brief Level 2 (13%) breach value, 8 implied decimals.
+    /// @return Level 2 (13%) breach value, 8 implied decimals.
+    [[nodiscard]] auto level2() const noexcept -> std::uint64_t {
+        return field<std::uint64_t, offsetof(struct_type, level2)>();
+    }
+
+    /// @brief Level 3 (20%) breach value, 8 implied decimals.
+    /// @return Level 3 (20%) breach value, 8 implied decimals.
+    [[nodiscard]] auto level3() const noexcept -> std::uint64_t {
+        return field<std::uint64_t, offsetof(struct_type, level3)>();
+    }
+};
+
+/// @brief Lazy view of an MWCB Status (`W`) message.
+class MWCBStatusView : public TypedView<MWCBStatusMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief '1', '2', or '3' for the level breached.
+    /// @return '1', '2', or '3' for the level breached.
+    [[nodiscard]] auto breached_level() const noexcept -> char {
+        return field<char, offsetof(struct_type, breached_level)>();
+    }
+};
+
+/// @brief Lazy view of an IPO Quoting Period Update (`K`) message.
+class IPOQuotingPeriodUpdateView : public TypedView<IPOQuotingPeriodUpdateMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Stock symbol, right padded with spaces.
+    /// @return Stock symbol, right padded with spaces.
+    [[nodiscard]] auto stock() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, stock), 8>();
+    }
+
+    /// @brief Seconds past midnight of the anticipated release.
+    /// @return Seconds past midnight of the anticipated release.
+    [[nodiscard]] auto ipo_quotation_release_time() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, ipo_quotation_release_time)>();
+    }
+
+    /// @brief 'A' anticipated, 'C' cancelled/postponed.
+    /// @return 'A' anticipated, 'C' cancelled/postponed.
+    [[nodiscard]] auto ipo_quotation_release_qualifier() const noexcept -> char {
+        return field<char, offsetof(struct_type, ipo_quotation_release_qualifier)>();
+    }
+
+    /// @brief IPO price (4 implied decimals).
+    /// @return IPO price (4 implied decimals).
+    [[nodiscard]] auto ipo_price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, ipo_price)>();
+    }
+};
+
+/// @brief Lazy view of a LULD Auction Collar (`J`) message.
+class LULDAuctionCollarView : public TypedView<LULDAuctionCollarMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Stock symbol, right padded with spaces.
+    /// @return Stock symbol, right padded with spaces.
+    [[nodiscard]] auto stock() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, stock), 8>();
+    }
+
+    /// @brief Reference price for the collars (4 decimals).
+    /// @return Reference price for the collars (4 decimals).
+    [[nodiscard]] auto auction_collar_reference_price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, auction_collar_reference_price)>();
+    }
+
+    /// @brief Upper auction collar price (4 decimals).
+    /// @return Upper auction collar price (4 decimals).
+    [[nodiscard]] auto upper_auction_collar_price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, upper_auction_collar_price)>();
+    }
+
+    /// @brief Lower auction collar price (4 decimals).
+    /// @return Lower auction collar price (4 decimals).
+    [[nodiscard]] auto lower_auction_collar_price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, lower_auction_collar_price)>();
+    }
+
+    /// @brief Number of collar extensions so far.
+    /// @return Number of collar extensions so far.
+    [[nodiscard]] auto auction_collar_extension() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, auction_collar_extension)>();
+    }
+};
+
+/// @brief Lazy view of an Operational Halt (`h`) message.
+class OperationalHaltView : public TypedView<OperationalHaltMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Stock symbol, right padded with spaces.
+    /// @return Stock symbol, right padded with spaces.
+    [[nodiscard]] auto stock() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, stock), 8>();
+    }
+
+    /// @brief 'Q' Nasdaq, 'B' BX, 'X' PSX.
+    /// @return 'Q' Nasdaq, 'B' BX, 'X' PSX.
+    [[nodiscard]] auto market_code() const noexcept -> char {
+        return field<char, offsetof(struct_type, market_code)>();
+    }
+
+    /// @brief 'H' halted, 'T' resumed.
+    /// @return 'H' halted, 'T' resumed.
+    [[nodiscard]] auto operational_halt_action() const noexcept -> char {
+        return field<char, offsetof(struct_type, operational_halt_action)>();
+    }
+};
+
+/// @brief Lazy view of an Add Order (`A`) message.
+class AddOrderView : public TypedView<AddOrderMessage> {
+   public:
+    using TypedView::TypedView;
+
     /// @brief Day-unique reference number for the order.
     /// @return Day-unique reference number for the order.
     [[nodiscard]] auto order_reference_number() const noexcept -> std::uint64_t {
-        return read<std::uint64_t>(11);
+        return field<std::uint64_t, offsetof(struct_type, order_reference_number)>();
     }
 
     /// @brief 'B' buy, 'S' sell.
     /// @return 'B' buy, 'S' sell.
-    [[nodiscard]] auto buy_sell_indicator() const noexcept -> char { return read<char>(19); }
+    [[nodiscard]] auto buy_sell_indicator() const noexcept -> char {
+        return field<char, offsetof(struct_type, buy_sell_indicator)>();
+    }
 
     /// @brief Displayed share quantity.
     /// @return Displayed share quantity.
-    [[nodiscard]] auto shares() const noexcept -> std::uint32_t { return read<std::uint32_t>(20); }
+    [[nodiscard]] auto shares() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, shares)>();
+    }
 
     /// @brief Stock symbol, right padded with spaces.
     /// @return Stock symbol, right padded with spaces.
     [[nodiscard]] auto stock() const noexcept -> std::string_view {
-        return detail::read_stock(m_data, 24);
+        return text<offsetof(struct_type, stock), 8>();
     }
 
     /// @brief Display price (4 implied decimals).
     /// @return Display price (4 implied decimals).
-    [[nodiscard]] auto price() const noexcept -> std::uint32_t { return read<std::uint32_t>(32); }
+    [[nodiscard]] auto price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, price)>();
+    }
+};
+
+/// @brief Lazy view of an Add Order With MPID Attribution (`F`) message.
+class AddOrderMPIDAttributionView : public TypedView<AddOrderMPIDAttributionMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Day-unique reference number for the order.
+    /// @return Day-unique reference number for the order.
+    [[nodiscard]] auto order_reference_number() const noexcept -> std::uint64_t {
+        return field<std::uint64_t, offsetof(struct_type, order_reference_number)>();
+    }
+
+    /// @brief 'B' buy, 'S' sell.
+    /// @return 'B' buy, 'S' sell.
+    [[nodiscard]] auto buy_sell_indicator() const noexcept -> char {
+        return field<char, offsetof(struct_type, buy_sell_indicator)>();
+    }
+
+    /// @brief Displayed share quantity.
+    /// @return Displayed share quantity.
+    [[nodiscard]] auto shares() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, shares)>();
+    }
+
+    /// @brief Stock symbol, right padded with spaces.
+    /// @return Stock symbol, right padded with spaces.
+    [[nodiscard]] auto stock() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, stock), 8>();
+    }
+
+    /// @brief Display price (4 implied decimals).
+    /// @return Display price (4 implied decimals).
+    [[nodiscard]] auto price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, price)>();
+    }
+
+    /// @brief Market participant identifier (MPID).
+    /// @return Market participant identifier (MPID).
+    [[nodiscard]] auto attribution() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, attribution), 4>();
+    }
 };
 
 /// @brief Lazy view of an Order Executed (`E`) message.
-class OrderExecutedView : public MessageView {
+class OrderExecutedView : public TypedView<OrderExecutedMessage> {
    public:
-    using MessageView::MessageView;
+    using TypedView::TypedView;
 
     /// @brief Reference number of the executed order.
     /// @return Reference number of the executed order.
     [[nodiscard]] auto order_reference_number() const noexcept -> std::uint64_t {
-        return read<std::uint64_t>(11);
+        return field<std::uint64_t, offsetof(struct_type, order_reference_number)>();
     }
 
     /// @brief Number of shares executed.
     /// @return Number of shares executed.
     [[nodiscard]] auto executed_shares() const noexcept -> std::uint32_t {
-        return read<std::uint32_t>(19);
+        return field<std::uint32_t, offsetof(struct_type, executed_shares)>();
     }
 
     /// @brief Day-unique match number for the execution.
     /// @return Day-unique match number for the execution.
     [[nodiscard]] auto match_number() const noexcept -> std::uint64_t {
-        return read<std::uint64_t>(23);
+        return field<std::uint64_t, offsetof(struct_type, match_number)>();
     }
 };
 
 /// @brief Lazy view of an Order Executed With Price (`C`) message.
-class OrderExecutedWithPriceView : public MessageView {
+class OrderExecutedWithPriceView : public TypedView<OrderExecutedWithPriceMessage> {
    public:
-    using MessageView::MessageView;
+    using TypedView::TypedView;
 
     /// @brief Reference number of the executed order.
     /// @return Reference number of the executed order.
     [[nodiscard]] auto order_reference_number() const noexcept -> std::uint64_t {
-        return read<std::uint64_t>(11);
+        return field<std::uint64_t, offsetof(struct_type, order_reference_number)>();
     }
 
     /// @brief Number of shares executed.
     /// @return Number of shares executed.
     [[nodiscard]] auto executed_shares() const noexcept -> std::uint32_t {
-        return read<std::uint32_t>(19);
+        return field<std::uint32_t, offsetof(struct_type, executed_shares)>();
     }
 
     /// @brief Day-unique match number for the execution.
     /// @return Day-unique match number for the execution.
     [[nodiscard]] auto match_number() const noexcept -> std::uint64_t {
-        return read<std::uint64_t>(23);
+        return field<std::uint64_t, offsetof(struct_type, match_number)>();
     }
 
     /// @brief 'Y' if the trade is printable to the tape, else 'N'.
     /// @return 'Y' if the trade is printable to the tape, else 'N'.
-    [[nodiscard]] auto printable() const noexcept -> char { return read<char>(31); }
+    [[nodiscard]] auto printable() const noexcept -> char {
+        return field<char, offsetof(struct_type, printable)>();
+    }
 
     /// @brief Price at which the order executed (4 decimals).
     /// @return Price at which the order executed (4 decimals).
     [[nodiscard]] auto execution_price() const noexcept -> std::uint32_t {
-        return read<std::uint32_t>(32);
+        return field<std::uint32_t, offsetof(struct_type, execution_price)>();
     }
 };
 
 /// @brief Lazy view of an Order Cancel (`X`) message.
-class OrderCancelView : public MessageView {
+class OrderCancelView : public TypedView<OrderCancelMessage> {
    public:
-    using MessageView::MessageView;
+    using TypedView::TypedView;
 
     /// @brief Reference number of the cancelled order.
     /// @return Reference number of the cancelled order.
     [[nodiscard]] auto order_reference_number() const noexcept -> std::uint64_t {
-        return read<std::uint64_t>(11);
+        return field<std::uint64_t, offsetof(struct_type, order_reference_number)>();
     }
 
     /// @brief Number of shares cancelled.
     /// @return Number of shares cancelled.
     [[nodiscard]] auto cancelled_shares() const noexcept -> std::uint32_t {
-        return read<std::uint32_t>(19);
+        return field<std::uint32_t, offsetof(struct_type, cancelled_shares)>();
     }
 };
 
 /// @brief Lazy view of an Order Delete (`D`) message.
-class OrderDeleteView : public MessageView {
+class OrderDeleteView : public TypedView<OrderDeleteMessage> {
    public:
-    using MessageView::MessageView;
+    using TypedView::TypedView;
 
     /// @brief Reference number of the deleted order.
     /// @return Reference number of the deleted order.
     [[nodiscard]] auto order_reference_number() const noexcept -> std::uint64_t {
-        return read<std::uint64_t>(11);
+        return field<std::uint64_t, offsetof(struct_type, order_reference_number)>();
     }
 };
 
 /// @brief Lazy view of an Order Replace (`U`) message.
-class OrderReplaceView : public MessageView {
+class OrderReplaceView : public TypedView<OrderReplaceMessage> {
    public:
-    using MessageView::MessageView;
+    using TypedView::TypedView;
 
     /// @brief Reference number being replaced.
     /// @return Reference number being replaced.
     [[nodiscard]] auto original_order_reference_number() const noexcept -> std::uint64_t {
-        return read<std::uint64_t>(11);
+        return field<std::uint64_t, offsetof(struct_type, original_order_reference_number)>();
     }
 
     /// @brief New reference number for the order.
     /// @return New reference number for the order.
     [[nodiscard]] auto new_order_reference_number() const noexcept -> std::uint64_t {
-        return read<std::uint64_t>(19);
+        return field<std::uint64_t, offsetof(struct_type, new_order_reference_number)>();
     }
 
     /// @brief New displayed share quantity.
     /// @return New displayed share quantity.
-    [[nodiscard]] auto shares() const noexcept -> std::uint32_t { return read<std::uint32_t>(27); }
+    [[nodiscard]] auto shares() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, shares)>();
+    }
 
     /// @brief New display price (4 implied decimals).
     /// @return New display price (4 implied decimals).
-    [[nodiscard]] auto price() const noexcept -> std::uint32_t { return read<std::uint32_t>(31); }
+    [[nodiscard]] auto price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, price)>();
+    }
 };
 
 /// @brief Lazy view of a Trade (`P`, non-cross) message.
-class NonCrossTradeView : public MessageView {
+class NonCrossTradeView : public TypedView<NonCrossTradeMessage> {
    public:
-    using MessageView::MessageView;
+    using TypedView::TypedView;
 
     /// @brief Reference number of the non-displayed order.
     /// @return Reference number of the non-displayed order.
     [[nodiscard]] auto order_reference_number() const noexcept -> std::uint64_t {
-        return read<std::uint64_t>(11);
+        return field<std::uint64_t, offsetof(struct_type, order_reference_number)>();
     }
 
     /// @brief 'B' buy, 'S' sell.
     /// @return 'B' buy, 'S' sell.
-    [[nodiscard]] auto buy_sell_indicator() const noexcept -> char { return read<char>(19); }
+    [[nodiscard]] auto buy_sell_indicator() const noexcept -> char {
+        return field<char, offsetof(struct_type, buy_sell_indicator)>();
+    }
 
     /// @brief Number of shares traded.
     /// @return Number of shares traded.
-    [[nodiscard]] auto shares() const noexcept -> std::uint32_t { return read<std::uint32_t>(20); }
+    [[nodiscard]] auto shares() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, shares)>();
+    }
 
     /// @brief Stock symbol, right padded with spaces.
     /// @return Stock symbol, right padded with spaces.
     [[nodiscard]] auto stock() const noexcept -> std::string_view {
-        return detail::read_stock(m_data, 24);
+        return text<offsetof(struct_type, stock), 8>();
     }
 
     /// @brief Trade price (4 implied decimals).
     /// @return Trade price (4 implied decimals).
-    [[nodiscard]] auto price() const noexcept -> std::uint32_t { return read<std::uint32_t>(32); }
+    [[nodiscard]] auto price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, price)>();
+    }
 
     /// @brief Day-unique match number for the trade.
     /// @return Day-unique match number for the trade.
     [[nodiscard]] auto match_number() const noexcept -> std::uint64_t {
-        return read<std::uint64_t>(36);
+        return field<std::uint64_t, offsetof(struct_type, match_number)>();
+    }
+};
+
+/// @brief Lazy view of a Cross Trade (`Q`) message.
+class CrossTradeView : public TypedView<CrossTradeMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Number of shares matched in the cross.
+    /// @return Number of shares matched in the cross.
+    [[nodiscard]] auto shares() const noexcept -> std::uint64_t {
+        return field<std::uint64_t, offsetof(struct_type, shares)>();
+    }
+
+    /// @brief Stock symbol, right padded with spaces.
+    /// @return Stock symbol, right padded with spaces.
+    [[nodiscard]] auto stock() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, stock), 8>();
+    }
+
+    /// @brief Price at which the cross executed (4 decimals).
+    /// @return Price at which the cross executed (4 decimals).
+    [[nodiscard]] auto cross_price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, cross_price)>();
+    }
+
+    /// @brief Day-unique match number for the cross.
+    /// @return Day-unique match number for the cross.
+    [[nodiscard]] auto match_number() const noexcept -> std::uint64_t {
+        return field<std::uint64_t, offsetof(struct_type, match_number)>();
+    }
+
+    /// @brief 'O' open, 'C' close, 'H' halt/IPO, 'I' intraday.
+    /// @return 'O' open, 'C' close, 'H' halt/IPO, 'I' intraday.
+    [[nodiscard]] auto cross_type() const noexcept -> char {
+        return field<char, offsetof(struct_type, cross_type)>();
+    }
+};
+
+/// @brief Lazy view of a Broken Trade (`B`) message.
+class BrokenTradeView : public TypedView<BrokenTradeMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Match number of the execution being broken.
+    /// @return Match number of the execution being broken.
+    [[nodiscard]] auto match_number() const noexcept -> std::uint64_t {
+        return field<std::uint64_t, offsetof(struct_type, match_number)>();
     }
 };
 
+/// @brief Lazy view of a Net Order Imbalance Indicator (`I`) message.
+class NOIIView : public TypedView<NOIIMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Shares paired at the current reference price.
+    /// @return Shares paired at the current reference price.
+    [[nodiscard]] auto paired_shares() const noexcept -> std::uint64_t {
+        return field<std::uint64_t, offsetof(struct_type, paired_shares)>();
+    }
+
+    /// @brief Shares not paired (the imbalance).
+    /// @return Shares not paired (the imbalance).
+    [[nodiscard]] auto imbalance_shares() const noexcept -> std::uint64_t {
+        return field<std::uint64_t, offsetof(struct_type, imbalance_shares)>();
+    }
+
+    /// @brief 'B' buy, 'S' sell, 'N' none, 'O' insufficient, 'P' paused.
+    /// @return 'B' buy, 'S' sell, 'N' none, 'O' insufficient, 'P' paused.
+    [[nodiscard]] auto imbalance_direction() const noexcept -> char {
+        return field<char, offsetof(struct_type, imbalance_direction)>();
+    }
+
+    /// @brief Stock symbol, right padded with spaces.
+    /// @return Stock symbol, right padded with spaces.
+    [[nodiscard]] auto stock() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, stock), 8>();
+    }
+
+    /// @brief Cross price using only eligible interest (4 decimals).
+    /// @return Cross price using only eligible interest (4 decimals).
+    [[nodiscard]] auto far_price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, far_price)>();
+    }
+
+    /// @brief Cross price using all interest (4 decimals).
+    /// @return Cross price using all interest (4 decimals).
+    [[nodiscard]] auto near_price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, near_price)>();
+    }
+
+    /// @brief Price the cross would occur at now (4 decimals).
+    /// @return Price the cross would occur at now (4 decimals).
+    [[nodiscard]] auto current_reference_price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, current_reference_price)>();
+    }
+
+    /// @brief 'O' open, 'C' close, 'H' halt/IPO cross.
+    /// @return 'O' open, 'C' close, 'H' halt/IPO cross.
+    [[nodiscard]] auto cross_type() const noexcept -> char {
+        return field<char, offsetof(struct_type, cross_type)>();
+    }
+
+    /// @brief Variation band (see indicators::PRICE_VARIATION_INDICATOR).
+    /// @return Variation band (see indicators::PRICE_VARIATION_INDICATOR).
+    [[nodiscard]] auto price_variation_indicator() const noexcept -> char {
+        return field<char, offsetof(struct_type, price_variation_indicator)>();
+    }
+};
+
+/// @brief Lazy view of a Retail Price Improvement Indicator (`N`) message.
+class RetailPriceImprovementIndicatorView
+    : public TypedView<RetailPriceImprovementIndicatorMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Stock symbol, right padded with spaces.
+    /// @return Stock symbol, right padded with spaces.
+    [[nodiscard]] auto stock() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, stock), 8>();
+    }
+
+    /// @brief 'B' bid, 'A' ask, 'C' both, 'N' none.
+    /// @return 'B' bid, 'A' ask, 'C' both, 'N' none.
+    [[nodiscard]] auto interest_flag() const noexcept -> char {
+        return field<char, offsetof(struct_type, interest_flag)>();
+    }
+};
+
+/// @brief Lazy view of a Direct Listing with Capital Raise Price Discovery (`O`) message.
+class DLCRView : public TypedView<DLCRMessage> {
+   public:
+    using TypedView::TypedView;
+
+    /// @brief Stock symbol, right padded with spaces.
+    /// @return Stock symbol, right padded with spaces.
+    [[nodiscard]] auto stock() const noexcept -> std::string_view {
+        return text<offsetof(struct_type, stock), 8>();
+    }
+
+    /// @brief Whether the security is eligible to open.
+    /// @return Whether the security is eligible to open.
+    [[nodiscard]] auto open_eligibility_status() const noexcept -> char {
+        return field<char, offsetof(struct_type, open_eligibility_status)>();
+    }
+
+    /// @brief Lowest allowable cross price (4 decimals).
+    /// @return Lowest allowable cross price (4 decimals).
+    [[nodiscard]] auto minimum_allowable_price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, minimum_allowable_price)>();
+    }
+
+    /// @brief Highest allowable cross price (4 decimals).
+    /// @return Highest allowable cross price (4 decimals).
+    [[nodiscard]] auto maximum_allowable_price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, maximum_allowable_price)>();
+    }
+
+    /// @brief Anticipated cross price (4 decimals).
+    /// @return Anticipated cross price (4 decimals).
+    [[nodiscard]] auto near_execution_price() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, near_execution_price)>();
+    }
+
+    /// @brief Time of the anticipated cross (ns past midnight).
+    /// @return Time of the anticipated cross (ns past midnight).
+    [[nodiscard]] auto near_execution_time() const noexcept -> std::uint64_t {
+        return field<std::uint64_t, offsetof(struct_type, near_execution_time)>();
+    }
+
+    /// @brief Lower price range collar (4 decimals).
+    /// @return Lower price range collar (4 decimals).
+    [[nodiscard]] auto lower_price_range_collar() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, lower_price_range_collar)>();
+    }
+
+    /// @brief Upper price range collar (4 decimals).
+    /// @return Upper price range collar (4 decimals).
+    [[nodiscard]] auto upper_price_range_collar() const noexcept -> std::uint32_t {
+        return field<std::uint32_t, offsetof(struct_type, upper_price_range_collar)>();
+    }
+};
 /// @brief The signature for the overlay framing callback.
 using ViewCallback = std::function<void(const MessageView&)>;
 
@@ -334,29 +989,25 @@ using ViewCallback = std::function<void(const MessageView&)>;
 /// @return An array indexed by message-type byte, holding the expected wire size
 ///         for each known message type (zero for unknown types).
 [[nodiscard]] consteval auto build_size_table() -> std::array<std::uint16_t, 256> {
-    std::array<std::uint16_t, 256> table {};
-    auto                           add = [&table]<typename MsgType>(char type) {
-        table[static_cast<unsigned char>(type)] =
-            static_cast<std::uint16_t>(itch::detail::WIRE_SIZE<MsgType>);
-    };
-    itch::detail::for_each_message_type(add);
-    return table;
+    return itch::detail::build_wire_size_table();
 }
 
 inline constexpr auto SIZE_TABLE = build_size_table();
 
-/// @brief Frames a buffer and invokes `callback` with a zero-copy `MessageView`
-///        for each well-formed message.
-///
-/// Framing and length validation match `Parser`: the 2-byte length prefix is
-/// honoured, unknown type bytes and undersized frames are skipped. Unlike the
-/// eager parser, no fields are decoded; the callback receives a view it can
-/// inspect lazily.
+namespace detail {
+
+/// @brief The overlay framing loop: frames a buffer and hands each well-formed
+///        frame that `admit` accepts to `on_frame`.
 ///
+/// @tparam Admit Callable invocable as `admit(const std::byte*)` returning bool.
+/// @tparam OnFrame Callable invocable as `on_frame(const std::byte*, std::uint16_t)`
+///         returning whether the frame was delivered.
 /// @param data The raw buffer containing one or more length-prefixed ITCH frames.
-/// @param callback Invoked with a `MessageView` for each well-formed frame found.
-/// @return The number of views delivered to `callback`.
-inline auto for_each_message(std::span<const std::byte> data, const ViewCallback& callback)
+/// @param admit Predicate over each well-formed frame, before any view is made.
+/// @param on_frame Invoked with the type byte and length of each admitted frame.
+/// @return The number of frames `on_frame` reported as delivered.
+template <typename Admit, typename OnFrame>
+inline auto for_each_frame(std::span<const std::byte> data, Admit&& admit, OnFrame&& on_frame)
     -> std::uint64_t {
     std::uint64_t delivered = 0;
     std::size_t   offset    = 0;
@@ -379,10 +1030,381 @@ inline auto for_each_message(std::span<const std::byte> data, const ViewCallback
         if (expected == 0 || length < expected) {
             continue;  // Unknown type or undersized frame.
         }
-        callback(MessageView {frame, length});
-        ++delivered;
+        if (!admit(frame)) {
+            continue;
+        }
+        if (on_frame(frame, length)) {
+            ++delivered;
+        }
     }
     return delivered;
 }
 
+/// @brief A compile-time list of view types.
+template <typename... Views>
+struct ViewList {};
+
+/// @brief Finds the view in `List` whose `struct_type` is `MsgType` (void if
+///        there is none).
+template <typename MsgType, typename List>
+struct FindView;
+
+template <typename MsgType>
+struct FindView<MsgType, ViewList<>> {
+    using type = void;
+};
+
+template <typename MsgType, typename View, typename... Views>
+struct FindView<MsgType, ViewList<View, Views...>> {
+    using type = std::conditional_t<
+        std::is_same_v<typename View::struct_type, MsgType>,
+        View,
+        typename FindView<MsgType, ViewList<Views...>>::type>;
+};
+
+/// @brief Every view, order-flow types first, in roughly the order of their
+///        frequency on a Nasdaq day feed; `visit` tests the type byte in this
+///        order.
+using ALL_VIEWS = ViewList<
+    AddOrderView,
+    OrderDeleteView,
+    OrderReplaceView,
+    OrderExecutedView,
+    OrderCancelView,
+    AddOrderMPIDAttributionView,
+    NonCrossTradeView,
+    OrderExecutedWithPriceView,
+    NOIIView,
+    CrossTradeView,
+    SystemEventView,
+    StockDirectoryView,
+    StockTradingActionView,
+    RegSHOView,
+    MarketParticipantPositionView,
+    MWCBDeclineLevelView,
+    MWCBStatusView,
+    IPOQuotingPeriodUpdateView,
+    LULDAuctionCollarView,
+    OperationalHaltView,
+    BrokenTradeView,
+    RetailPriceImprovementIndicatorView,
+    DLCRView>;
+
+}  // namespace detail
+
+/// @brief The view type that overlays frames of the message struct `MsgType`,
+///        e.g. `ViewFor<AddOrderMessage>` is `AddOrderView`.
+template <typename MsgType>
+using ViewFor = typename detail::FindView<MsgType, detail::ALL_VIEWS>::type;
+
+// Every message type in the registry must have a view, so that `visit` covers
+// the whole message set.
+static_assert([] {
+    bool complete = true;
+    itch::detail::for_each_message_type([&complete]<typename MsgType>(char type) {
+        complete = complete && !std::is_void_v<ViewFor<MsgType>> && ViewFor<MsgType>::TYPE == type;
+    });
+    return complete;
+}());
+
+/// @brief A writable view over one raw ITCH frame: the accessors of `View`,
+///        plus setters that store big-endian fields straight into the frame.
+///
+/// The setters change the bytes in place, so a feed can be rewritten (for
+/// example to re-sequence tracking numbers or anonymize MPIDs) without
+/// decoding and re-encoding each message. Like every view, it is non-owning
+/// and valid only while the underlying buffer lives.
+///
+/// @tparam View `MessageView` or one of the per-type views.
+template <typename View = MessageView>
+class MutableView : public View {
+   public:
+    /// @brief Constructs a writable view over a raw ITCH message frame.
+    ///
+    /// @param data Pointer to the start of the writable frame (the type byte).
+    /// @param size Size of the frame in bytes.
+    explicit MutableView(std::byte* data, std::size_t size) noexcept
+        : View {data, size}, m_bytes {data} {}
+
+    /// @brief Sets the locate code identifying the security.
+    /// @param stock_locate The new locate code.
+    auto set_stock_locate(std::uint16_t stock_locate) noexcept -> void {
+        write(detail::STOCK_LOCATE_OFFSET, stock_locate);
+    }
+
+    /// @brief Sets the Nasdaq internal tracking number.
+    /// @param tracking_number The new tracking number.
+    auto set_tracking_number(std::uint16_t tracking_number) noexcept -> void {
+        write(detail::TRACKING_NUMBER_OFFSET, tracking_number);
+    }
+
+    /// @brief Sets the message timestamp; bits above 48 are dropped.
+    /// @param timestamp The new timestamp (nanoseconds past midnight).
+    auto set_timestamp(std::uint64_t timestamp) noexcept -> void {
+        detail::write_timestamp(m_bytes, detail::TIMESTAMP_OFFSET, timestamp);
+    }
+
+    /// @brief Sets the stock symbol, right padded with spaces.
+    /// @param stock The new symbol; characters past the 8th are dropped.
+    auto set_stock(std::string_view stock) noexcept -> void
+        requires requires { View::struct_type::stock; }
+    {
+        using Msg = typename View::struct_type;
+        write_text(itch::detail::wire_offset(offsetof(Msg, stock)), sizeof(Msg::stock), stock);
+    }
+
+    /// @brief Sets the MPID of an attributed Add Order (`F`).
+    /// @param attribution The new MPID, right padded with spaces.
+    auto set_attribution(std::string_view attribution) noexcept -> void
+        requires requires { View::struct_type::attribution; }
+    {
+        using Msg = typename View::struct_type;
+        write_text(
+            itch::detail::wire_offset(offsetof(Msg, attribution)),
+            sizeof(Msg::attribution),
+            attribution
+        );
+    }
+
+    /// @brief Sets the MPID of a Market Participant Position (`L`).
+    /// @param mpid The new MPID, right padded with spaces.
+    auto set_mpid(std::string_view mpid) noexcept -> void
+        requires requires { View::struct_type::mpid; }
+    {
+        using Msg = typename View::struct_type;
+        write_text(itch::detail::wire_offset(offsetof(Msg, mpid)), sizeof(Msg::mpid), mpid);
+    }
+
+    /// @brief Writes an arbitrary integral field at a byte offset, big-endian;
+    ///        the counterpart of `MessageView::read`.
+    ///
+    /// @tparam FieldType The type of the field to write.
+    /// @param offset Byte offset of the field within the frame.
+    /// @param value The host-order value to store.
+    template <typename FieldType>
+    auto write(std::size_t offset, FieldType value) noexcept -> void {
+        detail::write_field(m_bytes, offset, value);
+    }
+
+    /// @brief Writes a fixed-width text field at a byte offset, right padded
+    ///        with spaces.
+    ///
+    /// @param offset Byte offset of the field within the frame.
+    /// @param size Width of the field in bytes.
+    /// @param text The text to store; characters past `size` are dropped.
+    auto write_text(std::size_t offset, std::size_t size, std::string_view text) noexcept
+        -> void {
+        detail::write_text(m_bytes, offset, size, text);
+    }
+
+    /// @brief Pointer to the writable frame (the type byte).
+    /// @return Pointer to the writable frame (the type byte).
+    [[nodiscard]] auto mutable_data() const noexcept -> std::byte* { return m_bytes; }
+
+   private:
+    std::byte* m_bytes {nullptr};
+};
+
+namespace detail {
+
+/// @brief The view `dispatch_view` builds for a frame of `View`'s type: `View`
+///        itself over a read-only frame; over a writable one, `MutableView<View>`
+///        or, for handlers that only take `MutableView<>&`, `MutableView<>`.
+template <typename View, typename Byte, typename Handler>
+using DeliveredView = std::conditional_t<
+    std::is_const_v<Byte>,
+    const View,
+    std::conditional_t<
+        std::is_invocable_v<Handler&, MutableView<View>&>,
+        MutableView<View>,
+        MutableView<>>>;
+
+/// @brief Hands the frame to `handler` as its `DeliveredView` if it is of
+///        `View`'s type and the handler accepts that view.
+///
+/// @return Whether the frame was delivered.
+template <typename View, typename Byte, typename Handler>
+inline auto deliver_as(char type, Byte* frame, std::uint16_t length, Handler& handler) -> bool {
+    using Delivered = DeliveredView<View, Byte, Handler>;
+    if constexpr (std::is_invocable_v<Handler&, Delivered&>) {
+        if (type == View::TYPE) {
+            Delivered view {frame, length};
+            handler(view);
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Dispatches one frame to `handler` through a chain of type-byte
+///        compares, one per view the handler accepts, in `ALL_VIEWS` order.
+///
+/// A chain of conditional branches, each predicted on its own, is cheaper on
+/// an interleaved feed than one indirect call whose target changes from frame
+/// to frame, and it lets the handler be inlined at every call site.
+///
+/// @return Whether the frame was delivered.
+template <typename Byte, typename Handler, typename... Views>
+inline auto dispatch_view(
+    Byte* frame, std::uint16_t length, Handler& handler, ViewList<Views...> /*views*/
+) -> bool {
+    const auto type = static_cast<char>(frame[0]);
+    return (deliver_as<Views>(type, frame, length, handler) || ...);
+}
+
+}  // namespace detail
+
+/// @brief Frames a buffer and invokes `callback` with a zero-copy `MessageView`
+///        for each well-formed message.
+///
+/// Framing and length validation match `Parser`: the 2-byte length prefix is
+/// honoured, unknown type bytes and undersized frames are skipped. Unlike the
+/// eager parser, no fields are decoded; the callback receives a view it can
+/// inspect lazily.
+///
+/// @param data The raw buffer containing one or more length-prefixed ITCH frames.
+/// @param callback Invoked with a `MessageView` for each well-formed frame found.
+/// @return The number of views delivered to `callback`.
+inline auto for_each_message(std::span<const std::byte> data, const ViewCallback& callback)
+    -> std::uint64_t {
+    return detail::for_each_frame(
+        data,
+        [](const std::byte*) { return true; },
+        [&callback](const std::byte* frame, std::uint16_t length) {
+            callback(MessageView {frame, length});
+            return true;
+        }
+    );
+}
+
+/// @brief Invokes `callback` with a zero-copy `MessageView` for each
+///        well-formed message of the securities `locates` keeps.
+///
+/// The locate test runs on the raw frame, before any view is built, and
+/// Stock Directory frames teach `locates` the locates of its watched symbols
+/// (see `LocateFilter`), so `locates` is updated as the buffer is scanned.
+///
+/// @param data The raw buffer containing one or more length-prefixed ITCH frames.
+/// @param locates The locate filter to apply and to teach.
+/// @param callback Invoked with a `MessageView` for each kept frame.
+/// @return The number of views delivered to `callback`.
+inline auto for_each_message(
+    std::span<const std::byte> data, LocateFilter& locates, const ViewCallback& callback
+) -> std::uint64_t {
+    return detail::for_each_frame(
+        data,
+        [&locates](const std::byte* frame) {
+            const void* raw = frame;
+            // NOLINTNEXTLINE(bugprone-casting-through-void)
+            return locates.admit(static_cast<const char*>(raw));
+        },
+        [&callback](const std::byte* frame, std::uint16_t length) {
+            callback(MessageView {frame, length});
+            return true;
+        }
+    );
+}
+
+/// @brief Memory-maps a file and invokes `callback` with a zero-copy
+///        `MessageView` for each well-formed message in it.
+///
+/// The views point straight into the mapping, which stays alive until this
+/// call returns; copy out anything that must outlive the callback.
+///
+/// @param path Filesystem path of the raw ITCH file.
+/// @param callback Invoked with a `MessageView` for each well-formed frame found.
+/// @return The number of views delivered to `callback`.
+/// @throw std::system_error if the file cannot be opened or mapped.
+inline auto for_each_message(const std::filesystem::path& path, const ViewCallback& callback)
+    -> std::uint64_t {
+    const io::MappedFile file {path};
+    return for_each_message(file.bytes(), callback);
+}
+
+/// @brief Invokes `callback` with a zero-copy `MessageView` for each
+///        well-formed message from a seek target to the end of the buffer.
+///
+/// @param data The buffer `index` was built from.
+/// @param index The seek index for `data`.
+/// @param target The first message to deliver.
+/// @param callback Invoked with a `MessageView` for each well-formed frame found.
+/// @return The number of views delivered to `callback`.
+/// @throw std::runtime_error if `index` does not match `data`.
+inline auto for_each_message(
+    std::span<const std::byte> data,
+    const SeekIndex&           index,
+    SeekTarget                 target,
+    const ViewCallback&        callback
+) -> std::uint64_t {
+    return for_each_message(index.seek(data, target), callback);
+}
+
+/// @brief Frames a buffer and hands each well-formed message to `handler` as
+///        its concrete view type (`AddOrderView`, `StockDirectoryView`, ...).
+///
+/// Framing and validation match `for_each_message`, but nothing is type
+/// erased: the frame is dispatched on its type byte through compares generated
+/// for the handler's own type, so the handler is inlined for each view type it
+/// accepts and no `std::function` is involved. Frames of types the handler does not accept
+/// are skipped; a generic lambda, or an overload taking `const MessageView&`,
+/// accepts every type.
+///
+/// @tparam Handler Callable invocable with the `const` view types it handles,
+///         e.g. an overload set of lambdas.
+/// @param data The raw buffer containing one or more length-prefixed ITCH frames.
+/// @param handler Invoked with a concrete view for each accepted frame.
+/// @return The number of views delivered to `handler`.
+template <typename Handler>
+inline auto visit(std::span<const std::byte> data, Handler&& handler) -> std::uint64_t {
+    return detail::for_each_frame(
+        data,
+        [](const std::byte*) { return true; },
+        [&handler](const std::byte* frame, std::uint16_t length) {
+            return detail::dispatch_view(frame, length, handler, detail::ALL_VIEWS {});
+        }
+    );
+}
+
+/// @brief Memory-maps a file and hands each well-formed message in it to
+///        `handler` as its concrete view type.
+///
+/// @tparam Handler Callable invocable with the `const` view types it handles.
+/// @param path Filesystem path of the raw ITCH file.
+/// @param handler Invoked with a concrete view for each accepted frame.
+/// @return The number of views delivered to `handler`.
+/// @throw std::system_error if the file cannot be opened or mapped.
+template <typename Handler>
+inline auto visit(const std::filesystem::path& path, Handler&& handler) -> std::uint64_t {
+    const io::MappedFile file {path};
+    return visit(file.bytes(), std::forward<Handler>(handler));
+}
+
+/// @brief Rewrites a buffer in place: frames it and hands each well-formed
+///        message to `handler` as a writable view of its concrete type
+///        (`MutableView<AddOrderView>`, ...).
+///
+/// Framing, validation, and dispatch match `visit`. The handler changes the
+/// frame through the view's setters, so a whole feed is rewritten in a single
+/// sweep with no decoding, re-encoding, or allocation; the frame lengths and
+/// type bytes are never changed, so the buffer stays well framed.
+///
+/// @tparam Handler Callable invocable with the `MutableView<...>&` types it
+///         handles, e.g. a generic lambda, or one taking `MutableView<>&`
+///         for every frame.
+/// @param data The writable buffer containing length-prefixed ITCH frames.
+/// @param handler Invoked with a writable view for each accepted frame.
+/// @return The number of views delivered to `handler`.
+template <typename Handler>
+inline auto transform(std::span<std::byte> data, Handler&& handler) -> std::uint64_t {
+    const std::span<const std::byte> frames {data};
+    return detail::for_each_frame(
+        frames,
+        [](const std::byte*) { return true; },
+        [&](const std::byte* frame, std::uint16_t length) {
+            std::byte* writable = data.data() + (frame - frames.data());
+            return detail::dispatch_view(writable, length, handler, detail::ALL_VIEWS {});
+        }
+    );
+}
+
 }  // namespace itch::overlay
@@ -0,0 +1,203 @@
+#pragma once
+
+/// @file
+/// @brief A two-phase, multi-threaded parser for whole-file ITCH analytics.
+///
+/// ITCH framing is strictly sequential: a frame's position is only known once
+/// every preceding length prefix has been read. `ParallelParser` exploits the
+/// fact that walking the prefixes is far cheaper than decoding the payloads. A
+/// first pass cuts the buffer into chunks that start and end on frame
+/// boundaries; a second pass decodes those chunks concurrently, each with its
+/// own `Parser`.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "itch/filter.hpp"
+#include "itch/messages.hpp"
+#include "itch/parser.hpp"
+#include "itch/parser_stats.hpp"
+
+namespace itch {
+
+/// @brief A contiguous run of whole frames produced by the indexing pass.
+struct FrameChunk {
+    std::size_t   begin {0};        ///< Offset of the length prefix of the chunk's first frame.
+    std::size_t   end {0};          ///< One past the last byte of the chunk's last frame.
+    std::uint64_t first_frame {0};  ///< Ordinal, within the buffer, of the chunk's first frame.
+    std::uint64_t frame_count {0};  ///< Number of non-padding frames in the chunk.
+};
+
+/// @brief The result of the indexing pass over a buffer.
+struct FrameIndex {
+    std::vector<FrameChunk> chunks;          ///< Frame-aligned chunks covering `complete_bytes`.
+    std::size_t             complete_bytes;  ///< Bytes covered by whole frames; less than the
+                                             ///< buffer size only if it ends mid-frame.
+    std::uint64_t           frame_count;     ///< Total non-padding frames across all chunks.
+};
+
+/// @brief The signature for callbacks invoked concurrently from worker threads.
+///
+/// @param std::size_t The index of the chunk (in `FrameIndex::chunks`) the
+///        message belongs to. Messages of one chunk arrive in stream order, on
+///        one thread; different chunks are delivered concurrently.
+/// @param const Message& The parsed message.
+using ChunkCallback = std::function<void(std::size_t, const Message&)>;
+
+/// @brief Parses a buffer on several threads.
+///
+/// Phase one (`index_frames`) walks only the 2-byte length prefixes and records
+/// chunk boundaries at frame starts. Phase two hands the chunks to worker
+/// threads, which pull the next undecoded chunk from a shared counter so that
+/// uneven chunks still balance. The buffer is cut into more chunks than there
+/// are threads for the same reason.
+///
+/// Results can be consumed three ways: per-thread callbacks (fastest, no
+/// ordering across chunks), an in-order callback on the calling thread, or a
+/// vector merged in stream order. Framing problems are counted exactly as
+/// `Parser` counts them and summed across workers.
+///
+/// Worker threads are started per call and joined before it returns; an
+/// exception thrown on a worker (including from a callback) is rethrown on the
+/// calling thread.
+class ParallelParser {
+   public:
+    /// @brief The number of chunks cut per worker thread, for load balancing.
+    static constexpr std::size_t CHUNKS_PER_THREAD = 4;
+
+    /// @brief The most input bytes (plus one frame) `parse_ordered` puts in one
+    ///        chunk, so the decoded messages it holds per chunk stay bounded.
+    static constexpr std::size_t ORDERED_CHUNK_BYTES = std::size_t {4} << 20U;
+
+    /// @brief Constructs a parser that decodes on `threads` worker threads.
+    ///
+    /// @param threads The number of worker threads; zero selects
+    ///        `std::thread::hardware_concurrency()` (at least one).
+    explicit ParallelParser(std::size_t threads = 0);
+
+    /// @brief The number of worker threads used for decoding.
+    ///
+    /// @return The configured thread count.
+    [[nodiscard]] auto thread_count() const noexcept -> std::size_t { return m_threads; }
+
+    /// @brief Phase one: cuts a buffer into frame-aligned chunks.
+    ///
+    /// Only the length prefixes are read. Chunk boundaries are placed at the
+    /// first frame starting at or after each multiple of `size / chunks`.
+    ///
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param chunks The number of chunks to aim for (at least one). Fewer are
+    ///        produced when the buffer holds fewer frames.
+    /// @return The chunk list, plus how many bytes and frames it covers.
+    [[nodiscard]] static auto index_frames(std::span<const std::byte> data, std::size_t chunks)
+        -> FrameIndex;
+
+    /// @brief Decodes a buffer concurrently, invoking `callback` from the worker
+    ///        threads.
+    ///
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param callback Invoked for each kept message; must be safe to call
+    ///        concurrently for different chunks.
+    /// @param filter The set of message types to decode and deliver.
+    /// @throw std::runtime_error if the buffer ends in the middle of a message
+    ///        (after every complete frame has been delivered).
+    auto parse(
+        std::span<const std::byte> data,
+        const ChunkCallback&       callback,
+        const MessageTypeFilter&   filter = MessageTypeFilter::all()
+    ) -> void;
+
+    /// @brief Decodes a buffer concurrently, invoking `callback` on the calling
+    ///        thread in stream order.
+    ///
+    /// The buffer is cut into chunks of at most `ORDERED_CHUNK_BYTES`, whatever
+    /// its size, and workers run at most `2 * thread_count()` chunks ahead of
+    /// the chunk being delivered. The decoded messages held at once are thus
+    /// bounded by that window of chunks, not by the size of the buffer.
+    ///
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param callback Invoked for each kept message, in stream order.
+    /// @param filter The set of message types to decode and deliver.
+    /// @throw std::runtime_error if the buffer ends in the middle of a message.
+    auto parse_ordered(
+        std::span<const std::byte> data,
+        const MessageCallback&     callback,
+        const MessageTypeFilter&   filter = MessageTypeFilter::all()
+    ) -> void;
+
+    /// @brief Decodes a buffer concurrently and returns the messages merged in
+    ///        stream order.
+    ///
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param filter The set of message types to decode and keep.
+    /// @return The kept messages, in stream order.
+    /// @throw std::runtime_error if the buffer ends in the middle of a message.
+    auto parse(
+        std::span<const std::byte> data, const MessageTypeFilter& filter = MessageTypeFilter::all()
+    ) -> std::vector<Message>;
+
+    /// @brief Frames skipped because their type byte was unknown, summed across
+    ///        workers.
+    ///
+    /// @return The running count of frames skipped for an unrecognized type byte.
+    [[nodiscard]] auto unknown_message_count() const noexcept -> std::uint64_t {
+        return m_unknown_message_count;
+    }
+
+    /// @brief Frames skipped or rejected as malformed (undersized or truncated),
+    ///        summed across workers.
+    ///
+    /// @return The running count of malformed frames.
+    [[nodiscard]] auto malformed_message_count() const noexcept -> std::uint64_t {
+        return m_malformed_message_count;
+    }
+
+    /// @brief Resets the accumulating diagnostics counters to zero.
+    auto reset_diagnostics() noexcept -> void {
+        m_unknown_message_count   = 0;
+        m_malformed_message_count = 0;
+    }
+
+    /// @brief The workers' `Parser::stats()`, merged (empty unless the library
+    ///        is built with `-DITCH_WITH_STATS=ON`).
+    ///
+    /// @return The accumulated statistics.
+    [[nodiscard]] auto stats() const noexcept -> const ParserStats& { return m_stats; }
+
+    /// @brief Resets the statistics returned by `stats()`.
+    auto reset_stats() noexcept -> void { m_stats.clear(); }
+
+   private:
+    /// @brief Runs `work(chunk_index, parser)` for every chunk on the worker
+    ///        threads, then folds the workers' diagnostics and statistics into
+    ///        this object.
+    ///
+    /// @param chunk_count The number of chunks to process.
+    /// @param work The per-chunk job; each worker owns one `Parser`.
+    /// @param on_caller Optional job run on the calling thread while the workers
+    ///        are running (used to deliver ordered results).
+    /// @throw Rethrows the first exception raised by a worker or by `on_caller`.
+    auto run_workers(
+        std::size_t                                      chunk_count,
+        const std::function<void(std::size_t, Parser&)>& work,
+        const std::function<void()>&                     on_caller = {}
+    ) -> void;
+
+    /// @brief Throws the truncation error if the index stopped short of the buffer.
+    ///
+    /// @param index The index built for the buffer.
+    /// @param data The buffer that was indexed.
+    auto check_complete(const FrameIndex& index, std::span<const std::byte> data) -> void;
+
+    std::size_t   m_threads {1};
+    std::uint64_t m_unknown_message_count {0};
+    std::uint64_t m_malformed_message_count {0};
+    ParserStats   m_stats {};
+};
+
+}  // namespace itch
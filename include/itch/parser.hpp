@@ -7,21 +7,27 @@
 /// `Parser` frames and decodes a raw ITCH byte stream into the `Message`
 /// variant defined in itch/messages.hpp, offering both throwing and
 /// non-throwing (`std::expected`-based) entry points over buffers, spans, and
-/// streams. The `itch::utils` helpers underneath handle endianness conversion
-/// and fixed-width field extraction, and are also reused by the encoder.
+/// streams, plus a statically dispatched `parse_with` that hands each message to
+/// a handler as its concrete struct. The `itch::utils` helpers underneath
+/// (defined in itch/detail/decode.hpp and re-exported here) handle endianness
+/// conversion and fixed-width field extraction, and are also reused by the
+/// encoder.
 ///
 /// @author Bertin Balouki SIMYELI
 
-#include <algorithm>
 #include <array>
-#include <bit>
-#include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <filesystem>
 #include <functional>
 #include <istream>
+#include <memory>
 #include <optional>
 #include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <version>
 
@@ -29,10 +35,23 @@
 #include <expected>
 #endif
 
+#include "itch/decode_kernel.hpp"
+#include "itch/detail/decode.hpp"
+#include "itch/detail/frame_buckets.hpp"
+#include "itch/detail/wire.hpp"
+#include "itch/filter.hpp"
+#include "itch/io/decompress.hpp"
 #include "itch/messages.hpp"
+#include "itch/parser_stats.hpp"
 
 namespace itch {
 
+class MessageArena;
+class StreamingParser;
+
+template <typename... Types>
+class BasicParser;
+
 /// @brief The signature for the callback function used in streaming parse
 /// methods.
 ///
@@ -45,9 +64,10 @@ using MessageCallback = std::function<void(const Message&)>;
 /// optional error callback, so callers can react without relying on exceptions
 /// or on the library writing to a global stream.
 enum class ParseError {
-    truncated,      ///< The buffer ended in the middle of a frame.
-    unknown_type,   ///< The message type byte does not correspond to a known message.
-    size_mismatch,  ///< The declared length is shorter than the message type requires.
+    truncated,       ///< The buffer ended in the middle of a frame.
+    unknown_type,    ///< The message type byte does not correspond to a known message.
+    size_mismatch,   ///< The declared length is shorter than the message type requires.
+    resynchronized,  ///< Bytes were skipped to recover framing after corruption.
 };
 
 /// @brief The signature for the optional diagnostics callback.
@@ -57,6 +77,33 @@ enum class ParseError {
 ///             e.g. for a truncated header).
 using ErrorCallback = std::function<void(ParseError, char)>;
 
+/// @brief A run of input bytes skipped while resynchronizing on a corrupted
+///        feed.
+///
+/// The offset counts from the start of the input, so the damage can be located
+/// in the file or stream: the buffer, the decompressed or `std::istream` data,
+/// or everything fed to a `StreamingParser` since its last `finish`.
+struct SkippedRange {
+    std::uint64_t offset {0};  ///< The first skipped byte, i.e. the corrupted frame's prefix.
+    std::uint64_t length {0};  ///< The number of bytes skipped.
+};
+
+/// @brief Selects the unchecked frame loop of `Parser` for input known to be
+///        well formed, e.g. a day file captured and checksummed in-house.
+///
+/// The checked loop tests, for every frame, that its length prefix and payload
+/// lie inside the buffer, that its type byte is known, and that it is long
+/// enough for its type. With `TrustedInput` those tests are skipped; with
+/// `validate` set they are made once over the whole buffer (see
+/// `Parser::validate`) before the unchecked loop runs, and input that fails is
+/// parsed by the checked loop instead, so the result is always that of
+/// `parse`. The validation pass walks the length prefixes serially and costs
+/// about as much as the checks it replaces, so it pays off when a file is
+/// validated once (e.g. when it is captured) and parsed unvalidated afterwards.
+struct TrustedInput {
+    bool validate {false};  ///< Validate the whole buffer once before decoding.
+};
+
 /// @brief A high-performance parser for the NASDAQ TotalView-ITCH 5.0 protocol.
 ///
 /// This class is designed to parse a raw binary feed of ITCH 5.0 messages,
@@ -69,8 +116,9 @@ using ErrorCallback = std::function<void(ParseError, char)>;
 /// allowing for throughput measured in gigabytes per second.
 ///
 /// For convenience, the parser also provides `std::istream` based wrappers.
-/// These are easier to use for simple cases but are significantly slower, as
-/// they must read the entire stream into an in-memory buffer before parsing.
+/// These read the stream through a fixed-size, reusable chunk buffer, so they
+/// work on pipes and other non-seekable streams and their memory use does not
+/// grow with the input; they pay one extra copy per byte over the buffer path.
 ///
 /// @note This parser assumes the input is a raw, sequenced ITCH 5.0 feed
 ///       without any higher-level protocol framing (e.g., SoupBinTCP packet
@@ -83,6 +131,16 @@ class Parser {
     /// byte, so no per-instance setup is required.
     Parser() = default;
 
+    /// @brief The size of the reusable read buffer used by the `std::istream`
+    ///        overloads. It comfortably exceeds the largest possible frame
+    ///        (a 2-byte prefix plus 65535 payload bytes).
+    static constexpr std::size_t STREAM_CHUNK_SIZE = std::size_t {1} << 20;
+
+    /// @brief The default number of frames per batch of `parse_bucketed`:
+    ///        enough that most types get a run of several frames, few enough
+    ///        that a batch and its decoded structs stay in cache.
+    static constexpr std::size_t DEFAULT_BUCKET_BATCH = 1024;
+
     /// @brief Parses messages from a memory buffer and invokes a callback for
     /// each.
     ///
@@ -130,37 +188,84 @@ class Parser {
     auto parse(const char* data, size_t size, const std::vector<char>& messages)
         -> std::vector<Message>;
 
+    /// @brief Parses messages from a memory buffer, invoking a callback only for
+    /// those whose type passes `filter`.
+    ///
+    /// The filter is applied to the raw type byte before the frame is decoded,
+    /// so rejected frames cost a length-prefix read and a bit test. Framing
+    /// problems are still detected and reported for every frame.
+    ///
+    /// @param data A pointer to the start of the memory buffer containing ITCH
+    /// data.
+    /// @param size The total size of the buffer in bytes.
+    /// @param callback A function to be called for each kept message.
+    /// @param filter The set of message types to decode and deliver.
+    /// @throw std::runtime_error if the buffer ends unexpectedly in the middle
+    /// of a message.
+    auto parse(
+        const char*              data,
+        size_t                   size,
+        const MessageCallback&   callback,
+        const MessageTypeFilter& filter
+    ) -> void;
+
+    /// @brief Parses a memory buffer, returning only the messages whose type
+    /// passes `filter`.
+    ///
+    /// @param data A pointer to the start of the memory buffer.
+    /// @param size The total size of the buffer in bytes.
+    /// @param filter The set of message types to decode and keep.
+    /// @return A std::vector<Message> containing only the filtered messages.
+    /// @throw std::runtime_error on buffer parsing errors.
+    auto parse(const char* data, size_t size, const MessageTypeFilter& filter)
+        -> std::vector<Message>;
+
     /// @brief [Convenience Wrapper] Parses messages from a stream via a
     /// callback.
     ///
-    /// This method reads the *entire* stream into an internal memory buffer and
-    /// then calls the high-performance buffer-based parser. It is provided for
-    /// ease of use with stream-based APIs.
+    /// This method reads the stream from its current position in fixed-size
+    /// chunks, parsing each chunk as soon as it arrives. A frame that straddles
+    /// a chunk boundary is carried over to the front of the next chunk, so peak
+    /// memory stays at one chunk (`STREAM_CHUNK_SIZE`) regardless of input size
+    /// and the first callback fires after the first chunk is read. The stream
+    /// need not be seekable.
     ///
     /// @param data A reference to an std::istream opened in binary mode.
     /// @param callback A function to be called for each successfully parsed
     /// message.
-    /// @throw std::runtime_error on stream reading errors.
+    /// @throw std::runtime_error on stream reading errors, or if the stream ends
+    /// in the middle of a message.
     /// @note For maximum performance, load the data into memory yourself and use
     ///       the `const char*` overload directly.
     auto parse(std::istream& data, const MessageCallback& callback) -> void;
 
+    /// @brief [Convenience Wrapper] Parses messages from a stream, invoking a
+    /// callback only for those whose type passes `filter`.
+    ///
+    /// @param data A reference to an std::istream opened in binary mode.
+    /// @param callback A function to be called for each kept message.
+    /// @param filter The set of message types to decode and deliver.
+    /// @throw std::runtime_error on stream reading errors, or if the stream ends
+    /// in the middle of a message.
+    auto parse(
+        std::istream& data, const MessageCallback& callback, const MessageTypeFilter& filter
+    ) -> void;
+
     /// @brief [Convenience Wrapper] Parses all messages from a stream into a
     /// vector.
     ///
-    /// This method reads the *entire* stream into memory before parsing.
+    /// The stream is read in chunks, but every parsed message is kept.
     ///
     /// @param data A reference to an std::istream opened in binary mode.
     /// @return A std::vector<Message> containing all parsed messages.
     /// @throw std::runtime_error on stream reading errors.
-    /// @note Be cautious with large files, as this will load the entire raw file
-    ///       *and* all parsed messages into memory.
+    /// @note Be cautious with large files, as this will hold all parsed messages
+    ///       in memory.
     auto parse(std::istream& data) -> std::vector<Message>;
 
     /// @brief [Convenience Wrapper] Parses and filters messages from a stream.
     ///
-    /// This method reads the *entire* stream into memory before parsing and
-    /// filtering.
+    /// The stream is read in chunks and the filter is applied before decode.
     ///
     /// @param data A reference to an std::istream opened in binary mode.
     /// @param messages A vector of message type characters to keep (e.g., {'A',
@@ -198,6 +303,227 @@ class Parser {
     auto parse(std::span<const std::byte> data, const std::vector<char>& messages)
         -> std::vector<Message>;
 
+    /// @brief Parses messages from a byte span, invoking a callback only for
+    /// those whose type passes `filter`.
+    ///
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param callback A function to be called for each kept message.
+    /// @param filter The set of message types to decode and deliver.
+    /// @throw std::runtime_error if the buffer ends in the middle of a message.
+    auto parse(
+        std::span<const std::byte> data,
+        const MessageCallback&     callback,
+        const MessageTypeFilter&   filter
+    ) -> void;
+
+    /// @brief Parses messages from a byte span, keeping only the types that pass
+    /// `filter`.
+    ///
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param filter The set of message types to decode and keep.
+    /// @return A std::vector<Message> containing only the filtered messages.
+    /// @throw std::runtime_error if the buffer ends in the middle of a message.
+    auto parse(std::span<const std::byte> data, const MessageTypeFilter& filter)
+        -> std::vector<Message>;
+
+    /// @brief Parses all messages from a byte span into a `MessageArena`.
+    ///
+    /// The compact alternative to collecting a `std::vector<Message>`: each
+    /// message is decoded straight into the arena at its own struct size, and
+    /// nothing already stored is moved as the arena grows.
+    ///
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param arena The arena to append the messages to.
+    /// @throw std::runtime_error if the buffer ends in the middle of a message
+    ///        (the messages before it have been appended).
+    auto parse(std::span<const std::byte> data, MessageArena& arena) -> void;
+
+    /// @brief Parses messages from a byte span into a `MessageArena`, keeping
+    /// only the types that pass `filter`.
+    ///
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param arena The arena to append the kept messages to.
+    /// @param filter The set of message types to decode and keep.
+    /// @throw std::runtime_error if the buffer ends in the middle of a message.
+    auto parse(
+        std::span<const std::byte> data, MessageArena& arena, const MessageTypeFilter& filter
+    ) -> void;
+
+    /// @brief Parses a file on disk, invoking a callback for each message.
+    ///
+    /// The file is memory-mapped (see `io::MappedFile`) and parsed in place, so
+    /// no copy of it is made and parsing starts as soon as the first page is
+    /// faulted in. A gzip- or zstd-compressed file is recognized by its magic
+    /// bytes and parsed with `parse_compressed` instead.
+    ///
+    /// @param path Filesystem path of the raw ITCH file.
+    /// @param callback A function to be called for each successfully parsed
+    /// message.
+    /// @throw std::system_error if the file cannot be opened or mapped.
+    /// @throw std::runtime_error if the file ends in the middle of a message, or
+    ///        is compressed in a format this build cannot read.
+    auto parse_file(const std::filesystem::path& path, const MessageCallback& callback) -> void;
+
+    /// @brief Parses a file on disk, invoking a callback only for messages whose
+    /// type passes `filter`.
+    ///
+    /// @param path Filesystem path of the raw ITCH file.
+    /// @param callback A function to be called for each kept message.
+    /// @param filter The set of message types to decode and deliver.
+    /// @throw std::system_error if the file cannot be opened or mapped.
+    /// @throw std::runtime_error if the file ends in the middle of a message, or
+    ///        is compressed in a format this build cannot read.
+    auto parse_file(
+        const std::filesystem::path& path,
+        const MessageCallback&       callback,
+        const MessageTypeFilter&     filter
+    ) -> void;
+
+    /// @brief Parses every message in a file on disk into a vector.
+    ///
+    /// @param path Filesystem path of the raw ITCH file.
+    /// @return A std::vector<Message> containing all parsed messages.
+    /// @throw std::system_error if the file cannot be opened or mapped.
+    /// @throw std::runtime_error if the file ends in the middle of a message, or
+    ///        is compressed in a format this build cannot read.
+    auto parse_file(const std::filesystem::path& path) -> std::vector<Message>;
+
+    /// @brief Parses a gzip- or zstd-compressed buffer, invoking a callback for
+    ///        each message.
+    ///
+    /// Decompression runs on a background thread that fills a ring of large
+    /// blocks (see `io::for_each_decompressed_block`) while this thread parses
+    /// the previous ones in place; a frame cut by a block boundary is carried
+    /// over to the next block. Throughput is therefore bounded by the
+    /// decompressor rather than by the parser or the disk. The format is
+    /// detected from the magic bytes; an uncompressed buffer is parsed as by
+    /// `parse`.
+    ///
+    /// @param data The compressed input, e.g. a mapped `.gz` or `.zst` file.
+    /// @param callback A function to be called for each successfully parsed
+    /// message.
+    /// @throw std::runtime_error if the input is corrupt or truncated, is
+    ///        compressed in a format this build cannot read, or ends in the
+    ///        middle of a message.
+    auto parse_compressed(std::span<const std::byte> data, const MessageCallback& callback)
+        -> void;
+
+    /// @brief Parses a gzip- or zstd-compressed buffer, invoking a callback
+    ///        only for messages whose type passes `filter`.
+    ///
+    /// @param data The compressed input, e.g. a mapped `.gz` or `.zst` file.
+    /// @param callback A function to be called for each kept message.
+    /// @param filter The set of message types to decode and deliver.
+    /// @param options The block size and depth of the decompression ring.
+    /// @throw std::runtime_error if the input is corrupt or truncated, is
+    ///        compressed in a format this build cannot read, or ends in the
+    ///        middle of a message.
+    auto parse_compressed(
+        std::span<const std::byte>   data,
+        const MessageCallback&       callback,
+        const MessageTypeFilter&     filter,
+        const io::DecompressOptions& options = {}
+    ) -> void;
+
+    /// @brief Parses messages from a byte span, handing each one to `handler` as
+    ///        its concrete message struct.
+    ///
+    /// The `MessageCallback` overloads build a full `Message` variant for every
+    /// frame and push it through a type-erased `std::function`. This overload
+    /// does neither: `handler` is an overload set (or a generic lambda) with one
+    /// `operator()` per message struct it wants, and a dispatch table generated
+    /// at compile time for that handler type calls it directly with the decoded
+    /// struct, so the decoder and the handler body inline into one another.
+    /// Message types the handler cannot be invoked with are length-skipped
+    /// without being decoded. Framing, validation, and diagnostics are identical
+    /// to `parse`.
+    ///
+    /// @tparam Handler A callable invocable as `handler(const MsgType&)` for each
+    ///         message struct it accepts.
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param handler The handler invoked with each decoded message it accepts.
+    /// @throw std::runtime_error if the buffer ends in the middle of a message.
+    template <typename Handler>
+    auto parse_with(std::span<const std::byte> data, Handler&& handler) -> void;
+
+    /// @brief Parses messages from a byte span in type-bucketed batches,
+    ///        handing the handler one span of decoded structs per type.
+    ///
+    /// Frames are collected `batch_size` at a time and counting-sorted by type
+    /// byte; each type's frames are then decoded by a loop specialized for that
+    /// type into a reused scratch buffer and handed over as one
+    /// `std::span<const MsgType>`. On an interleaved feed this removes the
+    /// per-frame indirect call of `parse` and `parse_with`, whose target the
+    /// branch predictor misses whenever the type changes. Framing, validation,
+    /// and diagnostics are identical to `parse`.
+    ///
+    /// Within a batch, spans arrive in ascending type-byte order and each span
+    /// is in feed order, but the interleaving across types is lost; handlers
+    /// that depend on it (e.g. an add followed by its execution) must use
+    /// `parse_with`. A span is only valid during the call that receives it.
+    ///
+    /// With statistics enabled, frames are counted as `parse` counts them, but
+    /// latency is timed a bucket at a time: each decoded bucket records its
+    /// decode-and-handler time divided by its frame count as one value.
+    ///
+    /// @tparam Handler A callable invocable as `handler(std::span<const MsgType>)`
+    ///         for each message struct it accepts, e.g. a generic lambda
+    ///         taking `auto messages`; other types are skipped undecoded.
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param handler The handler invoked with each non-empty bucket it accepts.
+    /// @param batch_size Frames per batch; 0 selects `DEFAULT_BUCKET_BATCH`.
+    /// @throw std::runtime_error if the buffer ends in the middle of a message
+    ///        (the complete frames before it have been delivered).
+    template <typename Handler>
+    auto parse_bucketed(
+        std::span<const std::byte> data, Handler&& handler, std::size_t batch_size = 0
+    ) -> void;
+
+    /// @brief Parses a trusted buffer, invoking a callback for each message,
+    ///        without per-frame validation.
+    ///
+    /// Unless `trust.validate` is set, `data` must be a well-formed feed: every
+    /// frame complete, of a known type, and at least as long as its type
+    /// requires. Anything else is undefined behavior (reads past the buffer or
+    /// a null decoder call), not an exception. Zero-length padding frames and
+    /// the locate filter are honored; malformed-frame diagnostics are not
+    /// produced because malformed frames are not looked for.
+    ///
+    /// @param trust Whether to validate the whole buffer once first.
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param callback A function to be called for each message.
+    /// @throw std::runtime_error only when `trust.validate` is set, validation
+    ///        fails, and the checked loop finds the buffer truncated.
+    auto parse(TrustedInput trust, std::span<const std::byte> data, const MessageCallback& callback)
+        -> void;
+
+    /// @brief Parses a trusted buffer with a statically dispatched handler (see
+    ///        `parse_with`), without per-frame validation.
+    ///
+    /// The preconditions are those of `parse(TrustedInput, ...)`.
+    ///
+    /// @tparam Handler A callable invocable as `handler(const MsgType&)` for each
+    ///         message struct it accepts.
+    /// @param trust Whether to validate the whole buffer once first.
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param handler The handler invoked with each decoded message it accepts.
+    /// @throw std::runtime_error only when `trust.validate` is set, validation
+    ///        fails, and the checked loop finds the buffer truncated.
+    template <typename Handler>
+    auto parse_with(TrustedInput trust, std::span<const std::byte> data, Handler&& handler)
+        -> void;
+
+    /// @brief Checks that a buffer is a well-formed feed, in one pass over its
+    ///        length prefixes and type bytes, without decoding anything.
+    ///
+    /// A buffer that passes can be parsed with `TrustedInput` safely.
+    ///
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @return `std::nullopt` if every frame is complete, of a known type, and
+    ///         long enough for it; otherwise the first problem found.
+    [[nodiscard]] static auto validate(std::span<const std::byte> data) noexcept
+        -> std::optional<ParseError>;
+
 #ifdef __cpp_lib_expected
     /// @brief Non-throwing parse: invokes a callback per message, reporting
     ///        truncation through the return value instead of an exception.
@@ -223,6 +549,38 @@ class Parser {
     /// @return All parsed messages on success, or a `ParseError` describing the failure.
     [[nodiscard]] auto try_parse(std::span<const std::byte> data
     ) -> std::expected<std::vector<Message>, ParseError>;
+
+    /// @brief Non-throwing parse that invokes a callback only for messages whose
+    ///        type passes `filter`.
+    ///
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param callback A function to be called for each kept message.
+    /// @param filter The set of message types to decode and deliver.
+    /// @return Nothing on success, or a `ParseError` describing the failure.
+    [[nodiscard]] auto try_parse(
+        std::span<const std::byte> data,
+        const MessageCallback&     callback,
+        const MessageTypeFilter&   filter
+    ) -> std::expected<void, ParseError>;
+
+    /// @brief Non-throwing parse that collects only the messages whose type
+    ///        passes `filter`.
+    ///
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param filter The set of message types to decode and keep.
+    /// @return The kept messages on success, or a `ParseError` describing the failure.
+    [[nodiscard]] auto try_parse(std::span<const std::byte> data, const MessageTypeFilter& filter)
+        -> std::expected<std::vector<Message>, ParseError>;
+
+    /// @brief Non-throwing parse of all messages into a `MessageArena`.
+    ///
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param arena The arena to append the messages to; on truncation it holds
+    ///        every message before the partial frame.
+    /// @return An empty `std::expected` on success, or the `ParseError` that
+    ///         aborted parsing.
+    [[nodiscard]] auto try_parse(std::span<const std::byte> data, MessageArena& arena)
+        -> std::expected<void, ParseError>;
 #endif
 
     /// @brief Registers a callback invoked for each recoverable framing problem.
@@ -235,6 +593,77 @@ class Parser {
     ///                 to clear any previously installed callback.
     auto set_error_callback(ErrorCallback callback) -> void;
 
+    /// @brief Enables resynchronization after corruption, or disables it.
+    ///
+    /// By default a frame is trusted as far as its length prefix goes, so one
+    /// corrupted prefix misframes everything after it or ends the parse as
+    /// truncated. With resynchronization on, a frame must have a known type
+    /// byte and exactly its type's wire size (over-long frames, otherwise
+    /// tolerated for forward compatibility, count as corrupt). On the first
+    /// frame that does not, the parser scans forward byte by byte for the next
+    /// offset that starts `frames` consecutive such frames (or fewer, if they
+    /// run to the end of the input), skips to it, and reports
+    /// `ParseError::resynchronized` with the type byte found at the corrupted
+    /// frame; the skipped range is then available from `last_skipped_range()`.
+    ///
+    /// @param frames The number of consecutive valid frames that confirm a
+    ///        resynchronization point, e.g. 4; 0 disables resynchronization
+    ///        (the default).
+    auto set_resync_frames(std::size_t frames) noexcept -> void { m_resync_frames = frames; }
+
+    /// @brief The number of consecutive valid frames that confirm a
+    ///        resynchronization point.
+    ///
+    /// @return The value set by `set_resync_frames`; 0 when disabled.
+    [[nodiscard]] auto resync_frames() const noexcept -> std::size_t { return m_resync_frames; }
+
+    /// @brief The most recent range skipped by resynchronization; read it from
+    ///        the error callback on `ParseError::resynchronized`.
+    ///
+    /// @return The range, or an empty range if nothing has been skipped since
+    ///         construction or `reset_diagnostics`.
+    [[nodiscard]] auto last_skipped_range() const noexcept -> SkippedRange {
+        return m_last_skipped_range;
+    }
+
+    /// @brief Selects the instruction set used to decode the order-flow messages
+    ///        (`A`, `D`, `E`, `X`, `U`) in the `MessageCallback`, vector, and
+    ///        stream overloads.
+    ///
+    /// A new parser uses `best_decode_kernel()`. Every kernel decodes to the
+    /// same messages, so this only matters for benchmarking or for pinning the
+    /// portable path.
+    ///
+    /// @param kernel The kernel to use from now on.
+    /// @throw std::invalid_argument if the running CPU cannot execute `kernel`.
+    auto set_decode_kernel(DecodeKernel kernel) -> void;
+
+    /// @brief The instruction set currently used for the order-flow messages.
+    ///
+    /// @return The selected decode kernel.
+    [[nodiscard]] auto decode_kernel() const noexcept -> DecodeKernel { return m_decode_kernel; }
+
+    /// @brief Restricts every entry point to the frames of a set of securities.
+    ///
+    /// Each well-formed frame's stock locate is tested against `filter` before
+    /// the type filter and before any decoding; frames of other securities are
+    /// length-skipped. A filter watching symbols learns their locates from the
+    /// Stock Directory frames this parser sees, so install it before parsing
+    /// the start of the day. It applies until cleared.
+    ///
+    /// @param filter The locates (and watched symbols) to keep.
+    auto set_locate_filter(LocateFilter filter) -> void { m_locate_filter = std::move(filter); }
+
+    /// @brief Removes the locate filter, so frames of every security are kept.
+    auto clear_locate_filter() noexcept -> void { m_locate_filter.reset(); }
+
+    /// @brief The installed locate filter, including the locates it has learned.
+    ///
+    /// @return A pointer to the filter, or nullptr if none is installed.
+    [[nodiscard]] auto locate_filter() const noexcept -> const LocateFilter* {
+        return m_locate_filter.has_value() ? &*m_locate_filter : nullptr;
+    }
+
     /// @brief The number of frames skipped because their type byte was unknown.
     ///
     /// @return The running count of frames skipped for an unrecognized type byte.
@@ -251,22 +680,169 @@ class Parser {
         return m_malformed_message_count;
     }
 
+    /// @brief The number of bytes skipped by resynchronization.
+    ///
+    /// @return The running count of bytes skipped to recover framing.
+    [[nodiscard]] auto skipped_byte_count() const noexcept -> std::uint64_t {
+        return m_skipped_byte_count;
+    }
+
     /// @brief Resets the accumulating diagnostics counters to zero.
     auto reset_diagnostics() noexcept -> void {
         m_unknown_message_count   = 0;
         m_malformed_message_count = 0;
+        m_skipped_byte_count      = 0;
+        m_last_skipped_range      = {};
     }
 
+    /// @brief Per-type message and byte counts and the per-frame latency
+    ///        histogram of everything this parser has delivered.
+    ///
+    /// Collected only when the library is built with `-DITCH_WITH_STATS=ON`
+    /// (`ParserStats::ENABLED`); otherwise the statistics are always empty and
+    /// the frame loop carries no instrumentation at all.
+    ///
+    /// @return The accumulated statistics.
+    [[nodiscard]] auto stats() const noexcept -> const ParserStats&;
+
+    /// @brief Resets the statistics returned by `stats()`.
+    auto reset_stats() noexcept -> void;
+
+    /// @brief Sets how many delivered frames there are per frame timed into
+    ///        the latency histogram (see `ParserStats::set_sample_interval`).
+    ///
+    /// Has no effect unless the library is built with `-DITCH_WITH_STATS=ON`.
+    ///
+    /// @param interval 1 to time every frame; 0 selects the default.
+    auto set_stats_sample_interval(std::uint32_t interval) noexcept -> void;
+
    private:
-    /// @brief The shared, non-throwing framing loop backing every parse overload.
+    friend class StreamingParser;
+
+    template <typename... Types>
+    friend class BasicParser;
+
+    /// @brief The framing loop shared by every entry point.
+    ///
+    /// Walks the length prefixes, skips zero-length padding, and routes unknown
+    /// types and undersized frames to the diagnostics policy. Each well-formed
+    /// frame whose type passes `filter` is handed to `on_frame` as a pointer to
+    /// its type byte; what happens to it (variant decode, typed dispatch, ...) is
+    /// up to the caller. Frames rejected by the filter are never decoded.
+    ///
+    /// The walk stops at the first frame that is not fully contained in the
+    /// buffer without reporting it, so a caller feeding the buffer piecewise can
+    /// carry the tail over to the next piece.
+    ///
+    /// @tparam TimeFrames Whether to time sampled `on_frame` calls into the
+    ///         latency histogram (see `deliver`).
+    /// @tparam FrameHandler Callable invocable as `on_frame(const char*)`.
+    /// @param data A pointer to the start of the memory buffer containing ITCH data.
+    /// @param size The total size of the buffer in bytes.
+    /// @param filter The message types to hand to `on_frame`.
+    /// @param on_frame Invoked with a pointer to each well-formed, kept frame.
+    /// @return The number of bytes consumed, i.e. the offset of the first
+    ///         incomplete frame (equal to `size` when the buffer ends cleanly).
+    template <bool TimeFrames = true, typename FrameHandler>
+    auto scan_frames(
+        const char*              data,
+        std::size_t              size,
+        const MessageTypeFilter& filter,
+        FrameHandler&&           on_frame
+    ) -> std::size_t;
+
+    /// @brief The frame loop of the `TrustedInput` entry points: `scan_frames`
+    ///        with every bounds, type, and length check removed.
+    ///
+    /// @tparam FrameHandler Callable invocable as `on_frame(const char*)`.
+    /// @param data A pointer to the start of a well-formed buffer.
+    /// @param size The total size of the buffer in bytes.
+    /// @param on_frame Invoked with a pointer to each frame the locate filter keeps.
+    template <typename FrameHandler>
+    auto scan_trusted(const char* data, std::size_t size, FrameHandler&& on_frame) -> void;
+
+    /// @brief Hands one kept frame to `on_frame`, counting it in the statistics
+    ///        when they are enabled.
+    ///
+    /// @tparam TimeFrames Whether a sampled call is timed into the latency
+    ///         histogram. Entry points whose `on_frame` only queues the frame
+    ///         for later decoding pass false and time the decoding themselves.
+    /// @tparam FrameHandler Callable invocable as `on_frame(const char*)`.
+    /// @param message A pointer to the frame's type byte.
+    /// @param length The frame's payload length.
+    /// @param on_frame The frame handler.
+    template <bool TimeFrames = true, typename FrameHandler>
+    auto deliver(const char* message, std::uint16_t length, FrameHandler& on_frame) -> void;
+
+    /// @brief Runs `scan_frames` over a complete buffer, reporting a trailing
+    ///        partial frame as truncation.
+    ///
+    /// @tparam TimeFrames Whether to time sampled `on_frame` calls (see `deliver`).
+    /// @tparam FrameHandler Callable invocable as `on_frame(const char*)`.
+    /// @param data A pointer to the start of the memory buffer containing ITCH data.
+    /// @param size The total size of the buffer in bytes.
+    /// @param filter The message types to hand to `on_frame`.
+    /// @param on_frame Invoked with a pointer to each well-formed, kept frame.
+    /// @return `std::nullopt` on success, or the `ParseError` that aborted the
+    ///         loop (only an unrecoverable truncation aborts it).
+    template <bool TimeFrames = true, typename FrameHandler>
+    auto frame_loop(
+        const char*              data,
+        std::size_t              size,
+        const MessageTypeFilter& filter,
+        FrameHandler&&           on_frame
+    ) -> std::optional<ParseError>;
+
+    /// @brief The variant-building framing loop backing every `MessageCallback` overload.
     ///
     /// @param data A pointer to the start of the memory buffer containing ITCH data.
     /// @param size The total size of the buffer in bytes.
     /// @param callback A function to be called for each successfully parsed message.
+    /// @param filter The message types to decode and deliver.
     /// @return `std::nullopt` on success, or the `ParseError` that aborted the
     ///         loop (only an unrecoverable truncation aborts it).
-    auto parse_impl(const char* data, std::size_t size, const MessageCallback& callback)
-        -> std::optional<ParseError>;
+    auto parse_impl(
+        const char*              data,
+        std::size_t              size,
+        const MessageCallback&   callback,
+        const MessageTypeFilter& filter
+    ) -> std::optional<ParseError>;
+
+    /// @brief Decodes the complete frames at the start of a buffer, stopping
+    ///        without error at the first incomplete one.
+    ///
+    /// @param data A pointer to the start of the memory buffer containing ITCH data.
+    /// @param size The total size of the buffer in bytes.
+    /// @param callback A function to be called for each successfully parsed message.
+    /// @param filter The message types to decode and deliver.
+    /// @return The number of bytes consumed, i.e. the offset of the first
+    ///         incomplete frame (equal to `size` when the buffer ends cleanly).
+    auto parse_available(
+        const char*              data,
+        std::size_t              size,
+        const MessageCallback&   callback,
+        const MessageTypeFilter& filter
+    ) -> std::size_t;
+
+    /// @brief The chunked reader backing every `std::istream` overload.
+    ///
+    /// @param data The stream to read from its current position to EOF.
+    /// @param callback A function to be called for each successfully parsed message.
+    /// @param filter The message types to decode and deliver.
+    /// @throw std::runtime_error on a read error or a trailing partial frame.
+    auto parse_stream(
+        std::istream& data, const MessageCallback& callback, const MessageTypeFilter& filter
+    ) -> void;
+
+    /// @brief Skips from a corrupted frame to the next resynchronization point
+    ///        and reports the skipped range.
+    ///
+    /// @param data A pointer to the start of the buffer being framed.
+    /// @param size The total size of the buffer in bytes.
+    /// @param from The offset of the corrupted frame's length prefix; its type
+    ///        byte must lie inside the buffer.
+    /// @return The offset to resume framing at (`size` if no point was found).
+    auto resync(const char* data, std::size_t size, std::size_t from) -> std::size_t;
 
     /// @brief Records a recoverable framing problem and notifies the callback.
     ///
@@ -275,80 +851,288 @@ class Parser {
     ///                     applicable, e.g. for a truncated header).
     auto report_error(ParseError error, char message_type) -> void;
 
-    ErrorCallback m_error_callback {};
-    std::uint64_t m_unknown_message_count {0};
-    std::uint64_t m_malformed_message_count {0};
+    ErrorCallback               m_error_callback {};
+    std::uint64_t               m_unknown_message_count {0};
+    std::uint64_t               m_malformed_message_count {0};
+    DecodeKernel                m_decode_kernel {best_decode_kernel()};
+    std::optional<LocateFilter> m_locate_filter {};
+    std::size_t                 m_resync_frames {0};
+    std::uint64_t               m_input_offset {0};  // Offset of the buffer being framed.
+    std::uint64_t               m_skipped_byte_count {0};
+    SkippedRange                m_last_skipped_range {};
+#ifdef ITCH_WITH_STATS
+    ParserStats m_stats {};
+#endif
 };
 
-namespace utils {
+namespace detail {
+
+/// @brief A decode-and-dispatch entry of a handler-specific dispatch table.
+template <typename Handler>
+using HandlerThunk = void (*)(const char*, Handler&);
 
-/// @brief Reverses the byte order of an integral value.
+/// @brief Builds, at compile time, the type-byte-indexed dispatch table used by
+///        `Parser::parse_with` for one handler type.
 ///
-/// Prefers `std::byteswap` (C++23) and otherwise falls back to a well-defined
-/// `std::bit_cast` based reversal. This deliberately avoids reading an inactive
-/// union member, which is undefined behavior in C++ and a hazard on the parser
-/// hot path.
+/// Each slot decodes its message struct and calls the handler with it directly.
+/// Slots for message types the handler cannot be invoked with stay null, so
+/// those frames are skipped without being decoded.
 ///
-/// @tparam IntType The integral type to byte-swap.
-/// @param value The value whose byte order should be reversed.
-/// @return `value` with its byte order reversed.
-template <std::integral IntType>
-[[nodiscard]] constexpr auto swap_bytes(IntType value) noexcept -> IntType {
-#ifdef __cpp_lib_byteswap
-    return std::byteswap(value);
-#else
-    if constexpr (sizeof(IntType) == 1) {
-        return value;
+/// @tparam Handler The (possibly const) handler type.
+/// @return An array indexed by message-type byte holding one thunk per accepted
+///         message type.
+template <typename Handler>
+consteval auto build_handler_table() -> std::array<HandlerThunk<Handler>, 256> {
+    std::array<HandlerThunk<Handler>, 256> table {};
+    auto                                   add = [&table]<typename MsgType>(char type) {
+        if constexpr (std::is_invocable_v<Handler&, const MsgType&>) {
+            table[static_cast<unsigned char>(type)] = [](const char* frame, Handler& handler) {
+                const MsgType msg = decode_typed<MsgType>(frame);
+                handler(msg);
+            };
+        }
+    };
+    for_each_message_type(add);
+    return table;
+}
+
+/// @brief The `parse_with` dispatch table for a given handler type.
+template <typename Handler>
+inline constexpr auto HANDLER_TABLE = build_handler_table<Handler>();
+
+/// @brief Decodes a bucket of frames of one type into scratch storage and
+///        hands them to the handler as one span.
+template <typename Handler>
+using BucketThunk = void (*)(std::span<const char* const>, Handler&, std::byte*);
+
+/// @brief Builds, at compile time, the type-byte-indexed table of per-type
+///        loops used by `Parser::parse_bucketed` for one handler type.
+///
+/// @tparam Handler The (possibly const) handler type.
+/// @return An array indexed by message-type byte holding one loop per accepted
+///         message type, null elsewhere.
+template <typename Handler>
+consteval auto build_bucket_table() -> std::array<BucketThunk<Handler>, 256> {
+    std::array<BucketThunk<Handler>, 256> table {};
+    auto                                  add = [&table]<typename MsgType>(char type) {
+        if constexpr (std::is_invocable_v<Handler&, std::span<const MsgType>>) {
+            table[static_cast<unsigned char>(type)] =
+                [](std::span<const char* const> frames, Handler& handler, std::byte* scratch) {
+                    // Message structs are packed, so any byte address is suitably aligned.
+                    auto* messages = static_cast<MsgType*>(static_cast<void*>(scratch));
+                    for (std::size_t index = 0; index < frames.size(); ++index) {
+                        std::construct_at(messages + index, decode_typed<MsgType>(frames[index]));
+                    }
+                    handler(std::span<const MsgType> {messages, frames.size()});
+                };
+        }
+    };
+    for_each_message_type(add);
+    return table;
+}
+
+/// @brief The `parse_bucketed` loop table for a given handler type.
+template <typename Handler>
+inline constexpr auto BUCKET_TABLE = build_bucket_table<Handler>();
+
+}  // namespace detail
+
+template <bool TimeFrames, typename FrameHandler>
+auto Parser::scan_frames(
+    const char*              data,
+    std::size_t              size,
+    const MessageTypeFilter& filter,
+    FrameHandler&&           on_frame
+) -> std::size_t {
+    const std::size_t resync_frames = m_resync_frames;
+    std::size_t       offset        = 0;
+    while (offset < size) {
+        // Ensure we can read the 2-byte length prefix.
+        if (offset + sizeof(std::uint16_t) > size) {
+            return offset;
+        }
+        std::uint16_t length {};
+        std::memcpy(&length, data + offset, sizeof(length));
+        length = utils::from_big_endian(length);
+
+        // When resynchronizing, a frame must have exactly its type's wire size;
+        // anything else is taken for corruption and skipped past.
+        if (resync_frames != 0 && length != 0 && offset + sizeof(std::uint16_t) < size &&
+            detail::WIRE_SIZE_TABLE[static_cast<unsigned char>(
+                data[offset + sizeof(std::uint16_t)]
+            )] != length) {
+            offset = resync(data, size, offset);
+            continue;
+        }
+
+        // Ensure the full declared payload is present.
+        if (offset + sizeof(std::uint16_t) + length > size) {
+            return offset;
+        }
+        offset += sizeof(std::uint16_t);
+
+        if (length == 0) {
+            continue;  // Skip zero-length padding frames.
+        }
+
+        const char* message      = data + offset;
+        const char  message_type = message[0];
+        offset += length;
+
+        const std::uint16_t wire_size =
+            detail::WIRE_SIZE_TABLE[static_cast<unsigned char>(message_type)];
+        if (wire_size == 0) {
+            // Unknown type: skip and count rather than writing to a global stream.
+            report_error(ParseError::unknown_type, message_type);
+            continue;
+        }
+        // A frame shorter than the type requires would make the decoder read into
+        // the next frame; reject it. A longer frame is tolerated for forward
+        // compatibility (the trailing bytes are simply skipped).
+        if (length < wire_size) {
+            report_error(ParseError::size_mismatch, message_type);
+            continue;
+        }
+
+        if (m_locate_filter.has_value() && !m_locate_filter->admit(message)) {
+            continue;  // Not a security in the universe.
+        }
+        if (filter.contains(message_type)) {
+            deliver<TimeFrames>(message, length, on_frame);
+        }
+    }
+    return offset;
+}
+
+template <typename FrameHandler>
+auto Parser::scan_trusted(const char* data, std::size_t size, FrameHandler&& on_frame) -> void {
+    const char* cursor = data;
+    const char* end    = data + size;
+    while (cursor < end) {
+        std::uint16_t length {};
+        std::memcpy(&length, cursor, sizeof(length));
+        length              = utils::from_big_endian(length);
+        const char* message = cursor + sizeof(std::uint16_t);
+        cursor              = message + length;
+
+        if (length == 0) {
+            continue;  // Skip zero-length padding frames.
+        }
+        if (m_locate_filter.has_value() && !m_locate_filter->admit(message)) {
+            continue;
+        }
+        deliver(message, length, on_frame);
+    }
+}
+
+template <bool TimeFrames, typename FrameHandler>
+auto Parser::deliver(const char* message, std::uint16_t length, FrameHandler& on_frame) -> void {
+#ifdef ITCH_WITH_STATS
+    if (TimeFrames && m_stats.sample_due()) {
+        const auto start = detail::read_ticks();
+        on_frame(message);
+        m_stats.record(message[0], sizeof(std::uint16_t) + length, detail::read_ticks() - start);
     } else {
-        auto bytes = std::bit_cast<std::array<std::byte, sizeof(IntType)>>(value);
-        std::ranges::reverse(bytes);
-        return std::bit_cast<IntType>(bytes);
+        on_frame(message);
+        m_stats.record(message[0], sizeof(std::uint16_t) + length);
     }
+#else
+    static_cast<void>(length);
+    on_frame(message);
 #endif
 }
 
-/// @brief Converts a big-endian (network order) value to the host byte order.
-///
-/// On little-endian hosts this swaps the bytes; on big-endian hosts it is a
-/// no-op. The choice is made at compile time via `std::endian`.
-///
-/// @tparam IntType The integral type to convert.
-/// @param value The big-endian value to convert.
-/// @return `value` converted to host byte order.
-template <std::integral IntType>
-[[nodiscard]] constexpr auto from_big_endian(IntType value) noexcept -> IntType {
-    if constexpr (std::endian::native == std::endian::little) {
-        return swap_bytes(value);
-    } else {
-        return value;
+template <bool TimeFrames, typename FrameHandler>
+auto Parser::frame_loop(
+    const char*              data,
+    std::size_t              size,
+    const MessageTypeFilter& filter,
+    FrameHandler&&           on_frame
+) -> std::optional<ParseError> {
+    m_input_offset = 0;
+    if (scan_frames<TimeFrames>(data, size, filter, std::forward<FrameHandler>(on_frame)) !=
+        size) {
+        report_error(ParseError::truncated, '\0');
+        return ParseError::truncated;
     }
+    return std::nullopt;
 }
 
-/// @brief Unpacks a value of type T from the buffer, advancing the offset.
-///        Handles endianness conversion for multi-byte integral types.
-///
-/// @tparam ValueType The type of value to unpack.
-/// @param buffer The buffer to read from.
-/// @param offset The byte offset to read from, advanced past the unpacked value.
-/// @return The unpacked value, converted to host byte order when applicable.
-template <typename ValueType>
-auto unpack(const char* buffer, std::size_t& offset) -> ValueType;
-
-/// @brief Copies a fixed-width character field out of the buffer.
-///
-/// @param buffer The buffer to read from.
-/// @param offset The byte offset to read from, advanced past the copied field.
-/// @param dest The destination buffer to copy the field into.
-/// @param size The number of characters to copy.
-inline auto unpack_string(const char* buffer, std::size_t& offset, char* dest, std::size_t size)
-    -> void;
-
-/// @brief Unpacks a 48-bit big-endian ITCH timestamp (2-byte high, 4-byte low).
-///
-/// @param buffer The buffer to read from.
-/// @param offset The byte offset to read from, advanced past the timestamp.
-/// @return The timestamp as nanoseconds past midnight.
-inline auto unpack_timestamp(const char* buffer, std::size_t& offset) -> std::uint64_t;
-}  // namespace utils
+template <typename Handler>
+auto Parser::parse_with(std::span<const std::byte> data, Handler&& handler) -> void {
+    using HandlerType = std::remove_reference_t<Handler>;
+    constexpr auto filter = MessageTypeFilter::all();
+    const auto     error  = frame_loop(
+        detail::as_char_ptr(data),
+        data.size(),
+        filter,
+        [&](const char* frame) {
+            const auto thunk =
+                detail::HANDLER_TABLE<HandlerType>[static_cast<unsigned char>(frame[0])];
+            if (thunk != nullptr) {
+                thunk(frame, handler);
+            }
+        }
+    );
+    if (error.has_value()) {
+        throw std::runtime_error("Incomplete message at end of buffer.");
+    }
+}
+
+template <typename Handler>
+auto Parser::parse_bucketed(
+    std::span<const std::byte> data, Handler&& handler, std::size_t batch_size
+) -> void {
+    using HandlerType = std::remove_reference_t<Handler>;
+    constexpr auto filter   = MessageTypeFilter::all();
+    const auto     capacity = batch_size == 0 ? DEFAULT_BUCKET_BATCH : batch_size;
+
+    detail::FrameBuckets buckets {capacity};
+    // sizeof(Message) bounds every message struct.
+    std::vector<std::byte> scratch(capacity * sizeof(Message));
+    auto                   flush = [&] {
+        buckets.drain([&](char type, std::span<const char* const> frames) {
+            const auto loop = detail::BUCKET_TABLE<HandlerType>[static_cast<unsigned char>(type)];
+            if (loop != nullptr) {
+#ifdef ITCH_WITH_STATS
+                // The frame loop only queues frames here, so the decode and
+                // callback are timed a bucket at a time instead.
+                const auto start = detail::read_ticks();
+                loop(frames, handler, scratch.data());
+                m_stats.record_latency((detail::read_ticks() - start) / frames.size());
+#else
+                loop(frames, handler, scratch.data());
+#endif
+            }
+        });
+    };
+    const auto error =
+        frame_loop<false>(detail::as_char_ptr(data), data.size(), filter, [&](const char* frame) {
+            buckets.push(frame);
+            if (buckets.full()) {
+                flush();
+            }
+        });
+    flush();
+    if (error.has_value()) {
+        throw std::runtime_error("Incomplete message at end of buffer.");
+    }
+}
+
+template <typename Handler>
+auto Parser::parse_with(TrustedInput trust, std::span<const std::byte> data, Handler&& handler)
+    -> void {
+    if (trust.validate && validate(data).has_value()) {
+        parse_with(data, std::forward<Handler>(handler));
+        return;
+    }
+    using HandlerType = std::remove_reference_t<Handler>;
+    scan_trusted(detail::as_char_ptr(data), data.size(), [&](const char* frame) {
+        const auto thunk = detail::HANDLER_TABLE<HandlerType>[static_cast<unsigned char>(frame[0])];
+        if (thunk != nullptr) {
+            thunk(frame, handler);
+        }
+    });
+}
 
 }  // namespace itch
@@ -0,0 +1,306 @@
+#pragma once
+
+/// @file
+/// @brief Optional per-type throughput counters and a decode-latency histogram
+///        for `Parser`.
+///
+/// Built with `-DITCH_WITH_STATS=ON`, every `Parser` counts the messages and
+/// bytes it delivers per message type and times a sample of the delivered
+/// frames, decode plus callback, with the CPU's time-stamp counter into a
+/// log-bucketed histogram. Comparing the latency distribution with and without the real
+/// callback tells whether the parser or the consumer is the bottleneck. In a
+/// default build the instrumentation compiles away entirely and
+/// `Parser::stats()` stays empty.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace itch {
+
+namespace detail {
+
+/// @brief Reads a cheap, monotonic tick counter: the time-stamp counter on
+///        x86-64, the steady clock in nanoseconds elsewhere.
+///
+/// @return The current tick count.
+inline auto read_ticks() noexcept -> std::uint64_t {
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#else
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()
+    );
+#endif
+}
+
+/// @brief The rate of `read_ticks`, measured once against the steady clock on
+///        first use (which takes about 10 ms).
+///
+/// @return Ticks per nanosecond.
+[[nodiscard]] auto ticks_per_nanosecond() -> double;
+
+}  // namespace detail
+
+/// @brief A log-bucketed histogram of unsigned values, in the spirit of HDR
+///        histograms: each power of two is split into `SUB_BUCKETS` linear
+///        buckets, so any recorded value is known to within 1/8 of itself
+///        while the whole 64-bit range fits in a fixed 4 KiB array.
+class LatencyHistogram {
+   public:
+    /// @brief log2 of the buckets per power of two.
+    static constexpr unsigned SUB_BUCKET_BITS = 3;
+
+    /// @brief The buckets per power of two.
+    static constexpr std::size_t SUB_BUCKETS = std::size_t {1} << SUB_BUCKET_BITS;
+
+    /// @brief The number of buckets covering every `std::uint64_t`.
+    static constexpr std::size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    /// @brief The bucket a value falls into.
+    ///
+    /// @param value The value to classify.
+    /// @return An index below `BUCKET_COUNT`.
+    [[nodiscard]] static constexpr auto bucket_of(std::uint64_t value) noexcept -> std::size_t {
+        if (value < SUB_BUCKETS) {
+            return static_cast<std::size_t>(value);
+        }
+        const auto shift = static_cast<unsigned>(std::bit_width(value)) - SUB_BUCKET_BITS - 1;
+        const auto sub   = static_cast<std::size_t>(value >> shift) - SUB_BUCKETS;
+        return ((shift + 1) * SUB_BUCKETS) + sub;
+    }
+
+    /// @brief The smallest value that falls into a bucket.
+    ///
+    /// @param bucket An index below `BUCKET_COUNT`.
+    /// @return The bucket's inclusive lower bound.
+    [[nodiscard]] static constexpr auto bucket_lower(std::size_t bucket) noexcept -> std::uint64_t {
+        if (bucket < SUB_BUCKETS) {
+            return bucket;
+        }
+        const auto shift = (bucket / SUB_BUCKETS) - 1;
+        return (SUB_BUCKETS + (bucket % SUB_BUCKETS)) << shift;
+    }
+
+    /// @brief The largest value that falls into a bucket.
+    ///
+    /// @param bucket An index below `BUCKET_COUNT`.
+    /// @return The bucket's inclusive upper bound.
+    [[nodiscard]] static constexpr auto bucket_upper(std::size_t bucket) noexcept -> std::uint64_t {
+        return bucket + 1 == BUCKET_COUNT ? ~std::uint64_t {0} : bucket_lower(bucket + 1) - 1;
+    }
+
+    /// @brief Adds one value.
+    ///
+    /// @param value The value to record, e.g. a tick count.
+    auto record(std::uint64_t value) noexcept -> void {
+        ++m_counts[bucket_of(value)];
+        ++m_count;
+        m_sum += value;
+        m_min = value < m_min ? value : m_min;
+        m_max = value > m_max ? value : m_max;
+    }
+
+    /// @brief Adds every value recorded in another histogram.
+    ///
+    /// @param other The histogram to merge in.
+    auto merge(const LatencyHistogram& other) noexcept -> void;
+
+    /// @brief Removes every recorded value.
+    auto clear() noexcept -> void { *this = LatencyHistogram {}; }
+
+    /// @brief The number of recorded values.
+    ///
+    /// @return The count of `record` calls since construction or `clear`.
+    [[nodiscard]] auto count() const noexcept -> std::uint64_t { return m_count; }
+
+    /// @brief The number of recorded values in one bucket.
+    ///
+    /// @param bucket An index below `BUCKET_COUNT`.
+    /// @return The bucket's count.
+    [[nodiscard]] auto count_in(std::size_t bucket) const noexcept -> std::uint64_t {
+        return m_counts[bucket];
+    }
+
+    /// @brief The smallest recorded value.
+    ///
+    /// @return The exact minimum, or 0 if the histogram is empty.
+    [[nodiscard]] auto min() const noexcept -> std::uint64_t { return m_count == 0 ? 0 : m_min; }
+
+    /// @brief The largest recorded value.
+    ///
+    /// @return The exact maximum, or 0 if the histogram is empty.
+    [[nodiscard]] auto max() const noexcept -> std::uint64_t { return m_max; }
+
+    /// @brief The mean of the recorded values.
+    ///
+    /// @return The exact mean, or 0 if the histogram is empty.
+    [[nodiscard]] auto mean() const noexcept -> double;
+
+    /// @brief The value below or at which a given share of the recorded values
+    ///        fall.
+    ///
+    /// @param percentile A percentage in [0, 100], e.g. 99.9.
+    /// @return The upper bound of the bucket holding that rank (capped at
+    ///         `max()`), or 0 if the histogram is empty.
+    [[nodiscard]] auto value_at_percentile(double percentile) const noexcept -> std::uint64_t;
+
+   private:
+    std::array<std::uint64_t, BUCKET_COUNT> m_counts {};
+    std::uint64_t                           m_count {0};
+    std::uint64_t                           m_sum {0};
+    std::uint64_t                           m_min {~std::uint64_t {0}};
+    std::uint64_t                           m_max {0};
+};
+
+/// @brief What a `Parser` has delivered, per message type, and how long each
+///        delivery took.
+///
+/// Only frames handed to the caller are counted: frames rejected by a type or
+/// locate filter, and malformed frames (see `Parser::malformed_message_count`),
+/// are not. Bytes include each frame's 2-byte length prefix.
+class ParserStats {
+   public:
+    /// @brief Whether the library was built with `ITCH_WITH_STATS`; when it was
+    ///        not, every counter stays zero.
+#ifdef ITCH_WITH_STATS
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+    /// @brief The default `sample_interval`: one frame in 64 is timed.
+    static constexpr std::uint32_t DEFAULT_SAMPLE_INTERVAL = 64;
+
+    /// @brief Counts one delivered frame.
+    ///
+    /// @param message_type The frame's type byte.
+    /// @param frame_size The frame's size, including its length prefix.
+    auto record(char message_type, std::size_t frame_size) noexcept -> void {
+        const auto type = static_cast<unsigned char>(message_type);
+        ++m_messages[type];
+        m_bytes[type] += frame_size;
+    }
+
+    /// @brief Counts one delivered frame and the time it took.
+    ///
+    /// @param message_type The frame's type byte.
+    /// @param frame_size The frame's size, including its length prefix.
+    /// @param ticks The time spent decoding and delivering it, in `read_ticks`
+    ///        units.
+    auto record(char message_type, std::size_t frame_size, std::uint64_t ticks) noexcept -> void {
+        record(message_type, frame_size);
+        m_latency.record(ticks);
+    }
+
+    /// @brief Records one latency value without counting a frame, e.g. the
+    ///        per-frame mean of a batch of frames decoded together.
+    ///
+    /// @param ticks The time per frame, in `read_ticks` units.
+    auto record_latency(std::uint64_t ticks) noexcept -> void { m_latency.record(ticks); }
+
+    /// @brief Advances the sampling countdown.
+    ///
+    /// @return `true` once every `sample_interval()` calls, when the next frame
+    ///         should be timed.
+    [[nodiscard]] auto sample_due() noexcept -> bool {
+        if (--m_countdown != 0) {
+            return false;
+        }
+        m_countdown = m_sample_interval;
+        return true;
+    }
+
+    /// @brief Sets how many delivered frames there are per timed one.
+    ///
+    /// Reading the tick counter costs tens of cycles, comparable to decoding a
+    /// frame, so timing every frame would distort the distribution it
+    /// measures. Counters are exact whatever the interval.
+    ///
+    /// @param interval 1 to time every frame; 0 selects `DEFAULT_SAMPLE_INTERVAL`.
+    auto set_sample_interval(std::uint32_t interval) noexcept -> void {
+        m_sample_interval = interval == 0 ? DEFAULT_SAMPLE_INTERVAL : interval;
+        m_countdown       = m_sample_interval;
+    }
+
+    /// @brief How many delivered frames there are per timed one.
+    ///
+    /// @return The sampling interval.
+    [[nodiscard]] auto sample_interval() const noexcept -> std::uint32_t {
+        return m_sample_interval;
+    }
+
+    /// @brief The messages of one type delivered.
+    ///
+    /// @param message_type A type byte, e.g. `'A'`.
+    /// @return The running count.
+    [[nodiscard]] auto messages(char message_type) const noexcept -> std::uint64_t {
+        return m_messages[static_cast<unsigned char>(message_type)];
+    }
+
+    /// @brief The bytes of one type's frames delivered.
+    ///
+    /// @param message_type A type byte, e.g. `'A'`.
+    /// @return The running byte count, length prefixes included.
+    [[nodiscard]] auto bytes(char message_type) const noexcept -> std::uint64_t {
+        return m_bytes[static_cast<unsigned char>(message_type)];
+    }
+
+    /// @brief The messages of every type delivered.
+    ///
+    /// @return The sum of `messages` over all types.
+    [[nodiscard]] auto total_messages() const noexcept -> std::uint64_t;
+
+    /// @brief The bytes of every type delivered.
+    ///
+    /// @return The sum of `bytes` over all types.
+    [[nodiscard]] auto total_bytes() const noexcept -> std::uint64_t;
+
+    /// @brief The distribution of per-frame decode-plus-callback time, in
+    ///        `read_ticks` units (TSC cycles on x86-64), over the sampled frames
+    ///        (per-bucket means for `Parser::parse_bucketed`).
+    ///
+    /// @return The latency histogram.
+    [[nodiscard]] auto latency() const noexcept -> const LatencyHistogram& { return m_latency; }
+
+    /// @brief Converts a tick count, e.g. from `latency()`, to nanoseconds.
+    ///
+    /// @param ticks A duration in `read_ticks` units.
+    /// @return The duration in nanoseconds.
+    [[nodiscard]] static auto to_nanoseconds(std::uint64_t ticks) -> double;
+
+    /// @brief Adds another parser's counts, e.g. to total a parallel run.
+    ///
+    /// @param other The statistics to merge in.
+    auto merge(const ParserStats& other) noexcept -> void;
+
+    /// @brief Resets every counter and the histogram, keeping the sampling
+    ///        interval.
+    auto clear() noexcept -> void {
+        const auto interval = m_sample_interval;
+        *this               = ParserStats {};
+        set_sample_interval(interval);
+    }
+
+   private:
+    std::array<std::uint64_t, 256> m_messages {};
+    std::array<std::uint64_t, 256> m_bytes {};
+    LatencyHistogram               m_latency;
+    std::uint32_t                  m_sample_interval {DEFAULT_SAMPLE_INTERVAL};
+    std::uint32_t                  m_countdown {DEFAULT_SAMPLE_INTERVAL};
+};
+
+}  // namespace itch
@@ -0,0 +1,196 @@
+#pragma once
+
+/// @file
+/// @brief A persistent sidecar index for random access into ITCH day files.
+///
+/// Framing is sequential, so without help the only way to reach the closing
+/// cross is to walk every frame since midnight. `SeekIndex` records a sample
+/// point (byte offset, message ordinal, timestamp) every `stride` messages plus
+/// the first and last frame of every stock locate, and can be saved next to
+/// the data file. A seek then costs one binary search and a walk of at most
+/// `stride` length prefixes.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "itch/parser.hpp"
+
+namespace itch {
+
+/// @brief One sampled position in the indexed buffer.
+struct SeekPoint {
+    std::uint64_t offset {0};     ///< Byte offset of the message's length prefix.
+    std::uint64_t ordinal {0};    ///< Zero-based index of the message among all messages.
+    std::uint64_t timestamp {0};  ///< The message's nanoseconds-past-midnight timestamp.
+};
+
+/// @brief Where one stock locate's messages sit in the indexed buffer.
+struct LocateRange {
+    std::uint16_t stock_locate {0};   ///< The stock locate code.
+    std::uint64_t first_offset {0};   ///< Byte offset of the locate's first message.
+    std::uint64_t last_offset {0};    ///< Byte offset of the locate's last message.
+    std::uint64_t message_count {0};  ///< Number of messages carrying this locate.
+};
+
+/// @brief A seek destination: a timestamp or a message ordinal.
+struct SeekTarget {
+    /// @brief The kind of position the target names.
+    enum class Kind : std::uint8_t {
+        time,     ///< The first message whose timestamp is at or after `value`.
+        ordinal,  ///< The message whose zero-based ordinal is `value`.
+    };
+
+    Kind          kind {Kind::ordinal};  ///< How `value` is interpreted.
+    std::uint64_t value {0};             ///< Nanoseconds past midnight, or a message ordinal.
+
+    /// @brief Targets the first message at or after a time of day.
+    ///
+    /// @param nanoseconds Nanoseconds past midnight.
+    /// @return A time target.
+    [[nodiscard]] static constexpr auto time(std::uint64_t nanoseconds) noexcept -> SeekTarget {
+        return {Kind::time, nanoseconds};
+    }
+
+    /// @brief Targets a message by its zero-based ordinal.
+    ///
+    /// @param index The message ordinal.
+    /// @return An ordinal target.
+    [[nodiscard]] static constexpr auto ordinal(std::uint64_t index) noexcept -> SeekTarget {
+        return {Kind::ordinal, index};
+    }
+};
+
+/// @brief A sampled (offset, ordinal, timestamp) index over an ITCH buffer, plus
+///        per-locate first/last offsets, with a compact on-disk format.
+///
+/// Ordinals count messages the way `Parser` delivers them: zero-length padding,
+/// unknown types, and undersized frames are not messages. Time seeks assume
+/// timestamps never decrease through the buffer, which holds for a single
+/// TotalView-ITCH session.
+///
+/// The sidecar format is little-endian and versioned; it records the size of
+/// the data it was built from so a stale index is rejected instead of producing
+/// wrong offsets.
+class SeekIndex {
+   public:
+    /// @brief The default number of messages between sample points.
+    static constexpr std::uint64_t DEFAULT_STRIDE = 4096;
+
+    /// @brief Constructs an empty index (no points, no locates).
+    SeekIndex() = default;
+
+    /// @brief Walks a buffer once and builds its index.
+    ///
+    /// @param data A view over the contiguous buffer containing ITCH data.
+    /// @param stride Messages between sample points (at least one).
+    /// @return The index for `data`.
+    [[nodiscard]] static auto build(
+        std::span<const std::byte> data, std::uint64_t stride = DEFAULT_STRIDE
+    ) -> SeekIndex;
+
+    /// @brief Reads a sidecar file written by `save`.
+    ///
+    /// @param path Filesystem path of the sidecar.
+    /// @return The loaded index.
+    /// @throw std::system_error if the file cannot be opened or mapped.
+    /// @throw std::runtime_error if the file is not a valid sidecar.
+    [[nodiscard]] static auto load(const std::filesystem::path& path) -> SeekIndex;
+
+    /// @brief Writes the index to a sidecar file.
+    ///
+    /// @param path Filesystem path of the sidecar to create or overwrite.
+    /// @throw std::runtime_error if the file cannot be written.
+    auto save(const std::filesystem::path& path) const -> void;
+
+    /// @brief The conventional sidecar path for a data file (`<data>.idx`).
+    ///
+    /// @param data_path Filesystem path of the ITCH data file.
+    /// @return `data_path` with `.idx` appended.
+    [[nodiscard]] static auto sidecar_path(const std::filesystem::path& data_path)
+        -> std::filesystem::path;
+
+    /// @brief Returns the tail of `data` that starts at `target`.
+    ///
+    /// The nearest sample point at or before the target is found by binary
+    /// search; the remaining distance is covered by walking length prefixes and
+    /// reading raw timestamps, so nothing is decoded.
+    ///
+    /// @param data The buffer this index was built from.
+    /// @param target The message to seek to.
+    /// @return The suffix of `data` beginning at the target message's length
+    ///         prefix, or an empty span if no message matches.
+    /// @throw std::runtime_error if `data` is not the size the index was built for.
+    [[nodiscard]] auto seek(std::span<const std::byte> data, SeekTarget target) const
+        -> std::span<const std::byte>;
+
+    /// @brief Looks up where a stock locate's messages sit.
+    ///
+    /// @param stock_locate The locate code to look up.
+    /// @return The locate's range, or `std::nullopt` if it never appears.
+    [[nodiscard]] auto locate_range(std::uint16_t stock_locate) const
+        -> std::optional<LocateRange>;
+
+    /// @brief The sampled points, in buffer order.
+    ///
+    /// @return One point every `stride()` messages.
+    [[nodiscard]] auto points() const noexcept -> const std::vector<SeekPoint>& { return m_points; }
+
+    /// @brief Every stock locate seen, sorted by locate code.
+    ///
+    /// @return The per-locate ranges.
+    [[nodiscard]] auto locates() const noexcept -> const std::vector<LocateRange>& {
+        return m_locates;
+    }
+
+    /// @brief The number of messages between sample points.
+    ///
+    /// @return The sampling stride.
+    [[nodiscard]] auto stride() const noexcept -> std::uint64_t { return m_stride; }
+
+    /// @brief The size in bytes of the buffer the index was built from.
+    ///
+    /// @return The indexed buffer's size.
+    [[nodiscard]] auto data_size() const noexcept -> std::uint64_t { return m_data_size; }
+
+    /// @brief The total number of messages in the indexed buffer.
+    ///
+    /// @return The message count.
+    [[nodiscard]] auto message_count() const noexcept -> std::uint64_t { return m_message_count; }
+
+   private:
+    std::uint64_t            m_stride {DEFAULT_STRIDE};
+    std::uint64_t            m_data_size {0};
+    std::uint64_t            m_message_count {0};
+    std::vector<SeekPoint>   m_points;
+    std::vector<LocateRange> m_locates;
+};
+
+/// @brief Parses a buffer from a seek target onward, invoking a callback for
+///        each message.
+///
+/// `index` locates the target without decoding anything before it (see
+/// `SeekIndex::seek`); `parser` then proceeds exactly as `Parser::parse` would
+/// over the remaining bytes.
+///
+/// @param parser The parser to decode with.
+/// @param data The buffer `index` was built from.
+/// @param index The seek index for `data`.
+/// @param target The first message to deliver.
+/// @param callback A function to be called for each message from `target` on.
+/// @throw std::runtime_error if `index` does not match `data`, or the buffer
+///        ends in the middle of a message.
+auto parse_from(
+    Parser&                    parser,
+    std::span<const std::byte> data,
+    const SeekIndex&           index,
+    SeekTarget                 target,
+    const MessageCallback&     callback
+) -> void;
+
+}  // namespace itch
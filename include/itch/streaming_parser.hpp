@@ -0,0 +1,126 @@
+#pragma once
+
+/// @file
+/// @brief Resumable, incremental parsing of an ITCH byte stream that arrives
+///        in arbitrary pieces.
+///
+/// `Parser::parse` needs the whole feed in one buffer and treats a frame cut
+/// off at its end as truncation. A receive loop gets the stream in pieces that
+/// split frames anywhere, so it would have to gather them into a contiguous
+/// buffer first. `StreamingParser::feed` instead decodes every complete frame
+/// straight out of the caller's piece and keeps just the bytes of a frame split
+/// across two pieces in a small fixed buffer inside the parser.
+///
+/// @author Bertin Balouki SIMYELI
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "itch/detail/wire.hpp"
+#include "itch/filter.hpp"
+#include "itch/parser.hpp"
+
+namespace itch {
+
+namespace detail {
+
+/// @brief The largest wire size of any known message type.
+inline constexpr std::size_t MAX_WIRE_SIZE = [] {
+    std::size_t largest = 0;
+    for (const auto size : WIRE_SIZE_TABLE) {
+        largest = size > largest ? size : largest;
+    }
+    return largest;
+}();
+
+}  // namespace detail
+
+/// @brief A parser fed a stream piece by piece, with no copy of whole frames.
+///
+/// Each `feed` call decodes the complete frames in its piece in place, like
+/// `Parser::parse`, and delivers them to the callback in stream order. A frame
+/// that runs past the end of the piece is carried over: its length prefix and
+/// at most the largest known wire size of its body are copied into a fixed
+/// internal buffer, and it is decoded once the following pieces complete it.
+/// Bytes of a frame beyond what any decoder reads (frames longer than their
+/// type requires are tolerated for forward compatibility) are counted but not
+/// kept. Nothing ever points into a piece after `feed` returns, so the caller
+/// may reuse its receive buffer immediately.
+///
+/// Resynchronization (see `Parser::set_resync_frames`) reports skipped ranges at
+/// their offset in the stream. It searches only the bytes at hand, so damage
+/// that a piece boundary cuts through may be reported as several ranges.
+class StreamingParser {
+   public:
+    /// @brief The capacity of the internal buffer for a split frame: a length
+    ///        prefix plus the largest known message.
+    static constexpr std::size_t CARRY_CAPACITY = sizeof(std::uint16_t) + detail::MAX_WIRE_SIZE;
+
+    /// @brief Constructs a streaming parser.
+    ///
+    /// @param callback Invoked with each decoded message, in stream order.
+    /// @param filter The message types to decode and deliver; frames of other
+    ///        types are length-skipped.
+    explicit StreamingParser(
+        MessageCallback callback, const MessageTypeFilter& filter = MessageTypeFilter::all()
+    );
+
+    /// @brief Decodes the next piece of the stream.
+    ///
+    /// @param data The bytes following those of the previous `feed` call.
+    /// @return The number of bytes of `data` consumed. This is always
+    ///         `data.size()`: complete frames are decoded and the start of a
+    ///         split frame is held internally, so the caller keeps nothing.
+    auto feed(std::span<const std::byte> data) -> std::size_t;
+
+    /// @brief Declares the end of the stream.
+    ///
+    /// The parser is ready for a new stream afterwards, even if it throws;
+    /// stream offsets (see `SkippedRange`) restart from 0.
+    ///
+    /// @throw std::runtime_error if the stream ended in the middle of a message.
+    auto finish() -> void;
+
+    /// @brief Discards a partially received frame, if any, without reporting it.
+    auto reset() noexcept -> void;
+
+    /// @brief The bytes of a split frame received so far.
+    ///
+    /// @return 0 when the stream so far ends on a frame boundary.
+    [[nodiscard]] auto pending_bytes() const noexcept -> std::size_t { return m_received; }
+
+    /// @brief The underlying parser, for diagnostics, the error callback, and
+    ///        the decode kernel.
+    ///
+    /// @return Reference to the embedded `Parser`.
+    [[nodiscard]] auto parser() noexcept -> Parser& { return m_parser; }
+
+    /// @brief The underlying parser, for diagnostics.
+    ///
+    /// @return Const reference to the embedded `Parser`.
+    [[nodiscard]] auto parser() const noexcept -> const Parser& { return m_parser; }
+
+   private:
+    /// @brief Appends bytes to the split frame until it is complete, and then
+    ///        decodes it.
+    ///
+    /// @param data Bytes continuing the split frame.
+    /// @return The number of bytes taken from `data`: all of it if the frame is
+    ///         still incomplete, otherwise exactly the rest of the frame.
+    auto carry(std::span<const std::byte> data) -> std::size_t;
+
+    Parser                                m_parser {};
+    MessageCallback                       m_callback;
+    MessageTypeFilter                     m_filter;
+    std::array<std::byte, CARRY_CAPACITY> m_carry {};
+    std::size_t                           m_carried {0};       ///< Bytes held in `m_carry`.
+    std::size_t                           m_kept {0};          ///< Bytes of the frame to hold.
+    std::size_t                           m_received {0};      ///< Bytes of the frame received.
+    std::size_t                           m_frame_size {0};    ///< Frame size with its prefix.
+    std::uint64_t                         m_position {0};      ///< Bytes fed in this stream.
+    std::uint64_t                         m_frame_offset {0};  ///< Stream offset of a split frame.
+};
+
+}  // namespace itch
@@ -54,6 +54,9 @@ class PcapReader {
 
     /// @brief Reads and decodes a capture file from disk.
     ///
+    /// The file is memory-mapped and decoded in place rather than copied into
+    /// a buffer first.
+    ///
     /// @param path Filesystem path to the `.pcap` or `.pcapng` file to read.
     /// @return `true` on a recognized, readable file; `false` if the file cannot
     ///         be opened or is not a capture.
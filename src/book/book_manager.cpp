@@ -1,5 +1,6 @@
 #include "itch/book/book_manager.hpp"
 
+#include <cstring>
 #include <utility>
 #include <variant>
 
@@ -25,6 +26,11 @@ auto BookManager::entry(std::uint16_t stock_locate) const -> BookEntry* {
     return m_books_by_locate[stock_locate].get();
 }
 
+auto BookManager::entry_for_order(std::uint64_t reference_number) const -> BookEntry* {
+    const OrderIndex::Entry found = m_orders->lookup(reference_number);
+    return found.value != OrderIndex::NPOS ? entry(found.owner) : nullptr;
+}
+
 auto BookManager::ensure_entry(std::uint16_t stock_locate, std::string_view symbol) -> BookEntry* {
     if (stock_locate >= m_books_by_locate.size()) {
         m_books_by_locate.resize(static_cast<std::size_t>(stock_locate) + 1);
@@ -38,8 +44,11 @@ auto BookManager::ensure_entry(std::uint16_t stock_locate, std::string_view symb
     if (!in_universe(symbol)) {
         return nullptr;
     }
-    m_books_by_locate[stock_locate] = std::make_unique<BookEntry>();
-    m_books_by_locate[stock_locate]->book.set_symbol(std::string {symbol});
+    auto created          = std::make_unique<BookEntry>();
+    created->book         = L3Book {std::string {symbol}, *m_orders, stock_locate};
+    created->stock_locate = stock_locate;
+
+    m_books_by_locate[stock_locate] = std::move(created);
     ++m_book_count;
     return m_books_by_locate[stock_locate].get();
 }
@@ -66,7 +75,7 @@ auto BookManager::handle_add_order(const AddMessage& add) -> void {
 }
 
 auto BookManager::handle_order_executed(const OrderExecutedMessage& exec) -> void {
-    BookEntry* target = entry(exec.stock_locate);
+    BookEntry* target = entry_for_order(exec.order_reference_number);
     if (target == nullptr) {
         return;
     }
@@ -76,7 +85,7 @@ auto BookManager::handle_order_executed(const OrderExecutedMessage& exec) -> voi
         if (price.has_value()) {
             Trade trade {};
             trade.timestamp    = exec.timestamp;
-            trade.stock_locate = exec.stock_locate;
+            trade.stock_locate = target->stock_locate;
             trade.symbol       = target->book.symbol();
             trade.price        = StandardPrice {*price};
             trade.shares       = exec.executed_shares;
@@ -92,7 +101,7 @@ auto BookManager::handle_order_executed(const OrderExecutedMessage& exec) -> voi
 
 auto BookManager::handle_order_executed_with_price(const OrderExecutedWithPriceMessage& exec
 ) -> void {
-    BookEntry* target = entry(exec.stock_locate);
+    BookEntry* target = entry_for_order(exec.order_reference_number);
     if (target == nullptr) {
         return;
     }
@@ -100,7 +109,7 @@ auto BookManager::handle_order_executed_with_price(const OrderExecutedWithPriceM
         const auto side = target->book.order_side(exec.order_reference_number);
         Trade      trade {};
         trade.timestamp    = exec.timestamp;
-        trade.stock_locate = exec.stock_locate;
+        trade.stock_locate = target->stock_locate;
         trade.symbol       = target->book.symbol();
         trade.price        = StandardPrice {exec.execution_price};
         trade.shares       = exec.executed_shares;
@@ -114,21 +123,21 @@ auto BookManager::handle_order_executed_with_price(const OrderExecutedWithPriceM
 }
 
 auto BookManager::handle_order_cancel(const OrderCancelMessage& cancel) -> void {
-    if (BookEntry* target = entry(cancel.stock_locate)) {
+    if (BookEntry* target = entry_for_order(cancel.order_reference_number)) {
         target->book.reduce_order(cancel.order_reference_number, cancel.cancelled_shares);
         emit_bbo_if_changed(*target);
     }
 }
 
 auto BookManager::handle_order_delete(const OrderDeleteMessage& del) -> void {
-    if (BookEntry* target = entry(del.stock_locate)) {
+    if (BookEntry* target = entry_for_order(del.order_reference_number)) {
         target->book.delete_order(del.order_reference_number);
         emit_bbo_if_changed(*target);
     }
 }
 
 auto BookManager::handle_order_replace(const OrderReplaceMessage& replace) -> void {
-    if (BookEntry* target = entry(replace.stock_locate)) {
+    if (BookEntry* target = entry_for_order(replace.original_order_reference_number)) {
         target->book.replace_order(
             replace.original_order_reference_number,
             replace.new_order_reference_number,
@@ -205,6 +214,133 @@ auto BookManager::process(const Message& message) -> void {
     }
 }
 
+// The view overloads read only the fields their handler uses into a message
+// struct, leaving the rest of it value-initialised and undecoded.
+
+auto BookManager::operator()(const overlay::AddOrderView& add) -> void {
+    AddOrderMessage msg {};
+    msg.stock_locate           = add.stock_locate();
+    msg.order_reference_number = add.order_reference_number();
+    msg.buy_sell_indicator     = add.buy_sell_indicator();
+    msg.shares                 = add.shares();
+    msg.price                  = add.price();
+    std::memcpy(msg.stock, add.stock().data(), STOCK_LEN);
+    handle_add_order(msg);
+}
+
+auto BookManager::operator()(const overlay::AddOrderMPIDAttributionView& add) -> void {
+    AddOrderMPIDAttributionMessage msg {};
+    msg.stock_locate           = add.stock_locate();
+    msg.order_reference_number = add.order_reference_number();
+    msg.buy_sell_indicator     = add.buy_sell_indicator();
+    msg.shares                 = add.shares();
+    msg.price                  = add.price();
+    std::memcpy(msg.stock, add.stock().data(), STOCK_LEN);
+    handle_add_order(msg);
+}
+
+auto BookManager::operator()(const overlay::OrderExecutedView& exec) -> void {
+    OrderExecutedMessage msg {};
+    msg.order_reference_number = exec.order_reference_number();
+    msg.executed_shares        = exec.executed_shares();
+    if (m_trade_callback) {
+        msg.timestamp    = exec.timestamp();
+        msg.match_number = exec.match_number();
+    }
+    handle_order_executed(msg);
+}
+
+auto BookManager::operator()(const overlay::OrderExecutedWithPriceView& exec) -> void {
+    OrderExecutedWithPriceMessage msg {};
+    msg.order_reference_number = exec.order_reference_number();
+    msg.executed_shares        = exec.executed_shares();
+    if (m_trade_callback) {
+        msg.timestamp       = exec.timestamp();
+        msg.match_number    = exec.match_number();
+        msg.printable       = exec.printable();
+        msg.execution_price = exec.execution_price();
+    }
+    handle_order_executed_with_price(msg);
+}
+
+auto BookManager::operator()(const overlay::OrderCancelView& cancel) -> void {
+    OrderCancelMessage msg {};
+    msg.order_reference_number = cancel.order_reference_number();
+    msg.cancelled_shares       = cancel.cancelled_shares();
+    handle_order_cancel(msg);
+}
+
+auto BookManager::operator()(const overlay::OrderDeleteView& del) -> void {
+    OrderDeleteMessage msg {};
+    msg.order_reference_number = del.order_reference_number();
+    handle_order_delete(msg);
+}
+
+auto BookManager::operator()(const overlay::OrderReplaceView& replace) -> void {
+    OrderReplaceMessage msg {};
+    msg.original_order_reference_number = replace.original_order_reference_number();
+    msg.new_order_reference_number      = replace.new_order_reference_number();
+    msg.shares                          = replace.shares();
+    msg.price                           = replace.price();
+    handle_order_replace(msg);
+}
+
+auto BookManager::operator()(const overlay::NonCrossTradeView& trade) -> void {
+    if (m_trade_callback) {
+        handle_non_cross_trade(trade.decode());
+    }
+}
+
+auto BookManager::operator()(const overlay::CrossTradeView& cross) -> void {
+    if (m_trade_callback) {
+        handle_cross_trade(cross.decode());
+    }
+}
+
+auto BookManager::operator()(const overlay::StockDirectoryView& directory) -> void {
+    StockDirectoryMessage msg {};
+    msg.stock_locate = directory.stock_locate();
+    std::memcpy(msg.stock, directory.stock().data(), STOCK_LEN);
+    handle_stock_directory(msg);
+}
+
+auto BookManager::process(const overlay::MessageView& view) -> void {
+    switch (view.type()) {
+        case overlay::AddOrderView::TYPE:
+            (*this)(overlay::AddOrderView {view.data(), view.size()});
+            break;
+        case overlay::AddOrderMPIDAttributionView::TYPE:
+            (*this)(overlay::AddOrderMPIDAttributionView {view.data(), view.size()});
+            break;
+        case overlay::OrderExecutedView::TYPE:
+            (*this)(overlay::OrderExecutedView {view.data(), view.size()});
+            break;
+        case overlay::OrderExecutedWithPriceView::TYPE:
+            (*this)(overlay::OrderExecutedWithPriceView {view.data(), view.size()});
+            break;
+        case overlay::OrderCancelView::TYPE:
+            (*this)(overlay::OrderCancelView {view.data(), view.size()});
+            break;
+        case overlay::OrderDeleteView::TYPE:
+            (*this)(overlay::OrderDeleteView {view.data(), view.size()});
+            break;
+        case overlay::OrderReplaceView::TYPE:
+            (*this)(overlay::OrderReplaceView {view.data(), view.size()});
+            break;
+        case overlay::NonCrossTradeView::TYPE:
+            (*this)(overlay::NonCrossTradeView {view.data(), view.size()});
+            break;
+        case overlay::CrossTradeView::TYPE:
+            (*this)(overlay::CrossTradeView {view.data(), view.size()});
+            break;
+        case overlay::StockDirectoryView::TYPE:
+            (*this)(overlay::StockDirectoryView {view.data(), view.size()});
+            break;
+        default:
+            break;  // Carries nothing the books need.
+    }
+}
+
 template auto BookManager::handle_add_order(const AddOrderMessage&) -> void;
 template auto BookManager::handle_add_order(const AddOrderMPIDAttributionMessage&) -> void;
 
@@ -5,14 +5,47 @@
 
 namespace itch::book {
 
-L3Book::L3Book(std::string symbol) : m_symbol {std::move(symbol)} {}
+L3Book::L3Book(std::string symbol, OrderIndexMode index_mode)
+    : m_symbol {std::move(symbol)}, m_index {index_mode} {}
 
-auto L3Book::side_levels(Side side) noexcept -> std::vector<Level>& {
-    return side == Side::buy ? m_bids : m_asks;
+L3Book::L3Book(std::string symbol, OrderIndex& shared_index, std::uint16_t owner)
+    : m_symbol {std::move(symbol)}, m_shared_index {&shared_index}, m_owner {owner} {}
+
+L3Book::L3Book(const L3Book& other)
+    : m_symbol {other.m_symbol},
+      m_pool {other.m_pool},
+      m_free_head {other.m_free_head},
+      m_levels {other.m_levels},
+      m_free_level {other.m_free_level},
+      m_bid_ladder {other.m_bid_ladder},
+      m_ask_ladder {other.m_ask_ladder},
+      m_index {other.m_index} {
+    if (other.m_shared_index == nullptr) {
+        return;
+    }
+    // Detach from the shared index: free pool nodes have no level, live ones
+    // are re-entered under the private index's default owner.
+    m_index = OrderIndex {other.m_shared_index->mode()};
+    for (std::uint32_t node_index = 0; node_index < m_pool.size(); ++node_index) {
+        if (m_pool[node_index].level != NIL) {
+            m_index.insert(m_pool[node_index].reference_number, node_index);
+        }
+    }
 }
 
-auto L3Book::side_levels(Side side) const noexcept -> const std::vector<Level>& {
-    return side == Side::buy ? m_bids : m_asks;
+auto L3Book::operator=(const L3Book& other) -> L3Book& {
+    if (this != &other) {
+        *this = L3Book {other};
+    }
+    return *this;
+}
+
+auto L3Book::side_ladder(Side side) noexcept -> PriceLadder& {
+    return side == Side::buy ? m_bid_ladder : m_ask_ladder;
+}
+
+auto L3Book::side_ladder(Side side) const noexcept -> const PriceLadder& {
+    return side == Side::buy ? m_bid_ladder : m_ask_ladder;
 }
 
 auto L3Book::allocate_node() -> std::uint32_t {
@@ -32,68 +65,44 @@ auto L3Book::free_node(std::uint32_t node_index) -> void {
     m_free_head             = node_index;
 }
 
-auto L3Book::find_level(Side side, std::uint32_t price) const -> std::uint32_t {
-    const auto& levels = side_levels(side);
-    // Bids are sorted descending, asks ascending; binary search accordingly.
-    // std::ranges::lower_bound would be the modern spelling, but it trips a
-    // known Clang/libstdc++ interop gap on some toolchains, so this sticks
-    // with the plain iterator-pair form for portability.
-    if (side == Side::buy) {
-        // NOLINTNEXTLINE(modernize-use-ranges)
-        const auto iter = std::lower_bound(
-            levels.begin(),
-            levels.end(),
-            price,
-            [](const Level& level, std::uint32_t value) { return level.price > value; }
-        );
-        if (iter != levels.end() && iter->price == price) {
-            return static_cast<std::uint32_t>(iter - levels.begin());
-        }
-    } else {
-        // NOLINTNEXTLINE(modernize-use-ranges)
-        const auto iter = std::lower_bound(
-            levels.begin(),
-            levels.end(),
-            price,
-            [](const Level& level, std::uint32_t value) { return level.price < value; }
-        );
-        if (iter != levels.end() && iter->price == price) {
-            return static_cast<std::uint32_t>(iter - levels.begin());
-        }
+auto L3Book::allocate_level() -> std::uint32_t {
+    if (m_free_level != NIL) {
+        const std::uint32_t index = m_free_level;
+        m_free_level              = m_levels[index].head;
+        m_levels[index]           = Level {};
+        return index;
     }
-    return NIL;
+    m_levels.push_back(Level {});
+    return static_cast<std::uint32_t>(m_levels.size() - 1);
+}
+
+auto L3Book::free_level(std::uint32_t level_index) -> void {
+    m_levels[level_index]      = Level {};
+    m_levels[level_index].head = m_free_level;
+    m_free_level               = level_index;
+}
+
+auto L3Book::find_level(Side side, std::uint32_t price) const -> std::uint32_t {
+    return side_ladder(side).find(price);
 }
 
 auto L3Book::find_or_create_level(Side side, std::uint32_t price) -> std::uint32_t {
-    auto& levels = side_levels(side);
-    // See find_level's comment above on why these stay iterator-pair calls.
-    auto position =
-        side == Side::buy
-            ? std::lower_bound(  // NOLINT(modernize-use-ranges)
-                  levels.begin(),
-                  levels.end(),
-                  price,
-                  [](const Level& level, std::uint32_t value) { return level.price > value; }
-              )
-            : std::lower_bound(  // NOLINT(modernize-use-ranges)
-                  levels.begin(),
-                  levels.end(),
-                  price,
-                  [](const Level& level, std::uint32_t value) { return level.price < value; }
-              );
-    if (position != levels.end() && position->price == price) {
-        return static_cast<std::uint32_t>(position - levels.begin());
+    PriceLadder& ladder = side_ladder(side);
+    if (const std::uint32_t existing = ladder.find(price); existing != NIL) {
+        return existing;
     }
-    Level new_level {};
-    new_level.price     = price;
-    const auto inserted = levels.insert(position, new_level);
-    return static_cast<std::uint32_t>(inserted - levels.begin());
+    const std::uint32_t level_index = allocate_level();
+    m_levels[level_index].price     = price;
+    ladder.insert(price, level_index);
+    return level_index;
 }
 
 auto L3Book::add_order(
     std::uint64_t reference_number, Side side, std::uint32_t shares, std::uint32_t price
 ) -> void {
-    if (m_index.find(reference_number) != OrderIndex::NPOS) {
+    // Reference numbers are unique feed-wide, so a shared index rejects a
+    // duplicate of another book's order too.
+    if (index().contains(reference_number)) {
         return;  // Duplicate add; ignore to keep the book consistent.
     }
     const std::uint32_t node_index = allocate_node();
@@ -104,7 +113,8 @@ auto L3Book::add_order(
     node.side                      = side;
 
     const std::uint32_t level_index = find_or_create_level(side, price);
-    Level&              level       = side_levels(side)[level_index];
+    Level&              level       = m_levels[level_index];
+    node.level                      = level_index;
 
     // Append to the tail of the level FIFO to preserve time priority.
     node.prev = level.tail;
@@ -118,17 +128,13 @@ auto L3Book::add_order(
     level.total_shares += shares;
     ++level.order_count;
 
-    m_index.insert(reference_number, node_index);
+    index().insert(reference_number, node_index, m_owner);
 }
 
 auto L3Book::unlink_node(std::uint32_t node_index) -> void {
     OrderNode&          node        = m_pool[node_index];
-    const std::uint32_t level_index = find_level(node.side, node.price);
-    if (level_index == NIL) {
-        return;
-    }
-    auto&  levels = side_levels(node.side);
-    Level& level  = levels[level_index];
+    const std::uint32_t level_index = node.level;
+    Level&              level       = m_levels[level_index];
 
     if (node.prev != NIL) {
         m_pool[node.prev].next = node.next;
@@ -143,12 +149,13 @@ auto L3Book::unlink_node(std::uint32_t node_index) -> void {
     level.total_shares -= node.shares;
     --level.order_count;
     if (level.order_count == 0) {
-        levels.erase(levels.begin() + level_index);
+        side_ladder(node.side).erase(level.price);
+        free_level(level_index);
     }
 }
 
 auto L3Book::execute_order(std::uint64_t reference_number, std::uint32_t shares) -> std::uint32_t {
-    const std::uint32_t node_index = m_index.find(reference_number);
+    const std::uint32_t node_index = index().find(reference_number, m_owner);
     if (node_index == OrderIndex::NPOS) {
         return 0;
     }
@@ -158,15 +165,12 @@ auto L3Book::execute_order(std::uint64_t reference_number, std::uint32_t shares)
     if (removed == node.shares) {
         unlink_node(node_index);
         free_node(node_index);
-        m_index.erase(reference_number);
+        index().erase(reference_number);
         return removed;
     }
 
-    node.shares -= removed;
-    const std::uint32_t level_index = find_level(node.side, node.price);
-    if (level_index != NIL) {
-        side_levels(node.side)[level_index].total_shares -= removed;
-    }
+    node.shares                       -= removed;
+    m_levels[node.level].total_shares -= removed;
     return removed;
 }
 
@@ -176,13 +180,13 @@ auto L3Book::reduce_order(std::uint64_t reference_number, std::uint32_t shares)
 }
 
 auto L3Book::delete_order(std::uint64_t reference_number) -> void {
-    const std::uint32_t node_index = m_index.find(reference_number);
+    const std::uint32_t node_index = index().find(reference_number, m_owner);
     if (node_index == OrderIndex::NPOS) {
         return;
     }
     unlink_node(node_index);
     free_node(node_index);
-    m_index.erase(reference_number);
+    index().erase(reference_number);
 }
 
 auto L3Book::replace_order(
@@ -191,7 +195,7 @@ auto L3Book::replace_order(
     std::uint32_t shares,
     std::uint32_t price
 ) -> void {
-    const std::uint32_t node_index = m_index.find(old_reference_number);
+    const std::uint32_t node_index = index().find(old_reference_number, m_owner);
     if (node_index == OrderIndex::NPOS) {
         return;
     }
@@ -201,11 +205,11 @@ auto L3Book::replace_order(
 }
 
 auto L3Book::contains(std::uint64_t reference_number) const -> bool {
-    return m_index.contains(reference_number);
+    return index().find(reference_number, m_owner) != OrderIndex::NPOS;
 }
 
 auto L3Book::order_price(std::uint64_t reference_number) const -> std::optional<std::uint32_t> {
-    const std::uint32_t node_index = m_index.find(reference_number);
+    const std::uint32_t node_index = index().find(reference_number, m_owner);
     if (node_index == OrderIndex::NPOS) {
         return std::nullopt;
     }
@@ -213,7 +217,7 @@ auto L3Book::order_price(std::uint64_t reference_number) const -> std::optional<
 }
 
 auto L3Book::order_side(std::uint64_t reference_number) const -> std::optional<Side> {
-    const std::uint32_t node_index = m_index.find(reference_number);
+    const std::uint32_t node_index = index().find(reference_number, m_owner);
     if (node_index == OrderIndex::NPOS) {
         return std::nullopt;
     }
@@ -222,31 +226,34 @@ auto L3Book::order_side(std::uint64_t reference_number) const -> std::optional<S
 
 auto L3Book::bbo() const -> Bbo {
     Bbo result {};
-    if (!m_bids.empty()) {
+    if (const std::uint32_t best_bid = m_bid_ladder.best(); best_bid != NIL) {
         result.has_bid    = true;
-        result.bid_price  = StandardPrice {m_bids.front().price};
-        result.bid_shares = m_bids.front().total_shares;
+        result.bid_price  = StandardPrice {m_levels[best_bid].price};
+        result.bid_shares = m_levels[best_bid].total_shares;
     }
-    if (!m_asks.empty()) {
+    if (const std::uint32_t best_ask = m_ask_ladder.best(); best_ask != NIL) {
         result.has_ask    = true;
-        result.ask_price  = StandardPrice {m_asks.front().price};
-        result.ask_shares = m_asks.front().total_shares;
+        result.ask_price  = StandardPrice {m_levels[best_ask].price};
+        result.ask_shares = m_levels[best_ask].total_shares;
     }
     return result;
 }
 
 auto L3Book::depth(Side side, std::size_t max_levels) const -> std::vector<DepthLevel> {
-    const auto&       levels = side_levels(side);
-    const std::size_t count = max_levels == 0 ? levels.size() : std::min(max_levels, levels.size());
+    const PriceLadder& ladder = side_ladder(side);
+    const std::size_t  count =
+        max_levels == 0 ? ladder.size() : std::min(max_levels, ladder.size());
     std::vector<DepthLevel> result;
     result.reserve(count);
-    for (std::size_t index = 0; index < count; ++index) {
+    ladder.for_each([&](std::uint32_t level_index) {
+        const Level& level = m_levels[level_index];
         result.push_back(DepthLevel {
-            .price       = StandardPrice {levels[index].price},
-            .shares      = levels[index].total_shares,
-            .order_count = levels[index].order_count,
+            .price       = StandardPrice {level.price},
+            .shares      = level.total_shares,
+            .order_count = level.order_count,
         });
-    }
+        return result.size() < count;
+    });
     return result;
 }
 
@@ -256,7 +263,7 @@ auto L3Book::orders_at(Side side, std::uint32_t price) const -> std::vector<Orde
     if (level_index == NIL) {
         return result;
     }
-    const Level& level = side_levels(side)[level_index];
+    const Level& level = m_levels[level_index];
     result.reserve(level.order_count);
     for (std::uint32_t node_index = level.head; node_index != NIL;
          node_index               = m_pool[node_index].next) {
@@ -271,7 +278,7 @@ auto L3Book::orders_at(Side side, std::uint32_t price) const -> std::vector<Orde
 }
 
 auto L3Book::level_count(Side side) const noexcept -> std::size_t {
-    return side_levels(side).size();
+    return side_ladder(side).size();
 }
 
 }  // namespace itch::book
@@ -0,0 +1,29 @@
+#include "itch/book/order_index.hpp"
+
+#include <cstdint>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace itch::book {
+
+auto OrderIndex::release_pages(std::byte* data, std::size_t size) noexcept -> void {
+#ifdef _WIN32
+    // Heap blocks cannot be partially decommitted; the table is freed whole.
+    static_cast<void>(data);
+    static_cast<void>(size);
+#else
+    static const auto page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+    // Only whole pages inside the range are released, so the allocator's
+    // bookkeeping around the block is never touched.
+    const auto begin = (reinterpret_cast<std::uintptr_t>(data) + page - 1) & ~(page - 1);
+    const auto end   = (reinterpret_cast<std::uintptr_t>(data) + size) & ~(page - 1);
+    if (begin < end) {
+        ::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+    }
+#endif
+}
+
+}  // namespace itch::book
@@ -0,0 +1,59 @@
+#include "itch/columnar.hpp"
+
+#include <variant>
+
+namespace itch {
+
+ColumnarBatch::ColumnarBatch(std::size_t capacity)
+    : m_capacity(capacity != 0 ? capacity : DEFAULT_CAPACITY) {}
+
+auto ColumnarBatch::append(const Message& message) -> void {
+    std::visit([this](const auto& msg) { (*this)(msg); }, message);
+}
+
+auto ColumnarBatch::clear() noexcept -> void {
+    m_add_orders.clear();
+    m_add_orders_mpid.clear();
+    m_executions.clear();
+    m_executions_with_price.clear();
+    m_cancels.clear();
+    m_deletes.clear();
+    m_replaces.clear();
+    m_trades.clear();
+    m_cross_trades.clear();
+    m_broken_trades.clear();
+    m_other.clear();
+    m_size = 0;
+}
+
+auto parse_columnar(
+    Parser&                      parser,
+    std::span<const std::byte>   data,
+    ColumnarBatch&               batch,
+    const ColumnarBatchCallback& on_batch
+) -> void {
+    batch.clear();
+    parser.parse_with(data, [&](const auto& msg) {
+        batch(msg);
+        if (batch.full()) {
+            on_batch(batch);
+            batch.clear();
+        }
+    });
+    if (!batch.empty()) {
+        on_batch(batch);
+        batch.clear();
+    }
+}
+
+auto parse_columnar(
+    Parser&                      parser,
+    std::span<const std::byte>   data,
+    std::size_t                  batch_size,
+    const ColumnarBatchCallback& on_batch
+) -> void {
+    ColumnarBatch batch {batch_size};
+    parse_columnar(parser, data, batch, on_batch);
+}
+
+}  // namespace itch
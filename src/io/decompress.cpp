@@ -0,0 +1,386 @@
+#include "itch/io/decompress.hpp"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef ITCH_WITH_ZLIB
+#define ZLIB_CONST
+#include <zlib.h>
+#endif
+
+#ifdef ITCH_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace itch::io {
+
+namespace {
+
+constexpr std::byte GZIP_MAGIC_0 {0x1F};
+constexpr std::byte GZIP_MAGIC_1 {0x8B};
+
+constexpr std::array<std::byte, 4> ZSTD_MAGIC {
+    std::byte {0x28}, std::byte {0xB5}, std::byte {0x2F}, std::byte {0xFD}
+};
+
+// Streams decompressed bytes out of a whole compressed buffer.
+class Decoder {
+   public:
+    Decoder()                                  = default;
+    Decoder(const Decoder&)                    = delete;
+    auto operator=(const Decoder&) -> Decoder& = delete;
+    Decoder(Decoder&&)                         = delete;
+    auto operator=(Decoder&&) -> Decoder&      = delete;
+    virtual ~Decoder()                         = default;
+
+    // Fills `out` as far as the stream allows, counting the bytes written in
+    // `produced` as it goes so that they survive a throw. Stops short of
+    // `out.size()` only once the stream has ended.
+    virtual auto fill(std::span<std::byte> out, std::size_t& produced) -> void = 0;
+};
+
+#ifdef ITCH_WITH_ZLIB
+
+// zlib's counters are 32-bit, so a large input is handed over in slices.
+constexpr std::size_t ZLIB_MAX_SLICE = std::numeric_limits<uInt>::max();
+
+class GzipDecoder final : public Decoder {
+   public:
+    explicit GzipDecoder(std::span<const std::byte> input) : m_input(input) {
+        // 15 window bits plus 32 asks zlib to accept a gzip or zlib header.
+        if (inflateInit2(&m_stream, MAX_WBITS + 32) != Z_OK) {
+            throw std::runtime_error("Failed to initialize the gzip decoder.");
+        }
+    }
+    GzipDecoder(const GzipDecoder&)                    = delete;
+    auto operator=(const GzipDecoder&) -> GzipDecoder& = delete;
+    GzipDecoder(GzipDecoder&&)                         = delete;
+    auto operator=(GzipDecoder&&) -> GzipDecoder&      = delete;
+    ~GzipDecoder() override { inflateEnd(&m_stream); }
+
+    auto fill(std::span<std::byte> out, std::size_t& produced) -> void override {
+        while (produced < out.size() && !m_finished) {
+            if (m_stream.avail_in == 0) {
+                refill();
+            }
+            const auto room    = std::min(out.size() - produced, ZLIB_MAX_SLICE);
+            m_stream.next_out  = static_cast<Bytef*>(static_cast<void*>(out.data() + produced));
+            m_stream.avail_out = static_cast<uInt>(room);
+            const int status   = inflate(&m_stream, Z_NO_FLUSH);
+            produced += room - m_stream.avail_out;
+
+            if (status == Z_STREAM_END) {
+                // A file may hold several gzip members back to back; carry on
+                // with the next one unless the input is exhausted.
+                if (m_stream.avail_in == 0) {
+                    refill();
+                }
+                if (m_stream.avail_in == 0) {
+                    m_finished = true;
+                } else if (inflateReset(&m_stream) != Z_OK) {
+                    throw std::runtime_error("Failed to reset the gzip decoder.");
+                }
+            } else if (status == Z_BUF_ERROR && m_stream.avail_in == 0) {
+                if (m_offset == m_input.size()) {
+                    throw std::runtime_error("Truncated gzip input.");
+                }
+            } else if (status != Z_OK) {
+                throw std::runtime_error(
+                    std::string("Corrupt gzip input: ") +
+                    (m_stream.msg != nullptr ? m_stream.msg : "inflate failed")
+                );
+            }
+        }
+    }
+
+   private:
+    // Hands zlib the next slice of input.
+    auto refill() noexcept -> void {
+        const auto slice   = std::min(m_input.size() - m_offset, ZLIB_MAX_SLICE);
+        // NOLINTNEXTLINE(bugprone-casting-through-void)
+        m_stream.next_in   = static_cast<const Bytef*>(static_cast<const void*>(
+            m_input.data() + m_offset
+        ));
+        m_stream.avail_in  = static_cast<uInt>(slice);
+        m_offset          += slice;
+    }
+
+    std::span<const std::byte> m_input;
+    std::size_t                m_offset {0};  ///< Input bytes handed to zlib so far.
+    z_stream                   m_stream {};
+    bool                       m_finished {false};
+};
+
+#endif
+
+#ifdef ITCH_WITH_ZSTD
+
+class ZstdDecoder final : public Decoder {
+   public:
+    explicit ZstdDecoder(std::span<const std::byte> input)
+        : m_input {input.data(), input.size(), 0}, m_context(ZSTD_createDCtx()) {
+        if (m_context == nullptr) {
+            throw std::runtime_error("Failed to initialize the zstd decoder.");
+        }
+    }
+    ZstdDecoder(const ZstdDecoder&)                    = delete;
+    auto operator=(const ZstdDecoder&) -> ZstdDecoder& = delete;
+    ZstdDecoder(ZstdDecoder&&)                         = delete;
+    auto operator=(ZstdDecoder&&) -> ZstdDecoder&      = delete;
+    ~ZstdDecoder() override { ZSTD_freeDCtx(m_context); }
+
+    auto fill(std::span<std::byte> out, std::size_t& produced) -> void override {
+        ZSTD_outBuffer output {out.data(), out.size(), produced};
+        while (output.pos < output.size) {
+            if (m_input.pos == m_input.size && m_pending == 0) {
+                break;
+            }
+            const auto before = output.pos;
+            m_pending         = ZSTD_decompressStream(m_context, &output, &m_input);
+            produced          = output.pos;
+            if (ZSTD_isError(m_pending) != 0U) {
+                throw std::runtime_error(
+                    std::string("Corrupt zstd input: ") + ZSTD_getErrorName(m_pending)
+                );
+            }
+            // A frame still open with all input consumed and no further
+            // output means the input was cut short.
+            if (m_input.pos == m_input.size && m_pending != 0 && output.pos == before) {
+                throw std::runtime_error("Truncated zstd input.");
+            }
+        }
+    }
+
+   private:
+    ZSTD_inBuffer m_input;
+    ZSTD_DCtx*    m_context;
+    std::size_t   m_pending {0};  ///< zstd's hint; non-zero while a frame is open.
+};
+
+#endif
+
+auto make_decoder(std::span<const std::byte> input, Compression compression)
+    -> std::unique_ptr<Decoder> {
+    switch (compression) {
+#ifdef ITCH_WITH_ZLIB
+        case Compression::gzip:
+            return std::make_unique<GzipDecoder>(input);
+#endif
+#ifdef ITCH_WITH_ZSTD
+        case Compression::zstd:
+            return std::make_unique<ZstdDecoder>(input);
+#endif
+        default:
+            break;
+    }
+    static_cast<void>(input);
+    throw std::runtime_error(
+        "This build of itch cannot decompress " + std::string(to_string(compression)) +
+        " input; rebuild with ITCH_WITH_ZLIB / ITCH_WITH_ZSTD."
+    );
+}
+
+// The ring shared by the decompression thread and the consumer. The producer
+// fills block `n % blocks` for the n-th block; the consumer hands a block back
+// once the carried tail has been copied out of it.
+class BlockRing {
+   public:
+    explicit BlockRing(const DecompressOptions& options)
+        : m_headroom(options.max_carry), m_block_size(options.block_size) {
+        m_blocks.resize(options.blocks);
+        for (auto& block : m_blocks) {
+            // NOLINTNEXTLINE(*-avoid-c-arrays)
+            block.data = std::make_unique_for_overwrite<std::byte[]>(m_headroom + m_block_size);
+        }
+    }
+
+    // Decompresses into free blocks until the stream ends, `stop` is called,
+    // or the decoder throws. A block cut short by an error is still published,
+    // ahead of the error, so the consumer sees every byte that was recovered.
+    auto produce(Decoder& decoder) -> void {
+        for (std::size_t sequence = 0;; ++sequence) {
+            {
+                std::unique_lock lock {m_mutex};
+                m_space.wait(lock, [&] {
+                    return m_stopped || sequence - m_released < m_blocks.size();
+                });
+                if (m_stopped) {
+                    return;
+                }
+            }
+            Block&             block  = slot(sequence);
+            std::size_t        filled = 0;
+            std::exception_ptr error;
+            try {
+                decoder.fill({block.data.get() + m_headroom, m_block_size}, filled);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            block.filled = filled;
+
+            const std::scoped_lock lock {m_mutex};
+            if (filled > 0) {
+                ++m_produced;
+            }
+            m_error = error;
+            m_done  = error || filled < m_block_size;
+            m_ready.notify_one();
+            if (m_done) {
+                return;
+            }
+        }
+    }
+
+    // Runs the consumer over each block in order, carrying unconsumed tails.
+    auto consume(const BlockConsumer& consumer) -> std::size_t {
+        std::size_t      carry = 0;
+        const std::byte* tail  = nullptr;
+        for (std::size_t sequence = 0;; ++sequence) {
+            {
+                std::unique_lock lock {m_mutex};
+                m_ready.wait(lock, [&] { return m_produced > sequence || m_done; });
+                if (m_produced <= sequence) {
+                    if (m_error) {
+                        std::rethrow_exception(m_error);
+                    }
+                    break;
+                }
+            }
+            Block&     block = slot(sequence);
+            std::byte* begin = block.data.get() + m_headroom - carry;
+            if (carry > 0) {
+                std::memcpy(begin, tail, carry);
+            }
+            if (sequence > 0) {
+                release();
+            }
+
+            const std::span<const std::byte> view {begin, carry + block.filled};
+            const auto consumed = std::min(consumer(view), view.size());
+            carry               = view.size() - consumed;
+            tail                = begin + consumed;
+            if (carry > m_headroom) {
+                throw std::runtime_error("Unconsumed bytes exceed the decompression carry limit.");
+            }
+        }
+        return carry;
+    }
+
+    // Stops the producer at its next block boundary.
+    auto stop() -> void {
+        const std::scoped_lock lock {m_mutex};
+        m_stopped = true;
+        m_space.notify_one();
+    }
+
+   private:
+    struct Block {
+        // NOLINTNEXTLINE(*-avoid-c-arrays)
+        std::unique_ptr<std::byte[]> data;  ///< Carry headroom, then the block.
+        std::size_t                  filled {0};
+    };
+
+    auto slot(std::size_t sequence) -> Block& { return m_blocks[sequence % m_blocks.size()]; }
+
+    auto release() -> void {
+        const std::scoped_lock lock {m_mutex};
+        ++m_released;
+        m_space.notify_one();
+    }
+
+    std::vector<Block>      m_blocks;
+    std::size_t             m_headroom;
+    std::size_t             m_block_size;
+    std::mutex              m_mutex;
+    std::condition_variable m_ready;             ///< A block was produced, or the stream ended.
+    std::condition_variable m_space;             ///< A block was released, or `stop` was called.
+    std::size_t             m_produced {0};      ///< Blocks handed to the consumer.
+    std::size_t             m_released {0};      ///< Blocks handed back to the producer.
+    bool                    m_done {false};      ///< The producer has published its last block.
+    bool                    m_stopped {false};   ///< The consumer has gone away.
+    std::exception_ptr      m_error;
+};
+
+}  // namespace
+
+auto detect_compression(std::span<const std::byte> data) noexcept -> Compression {
+    if (data.size() >= 2 && data[0] == GZIP_MAGIC_0 && data[1] == GZIP_MAGIC_1) {
+        return Compression::gzip;
+    }
+    if (data.size() >= ZSTD_MAGIC.size() &&
+        std::equal(ZSTD_MAGIC.begin(), ZSTD_MAGIC.end(), data.begin())) {
+        return Compression::zstd;
+    }
+    return Compression::none;
+}
+
+auto compression_supported(Compression compression) noexcept -> bool {
+    switch (compression) {
+        case Compression::none:
+            return true;
+        case Compression::gzip:
+#ifdef ITCH_WITH_ZLIB
+            return true;
+#else
+            return false;
+#endif
+        case Compression::zstd:
+#ifdef ITCH_WITH_ZSTD
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+auto for_each_decompressed_block(
+    std::span<const std::byte> compressed,
+    Compression                compression,
+    const BlockConsumer&       consumer,
+    const DecompressOptions&   options
+) -> std::size_t {
+    if (options.block_size == 0 || options.blocks < 2) {
+        throw std::invalid_argument("The decompression ring needs at least two non-empty blocks.");
+    }
+    if (compression == Compression::none) {
+        return compressed.size() - std::min(consumer(compressed), compressed.size());
+    }
+
+    const auto decoder = make_decoder(compressed, compression);
+    BlockRing  ring {options};
+    std::thread producer {[&ring, &decoder] { ring.produce(*decoder); }};
+
+    // Stop and join the producer however the consumer leaves, so no block is
+    // written after the ring is destroyed.
+    class StopGuard {
+       public:
+        StopGuard(BlockRing& ring, std::thread& thread) noexcept : m_ring(ring), m_thread(thread) {}
+        StopGuard(const StopGuard&)                    = delete;
+        auto operator=(const StopGuard&) -> StopGuard& = delete;
+        StopGuard(StopGuard&&)                         = delete;
+        auto operator=(StopGuard&&) -> StopGuard&      = delete;
+        ~StopGuard() {
+            m_ring.stop();
+            m_thread.join();
+        }
+
+       private:
+        BlockRing&   m_ring;
+        std::thread& m_thread;
+    } const guard {ring, producer};
+
+    return ring.consume(consumer);
+}
+
+}  // namespace itch::io
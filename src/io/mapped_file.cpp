@@ -0,0 +1,177 @@
+#include "itch/io/mapped_file.hpp"
+
+#include <cerrno>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace itch::io {
+
+namespace {
+
+[[noreturn]] auto throw_system_error(int code, const std::string& what) -> void {
+    throw std::system_error(code, std::system_category(), what);
+}
+
+#ifdef _WIN32
+
+// Owns a Win32 handle for the duration of the mapping setup. The view keeps the
+// underlying section alive on its own, so both handles are closed afterwards.
+class HandleGuard {
+   public:
+    explicit HandleGuard(HANDLE handle) noexcept : m_handle(handle) {}
+    HandleGuard(const HandleGuard&)                    = delete;
+    auto operator=(const HandleGuard&) -> HandleGuard& = delete;
+    ~HandleGuard() {
+        if (m_handle != nullptr && m_handle != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_handle);
+        }
+    }
+    [[nodiscard]] auto get() const noexcept -> HANDLE { return m_handle; }
+
+   private:
+    HANDLE m_handle;
+};
+
+#else
+
+// Closes a descriptor on scope exit. The mapping does not need the descriptor
+// once mmap has returned.
+class FdGuard {
+   public:
+    explicit FdGuard(int descriptor) noexcept : m_fd(descriptor) {}
+    FdGuard(const FdGuard&)                    = delete;
+    auto operator=(const FdGuard&) -> FdGuard& = delete;
+    ~FdGuard() {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+    [[nodiscard]] auto get() const noexcept -> int { return m_fd; }
+
+   private:
+    int m_fd;
+};
+
+#endif
+
+}  // namespace
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& path, MapOptions options) {
+    // Windows has no populate or huge-page hint for file-backed views; only the
+    // sequential-scan hint applies.
+    const DWORD flags = options.sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL;
+    HandleGuard file {CreateFileW(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr
+    )};
+    if (file.get() == INVALID_HANDLE_VALUE) {
+        throw_system_error(static_cast<int>(GetLastError()), "cannot open " + path.string());
+    }
+    LARGE_INTEGER size {};
+    if (GetFileSizeEx(file.get(), &size) == 0) {
+        throw_system_error(static_cast<int>(GetLastError()), "cannot size " + path.string());
+    }
+    if (size.QuadPart == 0) {
+        return;
+    }
+    HandleGuard mapping {CreateFileMappingW(file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr)};
+    if (mapping.get() == nullptr) {
+        throw_system_error(static_cast<int>(GetLastError()), "cannot map " + path.string());
+    }
+    void* view = MapViewOfFile(mapping.get(), FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        throw_system_error(static_cast<int>(GetLastError()), "cannot map " + path.string());
+    }
+    m_data = static_cast<const std::byte*>(view);
+    m_size = static_cast<std::size_t>(size.QuadPart);
+}
+
+auto MappedFile::release() noexcept -> void {
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path, MapOptions options) {
+    FdGuard file {::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (file.get() < 0) {
+        throw_system_error(errno, "cannot open " + path.string());
+    }
+    struct stat info {};
+    if (::fstat(file.get(), &info) != 0) {
+        throw_system_error(errno, "cannot size " + path.string());
+    }
+    if (info.st_size == 0) {
+        return;  // mmap rejects zero-length mappings; an empty span is the answer.
+    }
+    const auto size  = static_cast<std::size_t>(info.st_size);
+    int        flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (options.populate) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+    void* mapped = ::mmap(nullptr, size, PROT_READ, flags, file.get(), 0);
+    if (mapped == MAP_FAILED) {
+        throw_system_error(errno, "cannot map " + path.string());
+    }
+    // Advice failures are not errors: the mapping works either way.
+    if (options.sequential) {
+        ::madvise(mapped, size, MADV_SEQUENTIAL);
+    }
+#ifdef MADV_HUGEPAGE
+    if (options.huge_pages) {
+        ::madvise(mapped, size, MADV_HUGEPAGE);
+    }
+#endif
+    m_data = static_cast<const std::byte*>(mapped);
+    m_size = size;
+}
+
+auto MappedFile::release() noexcept -> void {
+    if (m_data != nullptr) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        ::munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+    if (this != &other) {
+        release();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() { release(); }
+
+}  // namespace itch::io
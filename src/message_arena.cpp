@@ -0,0 +1,66 @@
+#include "itch/message_arena.hpp"
+
+#include <variant>
+
+namespace itch {
+
+auto MessageArena::Entry::to_message() const -> Message {
+    Message message;
+    visit([&message](const auto& msg) { message = msg; });
+    return message;
+}
+
+MessageArena::const_iterator::const_iterator(const MessageArena* arena, std::size_t slab) noexcept
+    : m_arena(arena), m_slab(slab) {
+    if (m_slab < m_arena->m_active) {
+        const auto& current = m_arena->m_slabs[m_slab];
+        m_record            = current.data.get();
+        m_slab_end          = m_record + current.used;
+    }
+}
+
+auto MessageArena::const_iterator::advance_slab() noexcept -> void {
+    *this = const_iterator {m_arena, m_slab + 1};
+}
+
+MessageArena::MessageArena(std::size_t slab_size)
+    : m_slab_size(slab_size >= detail::MAX_STRUCT_SIZE ? slab_size : DEFAULT_SLAB_SIZE),
+      m_slab_used(m_slab_size) {}
+
+auto MessageArena::push_back(const Message& message) -> void {
+    std::visit([this](const auto& msg) { emplace(msg); }, message);
+}
+
+auto MessageArena::begin() const noexcept -> const_iterator { return const_iterator {this, 0}; }
+
+auto MessageArena::end() const noexcept -> const_iterator {
+    return const_iterator {this, m_active};
+}
+
+auto MessageArena::bytes_used() const noexcept -> std::size_t {
+    std::size_t used = 0;
+    for (std::size_t slab = 0; slab < m_active; ++slab) {
+        used += m_slabs[slab].used;
+    }
+    return used;
+}
+
+auto MessageArena::clear() noexcept -> void {
+    for (auto& slab : m_slabs) {
+        slab.used = 0;
+    }
+    m_active    = 0;
+    m_slab_used = m_slab_size;
+    m_size      = 0;
+}
+
+auto MessageArena::next_slab() -> void {
+    if (m_active == m_slabs.size()) {
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+        m_slabs.push_back({std::make_unique_for_overwrite<std::byte[]>(m_slab_size), 0});
+    }
+    ++m_active;
+    m_slab_used = 0;
+}
+
+}  // namespace itch
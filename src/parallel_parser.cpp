@@ -0,0 +1,251 @@
+#include "itch/parallel_parser.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace itch {
+
+ParallelParser::ParallelParser(std::size_t threads)
+    : m_threads(threads != 0 ? threads : std::max<std::size_t>(1, std::thread::hardware_concurrency())
+      ) {}
+
+auto ParallelParser::index_frames(std::span<const std::byte> data, std::size_t chunks)
+    -> FrameIndex {
+    FrameIndex  index {{}, 0, 0};
+    const auto  target_count = std::max<std::size_t>(1, chunks);
+    const auto  stride       = std::max<std::size_t>(1, data.size() / target_count);
+    const auto* bytes        = data.data();
+
+    FrameChunk    current {};
+    std::size_t   offset = 0;
+    std::uint64_t frames = 0;
+    while (offset + sizeof(std::uint16_t) <= data.size()) {
+        std::uint16_t length {};
+        std::memcpy(&length, bytes + offset, sizeof(length));
+        length = utils::from_big_endian(length);
+        if (offset + sizeof(std::uint16_t) + length > data.size()) {
+            break;  // Trailing partial frame; reported by the caller.
+        }
+        // Close the current chunk once the next frame starts past its stride
+        // target, so every chunk begins on a length prefix.
+        if (offset >= current.begin + stride && current.frame_count > 0 &&
+            index.chunks.size() + 1 < target_count) {
+            current.end = offset;
+            index.chunks.push_back(current);
+            current = FrameChunk {offset, offset, frames, 0};
+        }
+        offset += sizeof(std::uint16_t) + length;
+        if (length != 0) {
+            ++current.frame_count;
+            ++frames;
+        }
+    }
+    current.end = offset;
+    if (current.end > current.begin) {
+        index.chunks.push_back(current);
+    }
+    index.complete_bytes = offset;
+    index.frame_count    = frames;
+    return index;
+}
+
+auto ParallelParser::run_workers(
+    std::size_t                                      chunk_count,
+    const std::function<void(std::size_t, Parser&)>& work,
+    const std::function<void()>&                     on_caller
+) -> void {
+    std::atomic<std::size_t> next_chunk {0};
+    std::atomic<bool>        aborted {false};
+    std::mutex               error_mutex;
+    std::exception_ptr       first_error;
+
+    auto record_error = [&](std::exception_ptr error) {
+        const std::scoped_lock lock {error_mutex};
+        if (!first_error) {
+            first_error = std::move(error);
+        }
+        aborted.store(true, std::memory_order_relaxed);
+    };
+
+    const auto          worker_count = std::min(m_threads, std::max<std::size_t>(1, chunk_count));
+    std::vector<Parser> parsers(worker_count);
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(worker_count);
+        for (std::size_t worker = 0; worker < worker_count; ++worker) {
+            workers.emplace_back([&, worker] {
+                try {
+                    for (auto chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+                         chunk < chunk_count && !aborted.load(std::memory_order_relaxed);
+                         chunk = next_chunk.fetch_add(1, std::memory_order_relaxed)) {
+                        work(chunk, parsers[worker]);
+                    }
+                } catch (...) {
+                    record_error(std::current_exception());
+                }
+            });
+        }
+        if (on_caller) {
+            try {
+                on_caller();
+            } catch (...) {
+                record_error(std::current_exception());
+            }
+        }
+    }  // jthreads join here.
+
+    for (const auto& parser : parsers) {
+        m_unknown_message_count += parser.unknown_message_count();
+        m_malformed_message_count += parser.malformed_message_count();
+        m_stats.merge(parser.stats());
+    }
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
+}
+
+auto ParallelParser::check_complete(const FrameIndex& index, std::span<const std::byte> data)
+    -> void {
+    if (index.complete_bytes != data.size()) {
+        ++m_malformed_message_count;
+        throw std::runtime_error("Incomplete message at end of buffer.");
+    }
+}
+
+auto ParallelParser::parse(
+    std::span<const std::byte> data,
+    const ChunkCallback&       callback,
+    const MessageTypeFilter&   filter
+) -> void {
+    const auto index = index_frames(data, m_threads * CHUNKS_PER_THREAD);
+    run_workers(index.chunks.size(), [&](std::size_t chunk, Parser& parser) {
+        const auto& range = index.chunks[chunk];
+        parser.parse(
+            data.subspan(range.begin, range.end - range.begin),
+            [&](const Message& msg) { callback(chunk, msg); },
+            filter
+        );
+    });
+    check_complete(index, data);
+}
+
+auto ParallelParser::parse_ordered(
+    std::span<const std::byte> data,
+    const MessageCallback&     callback,
+    const MessageTypeFilter&   filter
+) -> void {
+    // Chunks are sized in bytes here, not per thread: the window below bounds
+    // memory only if each chunk does.
+    const auto by_size = (data.size() + ORDERED_CHUNK_BYTES - 1) / ORDERED_CHUNK_BYTES;
+    const auto index   = index_frames(data, std::max(m_threads * CHUNKS_PER_THREAD, by_size));
+    const auto window  = 2 * m_threads;
+
+    // Decoded chunks wait here until the calling thread delivers them. Workers
+    // pull chunks in increasing order and stall once they get `window` chunks
+    // ahead of delivery, which bounds the memory held in `ready`.
+    std::vector<std::vector<Message>> ready(index.chunks.size());
+    std::vector<bool>                 done(index.chunks.size(), false);
+    std::size_t                       delivered = 0;
+    bool                              failed    = false;
+    std::mutex                        mutex;
+    std::condition_variable           changed;
+
+    auto fail = [&] {
+        const std::scoped_lock lock {mutex};
+        failed = true;
+        changed.notify_all();
+    };
+
+    auto decode = [&](std::size_t chunk, Parser& parser) {
+        try {
+            {
+                std::unique_lock lock {mutex};
+                changed.wait(lock, [&] { return failed || chunk < delivered + window; });
+                if (failed) {
+                    return;
+                }
+            }
+            const auto&          range = index.chunks[chunk];
+            std::vector<Message> messages;
+            messages.reserve(range.frame_count);
+            parser.parse(
+                data.subspan(range.begin, range.end - range.begin),
+                [&](const Message& msg) { messages.push_back(msg); },
+                filter
+            );
+            const std::scoped_lock lock {mutex};
+            ready[chunk] = std::move(messages);
+            done[chunk]  = true;
+            changed.notify_all();
+        } catch (...) {
+            fail();
+            throw;
+        }
+    };
+
+    auto deliver = [&] {
+        try {
+            for (std::size_t chunk = 0; chunk < index.chunks.size(); ++chunk) {
+                std::vector<Message> messages;
+                {
+                    std::unique_lock lock {mutex};
+                    changed.wait(lock, [&] { return failed || done[chunk]; });
+                    if (failed) {
+                        return;
+                    }
+                    messages  = std::move(ready[chunk]);
+                    delivered = chunk + 1;
+                    changed.notify_all();
+                }
+                for (const auto& msg : messages) {
+                    callback(msg);
+                }
+            }
+        } catch (...) {
+            fail();
+            throw;
+        }
+    };
+
+    run_workers(index.chunks.size(), decode, deliver);
+    check_complete(index, data);
+}
+
+auto ParallelParser::parse(std::span<const std::byte> data, const MessageTypeFilter& filter)
+    -> std::vector<Message> {
+    const auto                        index = index_frames(data, m_threads * CHUNKS_PER_THREAD);
+    std::vector<std::vector<Message>> per_chunk(index.chunks.size());
+    run_workers(index.chunks.size(), [&](std::size_t chunk, Parser& parser) {
+        const auto& range    = index.chunks[chunk];
+        auto&       messages = per_chunk[chunk];
+        messages.reserve(range.frame_count);
+        parser.parse(
+            data.subspan(range.begin, range.end - range.begin),
+            [&](const Message& msg) { messages.push_back(msg); },
+            filter
+        );
+    });
+    check_complete(index, data);
+
+    std::size_t total = 0;
+    for (const auto& messages : per_chunk) {
+        total += messages.size();
+    }
+    std::vector<Message> merged;
+    merged.reserve(total);
+    for (auto& messages : per_chunk) {
+        std::move(messages.begin(), messages.end(), std::back_inserter(merged));
+        std::vector<Message> {}.swap(messages);  // Release each chunk as it is merged.
+    }
+    return merged;
+}
+
+}  // namespace itch
@@ -1,270 +1,65 @@
 #include "itch/parser.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
-#include <set>
+#include <ios>
+#include <optional>
+#include <span>
 #include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "itch/detail/simd_decode.hpp"
 #include "itch/detail/wire.hpp"
+#include "itch/io/mapped_file.hpp"
+#include "itch/message_arena.hpp"
 
 namespace itch {
 
-namespace utils {
-
-template <typename ValueType>
-auto unpack(const char* buffer, std::size_t& offset) -> ValueType {
-    ValueType value;
-    std::memcpy(&value, buffer + offset, sizeof(ValueType));
-    offset += sizeof(ValueType);
-
-    if constexpr (std::is_integral_v<ValueType> && sizeof(ValueType) > 1) {
-        return from_big_endian(value);
-    } else {
-        return value;
-    }
-}
-
-inline auto unpack_string(const char* buffer, std::size_t& offset, char* dest, std::size_t size)
-    -> void {
-    std::memcpy(dest, buffer + offset, size);
-    offset += size;
-}
-
-inline auto unpack_timestamp(const char* buffer, std::size_t& offset) -> std::uint64_t {
-    std::uint16_t high {};
-    std::uint32_t low {};
-    constexpr int LOWER_SHIFT = 32;
-    std::memcpy(&high, buffer + offset, sizeof(high));
-    offset += sizeof(high);
-    std::memcpy(&low, buffer + offset, sizeof(low));
-    offset += sizeof(low);
-    high = from_big_endian(high);
-    low  = from_big_endian(low);
-    return (static_cast<std::uint64_t>(high) << LOWER_SHIFT) | low;
-}
-}  // namespace utils
-
-auto unpack_message(SystemEventMessage& msg, const char* buffer, size_t& offset) -> void {
-    msg.event_code = utils::unpack<char>(buffer, offset);
-}
-
-auto unpack_message(StockDirectoryMessage& msg, const char* buffer, size_t& offset) -> void {
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-    msg.market_category            = utils::unpack<char>(buffer, offset);
-    msg.financial_status_indicator = utils::unpack<char>(buffer, offset);
-    msg.round_lot_size             = utils::unpack<uint32_t>(buffer, offset);
-    msg.round_lots_only            = utils::unpack<char>(buffer, offset);
-    msg.issue_classification       = utils::unpack<char>(buffer, offset);
-
-    utils::unpack_string(buffer, offset, msg.issue_sub_type, 2);
-    msg.authenticity                   = utils::unpack<char>(buffer, offset);
-    msg.short_sale_threshold_indicator = utils::unpack<char>(buffer, offset);
-    msg.ipo_flag                       = utils::unpack<char>(buffer, offset);
-    msg.luld_ref                       = utils::unpack<char>(buffer, offset);
-    msg.etp_flag                       = utils::unpack<char>(buffer, offset);
-    msg.etp_leverage_factor            = utils::unpack<uint32_t>(buffer, offset);
-    msg.inverse_indicator              = utils::unpack<char>(buffer, offset);
-}
-
-auto unpack_message(StockTradingActionMessage& msg, const char* buffer, size_t& offset) -> void {
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-    msg.trading_state = utils::unpack<char>(buffer, offset);
-    msg.reserved      = utils::unpack<char>(buffer, offset);
-    utils::unpack_string(buffer, offset, msg.reason, 4);
-}
-
-auto unpack_message(RegSHOMessage& msg, const char* buffer, size_t& offset) -> void {
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-    msg.reg_sho_action = utils::unpack<char>(buffer, offset);
-}
-
-auto unpack_message(MarketParticipantPositionMessage& msg, const char* buffer, size_t& offset)
-    -> void {
-    utils::unpack_string(buffer, offset, msg.mpid, 4);
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-    msg.primary_market_maker     = utils::unpack<char>(buffer, offset);
-    msg.market_maker_mode        = utils::unpack<char>(buffer, offset);
-    msg.market_participant_state = utils::unpack<char>(buffer, offset);
-}
-
-auto unpack_message(MWCBDeclineLevelMessage& msg, const char* buffer, size_t& offset) -> void {
-    msg.level1 = utils::unpack<uint64_t>(buffer, offset);
-    msg.level2 = utils::unpack<uint64_t>(buffer, offset);
-    msg.level3 = utils::unpack<uint64_t>(buffer, offset);
-}
-
-auto unpack_message(MWCBStatusMessage& msg, const char* buffer, size_t& offset) -> void {
-    msg.breached_level = utils::unpack<char>(buffer, offset);
-}
-
-auto unpack_message(IPOQuotingPeriodUpdateMessage& msg, const char* buffer, size_t& offset)
-    -> void {
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-    msg.ipo_quotation_release_time      = utils::unpack<uint32_t>(buffer, offset);
-    msg.ipo_quotation_release_qualifier = utils::unpack<char>(buffer, offset);
-    msg.ipo_price                       = utils::unpack<uint32_t>(buffer, offset);
-}
-
-auto unpack_message(LULDAuctionCollarMessage& msg, const char* buffer, size_t& offset) -> void {
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-    msg.auction_collar_reference_price = utils::unpack<uint32_t>(buffer, offset);
-    msg.upper_auction_collar_price     = utils::unpack<uint32_t>(buffer, offset);
-    msg.lower_auction_collar_price     = utils::unpack<uint32_t>(buffer, offset);
-    msg.auction_collar_extension       = utils::unpack<uint32_t>(buffer, offset);
-}
-
-auto unpack_message(OperationalHaltMessage& msg, const char* buffer, size_t& offset) -> void {
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-    msg.market_code             = utils::unpack<char>(buffer, offset);
-    msg.operational_halt_action = utils::unpack<char>(buffer, offset);
-}
-
-auto unpack_message(AddOrderMessage& msg, const char* buffer, size_t& offset) -> void {
-    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
-    msg.buy_sell_indicator     = utils::unpack<char>(buffer, offset);
-    msg.shares                 = utils::unpack<uint32_t>(buffer, offset);
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-    msg.price = utils::unpack<uint32_t>(buffer, offset);
-}
-
-auto unpack_message(AddOrderMPIDAttributionMessage& msg, const char* buffer, size_t& offset)
-    -> void {
-    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
-    msg.buy_sell_indicator     = utils::unpack<char>(buffer, offset);
-    msg.shares                 = utils::unpack<uint32_t>(buffer, offset);
-
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-    msg.price = utils::unpack<uint32_t>(buffer, offset);
-    utils::unpack_string(buffer, offset, msg.attribution, 4);
-}
-
-auto unpack_message(OrderExecutedMessage& msg, const char* buffer, size_t& offset) -> void {
-    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
-    msg.executed_shares        = utils::unpack<uint32_t>(buffer, offset);
-    msg.match_number           = utils::unpack<uint64_t>(buffer, offset);
-}
-
-auto unpack_message(OrderExecutedWithPriceMessage& msg, const char* buffer, size_t& offset)
-    -> void {
-    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
-    msg.executed_shares        = utils::unpack<uint32_t>(buffer, offset);
-    msg.match_number           = utils::unpack<uint64_t>(buffer, offset);
-    msg.printable              = utils::unpack<char>(buffer, offset);
-    msg.execution_price        = utils::unpack<uint32_t>(buffer, offset);
-}
-
-auto unpack_message(OrderCancelMessage& msg, const char* buffer, size_t& offset) -> void {
-    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
-    msg.cancelled_shares       = utils::unpack<uint32_t>(buffer, offset);
-}
-
-auto unpack_message(OrderDeleteMessage& msg, const char* buffer, size_t& offset) -> void {
-    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
-}
-
-auto unpack_message(OrderReplaceMessage& msg, const char* buffer, size_t& offset) -> void {
-    msg.original_order_reference_number = utils::unpack<uint64_t>(buffer, offset);
-    msg.new_order_reference_number      = utils::unpack<uint64_t>(buffer, offset);
-    msg.shares                          = utils::unpack<uint32_t>(buffer, offset);
-    msg.price                           = utils::unpack<uint32_t>(buffer, offset);
-}
-
-auto unpack_message(NonCrossTradeMessage& msg, const char* buffer, size_t& offset) -> void {
-    msg.order_reference_number = utils::unpack<uint64_t>(buffer, offset);
-    msg.buy_sell_indicator     = utils::unpack<char>(buffer, offset);
-    msg.shares                 = utils::unpack<uint32_t>(buffer, offset);
-
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-
-    msg.price        = utils::unpack<uint32_t>(buffer, offset);
-    msg.match_number = utils::unpack<uint64_t>(buffer, offset);
-}
-
-auto unpack_message(CrossTradeMessage& msg, const char* buffer, size_t& offset) -> void {
-    msg.shares = utils::unpack<uint64_t>(buffer, offset);
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-
-    msg.cross_price  = utils::unpack<uint32_t>(buffer, offset);
-    msg.match_number = utils::unpack<uint64_t>(buffer, offset);
-    msg.cross_type   = utils::unpack<char>(buffer, offset);
-}
-
-auto unpack_message(BrokenTradeMessage& msg, const char* buffer, size_t& offset) -> void {
-    msg.match_number = utils::unpack<uint64_t>(buffer, offset);
-}
-
-auto unpack_message(NOIIMessage& msg, const char* buffer, size_t& offset) -> void {
-    msg.paired_shares       = utils::unpack<uint64_t>(buffer, offset);
-    msg.imbalance_shares    = utils::unpack<uint64_t>(buffer, offset);
-    msg.imbalance_direction = utils::unpack<char>(buffer, offset);
-
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-
-    msg.far_price                 = utils::unpack<uint32_t>(buffer, offset);
-    msg.near_price                = utils::unpack<uint32_t>(buffer, offset);
-    msg.current_reference_price   = utils::unpack<uint32_t>(buffer, offset);
-    msg.cross_type                = utils::unpack<char>(buffer, offset);
-    msg.price_variation_indicator = utils::unpack<char>(buffer, offset);
-}
-
-using RPIMsg = RetailPriceImprovementIndicatorMessage;
-auto unpack_message(RPIMsg& msg, const char* buffer, size_t& offset) -> void {
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-    msg.interest_flag = utils::unpack<char>(buffer, offset);
-}
-
-auto unpack_message(DLCRMessage& msg, const char* buffer, size_t& offset) -> void {
-    utils::unpack_string(buffer, offset, msg.stock, STOCK_LEN);
-    msg.open_eligibility_status  = utils::unpack<char>(buffer, offset);
-    msg.minimum_allowable_price  = utils::unpack<uint32_t>(buffer, offset);
-    msg.maximum_allowable_price  = utils::unpack<uint32_t>(buffer, offset);
-    msg.near_execution_price     = utils::unpack<uint32_t>(buffer, offset);
-    msg.near_execution_time      = utils::unpack<uint64_t>(buffer, offset);
-    msg.lower_price_range_collar = utils::unpack<uint32_t>(buffer, offset);
-    msg.upper_price_range_collar = utils::unpack<uint32_t>(buffer, offset);
-}
-
 namespace {
 
-using detail::WIRE_SIZE;
-
-/// @brief Decodes the common header and type-specific body of a message of
-///        type MsgType from a frame, returning it wrapped in the Message variant.
+/// @brief Decodes a frame of type MsgType and wraps it in the Message variant.
 template <typename MsgType>
-auto decode_typed(const char* buffer) -> Message {
-    MsgType     msg;
-    std::size_t offset = 1;  // Skip the message type byte.
-
-    msg.stock_locate    = utils::unpack<std::uint16_t>(buffer, offset);
-    msg.tracking_number = utils::unpack<std::uint16_t>(buffer, offset);
-    msg.timestamp       = utils::unpack_timestamp(buffer, offset);
-
-    unpack_message(msg, buffer, offset);
-
-    return msg;
+auto decode_message(const char* buffer) -> Message {
+    return detail::decode_typed<MsgType>(buffer);
 }
 
-/// @brief One slot of the flat, type-byte-indexed dispatch table.
+/// @brief One slot of the flat, type-byte-indexed dispatch table. Frame length
+///        validation happens beforehand, against `detail::WIRE_SIZE_TABLE`.
 struct DispatchEntry {
-    std::uint16_t wire_size {0};               ///< Expected on-wire frame size (0 == unknown type).
     Message (*decode)(const char*) {nullptr};  ///< Decoder, or null for an unknown type.
 };
 
 constexpr std::size_t DISPATCH_TABLE_SIZE = 256;
 
-/// @brief Builds the dispatch table at compile time so message dispatch is a
-///        single flat-array lookup plus a direct (inlinable) call, with no map
+using DispatchTable = std::array<DispatchEntry, DISPATCH_TABLE_SIZE>;
+
+/// @brief The decoder `Kernel` uses for MsgType: its SIMD kernel for the
+///        order-flow types that have one, the scalar decoder otherwise.
+template <DecodeKernel Kernel, typename MsgType>
+consteval auto decoder_for() -> Message (*)(const char*) {
+    if constexpr (Kernel == DecodeKernel::avx2 && detail::HAS_SIMD_KERNEL<MsgType>) {
+        return &detail::decode_avx2<MsgType>;
+    } else if constexpr (Kernel == DecodeKernel::ssse3 && detail::HAS_SIMD_KERNEL<MsgType>) {
+        return &detail::decode_ssse3<MsgType>;
+    } else {
+        return &decode_message<MsgType>;
+    }
+}
+
+/// @brief Builds a kernel's dispatch table at compile time so message dispatch
+///        is a single flat-array lookup plus a direct call, with no map
 ///        traversal and no type-erased `std::function` indirection.
-consteval auto build_dispatch_table() -> std::array<DispatchEntry, DISPATCH_TABLE_SIZE> {
-    std::array<DispatchEntry, DISPATCH_TABLE_SIZE> table {};
+template <DecodeKernel Kernel>
+consteval auto build_dispatch_table() -> DispatchTable {
+    DispatchTable table {};
 
     auto add = [&table]<typename MsgType>(char type) {
-        table[static_cast<unsigned char>(type)] =
-            DispatchEntry {static_cast<std::uint16_t>(WIRE_SIZE<MsgType>), &decode_typed<MsgType>};
+        table[static_cast<unsigned char>(type)] = DispatchEntry {decoder_for<Kernel, MsgType>()};
     };
 
     // The canonical message-type registry lives in itch/detail/wire.hpp so the
@@ -274,10 +69,71 @@ consteval auto build_dispatch_table() -> std::array<DispatchEntry, DISPATCH_TABL
     return table;
 }
 
-constexpr auto DISPATCH_TABLE = build_dispatch_table();
+/// @brief One dispatch table per `DecodeKernel`, indexed by its value. The
+///        tables differ only in the order-flow slots.
+constexpr std::array<DispatchTable, DECODE_KERNEL_COUNT> DISPATCH_TABLES {
+    build_dispatch_table<DecodeKernel::scalar>(),
+    build_dispatch_table<DecodeKernel::ssse3>(),
+    build_dispatch_table<DecodeKernel::avx2>(),
+};
+
+auto dispatch_table(DecodeKernel kernel) noexcept -> const DispatchTable& {
+    return DISPATCH_TABLES[static_cast<std::size_t>(kernel)];
+}
+
+/// @brief Whether the 1 or 2 bytes `available` at `header`, cut off by the
+///        end of the buffer, could begin the length prefix of a known type.
+auto starts_cut_header(const char* header, std::size_t available) -> bool {
+    const auto high = static_cast<unsigned char>(header[0]);
+    const auto low  = available > 1 ? static_cast<unsigned char>(header[1]) : 0U;
+    return std::ranges::any_of(detail::WIRE_SIZE_TABLE, [&](std::uint16_t wire_size) {
+        return wire_size != 0 && (wire_size >> 8U) == high &&
+               (available < 2 || (wire_size & 0xFFU) == low);
+    });
+}
+
+/// @brief Whether `frames` consecutive frames with a known type and exactly
+///        its wire size start at `offset`. A run cut short by the end of the
+///        buffer also counts once it has one such frame, or once a plausible
+///        frame header runs past the end, so that the last frames of a damaged
+///        input are not thrown away and a frame straddling a stream chunk is
+///        left for the next chunk to complete.
+auto starts_frame_run(const char* data, std::size_t size, std::size_t offset, std::size_t frames)
+    -> bool {
+    for (std::size_t frame = 0; frame < frames; ++frame) {
+        if (offset + sizeof(std::uint16_t) >= size) {
+            // The length prefix or type byte is cut: keep the bytes if they
+            // could still begin a frame.
+            return frame > 0 || starts_cut_header(data + offset, size - offset);
+        }
+        std::uint16_t length {};
+        std::memcpy(&length, data + offset, sizeof(length));
+        length = utils::from_big_endian(length);
+        const auto type = static_cast<unsigned char>(data[offset + sizeof(length)]);
+        if (length == 0 || detail::WIRE_SIZE_TABLE[type] != length) {
+            return false;
+        }
+        offset += sizeof(std::uint16_t) + length;
+        if (offset > size) {
+            return true;
+        }
+    }
+    return true;
+}
 
 }  // namespace
 
+auto Parser::resync(const char* data, std::size_t size, std::size_t from) -> std::size_t {
+    std::size_t next = from + 1;
+    while (next < size && !starts_frame_run(data, size, next, m_resync_frames)) {
+        ++next;
+    }
+    m_last_skipped_range  = SkippedRange {m_input_offset + from, next - from};
+    m_skipped_byte_count += next - from;
+    report_error(ParseError::resynchronized, data[from + sizeof(std::uint16_t)]);
+    return next;
+}
+
 auto Parser::report_error(ParseError error, char message_type) -> void {
     switch (error) {
         case ParseError::unknown_type:
@@ -287,61 +143,60 @@ auto Parser::report_error(ParseError error, char message_type) -> void {
         case ParseError::truncated:
             ++m_malformed_message_count;
             break;
+        case ParseError::resynchronized:
+            break;  // Counted in bytes by resync().
     }
     if (m_error_callback) {
         m_error_callback(error, message_type);
     }
 }
 
-auto Parser::parse_impl(const char* data, std::size_t size, const MessageCallback& callback)
-    -> std::optional<ParseError> {
-    std::size_t offset = 0;
-    while (offset < size) {
-        // Ensure we can read the 2-byte length prefix.
-        if (offset + sizeof(std::uint16_t) > size) {
-            report_error(ParseError::truncated, '\0');
-            return ParseError::truncated;
-        }
-        std::uint16_t length {};
-        std::memcpy(&length, data + offset, sizeof(length));
-        length = utils::from_big_endian(length);
-        offset += sizeof(std::uint16_t);
-
-        if (length == 0) {
-            continue;  // Skip zero-length padding frames.
-        }
-
-        // Ensure the full declared payload is present.
-        if (offset + length > size) {
-            report_error(ParseError::truncated, '\0');
-            return ParseError::truncated;
-        }
+auto Parser::stats() const noexcept -> const ParserStats& {
+#ifdef ITCH_WITH_STATS
+    return m_stats;
+#else
+    static const ParserStats empty {};
+    return empty;
+#endif
+}
 
-        const char* message      = data + offset;
-        const char  message_type = message[0];
-        offset += length;
+auto Parser::reset_stats() noexcept -> void {
+#ifdef ITCH_WITH_STATS
+    m_stats.clear();
+#endif
+}
 
-        const DispatchEntry& entry = DISPATCH_TABLE[static_cast<unsigned char>(message_type)];
-        if (entry.decode == nullptr) {
-            // Unknown type: skip and count rather than writing to a global stream.
-            report_error(ParseError::unknown_type, message_type);
-            continue;
-        }
-        // A frame shorter than the type requires would make the decoder read into
-        // the next frame; reject it. A longer frame is tolerated for forward
-        // compatibility (the trailing bytes are simply skipped).
-        if (length < entry.wire_size) {
-            report_error(ParseError::size_mismatch, message_type);
-            continue;
-        }
+auto Parser::set_stats_sample_interval(std::uint32_t interval) noexcept -> void {
+#ifdef ITCH_WITH_STATS
+    m_stats.set_sample_interval(interval);
+#else
+    static_cast<void>(interval);
+#endif
+}
 
-        callback(entry.decode(message));
-    }
-    return std::nullopt;
+auto Parser::parse_impl(
+    const char*              data,
+    std::size_t              size,
+    const MessageCallback&   callback,
+    const MessageTypeFilter& filter
+) -> std::optional<ParseError> {
+    const auto& table = dispatch_table(m_decode_kernel);
+    return frame_loop(data, size, filter, [&](const char* message) {
+        callback(table[static_cast<unsigned char>(message[0])].decode(message));
+    });
 }
 
 auto Parser::parse(const char* data, size_t size, const MessageCallback& callback) -> void {
-    if (parse_impl(data, size, callback).has_value()) {
+    parse(data, size, callback, MessageTypeFilter::all());
+}
+
+auto Parser::parse(
+    const char*              data,
+    size_t                   size,
+    const MessageCallback&   callback,
+    const MessageTypeFilter& filter
+) -> void {
+    if (parse_impl(data, size, callback, filter).has_value()) {
         throw std::runtime_error("Incomplete message at end of buffer.");
     }
 }
@@ -357,102 +212,307 @@ auto Parser::parse(const char* data, size_t size) -> std::vector<Message> {
 
 auto Parser::parse(const char* data, size_t size, const std::vector<char>& messages)
     -> std::vector<Message> {
-    std::vector<Message> results;
-    std::set<char>       filter(messages.begin(), messages.end());
+    return parse(data, size, MessageTypeFilter {messages});
+}
 
+auto Parser::parse(const char* data, size_t size, const MessageTypeFilter& filter)
+    -> std::vector<Message> {
+    std::vector<Message> results;
     if (filter.empty()) {
         return results;
     }
     results.reserve(size / average_message_size);
-
-    auto callback = [&](const Message& msg) {
-        char message_type = std::visit([](auto&& arg) { return arg.message_type; }, msg);
-        if (filter.contains(message_type)) {
-            results.push_back(msg);
-        }
-    };
-    parse(data, size, callback);
+    parse(data, size, [&](const Message& msg) { results.push_back(msg); }, filter);
     return results;
 }
 
-namespace {
-// std::byte and char may legitimately alias; route through void* to obtain the
-// char view the framing core works with, without a forbidden reinterpret_cast.
-auto as_char_ptr(std::span<const std::byte> data) -> const char* {
-    // char may alias std::byte; the house style forbids reinterpret_cast, so the
-    // void* hop is the intended form here.
-    const void* raw = data.data();
-    return static_cast<const char*>(raw);  // NOLINT(bugprone-casting-through-void)
-}
-}  // namespace
-
 auto Parser::parse(std::span<const std::byte> data, const MessageCallback& callback) -> void {
-    parse(as_char_ptr(data), data.size(), callback);
+    parse(detail::as_char_ptr(data), data.size(), callback);
 }
 
 auto Parser::parse(std::span<const std::byte> data) -> std::vector<Message> {
-    return parse(as_char_ptr(data), data.size());
+    return parse(detail::as_char_ptr(data), data.size());
 }
 
 auto Parser::parse(std::span<const std::byte> data, const std::vector<char>& messages)
     -> std::vector<Message> {
-    return parse(as_char_ptr(data), data.size(), messages);
+    return parse(detail::as_char_ptr(data), data.size(), messages);
+}
+
+auto Parser::parse(
+    std::span<const std::byte> data,
+    const MessageCallback&     callback,
+    const MessageTypeFilter&   filter
+) -> void {
+    parse(detail::as_char_ptr(data), data.size(), callback, filter);
+}
+
+auto Parser::parse(std::span<const std::byte> data, const MessageTypeFilter& filter)
+    -> std::vector<Message> {
+    return parse(detail::as_char_ptr(data), data.size(), filter);
+}
+
+auto Parser::parse_file(const std::filesystem::path& path, const MessageCallback& callback)
+    -> void {
+    parse_file(path, callback, MessageTypeFilter::all());
+}
+
+auto Parser::parse_file(
+    const std::filesystem::path& path,
+    const MessageCallback&       callback,
+    const MessageTypeFilter&     filter
+) -> void {
+    const io::MappedFile file {path};
+    if (io::detect_compression(file.bytes()) != io::Compression::none) {
+        parse_compressed(file.bytes(), callback, filter);
+        return;
+    }
+    parse(file.bytes(), callback, filter);
+}
+
+auto Parser::parse_file(const std::filesystem::path& path) -> std::vector<Message> {
+    const io::MappedFile file {path};
+    if (io::detect_compression(file.bytes()) != io::Compression::none) {
+        std::vector<Message> messages;
+        parse_compressed(file.bytes(), [&messages](const Message& msg) {
+            messages.push_back(msg);
+        });
+        return messages;
+    }
+    return parse(file.bytes());
+}
+
+auto Parser::parse_compressed(std::span<const std::byte> data, const MessageCallback& callback)
+    -> void {
+    parse_compressed(data, callback, MessageTypeFilter::all());
+}
+
+auto Parser::parse_compressed(
+    std::span<const std::byte>   data,
+    const MessageCallback&       callback,
+    const MessageTypeFilter&     filter,
+    const io::DecompressOptions& options
+) -> void {
+    std::uint64_t position = 0;  // Decompressed offset of the current block.
+    const auto    leftover = io::for_each_decompressed_block(
+        data,
+        io::detect_compression(data),
+        [&](std::span<const std::byte> block) {
+            m_input_offset      = position;
+            const auto consumed =
+                parse_available(detail::as_char_ptr(block), block.size(), callback, filter);
+            position += consumed;
+            return consumed;
+        },
+        options
+    );
+    if (leftover > 0) {
+        report_error(ParseError::truncated, '\0');
+        throw std::runtime_error("Incomplete message at end of buffer.");
+    }
+}
+
+auto Parser::parse(std::span<const std::byte> data, MessageArena& arena) -> void {
+    parse(data, arena, MessageTypeFilter::all());
+}
+
+auto Parser::parse(
+    std::span<const std::byte> data, MessageArena& arena, const MessageTypeFilter& filter
+) -> void {
+    const auto error =
+        frame_loop(detail::as_char_ptr(data), data.size(), filter, [&arena](const char* frame) {
+            detail::HANDLER_TABLE<MessageArena>[static_cast<unsigned char>(frame[0])](frame, arena);
+        });
+    if (error.has_value()) {
+        throw std::runtime_error("Incomplete message at end of buffer.");
+    }
+}
+
+auto Parser::parse(
+    TrustedInput trust, std::span<const std::byte> data, const MessageCallback& callback
+) -> void {
+    if (trust.validate && validate(data).has_value()) {
+        parse(data, callback);
+        return;
+    }
+    const auto& table = dispatch_table(m_decode_kernel);
+    scan_trusted(detail::as_char_ptr(data), data.size(), [&](const char* message) {
+        callback(table[static_cast<unsigned char>(message[0])].decode(message));
+    });
+}
+
+auto Parser::validate(std::span<const std::byte> data) noexcept -> std::optional<ParseError> {
+    const char*       bytes  = detail::as_char_ptr(data);
+    const std::size_t size   = data.size();
+    std::size_t       offset = 0;
+    while (offset < size) {
+        if (offset + sizeof(std::uint16_t) > size) {
+            return ParseError::truncated;
+        }
+        std::uint16_t length {};
+        std::memcpy(&length, bytes + offset, sizeof(length));
+        length  = utils::from_big_endian(length);
+        offset += sizeof(std::uint16_t);
+        if (offset + length > size) {
+            return ParseError::truncated;
+        }
+        if (length == 0) {
+            continue;
+        }
+        const std::uint16_t wire_size =
+            detail::WIRE_SIZE_TABLE[static_cast<unsigned char>(bytes[offset])];
+        if (wire_size == 0) {
+            return ParseError::unknown_type;
+        }
+        if (length < wire_size) {
+            return ParseError::size_mismatch;
+        }
+        offset += length;
+    }
+    return std::nullopt;
 }
 
 #ifdef __cpp_lib_expected
 auto Parser::try_parse(std::span<const std::byte> data, const MessageCallback& callback)
     -> std::expected<void, ParseError> {
-    if (auto error = parse_impl(as_char_ptr(data), data.size(), callback)) {
+    return try_parse(data, callback, MessageTypeFilter::all());
+}
+
+auto Parser::try_parse(std::span<const std::byte> data
+) -> std::expected<std::vector<Message>, ParseError> {
+    return try_parse(data, MessageTypeFilter::all());
+}
+
+auto Parser::try_parse(
+    std::span<const std::byte> data,
+    const MessageCallback&     callback,
+    const MessageTypeFilter&   filter
+) -> std::expected<void, ParseError> {
+    if (auto error = parse_impl(detail::as_char_ptr(data), data.size(), callback, filter)) {
         return std::unexpected(*error);
     }
     return {};
 }
 
-auto Parser::try_parse(std::span<const std::byte> data
-) -> std::expected<std::vector<Message>, ParseError> {
+auto Parser::try_parse(std::span<const std::byte> data, const MessageTypeFilter& filter)
+    -> std::expected<std::vector<Message>, ParseError> {
     std::vector<Message> messages;
     messages.reserve(data.size() / average_message_size);
-    if (auto error = parse_impl(as_char_ptr(data), data.size(), [&](const Message& msg) {
-            messages.push_back(msg);
-        })) {
+    if (auto error = parse_impl(
+            detail::as_char_ptr(data),
+            data.size(),
+            [&](const Message& msg) { messages.push_back(msg); },
+            filter
+        )) {
         return std::unexpected(*error);
     }
     return messages;
 }
+
+auto Parser::try_parse(std::span<const std::byte> data, MessageArena& arena)
+    -> std::expected<void, ParseError> {
+    const auto error = frame_loop(
+        detail::as_char_ptr(data),
+        data.size(),
+        MessageTypeFilter::all(),
+        [&arena](const char* frame) {
+            detail::HANDLER_TABLE<MessageArena>[static_cast<unsigned char>(frame[0])](frame, arena);
+        }
+    );
+    if (error.has_value()) {
+        return std::unexpected(*error);
+    }
+    return {};
+}
 #endif
 
 auto Parser::set_error_callback(ErrorCallback callback) -> void {
     m_error_callback = std::move(callback);
 }
 
-// Read the whole stream into a buffer
-static auto read_stream_into_buffer(std::istream& data) -> std::vector<char> {
-    data.seekg(0, std::ios::end);
-    auto size = data.tellg();
-    data.seekg(0, std::ios::beg);
-
-    if (size < 0) {
-        throw std::runtime_error("Failed to determine stream size.");
+auto Parser::set_decode_kernel(DecodeKernel kernel) -> void {
+    if (!decode_kernel_supported(kernel)) {
+        throw std::invalid_argument(
+            "Decode kernel '" + std::string {to_string(kernel)} + "' is not supported by this CPU."
+        );
+    }
+    m_decode_kernel = kernel;
+}
+
+auto Parser::parse_available(
+    const char*              data,
+    std::size_t              size,
+    const MessageCallback&   callback,
+    const MessageTypeFilter& filter
+) -> std::size_t {
+    const auto& table = dispatch_table(m_decode_kernel);
+    return scan_frames(data, size, filter, [&](const char* message) {
+        callback(table[static_cast<unsigned char>(message[0])].decode(message));
+    });
+}
+
+auto Parser::parse_stream(
+    std::istream& data, const MessageCallback& callback, const MessageTypeFilter& filter
+) -> void {
+    const auto&       table = dispatch_table(m_decode_kernel);
+    std::vector<char> chunk(STREAM_CHUNK_SIZE);
+    std::size_t       carried  = 0;  // Bytes of a straddling frame kept from the last read.
+    std::uint64_t     position = 0;  // Stream offset of chunk[0].
+
+    while (data) {
+        data.read(chunk.data() + carried, static_cast<std::streamsize>(chunk.size() - carried));
+        const auto received = static_cast<std::size_t>(data.gcount());
+        if (received == 0) {
+            break;
+        }
+        const std::size_t filled = carried + received;
+        m_input_offset           = position;
+        const std::size_t consumed =
+            scan_frames(chunk.data(), filled, filter, [&](const char* message) {
+                callback(table[static_cast<unsigned char>(message[0])].decode(message));
+            });
+        carried   = filled - consumed;
+        position += consumed;
+        if (carried > 0) {
+            std::memmove(chunk.data(), chunk.data() + consumed, carried);
+        }
     }
 
-    std::vector<char> buffer(static_cast<size_t>(size));
-    data.read(buffer.data(), size);
-    return buffer;
+    if (data.bad()) {
+        throw std::runtime_error("Failed to read from stream.");
+    }
+    if (carried > 0) {
+        report_error(ParseError::truncated, '\0');
+        throw std::runtime_error("Incomplete message at end of buffer.");
+    }
 }
 
 auto Parser::parse(std::istream& data, const MessageCallback& callback) -> void {
-    auto buffer = read_stream_into_buffer(data);
-    parse(buffer.data(), buffer.size(), callback);
+    parse_stream(data, callback, MessageTypeFilter::all());
+}
+
+auto Parser::parse(
+    std::istream& data, const MessageCallback& callback, const MessageTypeFilter& filter
+) -> void {
+    parse_stream(data, callback, filter);
 }
 
 auto Parser::parse(std::istream& data) -> std::vector<Message> {
-    auto buffer = read_stream_into_buffer(data);
-    return parse(buffer.data(), buffer.size());
+    std::vector<Message> messages;
+    parse_stream(
+        data, [&](const Message& msg) { messages.push_back(msg); }, MessageTypeFilter::all()
+    );
+    return messages;
 }
 
 auto Parser::parse(std::istream& data, const std::vector<char>& messages) -> std::vector<Message> {
-    auto buffer = read_stream_into_buffer(data);
-    return parse(buffer.data(), buffer.size(), messages);
+    std::vector<Message>    results;
+    const MessageTypeFilter filter {messages};
+    if (filter.empty()) {
+        return results;
+    }
+    parse_stream(data, [&](const Message& msg) { results.push_back(msg); }, filter);
+    return results;
 }
 
 }  // namespace itch
@@ -0,0 +1,81 @@
+#include "itch/parser_stats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <thread>
+
+namespace itch {
+
+namespace detail {
+
+auto ticks_per_nanosecond() -> double {
+    static const double rate = [] {
+        using clock            = std::chrono::steady_clock;
+        const auto start_time  = clock::now();
+        const auto start_ticks = read_ticks();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        const auto ticks = static_cast<double>(read_ticks() - start_ticks);
+        const auto nanos = std::chrono::duration<double, std::nano>(clock::now() - start_time);
+        return nanos.count() > 0.0 ? ticks / nanos.count() : 1.0;
+    }();
+    return rate;
+}
+
+}  // namespace detail
+
+auto LatencyHistogram::merge(const LatencyHistogram& other) noexcept -> void {
+    for (std::size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        m_counts[bucket] += other.m_counts[bucket];
+    }
+    m_count += other.m_count;
+    m_sum   += other.m_sum;
+    m_min    = other.m_min < m_min ? other.m_min : m_min;
+    m_max    = other.m_max > m_max ? other.m_max : m_max;
+}
+
+auto LatencyHistogram::mean() const noexcept -> double {
+    return m_count == 0 ? 0.0 : static_cast<double>(m_sum) / static_cast<double>(m_count);
+}
+
+auto LatencyHistogram::value_at_percentile(double percentile) const noexcept -> std::uint64_t {
+    if (m_count == 0) {
+        return 0;
+    }
+    const double  clamped = std::clamp(percentile, 0.0, 100.0);
+    const auto    rank    = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(m_count)))
+    );
+    std::uint64_t seen    = 0;
+    for (std::size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        seen += m_counts[bucket];
+        if (seen >= rank) {
+            const auto upper = bucket_upper(bucket);
+            return upper < m_max ? upper : m_max;
+        }
+    }
+    return m_max;
+}
+
+auto ParserStats::total_messages() const noexcept -> std::uint64_t {
+    return std::accumulate(m_messages.begin(), m_messages.end(), std::uint64_t {0});
+}
+
+auto ParserStats::total_bytes() const noexcept -> std::uint64_t {
+    return std::accumulate(m_bytes.begin(), m_bytes.end(), std::uint64_t {0});
+}
+
+auto ParserStats::to_nanoseconds(std::uint64_t ticks) -> double {
+    return static_cast<double>(ticks) / detail::ticks_per_nanosecond();
+}
+
+auto ParserStats::merge(const ParserStats& other) noexcept -> void {
+    for (std::size_t type = 0; type < m_messages.size(); ++type) {
+        m_messages[type] += other.m_messages[type];
+        m_bytes[type]    += other.m_bytes[type];
+    }
+    m_latency.merge(other.m_latency);
+}
+
+}  // namespace itch
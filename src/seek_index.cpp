@@ -0,0 +1,316 @@
+#include "itch/seek_index.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "itch/detail/decode.hpp"
+#include "itch/detail/wire.hpp"
+#include "itch/io/mapped_file.hpp"
+#include "itch/overlay.hpp"
+
+namespace itch {
+
+namespace {
+
+constexpr std::string_view SIDECAR_MAGIC   = "ITCHSIDX";
+constexpr std::uint32_t    SIDECAR_VERSION = 1;
+constexpr std::size_t      HEADER_SIZE     = 64;
+constexpr std::size_t      POINT_SIZE      = 24;
+constexpr std::size_t      LOCATE_SIZE     = 32;
+
+// Every message starts with the same header, so any type's layout gives these.
+constexpr std::size_t LOCATE_OFFSET =
+    detail::wire_offset(offsetof(SystemEventMessage, stock_locate));
+constexpr std::size_t TIMESTAMP_OFFSET =
+    detail::wire_offset(offsetof(SystemEventMessage, timestamp));
+
+auto read_locate(const std::byte* frame) -> std::uint16_t {
+    std::uint16_t locate {};
+    std::memcpy(&locate, frame + LOCATE_OFFSET, sizeof(locate));
+    return utils::from_big_endian(locate);
+}
+
+auto read_timestamp(const std::byte* frame) -> std::uint64_t {
+    return overlay::detail::read_timestamp(frame, TIMESTAMP_OFFSET);
+}
+
+// Calls visit(offset, frame) for every frame starting at `offset` that the
+// parser would deliver as a message (known type, long enough), until `visit`
+// returns false or the buffer runs out of whole frames. Returns the offset of
+// the frame `visit` stopped at, or the end of the last whole frame.
+template <typename Visitor>
+auto walk_messages(std::span<const std::byte> data, std::size_t offset, Visitor&& visit)
+    -> std::size_t {
+    while (offset + sizeof(std::uint16_t) <= data.size()) {
+        std::uint16_t length {};
+        std::memcpy(&length, data.data() + offset, sizeof(length));
+        length = utils::from_big_endian(length);
+        if (offset + sizeof(std::uint16_t) + length > data.size()) {
+            break;
+        }
+        const std::byte* frame = data.data() + offset + sizeof(std::uint16_t);
+        if (length != 0) {
+            const auto type      = std::to_integer<unsigned char>(frame[0]);
+            const auto wire_size = detail::WIRE_SIZE_TABLE[type];
+            if (wire_size != 0 && length >= wire_size && !visit(offset, frame)) {
+                return offset;
+            }
+        }
+        offset += sizeof(std::uint16_t) + length;
+    }
+    return offset;
+}
+
+// Little-endian field writer/reader for the sidecar format.
+class LittleEndianWriter {
+   public:
+    auto u16(std::uint16_t value) -> void { put(value, sizeof(value)); }
+    auto u32(std::uint32_t value) -> void { put(value, sizeof(value)); }
+    auto u64(std::uint64_t value) -> void { put(value, sizeof(value)); }
+    auto zeros(std::size_t count) -> void { m_bytes.insert(m_bytes.end(), count, std::byte {0}); }
+    auto text(std::string_view value) -> void {
+        for (const char chr : value) {
+            m_bytes.push_back(static_cast<std::byte>(chr));
+        }
+    }
+    [[nodiscard]] auto bytes() const -> const std::vector<std::byte>& { return m_bytes; }
+
+   private:
+    auto put(std::uint64_t value, std::size_t width) -> void {
+        for (std::size_t idx = 0; idx < width; ++idx) {
+            m_bytes.push_back(static_cast<std::byte>((value >> (8 * idx)) & 0xFFU));
+        }
+    }
+    std::vector<std::byte> m_bytes;
+};
+
+class LittleEndianReader {
+   public:
+    explicit LittleEndianReader(std::span<const std::byte> data) : m_data(data) {}
+    auto u16() -> std::uint16_t { return static_cast<std::uint16_t>(get(sizeof(std::uint16_t))); }
+    auto u32() -> std::uint32_t { return static_cast<std::uint32_t>(get(sizeof(std::uint32_t))); }
+    auto u64() -> std::uint64_t { return get(sizeof(std::uint64_t)); }
+    auto skip(std::size_t count) -> void {
+        require(count);
+        m_offset += count;
+    }
+    auto text(std::size_t count) -> std::string {
+        require(count);
+        std::string value(count, '\0');
+        std::memcpy(value.data(), m_data.data() + m_offset, count);
+        m_offset += count;
+        return value;
+    }
+    [[nodiscard]] auto remaining() const -> std::size_t { return m_data.size() - m_offset; }
+
+   private:
+    auto require(std::size_t count) const -> void {
+        if (remaining() < count) {
+            throw std::runtime_error("Seek index file is truncated.");
+        }
+    }
+    auto get(std::size_t width) -> std::uint64_t {
+        require(width);
+        std::uint64_t value = 0;
+        for (std::size_t idx = 0; idx < width; ++idx) {
+            value |= std::to_integer<std::uint64_t>(m_data[m_offset + idx]) << (8 * idx);
+        }
+        m_offset += width;
+        return value;
+    }
+    std::span<const std::byte> m_data;
+    std::size_t                m_offset {0};
+};
+
+}  // namespace
+
+auto SeekIndex::build(std::span<const std::byte> data, std::uint64_t stride) -> SeekIndex {
+    SeekIndex index;
+    index.m_stride    = std::max<std::uint64_t>(1, stride);
+    index.m_data_size = data.size();
+
+    // Dense per-locate scratch; compacted into the sorted range list at the end.
+    constexpr std::size_t    LOCATE_SLOTS = std::size_t {1} << 16;
+    std::vector<LocateRange> ranges(LOCATE_SLOTS);
+
+    std::uint64_t ordinal = 0;
+    walk_messages(data, 0, [&](std::size_t offset, const std::byte* frame) {
+        if (ordinal % index.m_stride == 0) {
+            index.m_points.push_back({offset, ordinal, read_timestamp(frame)});
+        }
+        const auto locate = read_locate(frame);
+        if (locate != 0) {  // Locate 0 marks market-wide (not stock-specific) messages.
+            auto& range = ranges[locate];
+            if (range.message_count == 0) {
+                range.stock_locate = locate;
+                range.first_offset = offset;
+            }
+            range.last_offset = offset;
+            ++range.message_count;
+        }
+        ++ordinal;
+        return true;
+    });
+    index.m_message_count = ordinal;
+
+    for (const auto& range : ranges) {
+        if (range.message_count != 0) {
+            index.m_locates.push_back(range);
+        }
+    }
+    return index;
+}
+
+auto SeekIndex::seek(std::span<const std::byte> data, SeekTarget target) const
+    -> std::span<const std::byte> {
+    if (data.size() != m_data_size) {
+        throw std::runtime_error("Seek index does not match the data (size differs).");
+    }
+    if (m_points.empty()) {
+        return data.subspan(data.size());
+    }
+
+    // Start from the last sample point strictly before the target, so that every
+    // message at or after the target is still ahead of the walk.
+    auto first_at_or_after = std::partition_point(
+        m_points.begin(),
+        m_points.end(),
+        [&](const SeekPoint& point) {
+            return target.kind == SeekTarget::Kind::time ? point.timestamp < target.value
+                                                         : point.ordinal < target.value;
+        }
+    );
+    const auto& start = first_at_or_after == m_points.begin() ? m_points.front()
+                                                               : *std::prev(first_at_or_after);
+
+    std::uint64_t ordinal = start.ordinal;
+    const auto    found   = walk_messages(
+        data,
+        static_cast<std::size_t>(start.offset),
+        [&](std::size_t, const std::byte* frame) {
+            const bool reached = target.kind == SeekTarget::Kind::time
+                                     ? read_timestamp(frame) >= target.value
+                                     : ordinal >= target.value;
+            ++ordinal;
+            return !reached;
+        }
+    );
+    return data.subspan(std::min(found, data.size()));
+}
+
+auto SeekIndex::locate_range(std::uint16_t stock_locate) const -> std::optional<LocateRange> {
+    const auto found = std::lower_bound(
+        m_locates.begin(),
+        m_locates.end(),
+        stock_locate,
+        [](const LocateRange& range, std::uint16_t locate) { return range.stock_locate < locate; }
+    );
+    if (found == m_locates.end() || found->stock_locate != stock_locate) {
+        return std::nullopt;
+    }
+    return *found;
+}
+
+auto SeekIndex::sidecar_path(const std::filesystem::path& data_path) -> std::filesystem::path {
+    auto path = data_path;
+    path += ".idx";
+    return path;
+}
+
+auto SeekIndex::save(const std::filesystem::path& path) const -> void {
+    LittleEndianWriter writer;
+    writer.text(SIDECAR_MAGIC);
+    writer.u32(SIDECAR_VERSION);
+    writer.u32(0);
+    writer.u64(m_stride);
+    writer.u64(m_data_size);
+    writer.u64(m_message_count);
+    writer.u64(m_points.size());
+    writer.u64(m_locates.size());
+    writer.zeros(HEADER_SIZE - writer.bytes().size());
+    for (const auto& point : m_points) {
+        writer.u64(point.offset);
+        writer.u64(point.ordinal);
+        writer.u64(point.timestamp);
+    }
+    for (const auto& range : m_locates) {
+        writer.u16(range.stock_locate);
+        writer.zeros(6);
+        writer.u64(range.first_offset);
+        writer.u64(range.last_offset);
+        writer.u64(range.message_count);
+    }
+
+    std::ofstream out {path, std::ios::binary | std::ios::trunc};
+    const auto&   bytes = writer.bytes();
+    out.write(
+        static_cast<const char*>(static_cast<const void*>(bytes.data())),
+        static_cast<std::streamsize>(bytes.size())
+    );
+    if (!out) {
+        throw std::runtime_error("Failed to write seek index: " + path.string());
+    }
+}
+
+auto SeekIndex::load(const std::filesystem::path& path) -> SeekIndex {
+    const io::MappedFile file {path};
+    LittleEndianReader   reader {file.bytes()};
+    if (reader.text(SIDECAR_MAGIC.size()) != SIDECAR_MAGIC) {
+        throw std::runtime_error("Not a seek index file: " + path.string());
+    }
+    if (reader.u32() != SIDECAR_VERSION) {
+        throw std::runtime_error("Unsupported seek index version: " + path.string());
+    }
+    reader.skip(sizeof(std::uint32_t));
+
+    SeekIndex index;
+    index.m_stride          = reader.u64();
+    index.m_data_size       = reader.u64();
+    index.m_message_count   = reader.u64();
+    const auto point_count  = reader.u64();
+    const auto locate_count = reader.u64();
+    reader.skip(HEADER_SIZE - (file.size() - reader.remaining()));
+    if (point_count > reader.remaining() / POINT_SIZE ||
+        locate_count > (reader.remaining() - point_count * POINT_SIZE) / LOCATE_SIZE) {
+        throw std::runtime_error("Seek index file is truncated.");
+    }
+
+    index.m_points.reserve(point_count);
+    for (std::uint64_t idx = 0; idx < point_count; ++idx) {
+        SeekPoint point;
+        point.offset    = reader.u64();
+        point.ordinal   = reader.u64();
+        point.timestamp = reader.u64();
+        index.m_points.push_back(point);
+    }
+    index.m_locates.reserve(locate_count);
+    for (std::uint64_t idx = 0; idx < locate_count; ++idx) {
+        LocateRange range;
+        range.stock_locate = reader.u16();
+        reader.skip(6);
+        range.first_offset  = reader.u64();
+        range.last_offset   = reader.u64();
+        range.message_count = reader.u64();
+        index.m_locates.push_back(range);
+    }
+    return index;
+}
+
+auto parse_from(
+    Parser&                    parser,
+    std::span<const std::byte> data,
+    const SeekIndex&           index,
+    SeekTarget                 target,
+    const MessageCallback&     callback
+) -> void {
+    parser.parse(index.seek(data, target), callback);
+}
+
+}  // namespace itch
@@ -0,0 +1,376 @@
+#include "itch/detail/simd_decode.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <variant>
+
+#include "itch/decode_kernel.hpp"
+#include "itch/detail/wire.hpp"
+
+#if ITCH_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+namespace itch {
+
+namespace {
+
+#if ITCH_SIMD_X86
+
+struct CpuFeatures {
+    bool ssse3 {false};
+    bool avx2 {false};
+};
+
+auto detect_cpu_features() noexcept -> CpuFeatures {
+    CpuFeatures features;
+#if defined(_MSC_VER) && !defined(__clang__)
+    constexpr int SSSE3_BIT   = 9;   // CPUID.1:ECX
+    constexpr int OSXSAVE_BIT = 27;  // CPUID.1:ECX
+    constexpr int AVX_BIT     = 28;  // CPUID.1:ECX
+    constexpr int AVX2_BIT    = 5;   // CPUID.(7,0):EBX
+    constexpr unsigned long long YMM_STATE = 0x6;  // XCR0: SSE and AVX state saved by the OS.
+
+    std::array<int, 4> regs {};
+    __cpuid(regs.data(), 1);
+    const auto ecx     = static_cast<unsigned>(regs[2]);
+    features.ssse3     = ((ecx >> SSSE3_BIT) & 1U) != 0;
+    const bool os_ymm  = ((ecx >> OSXSAVE_BIT) & 1U) != 0 && ((ecx >> AVX_BIT) & 1U) != 0 &&
+                        (_xgetbv(0) & YMM_STATE) == YMM_STATE;
+    __cpuidex(regs.data(), 7, 0);
+    features.avx2 = os_ymm && ((static_cast<unsigned>(regs[1]) >> AVX2_BIT) & 1U) != 0;
+#else
+    __builtin_cpu_init();
+    features.ssse3 = __builtin_cpu_supports("ssse3") != 0;
+    features.avx2  = __builtin_cpu_supports("avx2") != 0;
+#endif
+    return features;
+}
+
+auto cpu_features() noexcept -> const CpuFeatures& {
+    static const CpuFeatures features = detect_cpu_features();
+    return features;
+}
+
+// Each kernel works from a plan that says, for every 16-byte block of the
+// decoded struct, which bytes of which 16-byte window of the frame land where.
+// The plan is derived at compile time from a per-type list of fields, so a
+// kernel is just: load the frame windows, shuffle each into the output blocks
+// that draw from it, OR the pieces together, and copy the blocks into the
+// struct. The structs are packed, so the field list is the only layout input.
+
+constexpr std::size_t LANE = 16;
+
+/// @brief Where one field sits on the wire and in the decoded struct.
+struct FieldMap {
+    std::size_t host_offset;  ///< offsetof the field in the message struct.
+    std::size_t wire_offset;  ///< Offset of the field in the frame.
+    std::size_t width;        ///< Bytes on the wire.
+    bool        big_endian;   ///< Integer to byte-swap, or raw characters to copy.
+};
+
+template <typename MsgType>
+consteval auto header_fields() -> std::array<FieldMap, 4> {
+    return {{
+        {offsetof(MsgType, message_type), 0, 1, false},
+        {offsetof(MsgType, stock_locate), 1, 2, true},
+        {offsetof(MsgType, tracking_number), 3, 2, true},
+        {offsetof(MsgType, timestamp), 5, 6, true},  // 48 bits into the low 6 bytes.
+    }};
+}
+
+template <std::size_t Extra, typename MsgType>
+consteval auto with_header(const std::array<FieldMap, Extra>& body)
+    -> std::array<FieldMap, 4 + Extra> {
+    std::array<FieldMap, 4 + Extra> fields {};
+    const auto                      header = header_fields<MsgType>();
+    for (std::size_t idx = 0; idx < header.size(); ++idx) {
+        fields[idx] = header[idx];
+    }
+    for (std::size_t idx = 0; idx < Extra; ++idx) {
+        fields[4 + idx] = body[idx];
+    }
+    return fields;
+}
+
+/// @brief The wire-to-struct field list of each message type with a kernel.
+template <typename MsgType>
+struct KernelFields;
+
+template <>
+struct KernelFields<AddOrderMessage> {
+    static constexpr auto VALUE = with_header<5, AddOrderMessage>({{
+        {offsetof(AddOrderMessage, order_reference_number), 11, 8, true},
+        {offsetof(AddOrderMessage, buy_sell_indicator), 19, 1, false},
+        {offsetof(AddOrderMessage, shares), 20, 4, true},
+        {offsetof(AddOrderMessage, stock), 24, 8, false},
+        {offsetof(AddOrderMessage, price), 32, 4, true},
+    }});
+};
+
+template <>
+struct KernelFields<OrderDeleteMessage> {
+    static constexpr auto VALUE = with_header<1, OrderDeleteMessage>({{
+        {offsetof(OrderDeleteMessage, order_reference_number), 11, 8, true},
+    }});
+};
+
+template <>
+struct KernelFields<OrderExecutedMessage> {
+    static constexpr auto VALUE = with_header<3, OrderExecutedMessage>({{
+        {offsetof(OrderExecutedMessage, order_reference_number), 11, 8, true},
+        {offsetof(OrderExecutedMessage, executed_shares), 19, 4, true},
+        {offsetof(OrderExecutedMessage, match_number), 23, 8, true},
+    }});
+};
+
+template <>
+struct KernelFields<OrderCancelMessage> {
+    static constexpr auto VALUE = with_header<2, OrderCancelMessage>({{
+        {offsetof(OrderCancelMessage, order_reference_number), 11, 8, true},
+        {offsetof(OrderCancelMessage, cancelled_shares), 19, 4, true},
+    }});
+};
+
+template <>
+struct KernelFields<OrderReplaceMessage> {
+    static constexpr auto VALUE = with_header<4, OrderReplaceMessage>({{
+        {offsetof(OrderReplaceMessage, original_order_reference_number), 11, 8, true},
+        {offsetof(OrderReplaceMessage, new_order_reference_number), 19, 8, true},
+        {offsetof(OrderReplaceMessage, shares), 27, 4, true},
+        {offsetof(OrderReplaceMessage, price), 31, 4, true},
+    }});
+};
+
+using ShuffleMask = std::array<std::int8_t, LANE>;
+
+/// @brief Offset of the `index`-th 16-byte block of a `total`-byte object. The
+///        last block is pulled back to end exactly at the end of the object,
+///        overlapping its neighbour, so no access ever leaves the object.
+consteval auto block_offset(std::size_t index, std::size_t total) -> std::size_t {
+    return index * LANE + LANE <= total ? index * LANE : total - LANE;
+}
+
+/// @brief The compile-time shuffle plan of one message type.
+template <typename MsgType>
+struct ShufflePlan {
+    static constexpr std::size_t WIRE_BYTES = detail::WIRE_SIZE<MsgType>;
+    static constexpr std::size_t HOST_BYTES = sizeof(MsgType);
+    static constexpr std::size_t IN_BLOCKS  = (WIRE_BYTES + LANE - 1) / LANE;
+    static constexpr std::size_t OUT_BLOCKS = (HOST_BYTES + LANE - 1) / LANE;
+    static constexpr std::size_t OUT_PAIRS  = (OUT_BLOCKS + 1) / 2;
+
+    static_assert(WIRE_BYTES >= LANE, "every frame window must fit inside the frame");
+
+    /// Frame offset of each 16-byte load.
+    std::array<std::size_t, IN_BLOCKS> window {};
+    /// Struct offset of each 16-byte store. Overlapping stores write the same
+    /// bytes, and every store is a whole vector, so nothing is staged.
+    std::array<std::size_t, OUT_BLOCKS> block {};
+    /// masks[out][in]: `pshufb` control moving window `in` into output block `out`.
+    std::array<std::array<ShuffleMask, IN_BLOCKS>, OUT_BLOCKS> masks {};
+    /// Whether output block `out` takes anything from window `in`.
+    std::array<std::array<bool, IN_BLOCKS>, OUT_BLOCKS> used {};
+    /// pair_masks[pair][in]: the masks of output blocks 2*pair and 2*pair+1 side
+    /// by side, for one 256-bit `vpshufb` of a window broadcast to both lanes.
+    std::array<std::array<std::array<std::int8_t, 2 * LANE>, IN_BLOCKS>, OUT_PAIRS> pair_masks {};
+};
+
+template <typename MsgType>
+consteval auto build_shuffle_plan() -> ShufflePlan<MsgType> {
+    using Plan = ShufflePlan<MsgType>;
+    constexpr std::int8_t ZERO   = -128;  // High bit set: pshufb writes a zero byte.
+    constexpr std::size_t UNUSED = Plan::WIRE_BYTES;
+
+    // Where each struct byte comes from on the wire; the high bytes of the
+    // 64-bit timestamp come from nowhere and stay zero.
+    std::array<std::size_t, Plan::HOST_BYTES> source {};
+    source.fill(UNUSED);
+    std::size_t covered = 0;
+    for (const auto& field : KernelFields<MsgType>::VALUE) {
+        for (std::size_t byte = 0; byte < field.width; ++byte) {
+            // Little-endian host: an integer's lowest byte is its last on the wire.
+            source[field.host_offset + byte] =
+                field.wire_offset + (field.big_endian ? field.width - 1 - byte : byte);
+        }
+        covered += field.width;
+    }
+    if (covered != Plan::WIRE_BYTES) {
+        throw "field list does not cover the frame";  // Fails constant evaluation.
+    }
+
+    Plan plan;
+    for (std::size_t in = 0; in < Plan::IN_BLOCKS; ++in) {
+        plan.window[in] = block_offset(in, Plan::WIRE_BYTES);
+    }
+    for (std::size_t out = 0; out < Plan::OUT_BLOCKS; ++out) {
+        plan.block[out] = block_offset(out, Plan::HOST_BYTES);
+        for (auto& mask : plan.masks[out]) {
+            mask.fill(ZERO);
+        }
+        for (std::size_t lane = 0; lane < LANE; ++lane) {
+            const std::size_t src = source[plan.block[out] + lane];
+            if (src == UNUSED) {
+                continue;
+            }
+            std::size_t in = 0;
+            while (src >= plan.window[in] + LANE) {
+                ++in;
+            }
+            plan.masks[out][in][lane] = static_cast<std::int8_t>(src - plan.window[in]);
+            plan.used[out][in]        = true;
+        }
+    }
+
+    for (std::size_t pair = 0; pair < Plan::OUT_PAIRS; ++pair) {
+        for (std::size_t in = 0; in < Plan::IN_BLOCKS; ++in) {
+            auto& combined = plan.pair_masks[pair][in];
+            combined.fill(ZERO);
+            for (std::size_t lane = 0; lane < LANE; ++lane) {
+                combined[lane] = plan.masks[2 * pair][in][lane];
+                if (2 * pair + 1 < Plan::OUT_BLOCKS) {
+                    combined[LANE + lane] = plan.masks[2 * pair + 1][in][lane];
+                }
+            }
+        }
+    }
+    return plan;
+}
+
+template <typename MsgType>
+constexpr auto PLAN = build_shuffle_plan<MsgType>();
+
+#endif  // ITCH_SIMD_X86
+
+}  // namespace
+
+auto decode_kernel_supported(DecodeKernel kernel) noexcept -> bool {
+    switch (kernel) {
+        case DecodeKernel::scalar:
+            return true;
+#if ITCH_SIMD_X86
+        case DecodeKernel::ssse3:
+            return cpu_features().ssse3;
+        case DecodeKernel::avx2:
+            return cpu_features().avx2;
+#else
+        case DecodeKernel::ssse3:
+        case DecodeKernel::avx2:
+            break;
+#endif
+    }
+    return false;
+}
+
+auto best_decode_kernel() noexcept -> DecodeKernel {
+    if (decode_kernel_supported(DecodeKernel::avx2)) {
+        return DecodeKernel::avx2;
+    }
+    if (decode_kernel_supported(DecodeKernel::ssse3)) {
+        return DecodeKernel::ssse3;
+    }
+    return DecodeKernel::scalar;
+}
+
+#if ITCH_SIMD_X86
+
+namespace detail {
+
+// The loops below have compile-time trip counts of at most three and tests on
+// constexpr plan entries, so they unroll into straight-line loads, shuffles,
+// ORs, and stores. The stores go straight into the returned variant: building a
+// local struct and copying it would reload bytes just written by overlapping
+// vector stores, which defeats store forwarding.
+
+template <typename MsgType>
+ITCH_SIMD_TARGET("ssse3") auto decode_ssse3(const char* frame) -> Message {
+    using Plan       = ShufflePlan<MsgType>;
+    const auto& plan = PLAN<MsgType>;
+
+    Message result {std::in_place_type<MsgType>};
+    char*   host = static_cast<char*>(static_cast<void*>(&std::get<MsgType>(result)));
+    for (std::size_t out = 0; out < Plan::OUT_BLOCKS; ++out) {
+        __m128i block = _mm_setzero_si128();
+        for (std::size_t in = 0; in < Plan::IN_BLOCKS; ++in) {
+            if (plan.used[out][in]) {
+                const auto window = _mm_loadu_si128(
+                    static_cast<const __m128i*>(static_cast<const void*>(frame + plan.window[in]))
+                );
+                const auto mask = _mm_loadu_si128(static_cast<const __m128i*>(
+                    static_cast<const void*>(plan.masks[out][in].data())
+                ));
+                block = _mm_or_si128(block, _mm_shuffle_epi8(window, mask));
+            }
+        }
+        _mm_storeu_si128(static_cast<__m128i*>(static_cast<void*>(host + plan.block[out])), block);
+    }
+    return result;
+}
+
+template <typename MsgType>
+ITCH_SIMD_TARGET("avx2") auto decode_avx2(const char* frame) -> Message {
+    using Plan       = ShufflePlan<MsgType>;
+    const auto& plan = PLAN<MsgType>;
+
+    // vpshufb shuffles within 128-bit lanes, so each window is broadcast to
+    // both lanes and one instruction fills two output blocks.
+    Message result {std::in_place_type<MsgType>};
+    char*   host = static_cast<char*>(static_cast<void*>(&std::get<MsgType>(result)));
+    for (std::size_t pair = 0; pair < Plan::OUT_PAIRS; ++pair) {
+        const std::size_t low  = 2 * pair;
+        const std::size_t high = low + 1;
+        __m256i           block = _mm256_setzero_si256();
+        for (std::size_t in = 0; in < Plan::IN_BLOCKS; ++in) {
+            if (plan.used[low][in] || (high < Plan::OUT_BLOCKS && plan.used[high][in])) {
+                const auto window = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+                    static_cast<const __m128i*>(static_cast<const void*>(frame + plan.window[in]))
+                ));
+                const auto mask = _mm256_loadu_si256(static_cast<const __m256i*>(
+                    static_cast<const void*>(plan.pair_masks[pair][in].data())
+                ));
+                block = _mm256_or_si256(block, _mm256_shuffle_epi8(window, mask));
+            }
+        }
+        if (high < Plan::OUT_BLOCKS && plan.block[high] == plan.block[low] + LANE) {
+            _mm256_storeu_si256(
+                static_cast<__m256i*>(static_cast<void*>(host + plan.block[low])), block
+            );
+            continue;
+        }
+        _mm_storeu_si128(
+            static_cast<__m128i*>(static_cast<void*>(host + plan.block[low])),
+            _mm256_castsi256_si128(block)
+        );
+        if (high < Plan::OUT_BLOCKS) {
+            _mm_storeu_si128(
+                static_cast<__m128i*>(static_cast<void*>(host + plan.block[high])),
+                _mm256_extracti128_si256(block, 1)
+            );
+        }
+    }
+    return result;
+}
+
+template auto decode_ssse3<AddOrderMessage>(const char*) -> Message;
+template auto decode_ssse3<OrderDeleteMessage>(const char*) -> Message;
+template auto decode_ssse3<OrderExecutedMessage>(const char*) -> Message;
+template auto decode_ssse3<OrderCancelMessage>(const char*) -> Message;
+template auto decode_ssse3<OrderReplaceMessage>(const char*) -> Message;
+
+template auto decode_avx2<AddOrderMessage>(const char*) -> Message;
+template auto decode_avx2<OrderDeleteMessage>(const char*) -> Message;
+template auto decode_avx2<OrderExecutedMessage>(const char*) -> Message;
+template auto decode_avx2<OrderCancelMessage>(const char*) -> Message;
+template auto decode_avx2<OrderReplaceMessage>(const char*) -> Message;
+
+}  // namespace detail
+
+#endif  // ITCH_SIMD_X86
+
+}  // namespace itch
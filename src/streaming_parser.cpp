@@ -0,0 +1,100 @@
+#include "itch/streaming_parser.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace itch {
+
+StreamingParser::StreamingParser(MessageCallback callback, const MessageTypeFilter& filter)
+    : m_callback(std::move(callback)), m_filter(filter) {}
+
+auto StreamingParser::feed(std::span<const std::byte> data) -> std::size_t {
+    // Every byte of the piece is consumed, so the next piece starts right after it.
+    const std::uint64_t base = m_position;
+    m_position += data.size();
+
+    std::size_t offset = 0;
+    if (m_received > 0) {
+        offset = carry(data);
+        if (m_received > 0) {
+            return offset;  // The split frame is still incomplete.
+        }
+    }
+
+    const auto rest         = data.subspan(offset);
+    m_parser.m_input_offset = base + offset;
+    offset +=
+        m_parser.parse_available(detail::as_char_ptr(rest), rest.size(), m_callback, m_filter);
+    if (offset < data.size()) {
+        m_frame_offset = base + offset;
+        offset += carry(data.subspan(offset));
+    }
+    return offset;
+}
+
+auto StreamingParser::finish() -> void {
+    m_position = 0;
+    if (m_received > 0) {
+        reset();
+        m_parser.report_error(ParseError::truncated, '\0');
+        throw std::runtime_error("Incomplete message at end of buffer.");
+    }
+}
+
+auto StreamingParser::reset() noexcept -> void {
+    m_carried    = 0;
+    m_kept       = 0;
+    m_received   = 0;
+    m_frame_size = 0;
+}
+
+auto StreamingParser::carry(std::span<const std::byte> data) -> std::size_t {
+    constexpr std::size_t PREFIX = sizeof(std::uint16_t);
+
+    std::size_t taken = 0;
+    while (taken < data.size()) {
+        if (m_received < PREFIX) {
+            m_carry[m_carried++] = data[taken++];
+            if (++m_received == PREFIX) {
+                std::uint16_t length {};
+                std::memcpy(&length, m_carry.data(), sizeof(length));
+                length = utils::from_big_endian(length);
+
+                // Hold no more of the body than the largest decoder reads; the
+                // rest of an over-long frame is skipped as it arrives, so the
+                // held copy gets the shortened length.
+                const auto held = std::min<std::size_t>(length, detail::MAX_WIRE_SIZE);
+                m_frame_size    = PREFIX + length;
+                m_kept          = PREFIX + held;
+                if (held < length) {
+                    const auto prefix = utils::from_big_endian(static_cast<std::uint16_t>(held));
+                    std::memcpy(m_carry.data(), &prefix, sizeof(prefix));
+                }
+            }
+        } else {
+            const auto step = std::min(m_frame_size - m_received, data.size() - taken);
+            const auto hold = std::min(step, m_kept - m_carried);
+            std::memcpy(m_carry.data() + m_carried, data.data() + taken, hold);
+            m_carried += hold;
+            m_received += step;
+            taken += step;
+        }
+
+        if (m_received >= PREFIX && m_received == m_frame_size) {
+            m_parser.m_input_offset = m_frame_offset;
+            m_parser.parse_available(
+                detail::as_char_ptr(std::span {m_carry}.first(m_carried)),
+                m_carried,
+                m_callback,
+                m_filter
+            );
+            reset();
+            break;
+        }
+    }
+    return taken;
+}
+
+}  // namespace itch
@@ -2,8 +2,11 @@
 
 #include <algorithm>
 #include <cstring>
-#include <fstream>
+#include <system_error>
 #include <utility>
+#include <vector>
+
+#include "itch/io/mapped_file.hpp"
 
 namespace itch::transport {
 
@@ -104,14 +107,13 @@ auto PcapReader::read(std::span<const std::byte> capture) -> bool {
 }
 
 auto PcapReader::read_file(const std::string& path) -> bool {
-    std::ifstream file {path, std::ios::binary};
-    if (!file) {
-        return false;
+    io::MappedFile file;
+    try {
+        file = io::MappedFile {path};
+    } catch (const std::system_error&) {
+        return false;  // Unreadable file: same contract as an unrecognized one.
     }
-    std::vector<char>      raw {std::istreambuf_iterator<char> {file}, {}};
-    std::vector<std::byte> bytes(raw.size());
-    std::memcpy(bytes.data(), raw.data(), raw.size());
-    return read(std::span<const std::byte> {bytes});
+    return read(file.bytes());
 }
 
 auto PcapReader::read_classic_pcap(std::span<const std::byte> capture, bool swapped) -> bool {
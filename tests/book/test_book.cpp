@@ -1,12 +1,18 @@
 #include <gtest/gtest.h>
 
 #include <cstring>
+#include <map>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "itch/book/book_manager.hpp"
 #include "itch/book/l3_book.hpp"
 #include "itch/messages.hpp"
+#include "itch/overlay.hpp"
+#include "itch/parser.hpp"
+#include "transport/frame_builders.hpp"
 
 namespace {
 
@@ -109,6 +115,245 @@ TEST(L3Book, HandlesCrossedBookState) {
     EXPECT_GT(bbo.bid_price.raw(), bbo.ask_price.raw());  // book represents the crossed state
 }
 
+TEST(OrderIndex, DenseModeFreesDeadPagesAndHashesOutliers) {
+    using itch::book::OrderIndex;
+    OrderIndex          index {itch::book::OrderIndexMode::dense};
+    const std::uint64_t base = 1'000'000;
+    for (std::uint64_t ref = base; ref < base + 3 * OrderIndex::DENSE_PAGE_SIZE; ++ref) {
+        index.insert(ref, static_cast<std::uint32_t>(ref - base), 7);
+    }
+    index.insert(base - OrderIndex::DENSE_PAGE_SIZE, 100);  // Below the base.
+    index.insert(base + OrderIndex::MAX_DENSE_PAGES * OrderIndex::DENSE_PAGE_SIZE, 200);
+    EXPECT_EQ(index.size(), 3 * OrderIndex::DENSE_PAGE_SIZE + 2);
+    EXPECT_EQ(index.dense_page_count(), 4U);  // The base is rounded down to a page.
+    EXPECT_EQ(index.find(base + 5, 7), 5U);
+    EXPECT_EQ(index.find(base + 5, 8), OrderIndex::NPOS);
+    EXPECT_EQ(index.find(base - OrderIndex::DENSE_PAGE_SIZE), 100U);
+    EXPECT_EQ(index.find(base + OrderIndex::MAX_DENSE_PAGES * OrderIndex::DENSE_PAGE_SIZE), 200U);
+    EXPECT_FALSE(index.contains(base + 3 * OrderIndex::DENSE_PAGE_SIZE));
+
+    for (std::uint64_t ref = base; ref < base + 3 * OrderIndex::DENSE_PAGE_SIZE; ++ref) {
+        index.erase(ref);
+    }
+    EXPECT_EQ(index.dense_page_count(), 0U);
+    EXPECT_EQ(index.size(), 2U);
+    EXPECT_FALSE(index.contains(base));
+    index.insert(base + 1, 9);  // A dead page comes back on demand.
+    EXPECT_EQ(index.find(base + 1), 9U);
+}
+
+TEST(OrderIndex, DenseModeHashesAFarOutlierWithoutGrowingThePageDirectory) {
+    using itch::book::OrderIndex;
+    constexpr std::uint64_t PAGE = OrderIndex::DENSE_PAGE_SIZE;
+    OrderIndex              index {itch::book::OrderIndexMode::dense};
+    const std::uint64_t     base    = 256 * PAGE;  // Page aligned.
+    const std::uint64_t     outlier = base + 4'000'000'000;
+    index.insert(base, 1);
+    index.insert(outlier, 2);
+    EXPECT_EQ(index.dense_page_span(), 1U);
+    EXPECT_EQ(index.dense_page_count(), 1U);
+    EXPECT_EQ(index.find(outlier), 2U);
+    index.erase(outlier);
+    EXPECT_FALSE(index.contains(outlier));
+    EXPECT_EQ(index.size(), 1U);
+
+    // A key hashed while out of reach stays findable once the pages catch up
+    // with it, and moves into its page when written again.
+    const std::uint64_t ahead = base + (OrderIndex::DENSE_SLACK_PAGES + 4) * PAGE;
+    index.insert(ahead, 3);
+    for (std::uint64_t ref = base + 1; ref < base + 8 * PAGE; ++ref) {
+        index.insert(ref, 4);
+    }
+    EXPECT_EQ(index.dense_page_span(), 8U);
+    EXPECT_EQ(index.find(ahead), 3U);
+    index.insert(ahead, 5);
+    EXPECT_EQ(index.find(ahead), 5U);
+    EXPECT_EQ(index.size(), 8 * PAGE + 1);
+    EXPECT_EQ(index.dense_page_count(), 9U);
+    index.erase(ahead);
+    EXPECT_FALSE(index.contains(ahead));
+    EXPECT_EQ(index.size(), 8 * PAGE);
+}
+
+TEST(OrderIndex, StaysConsistentWhileGrowingIncrementally) {
+    itch::book::OrderIndex                           index;
+    std::unordered_map<std::uint64_t, std::uint32_t> expected;
+    std::uint64_t                                    state = 12345;
+    auto next_key = [&state] {  // A small LCG: scattered, repeatable keys.
+        state = (state * 6364136223846793005ULL) + 1442695040888963407ULL;
+        return (state >> 40) % 300'000;
+    };
+    for (std::uint32_t step = 0; step < 400'000; ++step) {
+        const std::uint64_t key = next_key();
+        if (step % 3 == 2) {
+            index.erase(key);
+            expected.erase(key);
+        } else {
+            index.insert(key, step);  // Overwrites keys still in an old table too.
+            expected[key] = step;
+        }
+        if (step % 997 == 0) {
+            const std::uint64_t probe = next_key();
+            const auto          found = expected.find(probe);
+            EXPECT_EQ(
+                index.find(probe),
+                found == expected.end() ? itch::book::OrderIndex::NPOS : found->second
+            );
+        }
+    }
+    EXPECT_EQ(index.size(), expected.size());
+    for (const auto& [key, value] : expected) {
+        ASSERT_EQ(index.find(key), value);
+    }
+    // Clearing drops any table still being released; the index stays usable.
+    index.clear();
+    EXPECT_TRUE(index.empty());
+    index.insert(42, 7);
+    EXPECT_EQ(index.find(42), 7U);
+}
+
+TEST(PriceLadder, KeepsBestFirstOrderAcrossDriftAndOutliers) {
+    using itch::book::LadderDirection;
+    using itch::book::PriceLadder;
+    for (const auto direction : {LadderDirection::highest_first, LadderDirection::lowest_first}) {
+        PriceLadder                            ladder {direction};
+        std::map<std::uint32_t, std::uint32_t> expected;
+        std::uint64_t                          state = 777;
+        auto next = [&state] {
+            state = (state * 6364136223846793005ULL) + 1442695040888963407ULL;
+            return static_cast<std::uint32_t>(state >> 33);
+        };
+        for (std::uint32_t step = 0; step < 60'000; ++step) {
+            // The mid drifts from $50 to $650, well past any one window.
+            const std::uint32_t mid   = 500'000 + (step * 100);
+            std::uint32_t       price = mid + ((next() % 600) * 100) - 30'000;
+            const std::uint32_t kind = next() % 10;
+            if (kind == 0) {
+                price += 37;  // Off the penny grid.
+            } else if (kind == 1) {
+                price = 1 + (next() % 9'999);  // Under $1, on the $0.0001 grid.
+            } else if (kind == 2) {
+                price = 90'000'000 + ((next() % 5) * 100);  // Far above any window.
+            }
+            if (expected.contains(price)) {
+                ladder.erase(price);
+                expected.erase(price);
+            } else {
+                ladder.insert(price, step);
+                expected[price] = step;
+            }
+            ASSERT_EQ(ladder.size(), expected.size());
+            const std::uint32_t best =
+                expected.empty() ? PriceLadder::NIL
+                : direction == LadderDirection::lowest_first ? expected.begin()->second
+                                                             : expected.rbegin()->second;
+            ASSERT_EQ(ladder.best(), best);
+            const std::uint32_t probe = mid + ((next() % 600) * 100) - 30'000;
+            const auto          found = expected.find(probe);
+            ASSERT_EQ(
+                ladder.find(probe), found == expected.end() ? PriceLadder::NIL : found->second
+            );
+        }
+        std::vector<std::uint32_t> visited;
+        ladder.for_each([&visited](std::uint32_t handle) {
+            visited.push_back(handle);
+            return true;
+        });
+        std::vector<std::uint32_t> ordered;
+        for (const auto& [price, handle] : expected) {
+            ordered.push_back(handle);
+        }
+        if (direction == LadderDirection::highest_first) {
+            std::ranges::reverse(ordered);
+        }
+        EXPECT_EQ(visited, ordered);
+        EXPECT_LE(ladder.window_size(), PriceLadder::MAX_WINDOW);
+    }
+}
+
+TEST(PriceLadder, WindowShrinksBackOnceFarLevelsLeave) {
+    using itch::book::PriceLadder;
+    PriceLadder ladder {itch::book::LadderDirection::lowest_first};
+    ladder.insert(1'000'000, 1);  // $100.00
+    EXPECT_EQ(ladder.window_size(), PriceLadder::INITIAL_WINDOW);
+
+    ladder.insert(11'000'000, 2);  // $1100.00, 100,000 ticks away.
+    EXPECT_EQ(ladder.window_size(), std::size_t {1} << 17);
+    ladder.erase(11'000'000);
+
+    // The next re-anchor sizes the window to the levels left.
+    ladder.insert(980'000, 3);  // $98.00, better than the window.
+    EXPECT_EQ(ladder.window_size(), PriceLadder::INITIAL_WINDOW);
+    EXPECT_EQ(ladder.best(), 3U);
+    EXPECT_EQ(ladder.find(1'000'000), 1U);
+    EXPECT_EQ(ladder.size(), 2U);
+}
+
+TEST(L3Book, ReportsDepthBestFirstAcrossPennyAndSubPennyPrices) {
+    L3Book book {"AAPL"};
+    book.add_order(1, Side::buy, 100, 1000000);   // $100.00
+    book.add_order(2, Side::buy, 100, 9950);      // $0.9950, sub-dollar tick.
+    book.add_order(3, Side::buy, 100, 1000050);   // $100.0050, off the penny grid.
+    book.add_order(4, Side::buy, 100, 50000000);  // $5000.00, far above the window.
+    book.add_order(5, Side::sell, 100, 1000100);
+    book.add_order(6, Side::sell, 100, 1500000);
+
+    const auto bids = book.depth(Side::buy);
+    ASSERT_EQ(bids.size(), 4U);
+    EXPECT_EQ(bids[0].price.raw(), 50000000U);
+    EXPECT_EQ(bids[1].price.raw(), 1000050U);
+    EXPECT_EQ(bids[2].price.raw(), 1000000U);
+    EXPECT_EQ(bids[3].price.raw(), 9950U);
+    EXPECT_EQ(book.depth(Side::buy, 2).size(), 2U);
+
+    book.delete_order(4);
+    book.delete_order(3);
+    EXPECT_EQ(book.bbo().bid_price.raw(), 1000000U);
+    book.delete_order(1);
+    EXPECT_EQ(book.bbo().bid_price.raw(), 9950U);
+    EXPECT_EQ(book.orders_at(Side::buy, 9950).size(), 1U);
+    EXPECT_EQ(book.bbo().ask_price.raw(), 1000100U);
+    EXPECT_EQ(book.level_count(Side::sell), 2U);
+}
+
+TEST(L3Book, UpdatesReachTheirLevelAfterLevelsAreReused) {
+    L3Book book {"AAPL"};
+    book.add_order(1, Side::buy, 100, 1000000);
+    book.add_order(2, Side::buy, 100, 1000100);
+    book.add_order(3, Side::sell, 100, 1000300);
+    book.delete_order(2);                         // Frees the $100.01 level...
+    book.add_order(4, Side::sell, 100, 1000200);  // ...which the new ask reuses.
+    book.add_order(5, Side::buy, 100, 1000000);
+
+    EXPECT_EQ(book.execute_order(1, 40), 40U);
+    book.reduce_order(4, 30);
+    EXPECT_EQ(book.bbo().bid_shares, 160U);
+    EXPECT_EQ(book.bbo().ask_price.raw(), 1000200U);
+    EXPECT_EQ(book.bbo().ask_shares, 70U);
+    book.delete_order(4);
+    EXPECT_EQ(book.bbo().ask_price.raw(), 1000300U);
+    EXPECT_EQ(book.orders_at(Side::buy, 1000000).size(), 2U);
+}
+
+TEST(L3Book, DenseIndexModeMatchesHashedMode) {
+    L3Book hashed {"AAPL"};
+    L3Book dense {"AAPL", itch::book::OrderIndexMode::dense};
+    for (auto* book : {&hashed, &dense}) {
+        book->add_order(500, Side::buy, 100, 1000000);
+        book->add_order(501, Side::buy, 200, 1000100);
+        book->add_order(7, Side::sell, 300, 1000500);  // Below the dense base.
+        book->execute_order(501, 50);
+        book->replace_order(500, 502, 80, 1000200);
+        book->delete_order(7);
+    }
+    EXPECT_EQ(dense.bbo(), hashed.bbo());
+    EXPECT_EQ(dense.depth(Side::buy).size(), hashed.depth(Side::buy).size());
+    EXPECT_TRUE(dense.contains(502));
+    EXPECT_FALSE(dense.contains(500));
+    EXPECT_FALSE(dense.contains(7));
+    EXPECT_EQ(dense.bbo().bid_shares, 80U);
+}
+
 TEST(BookManager, RoutesMessagesToPerSymbolBooks) {
     itch::book::BookManager manager;
     manager.process(itch::Message {make_add(1, 10, 'B', 100, "AAPL", 1500000)});
@@ -171,3 +416,194 @@ TEST(BookManager, ExtractsTradeTapeWithPrintableFlag) {
     EXPECT_EQ(tape[1].price.raw(), 1499000U);  // C uses the execution price
     EXPECT_FALSE(tape[1].printable);           // honours the printable flag
 }
+
+TEST(BookManager, RoutesOrderUpdatesByReferenceNumber) {
+    itch::book::BookManager  manager;
+    std::vector<itch::Trade> tape;
+    manager.set_trade_callback([&](const itch::Trade& trade) { tape.push_back(trade); });
+    manager.process(itch::Message {make_add(1, 10, 'B', 100, "AAPL", 1500000)});
+    manager.process(itch::Message {make_add(2, 11, 'S', 200, "MSFT", 3000000)});
+
+    // The updates carry the wrong locate; the shared index finds the real book.
+    itch::OrderExecutedMessage exec {};
+    exec.stock_locate           = 2;
+    exec.order_reference_number = 10;
+    exec.executed_shares        = 30;
+    manager.process(itch::Message {exec});
+    itch::OrderDeleteMessage del {};
+    del.stock_locate           = 99;
+    del.order_reference_number = 11;
+    manager.process(itch::Message {del});
+
+    EXPECT_EQ(manager.book(1)->bbo().bid_shares, 70U);
+    EXPECT_TRUE(manager.book(2)->empty());
+    ASSERT_EQ(tape.size(), 1U);
+    EXPECT_EQ(tape[0].stock_locate, 1U);
+    EXPECT_EQ(tape[0].symbol, "AAPL");
+}
+
+TEST(BookManager, BooksSeeOnlyTheirOwnOrdersInTheSharedIndex) {
+    itch::book::BookManager manager;
+    manager.process(itch::Message {make_add(1, 10, 'B', 100, "AAPL", 1500000)});
+    manager.process(itch::Message {make_add(2, 11, 'S', 200, "MSFT", 3000000)});
+    // Reference numbers are unique feed-wide: a reused one is a duplicate.
+    manager.process(itch::Message {make_add(2, 10, 'S', 300, "MSFT", 3000100)});
+
+    EXPECT_TRUE(manager.book(1)->contains(10));
+    EXPECT_FALSE(manager.book(1)->contains(11));
+    EXPECT_FALSE(manager.book(2)->contains(10));
+    EXPECT_FALSE(manager.book(2)->order_price(10).has_value());
+    EXPECT_EQ(manager.book(2)->level_count(Side::sell), 1U);
+}
+
+TEST(BookManager, CopiedBookDetachesFromTheSharedIndex) {
+    itch::book::BookManager manager;
+    manager.process(itch::Message {make_add(1, 10, 'B', 100, "AAPL", 1500000)});
+    manager.process(itch::Message {make_add(1, 12, 'S', 50, "AAPL", 1500100)});
+
+    L3Book snapshot = *manager.book(1);
+    snapshot.delete_order(10);
+    snapshot.add_order(20, Side::buy, 300, 1499900);
+    EXPECT_FALSE(snapshot.contains(10));
+    EXPECT_TRUE(snapshot.contains(12));
+    EXPECT_TRUE(snapshot.contains(20));
+
+    // The manager's book and index are untouched by the copy's updates.
+    EXPECT_FALSE(manager.book(1)->contains(20));
+    itch::OrderDeleteMessage del {};
+    del.order_reference_number = 10;
+    manager.process(itch::Message {del});
+    EXPECT_FALSE(manager.book(1)->bbo().has_bid);
+    EXPECT_EQ(manager.book(1)->bbo().ask_shares, 50U);
+
+    L3Book assigned;
+    assigned = *manager.book(1);
+    assigned.delete_order(12);
+    EXPECT_TRUE(assigned.empty());
+    EXPECT_TRUE(manager.book(1)->contains(12));
+}
+
+TEST(BookManager, DenseIndexModeRoutesLikeHashedMode) {
+    itch::book::BookManager hashed;
+    itch::book::BookManager dense {itch::book::OrderIndexMode::dense};
+    for (auto* manager : {&hashed, &dense}) {
+        manager->process(itch::Message {make_add(1, 10, 'B', 100, "AAPL", 1500000)});
+        manager->process(itch::Message {make_add(2, 11, 'S', 200, "MSFT", 3000000)});
+        itch::OrderDeleteMessage del {};
+        del.order_reference_number = 11;
+        manager->process(itch::Message {del});
+    }
+    EXPECT_EQ(dense.book(1)->bbo(), hashed.book(1)->bbo());
+    EXPECT_TRUE(dense.book(2)->empty());
+    EXPECT_TRUE(dense.book(1)->contains(10));
+}
+
+TEST(BookManager, ParseWithHandlerBuildsTheSameBookAsProcess) {
+    std::vector<itch::Message> feed = {
+        itch::Message {make_add(1, 10, 'B', 100, "AAPL", 1500000)},
+        itch::Message {make_add(1, 11, 'S', 200, "AAPL", 1500300)},
+        itch::Message {make_add(2, 12, 'B', 300, "MSFT", 3000000)},
+    };
+    itch::OrderCancelMessage cancel {};
+    cancel.stock_locate           = 1;
+    cancel.order_reference_number = 10;
+    cancel.cancelled_shares       = 40;
+    feed.emplace_back(cancel);
+
+    const auto buffer = itch::test::encode_feed(feed);
+
+    itch::book::BookManager via_process;
+    for (const auto& message : feed) {
+        via_process.process(message);
+    }
+    itch::book::BookManager via_handler;
+    itch::Parser            parser;
+    parser.parse_with(std::span<const std::byte> {buffer}, via_handler);
+
+    EXPECT_EQ(via_handler.book_count(), via_process.book_count());
+    ASSERT_NE(via_handler.book(1), nullptr);
+    EXPECT_EQ(via_handler.book(1)->bbo(), via_process.book(1)->bbo());
+    EXPECT_EQ(via_handler.book(1)->bbo().bid_shares, 60U);
+    EXPECT_EQ(via_handler.book(2)->symbol(), "MSFT");
+}
+
+TEST(BookManager, OverlayViewsBuildTheSameBookAsProcess) {
+    std::vector<itch::Message> feed = {
+        itch::Message {make_add(1, 10, 'B', 100, "AAPL", 1500000)},
+        itch::Message {make_add(1, 11, 'S', 200, "AAPL", 1500300)},
+        itch::Message {make_add(2, 12, 'B', 300, "MSFT", 3000000)},
+    };
+    itch::OrderExecutedMessage exec {};
+    exec.stock_locate           = 1;
+    exec.timestamp              = 5000;
+    exec.order_reference_number = 11;
+    exec.executed_shares        = 50;
+    exec.match_number           = 77;
+    feed.emplace_back(exec);
+    itch::OrderExecutedWithPriceMessage exec_price {};
+    exec_price.stock_locate           = 1;
+    exec_price.order_reference_number = 11;
+    exec_price.executed_shares        = 25;
+    exec_price.printable              = 'N';
+    exec_price.execution_price        = 1500200;
+    feed.emplace_back(exec_price);
+    itch::OrderReplaceMessage replace {};
+    replace.stock_locate                    = 1;
+    replace.original_order_reference_number = 10;
+    replace.new_order_reference_number      = 13;
+    replace.shares                          = 90;
+    replace.price                           = 1500100;
+    feed.emplace_back(replace);
+    itch::OrderCancelMessage cancel {};
+    cancel.stock_locate           = 2;
+    cancel.order_reference_number = 12;
+    cancel.cancelled_shares       = 100;
+    feed.emplace_back(cancel);
+    itch::OrderDeleteMessage del {};
+    del.stock_locate           = 1;
+    del.order_reference_number = 11;
+    feed.emplace_back(del);
+
+    const auto buffer = itch::test::encode_feed(feed);
+
+    auto tape_of = [](itch::book::BookManager& manager, std::vector<itch::Trade>& tape) {
+        manager.set_trade_callback([&tape](const itch::Trade& trade) { tape.push_back(trade); });
+    };
+    std::vector<itch::Trade> process_tape;
+    std::vector<itch::Trade> view_tape;
+    std::vector<itch::Trade> visit_tape;
+    itch::book::BookManager  via_process;
+    itch::book::BookManager  via_view;
+    itch::book::BookManager  via_visit;
+    tape_of(via_process, process_tape);
+    tape_of(via_view, view_tape);
+    tape_of(via_visit, visit_tape);
+
+    for (const auto& message : feed) {
+        via_process.process(message);
+    }
+    itch::overlay::for_each_message(
+        std::span<const std::byte> {buffer},
+        [&via_view](const itch::overlay::MessageView& view) { via_view.process(view); }
+    );
+    EXPECT_EQ(itch::overlay::visit(buffer, via_visit), feed.size());
+
+    for (const auto* manager : {&via_view, &via_visit}) {
+        EXPECT_EQ(manager->book_count(), via_process.book_count());
+        for (const std::uint16_t locate : {1, 2}) {
+            ASSERT_NE(manager->book(locate), nullptr);
+            EXPECT_EQ(manager->book(locate)->bbo(), via_process.book(locate)->bbo());
+        }
+        EXPECT_EQ(manager->book(1)->symbol(), "AAPL");
+        EXPECT_TRUE(manager->book(1)->contains(13));
+    }
+    EXPECT_EQ(via_process.book(1)->bbo().bid_shares, 90U);
+    for (const auto* tape : {&view_tape, &visit_tape}) {
+        ASSERT_EQ(tape->size(), 2U);
+        EXPECT_EQ((*tape)[0].timestamp, 5000U);
+        EXPECT_EQ((*tape)[0].match_number, 77U);
+        EXPECT_EQ((*tape)[0].price.raw(), 1500300U);
+        EXPECT_EQ((*tape)[1].price.raw(), 1500200U);
+        EXPECT_FALSE((*tape)[1].printable);
+    }
+}
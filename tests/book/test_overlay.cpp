@@ -1,8 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <span>
+#include <string>
+#include <variant>
 #include <vector>
 
+#include "itch/encoder.hpp"
 #include "itch/messages.hpp"
 #include "itch/overlay.hpp"
 #include "itch/parser.hpp"
@@ -14,14 +20,136 @@ namespace {
 auto build_buffer(const std::vector<std::vector<std::byte>>& payloads) -> std::vector<std::byte> {
     std::vector<std::byte> buffer;
     for (const auto& payload : payloads) {
-        const auto frame = itch::test::length_prefixed(payload);
-        buffer.insert(buffer.end(), frame.begin(), frame.end());
+        itch::test::append_frame(buffer, payload);
     }
     return buffer;
 }
 
+// One frame of every message type, each filled with a distinct byte pattern so
+// that a view reading at a wrong offset sees a different value.
+auto every_type_buffer() -> std::vector<std::byte> {
+    std::vector<std::byte> buffer;
+    itch::detail::for_each_message_type([&buffer]<typename MsgType>(char type) {
+        MsgType msg {};
+        auto*   bytes = static_cast<unsigned char*>(static_cast<void*>(&msg));
+        for (std::size_t index = 0; index < sizeof(MsgType); ++index) {
+            const std::size_t pattern = (index * 37) + static_cast<unsigned char>(type);
+            bytes[index]              = static_cast<unsigned char>(pattern);
+        }
+        msg.message_type  = type;
+        msg.timestamp    &= 0x0000FFFFFFFFFFFFULL;  // Fits 48 bits.
+        const auto frame  = itch::encode_frame(itch::Message {msg});
+        buffer.insert(buffer.end(), frame.begin(), frame.end());
+    });
+    return buffer;
+}
+
+// Checks the fields of a few of the wider views against the eager decode; every
+// other view only has its common fields checked.
+struct FieldChecker {
+    const std::vector<itch::Message>* eager;
+    std::size_t                       index {0};
+
+    template <typename MsgType>
+    auto expected() -> const MsgType& {
+        return std::get<MsgType>((*eager)[index++]);
+    }
+
+    auto operator()(const itch::overlay::StockDirectoryView& view) -> void {
+        const auto& msg = expected<itch::StockDirectoryMessage>();
+        EXPECT_EQ(view.stock(), std::string_view(msg.stock, sizeof(msg.stock)));
+        EXPECT_EQ(view.round_lot_size(), msg.round_lot_size);
+        EXPECT_EQ(view.issue_sub_type(), std::string_view(msg.issue_sub_type, 2));
+        EXPECT_EQ(view.etp_leverage_factor(), msg.etp_leverage_factor);
+        EXPECT_EQ(view.inverse_indicator(), msg.inverse_indicator);
+    }
+
+    auto operator()(const itch::overlay::MWCBDeclineLevelView& view) -> void {
+        const auto& msg = expected<itch::MWCBDeclineLevelMessage>();
+        EXPECT_EQ(view.level1(), msg.level1);
+        EXPECT_EQ(view.level3(), msg.level3);
+    }
+
+    auto operator()(const itch::overlay::AddOrderMPIDAttributionView& view) -> void {
+        const auto& msg = expected<itch::AddOrderMPIDAttributionMessage>();
+        EXPECT_EQ(view.price(), msg.price);
+        EXPECT_EQ(view.attribution(), std::string_view(msg.attribution, 4));
+    }
+
+    auto operator()(const itch::overlay::CrossTradeView& view) -> void {
+        const auto& msg = expected<itch::CrossTradeMessage>();
+        EXPECT_EQ(view.shares(), msg.shares);
+        EXPECT_EQ(view.cross_price(), msg.cross_price);
+        EXPECT_EQ(view.match_number(), msg.match_number);
+        EXPECT_EQ(view.cross_type(), msg.cross_type);
+    }
+
+    auto operator()(const itch::overlay::NOIIView& view) -> void {
+        const auto& msg = expected<itch::NOIIMessage>();
+        EXPECT_EQ(view.paired_shares(), msg.paired_shares);
+        EXPECT_EQ(view.imbalance_direction(), msg.imbalance_direction);
+        EXPECT_EQ(view.current_reference_price(), msg.current_reference_price);
+        EXPECT_EQ(view.price_variation_indicator(), msg.price_variation_indicator);
+    }
+
+    auto operator()(const itch::overlay::DLCRView& view) -> void {
+        const auto& msg = expected<itch::DLCRMessage>();
+        EXPECT_EQ(view.near_execution_time(), msg.near_execution_time);
+        EXPECT_EQ(view.upper_price_range_collar(), msg.upper_price_range_collar);
+    }
+
+    auto operator()(const itch::overlay::MessageView& view) -> void {
+        const auto& msg = (*eager)[index++];
+        std::visit(
+            [&view](const auto& inner) {
+                EXPECT_EQ(view.type(), inner.message_type);
+                EXPECT_EQ(view.stock_locate(), inner.stock_locate);
+                EXPECT_EQ(view.tracking_number(), inner.tracking_number);
+                EXPECT_EQ(view.timestamp(), inner.timestamp);
+            },
+            msg
+        );
+    }
+};
+
 }  // namespace
 
+TEST(Overlay, EveryMessageTypeHasAView) {
+    const auto buffer = every_type_buffer();
+    const auto eager  = itch::Parser {}.parse(std::span<const std::byte> {buffer});
+    ASSERT_EQ(eager.size(), std::variant_size_v<itch::Message>);
+
+    // Each view decodes to exactly the struct the eager parser produces.
+    std::size_t index  = 0;
+    const auto  visits = itch::overlay::visit(buffer, [&](const auto& view) {
+        using View = std::decay_t<decltype(view)>;
+        ASSERT_EQ(view.type(), View::TYPE);
+        const auto  decoded = view.decode();
+        const auto& msg     = std::get<typename View::struct_type>(eager[index++]);
+        EXPECT_EQ(std::memcmp(&decoded, &msg, sizeof(msg)), 0) << view.type();
+    });
+    EXPECT_EQ(visits, eager.size());
+
+    FieldChecker checker {&eager};
+    itch::overlay::visit(buffer, checker);
+    EXPECT_EQ(checker.index, eager.size());
+}
+
+TEST(Overlay, VisitSkipsTypesTheHandlerDoesNotAccept) {
+    const auto buffer = build_buffer({
+        itch::test::add_order_payload(1, 1, 'B', 100, "AAA", 1000000),
+        itch::test::system_event_payload(5000, 'O'),
+        itch::test::add_order_payload(1, 2, 'S', 200, "AAA", 1000100),
+    });
+
+    std::uint64_t shares = 0;
+    const auto    visits = itch::overlay::visit(
+        buffer, [&shares](const itch::overlay::AddOrderView& add) { shares += add.shares(); }
+    );
+    EXPECT_EQ(visits, 2U);
+    EXPECT_EQ(shares, 300U);
+}
+
 TEST(Overlay, ViewFieldsMatchEagerDecode) {
     const auto payload = itch::test::add_order_payload(7, 42, 'B', 500, "AAPL", 1500000);
     const auto buffer  = build_buffer({payload});
@@ -83,3 +211,81 @@ TEST(Overlay, UndersizedFrameIsSkipped) {
         itch::overlay::for_each_message(std::span<const std::byte> {buffer}, [](const auto&) {});
     EXPECT_EQ(total, 0U);
 }
+
+TEST(Overlay, TransformMatchesDecodeModifyEncode) {
+    auto       buffer   = every_type_buffer();
+    const auto original = itch::Parser {}.parse(std::span<const std::byte> {buffer});
+
+    // Reference: decode, modify the structs, and re-encode.
+    std::vector<std::byte> expected;
+    std::uint16_t          sequence = 0;
+    for (auto msg : original) {
+        std::visit(
+            [&sequence](auto& decoded) {
+                decoded.tracking_number  = sequence++;
+                decoded.stock_locate    += 1;
+                decoded.timestamp       += 1000;
+                if constexpr (requires { decoded.attribution; }) {
+                    std::memcpy(decoded.attribution, "ANON", 4);
+                }
+                if constexpr (requires { decoded.mpid; }) {
+                    std::memcpy(decoded.mpid, "X   ", 4);
+                }
+            },
+            msg
+        );
+        const auto frame = itch::encode_frame(msg);
+        expected.insert(expected.end(), frame.begin(), frame.end());
+    }
+
+    sequence         = 0;
+    const auto count = itch::overlay::transform(buffer, [&sequence](auto& view) {
+        view.set_tracking_number(sequence++);
+        view.set_stock_locate(static_cast<std::uint16_t>(view.stock_locate() + 1));
+        view.set_timestamp(view.timestamp() + 1000);
+        if constexpr (requires { view.set_attribution("ANON"); }) {
+            view.set_attribution("ANON");
+        }
+        if constexpr (requires { view.set_mpid("X"); }) {
+            view.set_mpid("X");
+        }
+    });
+    EXPECT_EQ(count, original.size());
+    EXPECT_EQ(buffer, expected);
+}
+
+TEST(Overlay, TransformDeliversOnlyAcceptedTypes) {
+    auto buffer = build_buffer({
+        itch::test::add_order_payload(1, 1, 'B', 100, "AAPL", 1000000),
+        itch::test::system_event_payload(5000, 'O'),
+        itch::test::add_order_payload(1, 2, 'S', 200, "AAPL", 1000100),
+    });
+
+    constexpr std::size_t SHARES_OFFSET =
+        itch::detail::wire_offset(offsetof(itch::AddOrderMessage, shares));
+    const auto adds = itch::overlay::transform(
+        buffer,
+        [](itch::overlay::MutableView<itch::overlay::AddOrderView>& view) {
+            view.set_stock("MSFT");
+            view.write<std::uint32_t>(SHARES_OFFSET, view.shares() * 2);
+        }
+    );
+    EXPECT_EQ(adds, 2U);
+
+    std::uint64_t tracking = 0;
+    const auto    frames   = itch::overlay::transform(
+        buffer, [&tracking](itch::overlay::MutableView<>& view) {
+            view.set_tracking_number(static_cast<std::uint16_t>(++tracking));
+        }
+    );
+    EXPECT_EQ(frames, 3U);
+
+    const auto messages = itch::Parser {}.parse(std::span<const std::byte> {buffer});
+    ASSERT_EQ(messages.size(), 3U);
+    const auto& first = std::get<itch::AddOrderMessage>(messages[0]);
+    EXPECT_EQ(std::string_view(first.stock, sizeof(first.stock)), "MSFT    ");
+    EXPECT_EQ(first.shares, 200U);
+    EXPECT_EQ(std::get<itch::AddOrderMessage>(messages[2]).shares, 400U);
+    EXPECT_EQ(std::get<itch::SystemEventMessage>(messages[1]).tracking_number, 2U);
+    EXPECT_EQ(std::get<itch::SystemEventMessage>(messages[1]).timestamp, 5000U);
+}
@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "itch/io/decompress.hpp"
+#include "itch/parser.hpp"
+#include "transport/frame_builders.hpp"
+
+#ifdef ITCH_WITH_ZLIB
+#define ZLIB_CONST
+#include <zlib.h>
+#endif
+
+namespace {
+
+// A feed long enough to span many small decompression blocks.
+auto sample_feed(std::uint64_t orders = 500) -> std::vector<std::byte> {
+    using itch::test::append_frame;
+    std::vector<std::byte> buffer;
+    append_frame(buffer, itch::test::system_event_payload(1000, 'O'));
+    for (std::uint64_t ref = 1; ref <= orders; ++ref) {
+        append_frame(
+            buffer, itch::test::add_order_payload(7, ref, 'B', 100 + ref, "AAPL", 1500000)
+        );
+    }
+    append_frame(buffer, itch::test::system_event_payload(2000, 'C'));
+    return buffer;
+}
+
+auto parsed_count(itch::Parser& parser, std::span<const std::byte> data) -> std::size_t {
+    std::size_t count = 0;
+    parser.parse_compressed(data, [&count](const itch::Message&) { ++count; });
+    return count;
+}
+
+#ifdef ITCH_WITH_ZLIB
+
+auto gzip(std::span<const std::byte> raw) -> std::vector<std::byte> {
+    z_stream stream {};
+    // 15 window bits plus 16 selects the gzip container.
+    EXPECT_EQ(
+        deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY),
+        Z_OK
+    );
+    std::vector<std::byte> out(deflateBound(&stream, static_cast<uLong>(raw.size())));
+    stream.next_in   = static_cast<const Bytef*>(static_cast<const void*>(raw.data()));
+    stream.avail_in  = static_cast<uInt>(raw.size());
+    stream.next_out  = static_cast<Bytef*>(static_cast<void*>(out.data()));
+    stream.avail_out = static_cast<uInt>(out.size());
+    EXPECT_EQ(deflate(&stream, Z_FINISH), Z_STREAM_END);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return out;
+}
+
+#endif
+
+}  // namespace
+
+TEST(Decompress, DetectsFormatsByMagicBytes) {
+    using itch::io::Compression;
+    const std::vector<std::byte> gz {std::byte {0x1F}, std::byte {0x8B}, std::byte {0x08}};
+    const std::vector<std::byte> zst {
+        std::byte {0x28}, std::byte {0xB5}, std::byte {0x2F}, std::byte {0xFD}
+    };
+    EXPECT_EQ(itch::io::detect_compression(gz), Compression::gzip);
+    EXPECT_EQ(itch::io::detect_compression(zst), Compression::zstd);
+    EXPECT_EQ(itch::io::detect_compression(sample_feed(1)), Compression::none);
+    EXPECT_EQ(itch::io::detect_compression({}), Compression::none);
+    EXPECT_TRUE(itch::io::compression_supported(Compression::none));
+}
+
+TEST(Decompress, UncompressedInputIsHandedOverWhole) {
+    const auto  raw   = sample_feed(3);
+    std::size_t calls = 0;
+    const auto  left  = itch::io::for_each_decompressed_block(
+        raw,
+        itch::io::Compression::none,
+        [&](std::span<const std::byte> block) {
+            ++calls;
+            EXPECT_EQ(block.data(), raw.data());
+            return block.size() - 1;
+        }
+    );
+    EXPECT_EQ(calls, 1U);
+    EXPECT_EQ(left, 1U);
+
+    itch::Parser parser;
+    EXPECT_EQ(parsed_count(parser, raw), 5U);
+}
+
+TEST(Decompress, RejectsADegenerateRing) {
+    const auto raw         = sample_feed(1);
+    const auto consume_all = [](std::span<const std::byte> block) { return block.size(); };
+    EXPECT_THROW(
+        itch::io::for_each_decompressed_block(
+            raw, itch::io::Compression::none, consume_all, {.block_size = 1024, .blocks = 1}
+        ),
+        std::invalid_argument
+    );
+}
+
+TEST(Decompress, UnsupportedFormatsThrow) {
+    using itch::io::Compression;
+    const std::vector<std::byte> zst {
+        std::byte {0x28}, std::byte {0xB5}, std::byte {0x2F}, std::byte {0xFD}, std::byte {0x00}
+    };
+    if (itch::io::compression_supported(Compression::zstd)) {
+        GTEST_SKIP() << "zstd support is built in.";
+    }
+    itch::Parser parser;
+    EXPECT_THROW(static_cast<void>(parsed_count(parser, zst)), std::runtime_error);
+}
+
+#ifdef ITCH_WITH_ZLIB
+
+TEST(Decompress, ParsesGzipAcrossBlockBoundaries) {
+    const auto raw        = sample_feed();
+    const auto compressed = gzip(raw);
+    ASSERT_EQ(itch::io::detect_compression(compressed), itch::io::Compression::gzip);
+
+    // Blocks far smaller than the feed, and not a multiple of any frame size,
+    // so most frames are split across two blocks.
+    std::vector<std::uint64_t> refs;
+    itch::Parser               parser;
+    parser.parse_compressed(
+        compressed,
+        [&refs](const itch::Message& msg) {
+            if (const auto* add = std::get_if<itch::AddOrderMessage>(&msg)) {
+                refs.push_back(add->order_reference_number);
+            }
+        },
+        itch::MessageTypeFilter::all(),
+        {.block_size = 97, .blocks = 2}
+    );
+    ASSERT_EQ(refs.size(), 500U);
+    for (std::size_t index = 0; index < refs.size(); ++index) {
+        EXPECT_EQ(refs[index], index + 1);
+    }
+}
+
+TEST(Decompress, ReadsConcatenatedGzipMembers) {
+    const auto first  = gzip(sample_feed(10));
+    const auto second = gzip(sample_feed(20));
+    auto       joined = first;
+    joined.insert(joined.end(), second.begin(), second.end());
+
+    itch::Parser parser;
+    EXPECT_EQ(parsed_count(parser, joined), 12U + 22U);
+}
+
+TEST(Decompress, ParseFileDetectsGzip) {
+    const auto path = std::filesystem::temp_directory_path() / "itch_decompress_test.itch.gz";
+    {
+        const auto    compressed = gzip(sample_feed());
+        std::ofstream out {path, std::ios::binary};
+        out.write(
+            static_cast<const char*>(static_cast<const void*>(compressed.data())),
+            static_cast<std::streamsize>(compressed.size())
+        );
+    }
+    itch::Parser parser;
+    const auto   messages = parser.parse_file(path);
+    std::size_t  filtered = 0;
+    parser.parse_file(
+        path, [&filtered](const itch::Message&) { ++filtered; }, itch::MessageTypeFilter {"S"}
+    );
+    std::error_code ignored;
+    std::filesystem::remove(path, ignored);
+
+    EXPECT_EQ(messages.size(), 502U);
+    EXPECT_EQ(filtered, 2U);
+}
+
+TEST(Decompress, TruncatedGzipThrowsAfterDeliveringWhatItCould) {
+    auto compressed = gzip(sample_feed());
+    compressed.resize(compressed.size() / 2);
+
+    std::size_t  count = 0;
+    itch::Parser parser;
+    EXPECT_THROW(
+        parser.parse_compressed(compressed, [&count](const itch::Message&) { ++count; }),
+        std::runtime_error
+    );
+    EXPECT_GT(count, 0U);
+}
+
+TEST(Decompress, AFrameCutAtTheEndOfTheStreamIsTruncation) {
+    auto raw = sample_feed(2);
+    raw.pop_back();
+    const auto compressed = gzip(raw);
+
+    itch::Parser parser;
+    EXPECT_THROW(static_cast<void>(parsed_count(parser, compressed)), std::runtime_error);
+    EXPECT_EQ(parser.malformed_message_count(), 1U);
+}
+
+TEST(Decompress, ConsumerExceptionsStopTheDecompressor) {
+    const auto  compressed = gzip(sample_feed());
+    std::size_t blocks     = 0;
+    EXPECT_THROW(
+        itch::io::for_each_decompressed_block(
+            compressed,
+            itch::io::Compression::gzip,
+            [&blocks](std::span<const std::byte>) -> std::size_t {
+                if (++blocks == 3) {
+                    throw std::logic_error("stop");
+                }
+                return 0;
+            },
+            {.block_size = 64, .blocks = 2}
+        ),
+        std::logic_error
+    );
+    EXPECT_EQ(blocks, 3U);
+}
+
+TEST(Decompress, CarryBeyondTheLimitThrows) {
+    const auto compressed = gzip(sample_feed());
+    EXPECT_THROW(
+        itch::io::for_each_decompressed_block(
+            compressed,
+            itch::io::Compression::gzip,
+            [](std::span<const std::byte>) -> std::size_t { return 0; },
+            {.block_size = 64, .blocks = 2, .max_carry = 100}
+        ),
+        std::runtime_error
+    );
+}
+
+#endif
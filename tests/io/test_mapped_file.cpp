@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "itch/io/mapped_file.hpp"
+#include "itch/overlay.hpp"
+#include "itch/parser.hpp"
+#include "transport/frame_builders.hpp"
+
+namespace {
+
+// Writes `bytes` to a uniquely named file in the temp directory and removes it
+// again when the fixture goes out of scope.
+class TempFile {
+   public:
+    TempFile(const std::string& name, std::span<const std::byte> bytes)
+        : m_path(std::filesystem::temp_directory_path() / name) {
+        std::ofstream out {m_path, std::ios::binary};
+        out.write(
+            static_cast<const char*>(static_cast<const void*>(bytes.data())),
+            static_cast<std::streamsize>(bytes.size())
+        );
+    }
+    TempFile(const TempFile&)                    = delete;
+    auto operator=(const TempFile&) -> TempFile& = delete;
+    ~TempFile() {
+        std::error_code ignored;
+        std::filesystem::remove(m_path, ignored);
+    }
+    [[nodiscard]] auto path() const -> const std::filesystem::path& { return m_path; }
+
+   private:
+    std::filesystem::path m_path;
+};
+
+using itch::test::sample_feed;
+
+}  // namespace
+
+TEST(MappedFile, ExposesTheFileContentsAsABytesSpan) {
+    const auto     feed = sample_feed();
+    const TempFile file {"itch_mapped_file_contents.bin", feed};
+
+    const itch::io::MappedFile mapped {file.path(), {.populate = true, .huge_pages = true}};
+    ASSERT_EQ(mapped.size(), feed.size());
+    EXPECT_TRUE(std::equal(feed.begin(), feed.end(), mapped.bytes().begin()));
+}
+
+TEST(MappedFile, EmptyFileMapsToAnEmptySpan) {
+    const TempFile             file {"itch_mapped_file_empty.bin", {}};
+    const itch::io::MappedFile mapped {file.path()};
+    EXPECT_TRUE(mapped.empty());
+    EXPECT_TRUE(mapped.bytes().empty());
+}
+
+TEST(MappedFile, MissingFileThrowsSystemError) {
+    EXPECT_THROW(
+        itch::io::MappedFile {std::filesystem::temp_directory_path() / "itch_no_such_file.bin"},
+        std::system_error
+    );
+}
+
+TEST(MappedFile, MoveTransfersOwnership) {
+    const auto           feed = sample_feed();
+    const TempFile       file {"itch_mapped_file_move.bin", feed};
+    itch::io::MappedFile first {file.path()};
+    const auto*          data = first.data();
+
+    itch::io::MappedFile second {std::move(first)};
+    EXPECT_TRUE(first.empty());  // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(second.data(), data);
+    EXPECT_EQ(second.size(), feed.size());
+}
+
+TEST(MappedFile, ParseFileMatchesParsingTheBuffer) {
+    const auto     feed = sample_feed();
+    const TempFile file {"itch_mapped_file_parse.bin", feed};
+
+    itch::Parser parser;
+    const auto   from_file   = parser.parse_file(file.path());
+    const auto   from_buffer = parser.parse(std::span<const std::byte> {feed});
+    ASSERT_EQ(from_file.size(), from_buffer.size());
+
+    int adds = 0;
+    parser.parse_file(
+        file.path(), [&](const itch::Message&) { ++adds; }, itch::MessageTypeFilter {"A"}
+    );
+    EXPECT_EQ(adds, 2);
+    EXPECT_THROW(parser.parse_file(file.path().string() + ".missing"), std::system_error);
+}
+
+TEST(MappedFile, OverlayWalksAMappedFile) {
+    const auto     feed = sample_feed();
+    const TempFile file {"itch_mapped_file_overlay.bin", feed};
+
+    std::uint64_t refs = 0;
+    const auto    delivered =
+        itch::overlay::for_each_message(file.path(), [&](const itch::overlay::MessageView& view) {
+            if (view.type() == 'A') {
+                const itch::overlay::AddOrderView add {view.data(), view.size()};
+                refs += add.order_reference_number();
+            }
+        });
+    EXPECT_EQ(delivered, 3u);
+    EXPECT_EQ(refs, 85u);
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "itch/basic_parser.hpp"
+#include "itch/parser.hpp"
+#include "transport/frame_builders.hpp"
+
+namespace {
+
+using itch::test::append_frame;
+
+auto sample_feed() -> std::vector<std::byte> {
+    std::vector<std::byte> buffer;
+    append_frame(buffer, itch::test::system_event_payload(1000, 'O'));
+    append_frame(buffer, itch::test::add_order_payload(7, 42, 'B', 500, "AAPL", 1500000));
+    append_frame(buffer, itch::test::system_event_payload(2000, 'S'));
+    append_frame(buffer, itch::test::add_order_payload(7, 43, 'S', 300, "AAPL", 1510000));
+    return buffer;
+}
+
+using AddOnlyParser = itch::BasicParser<itch::AddOrderMessage>;
+
+}  // namespace
+
+static_assert(std::variant_size_v<AddOnlyParser::Message> == 1);
+static_assert(std::variant_size_v<itch::BookParser::Message> == 10);
+static_assert(itch::BookParser::TYPES.contains('A'));
+static_assert(itch::BookParser::TYPES.contains('R'));
+static_assert(!itch::BookParser::TYPES.contains('S'));
+
+TEST(BasicParser, DeliversOnlyItsTypesInFeedOrder) {
+    AddOnlyParser              parser;
+    std::vector<std::uint64_t> refs;
+    parser.parse(sample_feed(), [&refs](const AddOnlyParser::Message& msg) {
+        refs.push_back(std::get<itch::AddOrderMessage>(msg).order_reference_number);
+    });
+    EXPECT_EQ(refs, (std::vector<std::uint64_t> {42, 43}));
+}
+
+TEST(BasicParser, MatchesTheFullParser) {
+    using Subset = itch::BasicParser<itch::SystemEventMessage, itch::AddOrderMessage>;
+    const auto feed   = sample_feed();
+    const auto full   = itch::Parser {}.parse(feed);
+    const auto subset = Subset {}.parse(feed);
+    ASSERT_EQ(subset.size(), full.size());
+    for (std::size_t index = 0; index < full.size(); ++index) {
+        if (const auto* add = std::get_if<itch::AddOrderMessage>(&full[index])) {
+            const auto& got = std::get<itch::AddOrderMessage>(subset[index]);
+            EXPECT_EQ(got.order_reference_number, add->order_reference_number);
+            EXPECT_EQ(got.shares, add->shares);
+            EXPECT_EQ(got.price, add->price);
+            EXPECT_EQ(got.timestamp, add->timestamp);
+        } else {
+            const auto& event = std::get<itch::SystemEventMessage>(full[index]);
+            const auto& got   = std::get<itch::SystemEventMessage>(subset[index]);
+            EXPECT_EQ(got.event_code, event.event_code);
+        }
+    }
+}
+
+TEST(BasicParser, ParseWithCallsTheHandlerWithConcreteStructs) {
+    itch::BookParser parser;
+    std::uint64_t    shares = 0;
+    std::size_t      events = 0;
+    parser.parse_with(sample_feed(), [&](const auto& msg) {
+        using MsgType = std::decay_t<decltype(msg)>;
+        if constexpr (std::is_same_v<MsgType, itch::AddOrderMessage>) {
+            shares += msg.shares;
+        } else if constexpr (std::is_same_v<MsgType, itch::SystemEventMessage>) {
+            ++events;  // Never instantiated: 'S' is not a book type.
+        }
+    });
+    EXPECT_EQ(shares, 800U);
+    EXPECT_EQ(events, 0U);
+}
+
+TEST(BasicParser, ReportsDiagnosticsThroughTheEmbeddedParser) {
+    auto feed = sample_feed();
+    append_frame(feed, {std::byte {'!'}, std::byte {0}});  // Unknown type byte.
+    AddOnlyParser parser;
+    std::size_t   count = 0;
+    parser.parse(feed, [&count](const AddOnlyParser::Message&) { ++count; });
+    EXPECT_EQ(count, 2U);
+    EXPECT_EQ(parser.parser().unknown_message_count(), 1U);
+
+    feed.pop_back();
+    EXPECT_THROW(parser.parse(feed), std::runtime_error);
+    EXPECT_EQ(parser.parser().malformed_message_count(), 1U);
+}
+
+TEST(BasicParser, HonorsTheLocateFilter) {
+    auto feed = sample_feed();
+    append_frame(feed, itch::test::add_order_payload(9, 44, 'B', 100, "MSFT", 4000000));
+    AddOnlyParser parser;
+    parser.parser().set_locate_filter(itch::LocateFilter {}.allow(9));
+    const auto messages = parser.parse(feed);
+    ASSERT_EQ(messages.size(), 1U);
+    EXPECT_EQ(std::get<itch::AddOrderMessage>(messages[0]).order_reference_number, 44U);
+}
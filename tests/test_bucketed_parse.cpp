@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "itch/detail/frame_buckets.hpp"
+#include "itch/parser.hpp"
+#include "transport/frame_builders.hpp"
+
+namespace {
+
+using itch::test::append_frame;
+
+// S, A, S, A, A, S, ...: the interleaving the bucketed path reorders.
+auto interleaved_feed(std::uint64_t orders) -> std::vector<std::byte> {
+    std::vector<std::byte> buffer;
+    for (std::uint64_t ref = 1; ref <= orders; ++ref) {
+        append_frame(buffer, itch::test::system_event_payload(ref * 10, 'O'));
+        append_frame(
+            buffer,
+            itch::test::add_order_payload(7, ref, ref % 2 == 0 ? 'B' : 'S', 100, "AAPL", 1500000)
+        );
+        if (ref % 3 == 0) {
+            append_frame(buffer, itch::test::add_order_payload(8, ref + 1000, 'B', 1, "MSFT", 1));
+        }
+    }
+    return buffer;
+}
+
+}  // namespace
+
+TEST(FrameBuckets, DrainsStableBucketsInTypeOrder) {
+    const std::string          frames = "SASAXA";
+    itch::detail::FrameBuckets buckets {8};
+    for (const char& frame : frames) {
+        buckets.push(&frame);
+    }
+    EXPECT_EQ(buckets.size(), 6U);
+
+    std::string              types;
+    std::vector<std::size_t> order;
+    buckets.drain([&](char type, std::span<const char* const> bucket) {
+        types.push_back(type);
+        for (const char* frame : bucket) {
+            EXPECT_EQ(*frame, type);
+            order.push_back(static_cast<std::size_t>(frame - frames.data()));
+        }
+    });
+    EXPECT_EQ(types, "ASX");
+    EXPECT_EQ(order, (std::vector<std::size_t> {1, 3, 5, 0, 2, 4}));
+    EXPECT_EQ(buckets.size(), 0U);
+    EXPECT_THROW(itch::detail::FrameBuckets {0}, std::invalid_argument);
+}
+
+TEST(BucketedParse, DeliversEveryMessageOnceAsPerTypeSpans) {
+    const auto feed     = interleaved_feed(50);
+    const auto expected = itch::Parser {}.parse(feed);
+    for (const std::size_t batch_size : {std::size_t {1}, std::size_t {7}, std::size_t {0}}) {
+        std::vector<std::uint64_t> refs;
+        std::vector<std::uint64_t> timestamps;
+        std::size_t                spans = 0;
+        itch::Parser {}.parse_bucketed(
+            feed,
+            [&](auto messages) {
+                ++spans;
+                for (const auto& msg : messages) {
+                    EXPECT_EQ(msg.message_type, messages.front().message_type);
+                    using MsgType = std::decay_t<decltype(msg)>;
+                    if constexpr (std::is_same_v<MsgType, itch::AddOrderMessage>) {
+                        refs.push_back(msg.order_reference_number);
+                    } else if constexpr (std::is_same_v<MsgType, itch::SystemEventMessage>) {
+                        timestamps.push_back(msg.timestamp);
+                    }
+                }
+            },
+            batch_size
+        );
+
+        std::vector<std::uint64_t> expected_refs;
+        std::vector<std::uint64_t> expected_timestamps;
+        for (const auto& msg : expected) {
+            if (const auto* add = std::get_if<itch::AddOrderMessage>(&msg)) {
+                expected_refs.push_back(add->order_reference_number);
+            } else {
+                expected_timestamps.push_back(std::get<itch::SystemEventMessage>(msg).timestamp);
+            }
+        }
+        std::sort(refs.begin(), refs.end());
+        std::sort(expected_refs.begin(), expected_refs.end());
+        EXPECT_EQ(refs, expected_refs) << "batch " << batch_size;
+        EXPECT_EQ(timestamps, expected_timestamps) << "batch " << batch_size;
+        if (batch_size == 0) {
+            EXPECT_EQ(spans, 2U);  // One batch, two types.
+        }
+    }
+}
+
+TEST(BucketedParse, GroupsEachBatchByTypeAndSkipsUnhandledTypes) {
+    std::vector<std::byte> feed;
+    append_frame(feed, itch::test::system_event_payload(1000, 'O'));
+    append_frame(feed, itch::test::add_order_payload(7, 42, 'B', 500, "AAPL", 1500000));
+    append_frame(feed, itch::test::system_event_payload(2000, 'S'));
+    append_frame(feed, itch::test::add_order_payload(7, 43, 'S', 300, "AAPL", 1510000));
+
+    auto collect = [&feed](std::size_t batch_size) {
+        std::string  types;
+        itch::Parser parser;
+        parser.parse_bucketed(
+            feed,
+            [&types](auto messages) {
+                for (const auto& msg : messages) {
+                    types.push_back(msg.message_type);
+                }
+            },
+            batch_size
+        );
+        return types;
+    };
+    EXPECT_EQ(collect(0), "AASS");
+    EXPECT_EQ(collect(2), "ASAS");
+
+    std::uint64_t shares = 0;
+    itch::Parser {}.parse_bucketed(feed, [&shares](std::span<const itch::AddOrderMessage> adds) {
+        for (const auto& add : adds) {
+            shares += add.shares;
+        }
+    });
+    EXPECT_EQ(shares, 800U);
+}
+
+TEST(BucketedParse, ReportsDiagnosticsAndDeliversFramesBeforeATruncation) {
+    auto feed = interleaved_feed(3);
+    append_frame(feed, {std::byte {'!'}, std::byte {0}});  // Unknown type byte.
+    append_frame(feed, itch::test::system_event_payload(9000, 'C'));
+    feed.pop_back();
+
+    itch::Parser parser;
+    std::size_t  count = 0;
+    EXPECT_THROW(
+        parser.parse_bucketed(feed, [&count](auto messages) { count += messages.size(); }),
+        std::runtime_error
+    );
+    EXPECT_EQ(count, 7U);
+    EXPECT_EQ(parser.unknown_message_count(), 1U);
+    EXPECT_EQ(parser.malformed_message_count(), 1U);
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "itch/columnar.hpp"
+#include "itch/parser.hpp"
+#include "transport/frame_builders.hpp"
+
+namespace {
+
+// A mix of order-flow, trade, and system messages, each field derived from the
+// message ordinal so every row can be checked against it.
+auto build_feed(std::size_t count) -> std::vector<std::byte> {
+    std::vector<itch::Message> messages;
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        itch::Message message;
+        switch (idx % 5) {
+            case 0: {
+                itch::AddOrderMessage msg {};
+                msg.order_reference_number = idx;
+                msg.buy_sell_indicator     = idx % 2 == 0 ? 'B' : 'S';
+                msg.shares                 = static_cast<std::uint32_t>(100 + idx);
+                std::memcpy(msg.stock, "MSFT    ", 8);
+                msg.price = static_cast<std::uint32_t>(1000000 + idx);
+                message   = msg;
+                break;
+            }
+            case 1: {
+                itch::OrderExecutedMessage msg {};
+                msg.order_reference_number = idx - 1;
+                msg.executed_shares        = 10;
+                msg.match_number           = idx;
+                message                    = msg;
+                break;
+            }
+            case 2: {
+                itch::OrderReplaceMessage msg {};
+                msg.original_order_reference_number = idx - 2;
+                msg.new_order_reference_number      = idx;
+                msg.shares                          = 50;
+                msg.price                           = static_cast<std::uint32_t>(idx);
+                message                             = msg;
+                break;
+            }
+            case 3: {
+                itch::NonCrossTradeMessage msg {};
+                msg.shares = 7;
+                std::memcpy(msg.stock, "AAPL    ", 8);
+                msg.price        = 1500000;
+                msg.match_number = idx;
+                message          = msg;
+                break;
+            }
+            default: {
+                itch::SystemEventMessage msg {};
+                msg.event_code = 'O';
+                message        = msg;
+                break;
+            }
+        }
+        std::visit(
+            [&](auto& msg) {
+                msg.stock_locate = static_cast<std::uint16_t>(idx % 100);
+                msg.timestamp    = 1000 + idx;
+            },
+            message
+        );
+        messages.push_back(message);
+    }
+    return itch::test::encode_feed(messages);
+}
+
+}  // namespace
+
+TEST(ColumnarBatch, RowsLandInTheirTypesColumns) {
+    itch::ColumnarBatch batch;
+    EXPECT_EQ(batch.capacity(), itch::ColumnarBatch::DEFAULT_CAPACITY);
+
+    itch::AddOrderMessage add {};
+    add.timestamp              = 42;
+    add.order_reference_number = 7;
+    add.shares                 = 300;
+    std::memcpy(add.stock, "QQQ     ", 8);
+    add.price = 3000000;
+    batch(add);
+    batch.append(itch::Message {itch::SystemEventMessage {}});
+
+    const auto& adds = batch.columns<itch::AddOrderMessage>();
+    ASSERT_EQ(adds.size(), 1u);
+    EXPECT_EQ(adds.timestamp[0], 42u);
+    EXPECT_EQ(adds.order_reference_number[0], 7u);
+    EXPECT_EQ(adds.shares[0], 300u);
+    EXPECT_EQ(std::string_view(adds.stock[0].data(), 3), "QQQ");
+    EXPECT_EQ(adds.price[0], 3000000u);
+
+    const auto& other = batch.columns<itch::SystemEventMessage>();
+    ASSERT_EQ(other.size(), 1u);
+    EXPECT_EQ(other.message_type[0], 'S');
+    EXPECT_EQ(batch.size(), 2u);
+
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+    EXPECT_TRUE(batch.columns<itch::AddOrderMessage>().empty());
+    EXPECT_EQ(itch::ColumnarBatch {0}.capacity(), itch::ColumnarBatch::DEFAULT_CAPACITY);
+}
+
+TEST(ColumnarBatch, ParseColumnarMatchesVariantParse) {
+    const auto feed     = build_feed(1003);
+    const auto messages = itch::Parser {}.parse(std::span {feed});
+
+    std::vector<std::size_t>   batch_sizes;
+    std::vector<std::uint64_t> add_refs;
+    std::vector<std::uint32_t> add_prices;
+    std::vector<std::uint64_t> timestamps;
+    std::uint64_t              executed = 0;
+    std::size_t                replaces = 0;
+    std::size_t                trades   = 0;
+    std::size_t                others   = 0;
+
+    itch::Parser parser;
+    itch::parse_columnar(parser, std::span {feed}, 64, [&](const itch::ColumnarBatch& batch) {
+        batch_sizes.push_back(batch.size());
+        const auto& adds = batch.columns<itch::AddOrderMessage>();
+        add_refs.insert(
+            add_refs.end(), adds.order_reference_number.begin(), adds.order_reference_number.end()
+        );
+        add_prices.insert(add_prices.end(), adds.price.begin(), adds.price.end());
+        timestamps.insert(timestamps.end(), adds.timestamp.begin(), adds.timestamp.end());
+
+        const auto& execs = batch.columns<itch::OrderExecutedMessage>();
+        executed = std::accumulate(
+            execs.executed_shares.begin(), execs.executed_shares.end(), executed
+        );
+        replaces += batch.columns<itch::OrderReplaceMessage>().size();
+        trades += batch.columns<itch::NonCrossTradeMessage>().size();
+        others += batch.columns<itch::SystemEventMessage>().size();
+    });
+
+    // Every batch but the last is exactly full.
+    ASSERT_EQ(batch_sizes.size(), 16u);
+    for (std::size_t idx = 0; idx + 1 < batch_sizes.size(); ++idx) {
+        EXPECT_EQ(batch_sizes[idx], 64u);
+    }
+    EXPECT_EQ(batch_sizes.back(), 1003u - 15 * 64);
+
+    std::vector<std::uint64_t> expected_refs;
+    std::vector<std::uint32_t> expected_prices;
+    for (const auto& message : messages) {
+        if (const auto* add = std::get_if<itch::AddOrderMessage>(&message)) {
+            expected_refs.push_back(add->order_reference_number);
+            expected_prices.push_back(add->price);
+        }
+    }
+    EXPECT_EQ(add_refs, expected_refs);
+    EXPECT_EQ(add_prices, expected_prices);
+    for (std::size_t idx = 0; idx < timestamps.size(); ++idx) {
+        EXPECT_EQ(timestamps[idx], 1000 + add_refs[idx]);
+    }
+    EXPECT_EQ(executed, 10u * 201);
+    EXPECT_EQ(replaces, 201u);
+    EXPECT_EQ(trades, 200u);
+    EXPECT_EQ(others, 200u);
+}
+
+TEST(ColumnarBatch, TruncationThrowsAfterDeliveringCompleteBatches) {
+    auto feed = build_feed(20);
+    feed.pop_back();
+
+    std::size_t         delivered = 0;
+    itch::ColumnarBatch batch {8};
+    itch::Parser        parser;
+    EXPECT_THROW(
+        itch::parse_columnar(
+            parser,
+            std::span {feed},
+            batch,
+            [&](const itch::ColumnarBatch& full) { delivered += full.size(); }
+        ),
+        std::runtime_error
+    );
+    EXPECT_EQ(delivered, 16u);
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "itch/decode_kernel.hpp"
+#include "itch/parser.hpp"
+#include "transport/frame_builders.hpp"
+
+namespace {
+
+constexpr std::uint64_t TIMESTAMP_MASK = (std::uint64_t {1} << 48) - 1;
+
+// Order-flow messages with every field randomized, so each wire byte ends up
+// somewhere a misplaced shuffle lane would show, interleaved with a few types
+// that always take the scalar path.
+auto build_feed(std::size_t count) -> std::vector<std::byte> {
+    std::mt19937_64 rng {20240601};
+    auto            u16 = [&] { return static_cast<std::uint16_t>(rng()); };
+    auto            u32 = [&] { return static_cast<std::uint32_t>(rng()); };
+    auto            chr = [&] { return static_cast<char>('A' + rng() % 26); };
+
+    std::vector<itch::Message> messages;
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        itch::Message message;
+        switch (idx % 6) {
+            case 0: {
+                itch::AddOrderMessage msg {};
+                msg.order_reference_number = rng();
+                msg.buy_sell_indicator     = rng() % 2 == 0 ? 'B' : 'S';
+                msg.shares                 = u32();
+                for (auto& letter : msg.stock) {
+                    letter = chr();
+                }
+                msg.price = u32();
+                message   = msg;
+                break;
+            }
+            case 1: {
+                itch::OrderDeleteMessage msg {};
+                msg.order_reference_number = rng();
+                message                    = msg;
+                break;
+            }
+            case 2: {
+                itch::OrderExecutedMessage msg {};
+                msg.order_reference_number = rng();
+                msg.executed_shares        = u32();
+                msg.match_number           = rng();
+                message                    = msg;
+                break;
+            }
+            case 3: {
+                itch::OrderCancelMessage msg {};
+                msg.order_reference_number = rng();
+                msg.cancelled_shares       = u32();
+                message                    = msg;
+                break;
+            }
+            case 4: {
+                itch::OrderReplaceMessage msg {};
+                msg.original_order_reference_number = rng();
+                msg.new_order_reference_number      = rng();
+                msg.shares                          = u32();
+                msg.price                           = u32();
+                message                             = msg;
+                break;
+            }
+            default: {
+                itch::SystemEventMessage msg {};
+                msg.event_code = 'O';
+                message        = msg;
+                break;
+            }
+        }
+        std::visit(
+            [&](auto& msg) {
+                msg.stock_locate    = u16();
+                msg.tracking_number = u16();
+                msg.timestamp       = rng() & TIMESTAMP_MASK;
+            },
+            message
+        );
+        messages.push_back(message);
+    }
+    return itch::test::encode_feed(messages);
+}
+
+// The message structs are packed, so equal messages are equal byte for byte.
+auto same_message(const itch::Message& lhs, const itch::Message& rhs) -> bool {
+    if (lhs.index() != rhs.index()) {
+        return false;
+    }
+    return std::visit(
+        [&](const auto& left) {
+            const auto& right = std::get<std::decay_t<decltype(left)>>(rhs);
+            return std::memcmp(&left, &right, sizeof(left)) == 0;
+        },
+        lhs
+    );
+}
+
+auto parse_with_kernel(std::span<const std::byte> data, itch::DecodeKernel kernel)
+    -> std::vector<itch::Message> {
+    itch::Parser parser;
+    parser.set_decode_kernel(kernel);
+    return parser.parse(data);
+}
+
+}  // namespace
+
+TEST(DecodeKernel, ScalarIsAlwaysSupportedAndBestIsSupported) {
+    EXPECT_TRUE(itch::decode_kernel_supported(itch::DecodeKernel::scalar));
+    EXPECT_TRUE(itch::decode_kernel_supported(itch::best_decode_kernel()));
+    EXPECT_EQ(itch::Parser {}.decode_kernel(), itch::best_decode_kernel());
+    EXPECT_EQ(itch::to_string(itch::DecodeKernel::avx2), "avx2");
+}
+
+TEST(DecodeKernel, EveryKernelMatchesScalarDecode) {
+    const auto feed     = build_feed(6000);
+    const auto expected = parse_with_kernel(std::span {feed}, itch::DecodeKernel::scalar);
+    ASSERT_EQ(expected.size(), 6000u);
+
+    for (const auto kernel : {itch::DecodeKernel::ssse3, itch::DecodeKernel::avx2}) {
+        if (!itch::decode_kernel_supported(kernel)) {
+            itch::Parser parser;
+            EXPECT_THROW(parser.set_decode_kernel(kernel), std::invalid_argument);
+            continue;
+        }
+        const auto decoded = parse_with_kernel(std::span {feed}, kernel);
+        ASSERT_EQ(decoded.size(), expected.size()) << itch::to_string(kernel);
+        for (std::size_t idx = 0; idx < decoded.size(); ++idx) {
+            ASSERT_TRUE(same_message(decoded[idx], expected[idx]))
+                << itch::to_string(kernel) << " differs at message " << idx;
+        }
+    }
+}
+
+TEST(DecodeKernel, FrameEndingTheBufferIsDecodedWithoutOverread) {
+    // Each order-flow frame alone in an exactly sized heap buffer: the kernels
+    // must not load past its last byte (AddressSanitizer builds check this).
+    const auto feed     = build_feed(5);
+    const auto expected = parse_with_kernel(std::span {feed}, itch::DecodeKernel::scalar);
+
+    std::size_t offset = 0;
+    for (const auto& message : expected) {
+        const auto length = (std::to_integer<std::size_t>(feed[offset]) << 8U) |
+                            std::to_integer<std::size_t>(feed[offset + 1]);
+        const std::vector<std::byte> alone(
+            feed.begin() + static_cast<std::ptrdiff_t>(offset),
+            feed.begin() + static_cast<std::ptrdiff_t>(offset + 2 + length)
+        );
+        offset += 2 + length;
+
+        itch::Parser parser;
+        const auto   decoded = parser.parse(std::span {alone});
+        ASSERT_EQ(decoded.size(), 1u);
+        EXPECT_TRUE(same_message(decoded.front(), message));
+    }
+}
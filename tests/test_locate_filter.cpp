@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "itch/encoder.hpp"
+#include "itch/filter.hpp"
+#include "itch/overlay.hpp"
+#include "itch/parser.hpp"
+
+namespace {
+
+constexpr std::uint16_t SECURITIES = 50;
+
+auto append(std::vector<std::byte>& feed, const itch::Message& message) -> void {
+    const auto frame = itch::encode_frame(message);
+    feed.insert(feed.end(), frame.begin(), frame.end());
+}
+
+// A directory of SECURITIES symbols ("S0".."S49" at locates 1..50), then Add
+// Orders cycling over every locate, with a system event (locate 0) at the end.
+auto build_feed(std::size_t orders) -> std::vector<std::byte> {
+    std::vector<std::byte> feed;
+    for (std::uint16_t locate = 1; locate <= SECURITIES; ++locate) {
+        itch::StockDirectoryMessage directory {};
+        directory.stock_locate = locate;
+        const auto symbol      = "S" + std::to_string(locate - 1);
+        std::memset(directory.stock, ' ', sizeof(directory.stock));
+        std::memcpy(directory.stock, symbol.data(), symbol.size());
+        append(feed, directory);
+    }
+    for (std::size_t idx = 0; idx < orders; ++idx) {
+        itch::AddOrderMessage add {};
+        add.stock_locate           = static_cast<std::uint16_t>(1 + idx % SECURITIES);
+        add.order_reference_number = idx;
+        append(feed, add);
+    }
+    append(feed, itch::SystemEventMessage {});
+    return feed;
+}
+
+}  // namespace
+
+TEST(LocateFilter, BitmapMembership) {
+    itch::LocateFilter filter;
+    EXPECT_TRUE(filter.contains(0));
+    EXPECT_FALSE(filter.contains(7));
+    filter.allow(7).allow(65535);
+    EXPECT_TRUE(filter.contains(7));
+    EXPECT_TRUE(filter.contains(65535));
+    EXPECT_EQ(filter.size(), 2u);
+    filter.deny(7);
+    EXPECT_FALSE(filter.contains(7));
+    EXPECT_THROW(filter.watch("TOOLONGSYM"), std::invalid_argument);
+}
+
+TEST(LocateFilter, ParserLearnsLocatesFromStockDirectory) {
+    const auto feed = build_feed(1000);
+
+    itch::Parser parser;
+    parser.set_locate_filter(itch::LocateFilter {{"S3", "S17", "ZZZZ"}});
+
+    std::vector<std::uint16_t> locates;
+    std::size_t                directories = 0;
+    std::size_t                system      = 0;
+    parser.parse(std::span {feed}, [&](const itch::Message& message) {
+        if (const auto* add = std::get_if<itch::AddOrderMessage>(&message)) {
+            locates.push_back(add->stock_locate);
+        } else if (std::holds_alternative<itch::StockDirectoryMessage>(message)) {
+            ++directories;
+        } else {
+            ++system;
+        }
+    });
+
+    EXPECT_EQ(directories, 2u);  // Only the watched symbols' own directory frames.
+    EXPECT_EQ(system, 1u);       // Locate 0 always passes.
+    ASSERT_EQ(locates.size(), 40u);
+    for (const auto locate : locates) {
+        EXPECT_TRUE(locate == 4 || locate == 18) << locate;
+    }
+    ASSERT_NE(parser.locate_filter(), nullptr);
+    EXPECT_EQ(parser.locate_filter()->size(), 2u);
+
+    // The statically dispatched path goes through the same framing loop.
+    std::size_t handled = 0;
+    parser.parse_with(std::span {feed}, [&](const itch::AddOrderMessage&) { ++handled; });
+    EXPECT_EQ(handled, 40u);
+
+    parser.clear_locate_filter();
+    EXPECT_EQ(parser.locate_filter(), nullptr);
+    EXPECT_EQ(parser.parse(std::span {feed}).size(), 1000u + SECURITIES + 1);
+}
+
+TEST(LocateFilter, OverlayAppliesAndTeachesTheFilter) {
+    const auto feed = build_feed(500);
+
+    itch::LocateFilter filter {{"S0"}};
+    filter.allow(SECURITIES);  // A locate known up front.
+    std::size_t adds = 0;
+    const auto  delivered =
+        itch::overlay::for_each_message(std::span {feed}, filter, [&](const auto& view) {
+            adds += view.type() == 'A' ? 1 : 0;
+        });
+    EXPECT_EQ(adds, 20u);
+    EXPECT_EQ(delivered, 20u + 2u + 1u);
+    EXPECT_TRUE(filter.contains(1));
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "itch/message_arena.hpp"
+#include "itch/parser.hpp"
+#include "transport/frame_builders.hpp"
+
+namespace {
+
+// Messages of three very different sizes, so records straddle slab boundaries
+// at varying offsets.
+auto build_feed(std::size_t count) -> std::vector<std::byte> {
+    std::vector<itch::Message> messages;
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        itch::Message message;
+        if (idx % 3 == 0) {
+            itch::AddOrderMessage msg {};
+            msg.order_reference_number = idx;
+            msg.shares                 = static_cast<std::uint32_t>(idx);
+            std::memcpy(msg.stock, "IBM     ", 8);
+            message = msg;
+        } else if (idx % 3 == 1) {
+            itch::OrderDeleteMessage msg {};
+            msg.order_reference_number = idx;
+            message                    = msg;
+        } else {
+            itch::NOIIMessage msg {};
+            msg.paired_shares = idx;
+            message           = msg;
+        }
+        std::visit([&](auto& msg) { msg.timestamp = idx; }, message);
+        messages.push_back(message);
+    }
+    return itch::test::encode_feed(messages);
+}
+
+}  // namespace
+
+TEST(MessageArena, ParseMatchesVectorAcrossSlabs) {
+    const auto feed     = build_feed(2000);
+    const auto expected = itch::Parser {}.parse(std::span {feed});
+
+    // Small slabs force hundreds of slab switches.
+    itch::MessageArena arena {256};
+    itch::Parser {}.parse(std::span {feed}, arena);
+    ASSERT_EQ(arena.size(), expected.size());
+    EXPECT_GT(arena.bytes_reserved(), 256u * 100);
+
+    std::size_t idx = 0;
+    for (const auto entry : arena) {
+        ASSERT_LT(idx, expected.size());
+        const auto message = entry.to_message();
+        ASSERT_EQ(message.index(), expected[idx].index());
+        std::visit(
+            [&](const auto& msg) {
+                const auto& want = std::get<std::decay_t<decltype(msg)>>(expected[idx]);
+                EXPECT_EQ(std::memcmp(&msg, &want, sizeof(msg)), 0) << "message " << idx;
+            },
+            message
+        );
+        ++idx;
+    }
+    EXPECT_EQ(idx, expected.size());
+
+    // Records are stored at their own size, not sizeof(Message).
+    const std::size_t packed = 667 * sizeof(itch::AddOrderMessage) +
+                               667 * sizeof(itch::OrderDeleteMessage) +
+                               666 * sizeof(itch::NOIIMessage);
+    EXPECT_EQ(arena.bytes_used(), packed);
+    EXPECT_LT(arena.bytes_used(), expected.size() * sizeof(itch::Message));
+}
+
+TEST(MessageArena, TypedAccessAndVisit) {
+    itch::MessageArena    arena;
+    itch::AddOrderMessage add {};
+    add.order_reference_number = 99;
+    const auto& stored         = arena.emplace(add);
+    arena.push_back(itch::Message {itch::OrderDeleteMessage {}});
+    EXPECT_EQ(stored.order_reference_number, 99u);
+
+    auto entry = arena.begin();
+    EXPECT_EQ((*entry).type(), 'A');
+    ASSERT_NE((*entry).get_if<itch::AddOrderMessage>(), nullptr);
+    EXPECT_EQ((*entry).get_if<itch::OrderDeleteMessage>(), nullptr);
+    EXPECT_EQ(&stored, (*entry).get_if<itch::AddOrderMessage>());
+    ++entry;
+    EXPECT_TRUE((*entry).holds<itch::OrderDeleteMessage>());
+    ++entry;
+    EXPECT_EQ(entry, arena.end());
+
+    // Types the visitor does not accept are skipped.
+    std::size_t adds = 0;
+    arena.visit([&](const itch::AddOrderMessage& msg) { adds += msg.order_reference_number; });
+    EXPECT_EQ(adds, 99u);
+
+    const auto reserved = arena.bytes_reserved();
+    arena.clear();
+    EXPECT_TRUE(arena.empty());
+    EXPECT_EQ(arena.begin(), arena.end());
+    EXPECT_EQ(arena.bytes_used(), 0u);
+    EXPECT_EQ(arena.bytes_reserved(), reserved);
+}
+
+TEST(MessageArena, FilterAndTruncation) {
+    auto feed = build_feed(30);
+
+    itch::MessageArena arena;
+    itch::Parser {}.parse(std::span {feed}, arena, itch::MessageTypeFilter {"D"});
+    EXPECT_EQ(arena.size(), 10u);
+
+    feed.pop_back();
+    arena.clear();
+    itch::Parser parser;
+    EXPECT_THROW(parser.parse(std::span {feed}, arena), std::runtime_error);
+    EXPECT_EQ(arena.size(), 29u);
+#ifdef __cpp_lib_expected
+    arena.clear();
+    const auto result = parser.try_parse(std::span {feed}, arena);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), itch::ParseError::truncated);
+    EXPECT_EQ(arena.size(), 29u);
+#endif
+}
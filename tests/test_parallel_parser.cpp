@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "itch/parallel_parser.hpp"
+#include "itch/parser.hpp"
+#include "transport/frame_builders.hpp"
+
+namespace {
+
+// A feed of alternating Add Orders (order ref = ordinal) and System Events,
+// with a zero-length padding frame sprinkled in now and then.
+auto build_feed(std::size_t frames) -> std::vector<std::byte> {
+    std::vector<std::byte> buffer;
+    for (std::size_t ordinal = 0; ordinal < frames; ++ordinal) {
+        const auto payload =
+            ordinal % 2 == 0 ? itch::test::add_order_payload(7, ordinal, 'B', 100, "AAPL", 1500000)
+                             : itch::test::system_event_payload(ordinal, 'O');
+        itch::test::append_frame(buffer, payload);
+        if (ordinal % 97 == 0) {
+            itch::test::append_be16(buffer, 0);
+        }
+    }
+    return buffer;
+}
+
+auto sequence_of(const itch::Message& message) -> std::uint64_t {
+    if (const auto* add = std::get_if<itch::AddOrderMessage>(&message)) {
+        return add->order_reference_number;
+    }
+    return std::get<itch::SystemEventMessage>(message).timestamp;
+}
+
+}  // namespace
+
+TEST(ParallelParser, IndexCutsContiguousFrameAlignedChunks) {
+    const auto feed  = build_feed(1000);
+    const auto index = itch::ParallelParser::index_frames(std::span {feed}, 8);
+
+    ASSERT_EQ(index.chunks.size(), 8u);
+    EXPECT_EQ(index.complete_bytes, feed.size());
+    EXPECT_EQ(index.frame_count, 1000u);
+
+    std::size_t   expected_begin = 0;
+    std::uint64_t frames         = 0;
+    for (const auto& chunk : index.chunks) {
+        EXPECT_EQ(chunk.begin, expected_begin);
+        EXPECT_EQ(chunk.first_frame, frames);
+        // Each chunk must parse cleanly on its own, i.e. end on a frame boundary.
+        itch::Parser parser;
+        EXPECT_EQ(
+            parser.parse(std::span {feed}.subspan(chunk.begin, chunk.end - chunk.begin)).size(),
+            chunk.frame_count
+        );
+        expected_begin = chunk.end;
+        frames += chunk.frame_count;
+    }
+    EXPECT_EQ(expected_begin, feed.size());
+}
+
+TEST(ParallelParser, MergedResultMatchesSequentialParse) {
+    const auto feed = build_feed(5000);
+
+    itch::ParallelParser parallel {4};
+    itch::Parser         sequential;
+    const auto           merged   = parallel.parse(std::span {feed});
+    const auto           expected = sequential.parse(std::span {feed});
+
+    ASSERT_EQ(merged.size(), expected.size());
+    for (std::size_t idx = 0; idx < merged.size(); ++idx) {
+        ASSERT_EQ(sequence_of(merged[idx]), idx);
+    }
+
+    const auto adds = parallel.parse(std::span {feed}, itch::MessageTypeFilter {"A"});
+    EXPECT_EQ(adds.size(), 2500u);
+}
+
+TEST(ParallelParser, OrderedCallbackPreservesStreamOrder) {
+    const auto feed = build_feed(5000);
+
+    itch::ParallelParser parallel {3};
+    std::uint64_t        next     = 0;
+    bool                 in_order = true;
+    parallel.parse_ordered(std::span {feed}, [&](const itch::Message& msg) {
+        in_order = in_order && sequence_of(msg) == next;
+        ++next;
+    });
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(next, 5000u);
+}
+
+TEST(ParallelParser, OrderedCallbackCutsLargeBuffersIntoBoundedChunks) {
+    // Large enough that one thread's CHUNKS_PER_THREAD chunks would each exceed
+    // ORDERED_CHUNK_BYTES, so the byte-sized chunking has to kick in.
+    const auto feed = build_feed(800000);
+    ASSERT_GT(
+        feed.size(),
+        itch::ParallelParser::CHUNKS_PER_THREAD * itch::ParallelParser::ORDERED_CHUNK_BYTES
+    );
+
+    itch::ParallelParser parallel {1};
+    std::uint64_t        next     = 0;
+    bool                 in_order = true;
+    parallel.parse_ordered(std::span {feed}, [&](const itch::Message& msg) {
+        in_order = in_order && sequence_of(msg) == next;
+        ++next;
+    });
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(next, 800000u);
+}
+
+TEST(ParallelParser, ChunkCallbacksSeeEveryMessageInOrderWithinAChunk) {
+    const auto feed = build_feed(5000);
+
+    itch::ParallelParser       parallel {4};
+    const auto                 index = itch::ParallelParser::index_frames(
+        std::span {feed}, parallel.thread_count() * itch::ParallelParser::CHUNKS_PER_THREAD
+    );
+    std::vector<std::uint64_t> last(index.chunks.size(), 0);
+    std::vector<char>          seen(index.chunks.size(), 0);
+    std::atomic<std::uint64_t> total {0};
+    std::atomic<bool>          in_order {true};
+
+    parallel.parse(std::span {feed}, [&](std::size_t chunk, const itch::Message& msg) {
+        // Each chunk is owned by one worker, so its slot needs no lock.
+        const auto sequence = sequence_of(msg);
+        if (seen[chunk] != 0 && sequence != last[chunk] + 1) {
+            in_order = false;
+        }
+        seen[chunk] = 1;
+        last[chunk] = sequence;
+        ++total;
+    });
+    EXPECT_EQ(total.load(), 5000u);
+    EXPECT_TRUE(in_order.load());
+}
+
+TEST(ParallelParser, TruncatedTailThrowsAfterDeliveringCompleteFrames) {
+    auto feed = build_feed(1000);
+    feed.insert(feed.end(), {std::byte {0}, std::byte {40}, std::byte {'A'}});
+    const auto unknown = itch::test::length_prefixed({std::byte {'?'}, std::byte {0}});
+    feed.insert(feed.begin(), unknown.begin(), unknown.end());
+
+    itch::ParallelParser       parallel {2};
+    std::atomic<std::uint64_t> total {0};
+    EXPECT_THROW(
+        parallel.parse(std::span {feed}, [&](std::size_t, const itch::Message&) { ++total; }),
+        std::runtime_error
+    );
+    EXPECT_EQ(total.load(), 1000u);
+    EXPECT_EQ(parallel.unknown_message_count(), 1u);
+    EXPECT_EQ(parallel.malformed_message_count(), 1u);
+}
+
+TEST(ParallelParser, CallbackExceptionPropagatesToCaller) {
+    const auto feed = build_feed(2000);
+
+    itch::ParallelParser parallel {4};
+    EXPECT_THROW(
+        parallel.parse_ordered(
+            std::span {feed},
+            [](const itch::Message& msg) {
+                if (sequence_of(msg) == 1500) {
+                    throw std::logic_error("stop");
+                }
+            }
+        ),
+        std::logic_error
+    );
+    EXPECT_THROW(
+        parallel.parse(
+            std::span {feed},
+            [](std::size_t, const itch::Message& msg) {
+                if (sequence_of(msg) == 10) {
+                    throw std::logic_error("stop");
+                }
+            }
+        ),
+        std::logic_error
+    );
+}
@@ -234,8 +234,10 @@ TEST_F(ParserTest, IgnoresTrailingGarbageData) {
     std::stringstream ss2(data2);
     EXPECT_THROW(parser.parse(ss2), std::runtime_error);
 
+    // Streams are consumed from their current position, so re-parse a fresh one.
+    std::stringstream          data_stream2(data);
     std::vector<itch::Message> messages;
-    EXPECT_THROW(messages = parser.parse(data_stream), std::runtime_error);
+    EXPECT_THROW(messages = parser.parse(data_stream2), std::runtime_error);
 }
 
 TEST_F(ParserTest, HandlesStreamEndingExactlyOnBoundary) {
@@ -1,8 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <istream>
 #include <span>
+#include <streambuf>
 #include <vector>
 
 #include "itch/parser.hpp"
@@ -92,6 +97,32 @@ class FrameWriter {
 
 constexpr char STOCK_AAPL[9] = "AAPL    ";
 
+// A forward-only stream buffer over a byte vector that hands out at most
+// `piece` bytes per refill and refuses to seek, like a pipe.
+class PipeBuf : public std::streambuf {
+   public:
+    PipeBuf(const std::vector<std::uint8_t>& bytes, std::size_t piece)
+        : m_bytes(bytes), m_piece(piece) {}
+
+   protected:
+    auto underflow() -> int_type override {
+        if (m_pos >= m_bytes.size()) {
+            return traits_type::eof();
+        }
+        const std::size_t count = std::min(m_piece, m_bytes.size() - m_pos);
+        std::memcpy(m_window.data(), m_bytes.data() + m_pos, count);
+        m_pos += count;
+        setg(m_window.data(), m_window.data(), m_window.data() + count);
+        return traits_type::to_int_type(m_window[0]);
+    }
+
+   private:
+    const std::vector<std::uint8_t>& m_bytes;
+    std::size_t                      m_piece;
+    std::size_t                      m_pos {0};
+    std::array<char, 4096>           m_window {};
+};
+
 }  // namespace
 
 TEST(ParserEdge, EndiannessRoundTrip) {
@@ -187,6 +218,165 @@ TEST(ParserEdge, ThrowsOnTruncatedPayload) {
     EXPECT_THROW(parser.parse(writer.as_byte_span()), std::runtime_error);
 }
 
+TEST(ParserEdge, StreamParseWorksOnNonSeekableInputAcrossChunks) {
+    // Enough 14-byte frames to span several read chunks, so frames straddle
+    // chunk boundaries at assorted offsets.
+    FrameWriter writer;
+    const auto  frames = (3 * itch::Parser::STREAM_CHUNK_SIZE) / 14 + 7;
+    for (std::size_t idx = 0; idx < frames; ++idx) {
+        writer.add_system_event(1, static_cast<std::uint16_t>(idx), idx, 'O');
+    }
+    PipeBuf      pipe {writer.bytes(), 997};
+    std::istream stream {&pipe};
+
+    itch::Parser  parser;
+    std::uint64_t count = 0;
+    std::uint64_t sum   = 0;
+    parser.parse(stream, [&](const itch::Message& msg) {
+        sum += std::get<itch::SystemEventMessage>(msg).timestamp;
+        ++count;
+    });
+    EXPECT_EQ(count, frames);
+    EXPECT_EQ(sum, frames * (frames - 1) / 2);
+}
+
+TEST(ParserEdge, StreamParseThrowsOnTrailingPartialFrameAfterDeliveringTheRest) {
+    FrameWriter writer;
+    writer.add_system_event(1, 2, 3, 'O');
+    writer.add_order(1, 42, 'B', 100, STOCK_AAPL, 5000);
+    writer.add_raw_frame(12, {static_cast<std::uint8_t>('S'), 0, 0, 0});  // truncated
+    PipeBuf      pipe {writer.bytes(), 5};
+    std::istream stream {&pipe};
+
+    itch::Parser parser;
+    int          seen = 0;
+    EXPECT_THROW(
+        parser.parse(
+            stream, [&](const itch::Message&) { ++seen; }, itch::MessageTypeFilter {"A"}
+        ),
+        std::runtime_error
+    );
+    EXPECT_EQ(seen, 1);
+    EXPECT_EQ(parser.malformed_message_count(), 1u);
+}
+
+TEST(ParserEdge, ParseWithDeliversConcreteStructsMatchingParse) {
+    FrameWriter writer;
+    writer.add_system_event(1, 2, 3, 'O');
+    writer.add_order(1, 42, 'B', 100, STOCK_AAPL, 5000);
+
+    itch::Parser               parser;
+    std::vector<itch::Message> typed;
+    parser.parse_with(writer.as_byte_span(), [&](const auto& msg) {
+        typed.push_back(itch::Message {msg});
+    });
+
+    const auto eager = parser.parse(writer.as_byte_span());
+    ASSERT_EQ(typed.size(), eager.size());
+    const auto& add = std::get<itch::AddOrderMessage>(typed[1]);
+    EXPECT_EQ(add.order_reference_number, 42u);
+    EXPECT_EQ(add.shares, 100u);
+    EXPECT_EQ(add.price, 5000u);
+    EXPECT_EQ(std::get<itch::SystemEventMessage>(typed[0]).event_code, 'O');
+}
+
+TEST(ParserEdge, ParseWithSkipsTypesTheHandlerDoesNotAccept) {
+    FrameWriter writer;
+    writer.add_system_event(1, 2, 3, 'O');
+    writer.add_order(1, 42, 'B', 100, STOCK_AAPL, 5000);
+    writer.add_system_event(4, 5, 6, 'C');
+
+    itch::Parser  parser;
+    std::uint64_t refs = 0;
+    parser.parse_with(writer.as_byte_span(), [&](const itch::AddOrderMessage& add) {
+        refs += add.order_reference_number;
+    });
+
+    EXPECT_EQ(refs, 42u);
+    // Skipped types are known types, not diagnostics.
+    EXPECT_EQ(parser.unknown_message_count(), 0u);
+}
+
+TEST(ParserEdge, ParseWithReportsFramingProblemsLikeParse) {
+    FrameWriter writer;
+    writer.add_raw_frame(4, {static_cast<std::uint8_t>('?'), 0, 0, 0});     // unknown
+    writer.add_raw_frame(5, {static_cast<std::uint8_t>('S'), 0, 0, 0, 0});  // undersized
+    writer.add_raw_frame(12, {static_cast<std::uint8_t>('S'), 0, 0, 0});    // truncated
+
+    itch::Parser parser;
+    int          seen = 0;
+    EXPECT_THROW(
+        parser.parse_with(writer.as_byte_span(), [&](const auto&) { ++seen; }), std::runtime_error
+    );
+    EXPECT_EQ(seen, 0);
+    EXPECT_EQ(parser.unknown_message_count(), 1u);
+    EXPECT_EQ(parser.malformed_message_count(), 2u);
+}
+
+TEST(ParserEdge, MessageTypeFilterBitmapMembership) {
+    constexpr auto filter = itch::MessageTypeFilter {"A,E,P"};
+    static_assert(filter.contains('A') && filter.contains('P'));
+    EXPECT_FALSE(filter.contains('S'));
+    EXPECT_FALSE(filter.contains('\xFF'));
+    EXPECT_TRUE(itch::MessageTypeFilter {}.empty());
+    EXPECT_TRUE(itch::MessageTypeFilter::all().contains('\xFF'));
+    EXPECT_EQ(itch::MessageTypeFilter {std::vector<char>({'P', 'E', 'A'})}, filter);
+
+    auto narrowed = filter;
+    narrowed.deny('E');
+    EXPECT_FALSE(narrowed.contains('E'));
+    EXPECT_TRUE(narrowed.contains('A'));
+}
+
+TEST(ParserEdge, FilteredCallbackOnlySeesKeptTypes) {
+    FrameWriter writer;
+    writer.add_system_event(1, 2, 3, 'O');
+    writer.add_order(1, 42, 'B', 100, STOCK_AAPL, 5000);
+    writer.add_system_event(4, 5, 6, 'C');
+    writer.add_order(1, 43, 'S', 200, STOCK_AAPL, 5100);
+
+    itch::Parser               parser;
+    std::vector<std::uint64_t> refs;
+    parser.parse(
+        writer.as_byte_span(),
+        [&](const itch::Message& msg) {
+            refs.push_back(std::get<itch::AddOrderMessage>(msg).order_reference_number);
+        },
+        itch::MessageTypeFilter {"A"}
+    );
+    EXPECT_EQ(refs, (std::vector<std::uint64_t> {42, 43}));
+
+    const auto kept = parser.parse(writer.as_byte_span(), itch::MessageTypeFilter {"S"});
+    ASSERT_EQ(kept.size(), 2u);
+    EXPECT_EQ(std::get<itch::SystemEventMessage>(kept[1]).event_code, 'C');
+
+    // The legacy character-list overload goes through the same bitmap.
+    EXPECT_EQ(parser.parse(writer.as_byte_span(), std::vector<char> {'A'}).size(), 2u);
+    EXPECT_TRUE(parser.parse(writer.as_byte_span(), itch::MessageTypeFilter {}).empty());
+}
+
+TEST(ParserEdge, FilteredParseStillValidatesRejectedFrames) {
+    FrameWriter writer;
+    writer.add_raw_frame(4, {static_cast<std::uint8_t>('?'), 0, 0, 0});     // unknown
+    writer.add_raw_frame(5, {static_cast<std::uint8_t>('S'), 0, 0, 0, 0});  // undersized
+    writer.add_order(1, 42, 'B', 100, STOCK_AAPL, 5000);
+    writer.add_raw_frame(12, {static_cast<std::uint8_t>('S'), 0, 0, 0});    // truncated
+
+    itch::Parser parser;
+    int          seen = 0;
+    EXPECT_THROW(
+        parser.parse(
+            writer.as_byte_span(),
+            [&](const itch::Message&) { ++seen; },
+            itch::MessageTypeFilter {"A"}
+        ),
+        std::runtime_error
+    );
+    EXPECT_EQ(seen, 1);
+    EXPECT_EQ(parser.unknown_message_count(), 1u);
+    EXPECT_EQ(parser.malformed_message_count(), 2u);
+}
+
 #if defined(__cpp_lib_expected)
 TEST(ParserEdge, TryParseReturnsTruncatedInsteadOfThrowing) {
     FrameWriter writer;
@@ -213,4 +403,27 @@ TEST(ParserEdge, TryParseSucceedsOnWellFormedInput) {
     ASSERT_TRUE(result.has_value());
     EXPECT_EQ(result->size(), 2u);
 }
+
+TEST(ParserEdge, TryParseAppliesTypeFilter) {
+    FrameWriter writer;
+    writer.add_system_event(1, 2, 3, 'O');
+    writer.add_order(1, 42, 'B', 100, STOCK_AAPL, 5000);
+    writer.add_raw_frame(12, {static_cast<std::uint8_t>('S'), 0, 0, 0});  // truncated
+
+    itch::Parser parser;
+    int          seen   = 0;
+    auto         result = parser.try_parse(
+        writer.as_byte_span(), [&](const itch::Message&) { ++seen; }, itch::MessageTypeFilter {"A"}
+    );
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(seen, 1);
+
+    auto kept = parser.try_parse(
+        std::span {writer.as_byte_span()}.first(writer.bytes().size() - 6),
+        itch::MessageTypeFilter {"S"}
+    );
+    ASSERT_TRUE(kept.has_value());
+    ASSERT_EQ(kept->size(), 1u);
+    EXPECT_TRUE(std::holds_alternative<itch::SystemEventMessage>(kept->front()));
+}
 #endif
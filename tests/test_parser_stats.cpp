@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "itch/parser.hpp"
+#include "itch/parser_stats.hpp"
+#include "transport/frame_builders.hpp"
+
+namespace {
+
+using itch::test::sample_feed;
+
+}  // namespace
+
+TEST(LatencyHistogram, BucketsCoverTheRangeContiguously) {
+    using itch::LatencyHistogram;
+    EXPECT_EQ(LatencyHistogram::bucket_of(0), 0U);
+    EXPECT_EQ(LatencyHistogram::bucket_of(7), 7U);
+    EXPECT_EQ(LatencyHistogram::bucket_of(8), 8U);
+    EXPECT_EQ(LatencyHistogram::bucket_of(16), 16U);
+    EXPECT_EQ(LatencyHistogram::bucket_of(~std::uint64_t {0}), LatencyHistogram::BUCKET_COUNT - 1);
+
+    for (std::size_t bucket = 0; bucket + 1 < LatencyHistogram::BUCKET_COUNT; ++bucket) {
+        const auto lower = LatencyHistogram::bucket_lower(bucket);
+        const auto upper = LatencyHistogram::bucket_upper(bucket);
+        ASSERT_LE(lower, upper);
+        ASSERT_EQ(LatencyHistogram::bucket_of(lower), bucket);
+        ASSERT_EQ(LatencyHistogram::bucket_of(upper), bucket);
+        ASSERT_EQ(LatencyHistogram::bucket_lower(bucket + 1), upper + 1);
+    }
+}
+
+TEST(LatencyHistogram, BucketWidthStaysWithinAnEighthOfTheValue) {
+    using itch::LatencyHistogram;
+    for (const std::uint64_t value : {9ULL, 100ULL, 1234ULL, 1000000ULL, 1ULL << 40U}) {
+        const auto bucket = LatencyHistogram::bucket_of(value);
+        const auto width  = LatencyHistogram::bucket_upper(bucket) -
+                           LatencyHistogram::bucket_lower(bucket) + 1;
+        EXPECT_LE(width * LatencyHistogram::SUB_BUCKETS, value);
+    }
+}
+
+TEST(LatencyHistogram, PercentilesAndSummary) {
+    itch::LatencyHistogram histogram;
+    EXPECT_EQ(histogram.value_at_percentile(50), 0U);
+    EXPECT_EQ(histogram.min(), 0U);
+
+    for (std::uint64_t value = 1; value <= 100; ++value) {
+        histogram.record(value);
+    }
+    EXPECT_EQ(histogram.count(), 100U);
+    EXPECT_EQ(histogram.min(), 1U);
+    EXPECT_EQ(histogram.max(), 100U);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 50.5);
+    EXPECT_EQ(histogram.value_at_percentile(0), 1U);
+    EXPECT_EQ(histogram.value_at_percentile(100), 100U);
+
+    // The 50th value lies in [48, 51]; the percentile reports the bucket's top.
+    const auto median = histogram.value_at_percentile(50);
+    EXPECT_GE(median, 50U);
+    EXPECT_LE(median, 51U);
+}
+
+TEST(LatencyHistogram, MergeAddsCountsAndExtremes) {
+    itch::LatencyHistogram first;
+    itch::LatencyHistogram second;
+    first.record(10);
+    second.record(1000);
+    second.record(3);
+    first.merge(second);
+    EXPECT_EQ(first.count(), 3U);
+    EXPECT_EQ(first.min(), 3U);
+    EXPECT_EQ(first.max(), 1000U);
+
+    first.clear();
+    EXPECT_EQ(first.count(), 0U);
+    EXPECT_EQ(first.max(), 0U);
+}
+
+TEST(ParserStats, RecordsPerTypeMessagesAndBytes) {
+    itch::ParserStats stats;
+    stats.record('A', 38, 120);
+    stats.record('A', 38, 80);
+    stats.record('S', 14, 40);
+    EXPECT_EQ(stats.messages('A'), 2U);
+    EXPECT_EQ(stats.bytes('A'), 76U);
+    EXPECT_EQ(stats.messages('S'), 1U);
+    EXPECT_EQ(stats.total_messages(), 3U);
+    EXPECT_EQ(stats.total_bytes(), 90U);
+    EXPECT_EQ(stats.latency().count(), 3U);
+    EXPECT_GT(itch::ParserStats::to_nanoseconds(1000000), 0.0);
+
+    itch::ParserStats other;
+    other.record('D', 21, 10);
+    stats.merge(other);
+    EXPECT_EQ(stats.total_messages(), 4U);
+    stats.clear();
+    EXPECT_EQ(stats.total_bytes(), 0U);
+}
+
+TEST(ParserStats, ParserCollectsOnlyWhenEnabled) {
+    const auto   feed = sample_feed();
+    itch::Parser parser;
+    parser.set_stats_sample_interval(1);
+    parser.parse(feed, [](const itch::Message&) {}, itch::MessageTypeFilter {"A"});
+
+    const auto& stats = parser.stats();
+    if constexpr (!itch::ParserStats::ENABLED) {
+        EXPECT_EQ(stats.total_messages(), 0U);
+        return;
+    }
+    // Only delivered frames count; the filtered-out 'S' frame does not.
+    EXPECT_EQ(stats.messages('A'), 2U);
+    EXPECT_EQ(stats.messages('S'), 0U);
+    EXPECT_EQ(stats.bytes('A'), 2U * (2U + 36U));
+    EXPECT_EQ(stats.latency().count(), 2U);
+
+    parser.parse_with(feed, [](const itch::SystemEventMessage&) {});
+    EXPECT_EQ(parser.stats().total_messages(), 5U);
+
+    parser.reset_stats();
+    EXPECT_EQ(parser.stats().total_messages(), 0U);
+    EXPECT_EQ(parser.stats().sample_interval(), 1U);
+}
+
+TEST(ParserStats, BucketedParseTimesWholeBuckets) {
+    const auto   feed = sample_feed();
+    itch::Parser parser;
+    parser.set_stats_sample_interval(1);
+    std::size_t adds = 0;
+    parser.parse_bucketed(feed, [&adds](std::span<const itch::AddOrderMessage> messages) {
+        adds += messages.size();
+    });
+    EXPECT_EQ(adds, 2U);
+
+    const auto& stats = parser.stats();
+    if constexpr (!itch::ParserStats::ENABLED) {
+        EXPECT_EQ(stats.total_messages(), 0U);
+        return;
+    }
+    EXPECT_EQ(stats.messages('A'), 2U);
+    EXPECT_EQ(stats.messages('S'), 1U);
+    // One value for the decoded 'A' bucket; queueing a frame is not timed, and
+    // the 'S' bucket is skipped undecoded.
+    EXPECT_EQ(stats.latency().count(), 1U);
+}
+
+TEST(ParserStats, SamplesOneFrameInEveryInterval) {
+    itch::ParserStats stats;
+    EXPECT_EQ(stats.sample_interval(), itch::ParserStats::DEFAULT_SAMPLE_INTERVAL);
+    stats.set_sample_interval(4);
+    std::size_t due = 0;
+    for (int frame = 0; frame < 20; ++frame) {
+        due += stats.sample_due() ? 1U : 0U;
+    }
+    EXPECT_EQ(due, 5U);
+    stats.set_sample_interval(0);
+    EXPECT_EQ(stats.sample_interval(), itch::ParserStats::DEFAULT_SAMPLE_INTERVAL);
+}
@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "itch/parser.hpp"
+#include "itch/streaming_parser.hpp"
+#include "transport/frame_builders.hpp"
+
+namespace {
+
+using itch::test::append_frame;
+
+// Orders 1..count, each an `A` frame followed by an `S` frame.
+auto order_feed(std::uint64_t count) -> std::vector<std::byte> {
+    std::vector<std::byte> buffer;
+    for (std::uint64_t ref = 1; ref <= count; ++ref) {
+        append_frame(buffer, itch::test::add_order_payload(7, ref, 'B', 100, "AAPL", 1500000));
+        append_frame(buffer, itch::test::system_event_payload(ref, 'O'));
+    }
+    return buffer;
+}
+
+constexpr std::size_t ADD_FRAME_SIZE   = 2 + itch::detail::WIRE_SIZE<itch::AddOrderMessage>;
+constexpr std::size_t EVENT_FRAME_SIZE = 2 + itch::detail::WIRE_SIZE<itch::SystemEventMessage>;
+constexpr std::size_t PAIR_FRAME_SIZE  = ADD_FRAME_SIZE + EVENT_FRAME_SIZE;
+
+auto order_refs(const std::vector<itch::Message>& messages) -> std::vector<std::uint64_t> {
+    std::vector<std::uint64_t> refs;
+    for (const auto& msg : messages) {
+        if (const auto* add = std::get_if<itch::AddOrderMessage>(&msg)) {
+            refs.push_back(add->order_reference_number);
+        }
+    }
+    return refs;
+}
+
+struct Reported {
+    std::vector<itch::SkippedRange> ranges;
+    std::string                     types;
+};
+
+// Records every resynchronization `parser` reports.
+auto watch_resync(itch::Parser& parser, Reported& reported) -> void {
+    parser.set_error_callback([&reported, &parser](itch::ParseError error, char type) {
+        if (error == itch::ParseError::resynchronized) {
+            reported.ranges.push_back(parser.last_skipped_range());
+            reported.types.push_back(type);
+        }
+    });
+}
+
+}  // namespace
+
+TEST(Resync, DisabledByDefault) {
+    itch::Parser parser;
+    EXPECT_EQ(parser.resync_frames(), 0U);
+
+    auto feed = order_feed(3);
+    feed[PAIR_FRAME_SIZE + 1] = std::byte {0x30};  // Second `A` frame now claims 48 bytes.
+    EXPECT_THROW(parser.parse(feed), std::runtime_error);  // Misframed to the end.
+    EXPECT_EQ(parser.skipped_byte_count(), 0U);
+}
+
+TEST(Resync, SkipsAFrameWithACorruptedLengthPrefix) {
+    auto feed = order_feed(10);
+    feed[PAIR_FRAME_SIZE + 1] = std::byte {0x30};
+
+    Reported     reported;
+    itch::Parser parser;
+    parser.set_resync_frames(4);
+    watch_resync(parser, reported);
+
+    const auto refs = order_refs(parser.parse(feed));
+    EXPECT_EQ(refs, (std::vector<std::uint64_t> {1, 3, 4, 5, 6, 7, 8, 9, 10}));
+    ASSERT_EQ(reported.ranges.size(), 1U);
+    EXPECT_EQ(reported.ranges[0].offset, PAIR_FRAME_SIZE);
+    EXPECT_EQ(reported.ranges[0].length, ADD_FRAME_SIZE);
+    EXPECT_EQ(reported.types, "A");
+    EXPECT_EQ(parser.skipped_byte_count(), ADD_FRAME_SIZE);
+    EXPECT_EQ(parser.malformed_message_count(), 0U);
+}
+
+TEST(Resync, SkipsUnknownTypesAndInsertedGarbage) {
+    auto feed = order_feed(8);
+    feed[PAIR_FRAME_SIZE + 2] = std::byte {'!'};  // Second `A` frame gets an unknown type.
+    const std::vector<std::byte> garbage(5, std::byte {0xFF});
+    feed.insert(feed.begin() + 4 * PAIR_FRAME_SIZE, garbage.begin(), garbage.end());
+
+    Reported     reported;
+    itch::Parser parser;
+    parser.set_resync_frames(4);
+    watch_resync(parser, reported);
+
+    EXPECT_EQ(
+        order_refs(parser.parse(feed)), (std::vector<std::uint64_t> {1, 3, 4, 5, 6, 7, 8})
+    );
+    ASSERT_EQ(reported.ranges.size(), 2U);
+    EXPECT_EQ(reported.ranges[0].offset, PAIR_FRAME_SIZE);
+    EXPECT_EQ(reported.ranges[0].length, ADD_FRAME_SIZE);
+    EXPECT_EQ(reported.ranges[1].offset, 4 * PAIR_FRAME_SIZE);
+    EXPECT_EQ(reported.ranges[1].length, garbage.size());
+    EXPECT_EQ(reported.types, "!\xFF");
+    EXPECT_EQ(parser.skipped_byte_count(), ADD_FRAME_SIZE + garbage.size());
+
+    parser.reset_diagnostics();
+    EXPECT_EQ(parser.skipped_byte_count(), 0U);
+    EXPECT_EQ(parser.last_skipped_range().length, 0U);
+}
+
+TEST(Resync, KeepsTheFramesAfterADamagedTail) {
+    auto feed = order_feed(3);
+    feed[2 * PAIR_FRAME_SIZE + 1] = std::byte {0x30};  // Third `A` frame claims 48 bytes.
+
+    itch::Parser parser;
+    parser.set_resync_frames(4);
+    const auto messages = parser.parse(feed);
+    EXPECT_EQ(order_refs(messages), (std::vector<std::uint64_t> {1, 2}));
+    EXPECT_EQ(messages.size(), 5U);  // The final `S` frame is recovered.
+    EXPECT_EQ(parser.skipped_byte_count(), ADD_FRAME_SIZE);
+
+    // Nothing after the damage to resynchronize on: the rest is skipped.
+    auto tail = order_feed(2);
+    tail.resize(tail.size() - EVENT_FRAME_SIZE);
+    tail[PAIR_FRAME_SIZE + 1] = std::byte {0x30};
+    parser.reset_diagnostics();
+    EXPECT_EQ(order_refs(parser.parse(tail)), (std::vector<std::uint64_t> {1}));
+    EXPECT_EQ(parser.skipped_byte_count(), tail.size() - PAIR_FRAME_SIZE);
+}
+
+TEST(Resync, StillThrowsOnAPlausibleTruncatedFrame) {
+    auto feed = order_feed(2);
+    feed.pop_back();
+
+    itch::Parser parser;
+    parser.set_resync_frames(4);
+    EXPECT_THROW(parser.parse(feed), std::runtime_error);
+    EXPECT_EQ(parser.skipped_byte_count(), 0U);
+}
+
+TEST(Resync, ReportsStreamOffsetsAcrossChunks) {
+    auto              feed    = order_feed(25000);  // Spans two stream chunks.
+    const std::size_t damaged = 22000 * PAIR_FRAME_SIZE;
+    feed[damaged + 2]         = std::byte {'!'};
+
+    Reported     reported;
+    itch::Parser parser;
+    parser.set_resync_frames(4);
+    watch_resync(parser, reported);
+
+    std::stringstream stream;
+    stream.write(
+        static_cast<const char*>(static_cast<const void*>(feed.data())),
+        static_cast<std::streamsize>(feed.size())
+    );
+    EXPECT_EQ(order_refs(parser.parse(stream)).size(), 24999U);
+    ASSERT_EQ(reported.ranges.size(), 1U);
+    EXPECT_EQ(reported.ranges[0].offset, damaged);
+    EXPECT_EQ(reported.ranges[0].length, ADD_FRAME_SIZE);
+}
+
+TEST(Resync, KeepsAFrameWhoseHeaderStraddlesAStreamChunk) {
+    constexpr std::size_t CHUNK = itch::Parser::STREAM_CHUNK_SIZE;
+    // Garbage ends 1 or 2 bytes before the chunk boundary, where the next
+    // frame starts with only part of its header in the first chunk.
+    for (const std::size_t in_chunk : {std::size_t {1}, std::size_t {2}}) {
+        const std::size_t pairs = (CHUNK - in_chunk - 1) / PAIR_FRAME_SIZE;
+        const std::size_t start = pairs * PAIR_FRAME_SIZE;
+        auto              feed  = order_feed(pairs + 10);
+        const std::vector<std::byte> garbage(CHUNK - in_chunk - start, std::byte {0xFF});
+        feed.insert(
+            feed.begin() + static_cast<std::ptrdiff_t>(start), garbage.begin(), garbage.end()
+        );
+
+        Reported     reported;
+        itch::Parser parser;
+        parser.set_resync_frames(4);
+        watch_resync(parser, reported);
+
+        std::stringstream stream;
+        stream.write(
+            static_cast<const char*>(static_cast<const void*>(feed.data())),
+            static_cast<std::streamsize>(feed.size())
+        );
+        EXPECT_EQ(order_refs(parser.parse(stream)).size(), pairs + 10);
+        ASSERT_EQ(reported.ranges.size(), 1U);
+        EXPECT_EQ(reported.ranges[0].offset, start);
+        EXPECT_EQ(reported.ranges[0].length, garbage.size());
+    }
+}
+
+TEST(Resync, ReportsStreamOffsetsFromAStreamingParser) {
+    auto feed = order_feed(20);
+    feed[3 * PAIR_FRAME_SIZE + 2]  = std::byte {'!'};
+    feed[12 * PAIR_FRAME_SIZE + 2] = std::byte {'!'};
+
+    // Small pieces carry every frame over; large ones resynchronize in place.
+    for (const std::size_t piece : {std::size_t {7}, std::size_t {100}, feed.size()}) {
+        Reported              reported;
+        std::size_t           adds = 0;
+        itch::StreamingParser streaming {[&adds](const itch::Message& msg) {
+            adds += std::holds_alternative<itch::AddOrderMessage>(msg) ? 1U : 0U;
+        }};
+        streaming.parser().set_resync_frames(4);
+        watch_resync(streaming.parser(), reported);
+
+        for (std::size_t offset = 0; offset < feed.size(); offset += piece) {
+            streaming.feed(std::span {feed}.subspan(offset, std::min(piece, feed.size() - offset)));
+        }
+        streaming.finish();
+        EXPECT_EQ(adds, 18U);
+        if (piece >= PAIR_FRAME_SIZE) {
+            ASSERT_EQ(reported.ranges.size(), 2U);
+            EXPECT_EQ(reported.ranges[0].offset, 3 * PAIR_FRAME_SIZE);
+            EXPECT_EQ(reported.ranges[0].length, ADD_FRAME_SIZE);
+            EXPECT_EQ(reported.ranges[1].offset, 12 * PAIR_FRAME_SIZE);
+            EXPECT_EQ(reported.ranges[1].length, ADD_FRAME_SIZE);
+            continue;
+        }
+        // Damage cut by piece boundaries may be reported in several ranges,
+        // but each one must still lie inside a corrupted frame.
+        ASSERT_FALSE(reported.ranges.empty());
+        EXPECT_EQ(reported.ranges.front().offset, 3 * PAIR_FRAME_SIZE);
+        for (const auto& range : reported.ranges) {
+            const bool in_first  = range.offset >= 3 * PAIR_FRAME_SIZE &&
+                                  range.offset + range.length <= 3 * PAIR_FRAME_SIZE + ADD_FRAME_SIZE;
+            const bool in_second = range.offset >= 12 * PAIR_FRAME_SIZE &&
+                                   range.offset + range.length <=
+                                       12 * PAIR_FRAME_SIZE + ADD_FRAME_SIZE;
+            EXPECT_TRUE(in_first || in_second) << range.offset << "+" << range.length;
+        }
+    }
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "itch/overlay.hpp"
+#include "itch/parser.hpp"
+#include "itch/seek_index.hpp"
+#include "transport/frame_builders.hpp"
+
+namespace {
+
+constexpr std::uint64_t FIRST_TIMESTAMP = 1000;
+constexpr std::uint64_t TIME_STEP       = 10;
+
+// Overwrites the 48-bit big-endian timestamp at payload bytes 5..10.
+auto set_timestamp(std::vector<std::byte>& payload, std::uint64_t timestamp) -> void {
+    for (std::size_t idx = 0; idx < 6; ++idx) {
+        payload[5 + idx] = static_cast<std::byte>((timestamp >> (8 * (5 - idx))) & 0xFFU);
+    }
+}
+
+// Add Orders (order ref = ordinal, locate cycling through 1..5) interleaved with
+// System Events (locate 1), timestamps rising by TIME_STEP per message, and a
+// zero-length padding frame now and then.
+auto build_feed(std::size_t messages) -> std::vector<std::byte> {
+    std::vector<std::byte> buffer;
+    for (std::size_t ordinal = 0; ordinal < messages; ++ordinal) {
+        auto payload = ordinal % 3 == 2
+                           ? itch::test::system_event_payload(0, 'O')
+                           : itch::test::add_order_payload(
+                                 static_cast<std::uint16_t>(1 + ordinal % 5),
+                                 ordinal,
+                                 'B',
+                                 100,
+                                 "AAPL",
+                                 1500000
+                             );
+        set_timestamp(payload, FIRST_TIMESTAMP + ordinal * TIME_STEP);
+        itch::test::append_frame(buffer, payload);
+        if (ordinal % 41 == 0) {
+            itch::test::append_be16(buffer, 0);
+        }
+    }
+    return buffer;
+}
+
+auto timestamps_of(std::span<const std::byte> data) -> std::vector<std::uint64_t> {
+    std::vector<std::uint64_t> timestamps;
+    itch::overlay::for_each_message(data, [&](const itch::overlay::MessageView& view) {
+        timestamps.push_back(view.timestamp());
+    });
+    return timestamps;
+}
+
+}  // namespace
+
+TEST(SeekIndex, BuildSamplesEveryStrideMessages) {
+    const auto feed  = build_feed(1000);
+    const auto index = itch::SeekIndex::build(std::span {feed}, 64);
+
+    EXPECT_EQ(index.message_count(), 1000u);
+    EXPECT_EQ(index.data_size(), feed.size());
+    ASSERT_EQ(index.points().size(), 16u);
+    for (std::size_t idx = 0; idx < index.points().size(); ++idx) {
+        const auto& point = index.points()[idx];
+        EXPECT_EQ(point.ordinal, idx * 64);
+        EXPECT_EQ(point.timestamp, FIRST_TIMESTAMP + point.ordinal * TIME_STEP);
+        // Every point lands on a length prefix: parsing from it starts at its ordinal.
+        EXPECT_EQ(timestamps_of(std::span {feed}.subspan(point.offset)).front(), point.timestamp);
+    }
+}
+
+TEST(SeekIndex, SeekMatchesFullScan) {
+    const auto feed     = build_feed(2000);
+    const auto index    = itch::SeekIndex::build(std::span {feed}, 100);
+    const auto expected = timestamps_of(std::span {feed});
+
+    for (const std::uint64_t ordinal : {0u, 1u, 99u, 100u, 101u, 1234u, 1999u}) {
+        const auto tail = index.seek(std::span {feed}, itch::SeekTarget::ordinal(ordinal));
+        const auto seen = timestamps_of(tail);
+        ASSERT_EQ(seen.size(), expected.size() - ordinal);
+        EXPECT_EQ(seen.front(), expected[ordinal]);
+    }
+
+    // Between two messages: lands on the later one.
+    const auto tail = index.seek(
+        std::span {feed}, itch::SeekTarget::time(FIRST_TIMESTAMP + 1500 * TIME_STEP - 3)
+    );
+    EXPECT_EQ(timestamps_of(tail).front(), FIRST_TIMESTAMP + 1500 * TIME_STEP);
+
+    EXPECT_TRUE(index.seek(std::span {feed}, itch::SeekTarget::ordinal(2000)).empty());
+    EXPECT_TRUE(index.seek(std::span {feed}, itch::SeekTarget::time(1u << 30)).empty());
+    EXPECT_EQ(index.seek(std::span {feed}, itch::SeekTarget::time(0)).size(), feed.size());
+}
+
+TEST(SeekIndex, ParseFromDeliversTheTail) {
+    const auto feed  = build_feed(500);
+    const auto index = itch::SeekIndex::build(std::span {feed}, 32);
+
+    itch::Parser               parser;
+    std::vector<std::uint64_t> refs;
+    itch::parse_from(
+        parser,
+        std::span {feed},
+        index,
+        itch::SeekTarget::ordinal(300),
+        [&](const itch::Message& msg) {
+            if (const auto* add = std::get_if<itch::AddOrderMessage>(&msg)) {
+                refs.push_back(add->order_reference_number);
+            }
+        }
+    );
+    ASSERT_FALSE(refs.empty());
+    EXPECT_EQ(refs.front(), 300u);
+    EXPECT_EQ(refs.back(), 499u);
+
+    std::uint64_t views = itch::overlay::for_each_message(
+        std::span {feed}, index, itch::SeekTarget::ordinal(300), [](const auto&) {}
+    );
+    EXPECT_EQ(views, 200u);
+}
+
+TEST(SeekIndex, LocateRangesCoverEveryLocate) {
+    const auto feed  = build_feed(1000);
+    const auto index = itch::SeekIndex::build(std::span {feed});
+
+    ASSERT_EQ(index.locates().size(), 5u);
+    std::uint64_t total = 0;
+    for (const auto& range : index.locates()) {
+        EXPECT_LE(range.first_offset, range.last_offset);
+        total += range.message_count;
+    }
+    EXPECT_EQ(total, 1000u);
+
+    const auto first = index.locate_range(1);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->first_offset, 0u);
+    EXPECT_FALSE(index.locate_range(6).has_value());
+}
+
+TEST(SeekIndex, SaveAndLoadRoundTrip) {
+    const auto feed  = build_feed(3000);
+    const auto index = itch::SeekIndex::build(std::span {feed}, 128);
+    const auto path  = itch::SeekIndex::sidecar_path(
+        std::filesystem::temp_directory_path() / "itch_seek_index_test.itch"
+    );
+    EXPECT_EQ(path.extension(), ".idx");
+
+    index.save(path);
+    const auto loaded = itch::SeekIndex::load(path);
+    std::error_code ignored;
+    std::filesystem::remove(path, ignored);
+
+    EXPECT_EQ(loaded.stride(), index.stride());
+    EXPECT_EQ(loaded.data_size(), index.data_size());
+    EXPECT_EQ(loaded.message_count(), index.message_count());
+    ASSERT_EQ(loaded.points().size(), index.points().size());
+    for (std::size_t idx = 0; idx < index.points().size(); ++idx) {
+        EXPECT_EQ(loaded.points()[idx].offset, index.points()[idx].offset);
+        EXPECT_EQ(loaded.points()[idx].timestamp, index.points()[idx].timestamp);
+    }
+    ASSERT_EQ(loaded.locates().size(), index.locates().size());
+    EXPECT_EQ(loaded.locates().back().last_offset, index.locates().back().last_offset);
+    EXPECT_EQ(
+        loaded.seek(std::span {feed}, itch::SeekTarget::ordinal(2500)).size(),
+        index.seek(std::span {feed}, itch::SeekTarget::ordinal(2500)).size()
+    );
+}
+
+TEST(SeekIndex, RejectsStaleOrCorruptSidecars) {
+    const auto feed  = build_feed(100);
+    const auto index = itch::SeekIndex::build(std::span {feed});
+
+    const auto shorter = std::span {feed}.first(feed.size() - 1);
+    EXPECT_THROW(
+        static_cast<void>(index.seek(shorter, itch::SeekTarget::ordinal(0))), std::runtime_error
+    );
+
+    const auto path = std::filesystem::temp_directory_path() / "itch_seek_index_bad.idx";
+    {
+        std::ofstream out {path, std::ios::binary};
+        out << "NOTANIDXFILE";
+    }
+    EXPECT_THROW(static_cast<void>(itch::SeekIndex::load(path)), std::runtime_error);
+
+    index.save(path);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_THROW(static_cast<void>(itch::SeekIndex::load(path)), std::runtime_error);
+
+    std::error_code ignored;
+    std::filesystem::remove(path, ignored);
+}
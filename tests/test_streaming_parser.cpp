@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include "itch/parser.hpp"
+#include "itch/streaming_parser.hpp"
+#include "transport/frame_builders.hpp"
+
+namespace {
+
+auto build_feed(std::size_t count) -> std::vector<std::byte> {
+    std::vector<itch::Message> messages;
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        itch::Message message;
+        if (idx % 4 == 0) {
+            itch::AddOrderMessage msg {};
+            msg.order_reference_number = idx;
+            message                    = msg;
+        } else if (idx % 4 == 1) {
+            itch::OrderDeleteMessage msg {};
+            msg.order_reference_number = idx;
+            message                    = msg;
+        } else if (idx % 4 == 2) {
+            itch::NOIIMessage msg {};
+            msg.paired_shares = idx;
+            message           = msg;
+        } else {
+            itch::SystemEventMessage msg {};
+            msg.event_code = 'O';
+            message        = msg;
+        }
+        std::visit([&](auto& msg) { msg.timestamp = idx; }, message);
+        messages.push_back(message);
+    }
+    return itch::test::encode_feed(messages, 9);
+}
+
+auto timestamps_of(const std::vector<itch::Message>& messages) -> std::vector<std::uint64_t> {
+    std::vector<std::uint64_t> timestamps;
+    for (const auto& message : messages) {
+        timestamps.push_back(std::visit([](const auto& msg) { return msg.timestamp; }, message));
+    }
+    return timestamps;
+}
+
+}  // namespace
+
+TEST(StreamingParser, AnySplitMatchesOneShotParse) {
+    const auto feed     = build_feed(400);
+    const auto expected = timestamps_of(itch::Parser {}.parse(std::span {feed}));
+
+    std::mt19937 rng {7};
+    for (const std::size_t max_piece : {1u, 2u, 3u, 17u, 64u, 1000u}) {
+        std::vector<itch::Message> seen;
+        itch::StreamingParser      parser {[&](const itch::Message& msg) { seen.push_back(msg); }};
+
+        std::size_t offset = 0;
+        while (offset < feed.size()) {
+            const std::size_t piece = std::min<std::size_t>(
+                1 + rng() % max_piece, feed.size() - offset
+            );
+            EXPECT_EQ(parser.feed(std::span {feed}.subspan(offset, piece)), piece);
+            offset += piece;
+        }
+        EXPECT_EQ(parser.pending_bytes(), 0u);
+        EXPECT_NO_THROW(parser.finish());
+        EXPECT_EQ(timestamps_of(seen), expected) << "max piece " << max_piece;
+    }
+}
+
+TEST(StreamingParser, OverlongFrameSplitAcrossPiecesIsDecoded) {
+    // A Delete frame padded well past the carry buffer, split in three.
+    auto frame = itch::encode_frame(itch::Message {itch::OrderDeleteMessage {
+        'D', 1, 2, 3, 0xABCDEF
+    }});
+    const std::size_t padding = 3 * itch::StreamingParser::CARRY_CAPACITY;
+    const auto        length  = static_cast<std::uint16_t>(frame.size() - 2 + padding);
+    frame[0]                  = static_cast<std::byte>(length >> 8U);
+    frame[1]                  = static_cast<std::byte>(length & 0xFFU);
+    frame.insert(frame.end(), padding, std::byte {0x55});
+
+    std::vector<itch::Message> seen;
+    itch::StreamingParser      parser {[&](const itch::Message& msg) { seen.push_back(msg); }};
+    const auto                 bytes = std::span {frame};
+    parser.feed(bytes.first(5));
+    parser.feed(bytes.subspan(5, 100));
+    EXPECT_TRUE(seen.empty());
+    EXPECT_EQ(parser.pending_bytes(), 105u);
+    parser.feed(bytes.subspan(105));
+    ASSERT_EQ(seen.size(), 1u);
+    EXPECT_EQ(std::get<itch::OrderDeleteMessage>(seen[0]).order_reference_number, 0xABCDEFu);
+    EXPECT_EQ(parser.pending_bytes(), 0u);
+}
+
+TEST(StreamingParser, FinishReportsASplitFrameAndResets) {
+    const auto  feed = build_feed(3);
+    std::size_t seen = 0;
+
+    itch::StreamingParser parser {[&](const itch::Message&) { ++seen; }};
+    parser.feed(std::span {feed}.first(feed.size() - 1));
+    // The last frame is the NOII (2 + 50 bytes), cut one byte short.
+    EXPECT_EQ(parser.pending_bytes(), 2u + 50u - 1u);
+    EXPECT_EQ(seen, 2u);
+    EXPECT_THROW(parser.finish(), std::runtime_error);
+    EXPECT_EQ(parser.pending_bytes(), 0u);
+
+    parser.feed(std::span {feed});
+    EXPECT_NO_THROW(parser.finish());
+    EXPECT_EQ(seen, 2u + 3u);
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include "itch/parser.hpp"
+#include "transport/frame_builders.hpp"
+
+namespace {
+
+using itch::test::append_frame;
+
+auto sample_feed() -> std::vector<std::byte> {
+    std::vector<std::byte> buffer;
+    append_frame(buffer, itch::test::system_event_payload(1000, 'O'));
+    append_frame(buffer, itch::test::add_order_payload(7, 42, 'B', 500, "AAPL", 1500000));
+    buffer.push_back(std::byte {0});  // Zero-length padding frame.
+    buffer.push_back(std::byte {0});
+    append_frame(buffer, itch::test::add_order_payload(9, 43, 'S', 300, "MSFT", 4000000));
+    return buffer;
+}
+
+auto order_refs(const std::vector<itch::Message>& messages) -> std::vector<std::uint64_t> {
+    std::vector<std::uint64_t> refs;
+    for (const auto& msg : messages) {
+        if (const auto* add = std::get_if<itch::AddOrderMessage>(&msg)) {
+            refs.push_back(add->order_reference_number);
+        }
+    }
+    return refs;
+}
+
+auto trusted_parse(
+    itch::Parser& parser, itch::TrustedInput trust, std::span<const std::byte> data
+) -> std::vector<itch::Message> {
+    std::vector<itch::Message> messages;
+    parser.parse(trust, data, [&messages](const itch::Message& msg) { messages.push_back(msg); });
+    return messages;
+}
+
+}  // namespace
+
+TEST(TrustedInput, MatchesTheCheckedParserOnAWellFormedFeed) {
+    const auto feed = sample_feed();
+    EXPECT_EQ(itch::Parser::validate(feed), std::nullopt);
+
+    itch::Parser parser;
+    for (const bool validate : {false, true}) {
+        const auto messages = trusted_parse(parser, itch::TrustedInput {validate}, feed);
+        ASSERT_EQ(messages.size(), 3U);
+        EXPECT_TRUE(std::holds_alternative<itch::SystemEventMessage>(messages[0]));
+        EXPECT_EQ(order_refs(messages), (std::vector<std::uint64_t> {42, 43}));
+    }
+
+    std::uint64_t shares = 0;
+    parser.parse_with(itch::TrustedInput {}, feed, [&shares](const itch::AddOrderMessage& msg) {
+        shares += msg.shares;
+    });
+    EXPECT_EQ(shares, 800U);
+}
+
+TEST(TrustedInput, HonorsTheLocateFilter) {
+    itch::Parser parser;
+    parser.set_locate_filter(itch::LocateFilter {}.allow(9));
+    EXPECT_EQ(
+        order_refs(trusted_parse(parser, itch::TrustedInput {}, sample_feed())),
+        (std::vector<std::uint64_t> {43})
+    );
+}
+
+TEST(TrustedInput, ValidateReportsTheFirstProblem) {
+    auto truncated = sample_feed();
+    truncated.pop_back();
+    EXPECT_EQ(itch::Parser::validate(truncated), itch::ParseError::truncated);
+
+    auto unknown = sample_feed();
+    append_frame(unknown, {std::byte {'!'}, std::byte {0}});
+    EXPECT_EQ(itch::Parser::validate(unknown), itch::ParseError::unknown_type);
+
+    auto undersized = sample_feed();
+    append_frame(undersized, {std::byte {'A'}, std::byte {0}});
+    EXPECT_EQ(itch::Parser::validate(undersized), itch::ParseError::size_mismatch);
+
+    const std::vector<std::byte> half_prefix {std::byte {0}};
+    EXPECT_EQ(itch::Parser::validate(half_prefix), itch::ParseError::truncated);
+    EXPECT_EQ(itch::Parser::validate({}), std::nullopt);
+}
+
+TEST(TrustedInput, ValidatedModeFallsBackToTheCheckedLoop) {
+    auto feed = sample_feed();
+    append_frame(feed, {std::byte {'!'}, std::byte {0}});
+
+    itch::Parser parser;
+    const auto   messages = trusted_parse(parser, itch::TrustedInput {.validate = true}, feed);
+    EXPECT_EQ(messages.size(), 3U);
+    EXPECT_EQ(parser.unknown_message_count(), 1U);
+
+    feed.pop_back();
+    EXPECT_THROW(
+        trusted_parse(parser, itch::TrustedInput {.validate = true}, feed), std::runtime_error
+    );
+}
+
+TEST(TrustedInput, ValidatedModeAgreesWithTheCheckedLoopOnRandomBytes) {
+    std::mt19937                               rng {20240917};
+    std::uniform_int_distribution<int>         byte {0, 255};
+    std::uniform_int_distribution<std::size_t> length {0, 96};
+    const auto                                 well_formed = sample_feed();
+
+    for (int round = 0; round < 2000; ++round) {
+        // Half the rounds corrupt a valid feed, half are pure noise.
+        std::vector<std::byte> data;
+        if (round % 2 == 0) {
+            data                            = well_formed;
+            data[length(rng) % data.size()] = static_cast<std::byte>(byte(rng));
+        } else {
+            data.resize(length(rng));
+            for (auto& value : data) {
+                value = static_cast<std::byte>(byte(rng));
+            }
+        }
+
+        std::size_t  checked = 0;
+        std::size_t  trusted = 0;
+        itch::Parser parser;
+        try {
+            parser.parse(data, [&checked](const itch::Message&) { ++checked; });
+        } catch (const std::runtime_error&) {
+            // Truncated noise is expected; only the counts must agree.
+        }
+        try {
+            parser.parse(itch::TrustedInput {.validate = true}, data, [&trusted](const auto&) {
+                ++trusted;
+            });
+        } catch (const std::runtime_error&) {
+            // As above.
+        }
+        ASSERT_EQ(trusted, checked) << "round " << round;
+    }
+}
@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 
+#include "itch/encoder.hpp"
 #include "itch/parser.hpp"
 
 namespace itch::test {
@@ -138,6 +139,42 @@ inline auto length_prefixed(const std::vector<std::byte>& payload) -> std::vecto
     return frame;
 }
 
+/// @brief Appends a raw payload to `out` as a length-prefixed ITCH frame.
+/// @param out The byte buffer to append to.
+/// @param payload The raw payload to prefix and append.
+inline auto append_frame(std::vector<std::byte>& out, const std::vector<std::byte>& payload)
+    -> void {
+    append_bytes(out, length_prefixed(payload));
+}
+
+/// @brief Builds a small three-frame feed: a start-of-messages System Event
+///        followed by two AAPL Add Orders on locate 7.
+/// @return The length-prefixed feed.
+inline auto sample_feed() -> std::vector<std::byte> {
+    std::vector<std::byte> feed;
+    append_frame(feed, system_event_payload(1000, 'O'));
+    append_frame(feed, add_order_payload(7, 42, 'B', 500, "AAPL", 1500000));
+    append_frame(feed, add_order_payload(7, 43, 'S', 300, "AAPL", 1510000));
+    return feed;
+}
+
+/// @brief Encodes messages as back-to-back length-prefixed ITCH frames.
+/// @param messages The messages to encode, in order.
+/// @param padding_every Follow every `padding_every`th message, starting with
+///        the first, with a zero-length padding frame (0 for none).
+/// @return The encoded feed.
+inline auto encode_feed(const std::vector<itch::Message>& messages, std::size_t padding_every = 0)
+    -> std::vector<std::byte> {
+    std::vector<std::byte> feed;
+    for (std::size_t idx = 0; idx < messages.size(); ++idx) {
+        append_bytes(feed, itch::encode_frame(messages[idx]));
+        if (padding_every != 0 && idx % padding_every == 0) {
+            append_be16(feed, 0);
+        }
+    }
+    return feed;
+}
+
 /// @brief Builds a complete MoldUDP64 datagram from a list of raw message
 ///        payloads.
 /// @param session The session identifier (right-padded/truncated to 10
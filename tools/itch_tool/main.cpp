@@ -1,16 +1,20 @@
 #include <array>
 #include <cstdint>
-#include <cstring>
 #include <format>
 #include <fstream>
 #include <iostream>
 #include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <vector>
 
 #include "itch/io/csv_sink.hpp"
+#include "itch/io/decompress.hpp"
+#include "itch/io/mapped_file.hpp"
 #include "itch/parser.hpp"
+#include "itch/seek_index.hpp"
 #include "itch/transport/pcap.hpp"
 
 namespace {
@@ -22,51 +26,94 @@ auto print_line(std::ostream& out, std::string_view fmt, const Args&... args) ->
     out << std::vformat(fmt, std::make_format_args(args...)) << '\n';
 }
 
-// Reads an entire file into a byte buffer.
-auto read_file(const std::string& path) -> std::vector<std::byte> {
-    std::ifstream file {path, std::ios::binary};
-    if (!file) {
-        return {};
-    }
-    std::vector<char>      raw {std::istreambuf_iterator<char> {file}, {}};
-    std::vector<std::byte> bytes(raw.size());
-    if (!raw.empty()) {
-        std::memcpy(bytes.data(), raw.data(), raw.size());
-    }
-    return bytes;
+auto message_type_of(const itch::Message& message) -> char {
+    return std::visit([](const auto& msg) { return msg.message_type; }, message);
 }
 
 // Drives a callback over every message in a file, auto-detecting whether the
-// input is a pcap/pcapng capture or a raw length-prefixed ITCH stream.
-auto for_each_message(std::span<const std::byte> data, const itch::MessageCallback& callback)
-    -> void {
-    itch::transport::PcapReader reader {callback};
+// input is a gzip/zstd-compressed stream, a pcap/pcapng capture, or a raw
+// length-prefixed ITCH stream. On a raw stream the type filter is pushed down
+// into the parser, so rejected frames are never decoded; a compressed stream is
+// decompressed on a background thread while it is parsed.
+auto for_each_message(
+    std::span<const std::byte>     data,
+    itch::Parser&                  parser,
+    const itch::MessageCallback&   callback,
+    const itch::MessageTypeFilter& filter = itch::MessageTypeFilter::all()
+) -> void {
+    if (itch::io::detect_compression(data) != itch::io::Compression::none) {
+        parser.parse_compressed(data, callback, filter);
+        return;
+    }
+    itch::transport::PcapReader reader {[&](const itch::Message& msg) {
+        if (filter.contains(message_type_of(msg))) {
+            callback(msg);
+        }
+    }};
     if (reader.read(data)) {
         return;  // The input was a capture file.
     }
+    parser.parse(data, callback, filter);
+}
+
+auto for_each_message(
+    std::span<const std::byte>     data,
+    const itch::MessageCallback&   callback,
+    const itch::MessageTypeFilter& filter = itch::MessageTypeFilter::all()
+) -> void {
     itch::Parser parser;
-    parser.parse(data, callback);
+    for_each_message(data, parser, callback, filter);
 }
 
-// Parses a comma-or-concatenated list of message-type characters (e.g. "AEP").
-auto parse_type_filter(std::string_view spec) -> std::array<bool, 256> {
-    std::array<bool, 256> wanted {};
-    for (char chr : spec) {
-        if (chr != ',') {
-            wanted[static_cast<unsigned char>(chr)] = true;
+// Prints the parser's per-type byte counts and decode-plus-callback latency
+// percentiles; only available when the library collects them.
+auto print_parser_stats(const itch::ParserStats& stats) -> void {
+    if (stats.total_messages() == 0) {
+        return;  // Not collected, or the input was a capture file.
+    }
+    print_line(std::cout, "");
+    print_line(std::cout, "{:<6} {:>14} {:>16}", "type", "messages", "bytes");
+    for (std::size_t type = 0; type < 256; ++type) {
+        const auto message_type = static_cast<char>(type);
+        if (stats.messages(message_type) > 0) {
+            print_line(
+                std::cout,
+                "{:<6} {:>14} {:>16}",
+                message_type,
+                stats.messages(message_type),
+                stats.bytes(message_type)
+            );
         }
     }
-    return wanted;
-}
+    print_line(
+        std::cout, "{:<6} {:>14} {:>16}", "TOTAL", stats.total_messages(), stats.total_bytes()
+    );
 
-auto message_type_of(const itch::Message& message) -> char {
-    return std::visit([](const auto& msg) { return msg.message_type; }, message);
+    const auto& latency = stats.latency();
+    print_line(std::cout, "");
+    print_line(std::cout, "decode + callback latency per message (ns):");
+    print_line(
+        std::cout,
+        "  mean {:.1f}  min {:.1f}  max {:.1f}",
+        itch::ParserStats::to_nanoseconds(static_cast<std::uint64_t>(latency.mean())),
+        itch::ParserStats::to_nanoseconds(latency.min()),
+        itch::ParserStats::to_nanoseconds(latency.max())
+    );
+    for (const double percentile : {50.0, 90.0, 99.0, 99.9, 99.99}) {
+        print_line(
+            std::cout,
+            "  p{:<6} {:>10.1f}",
+            percentile,
+            itch::ParserStats::to_nanoseconds(latency.value_at_percentile(percentile))
+        );
+    }
 }
 
 auto cmd_stats(std::span<const std::byte> data) -> int {
     std::array<std::uint64_t, 256> counts {};
     std::uint64_t                  total = 0;
-    for_each_message(data, [&](const itch::Message& msg) {
+    itch::Parser                   parser;
+    for_each_message(data, parser, [&](const itch::Message& msg) {
         ++counts[static_cast<unsigned char>(message_type_of(msg))];
         ++total;
     });
@@ -77,6 +124,7 @@ auto cmd_stats(std::span<const std::byte> data) -> int {
         }
     }
     print_line(std::cout, "{:<6} {:>14}", "TOTAL", total);
+    print_parser_stats(parser.stats());
     return 0;
 }
 
@@ -93,10 +141,9 @@ auto cmd_inspect(std::span<const std::byte> data, std::uint64_t limit) -> int {
 }
 
 auto cmd_filter_or_convert(
-    std::span<const std::byte>   data,
-    const std::array<bool, 256>& wanted,
-    bool                         has_filter,
-    const std::string&           out_path
+    std::span<const std::byte>     data,
+    const itch::MessageTypeFilter& wanted,
+    const std::string&             out_path
 ) -> int {
     std::ofstream file_out;
     if (!out_path.empty()) {
@@ -108,16 +155,43 @@ auto cmd_filter_or_convert(
     }
     std::ostream&     out = out_path.empty() ? std::cout : file_out;
     itch::io::CsvSink sink {out};
-    for_each_message(data, [&](const itch::Message& msg) {
-        if (!has_filter || wanted[static_cast<unsigned char>(message_type_of(msg))]) {
-            sink.write(msg);
-        }
-    });
+    for_each_message(data, [&](const itch::Message& msg) { sink.write(msg); }, wanted);
     sink.flush();
     print_line(std::cerr, "Wrote {} rows.", sink.rows_written());
     return 0;
 }
 
+auto cmd_index(
+    std::span<const std::byte> data,
+    const std::string&         path,
+    std::uint64_t              stride,
+    std::string                out_path
+) -> int {
+    if (itch::io::detect_compression(data) != itch::io::Compression::none) {
+        print_line(std::cerr, "Error: seek indexes need an uncompressed file.");
+        return 1;
+    }
+    if (out_path.empty()) {
+        out_path = itch::SeekIndex::sidecar_path(path).string();
+    }
+    const auto index = itch::SeekIndex::build(data, stride);
+    try {
+        index.save(out_path);
+    } catch (const std::runtime_error& error) {
+        print_line(std::cerr, "Error: {}", error.what());
+        return 1;
+    }
+    print_line(
+        std::cerr,
+        "Indexed {} messages ({} seek points, {} locates) into '{}'.",
+        index.message_count(),
+        index.points().size(),
+        index.locates().size(),
+        out_path
+    );
+    return 0;
+}
+
 auto usage(const char* program) -> int {
     print_line(std::cerr, "itch-tool - inspect, filter, and convert NASDAQ ITCH 5.0 data");
     print_line(std::cerr, "Usage:");
@@ -125,7 +199,9 @@ auto usage(const char* program) -> int {
     print_line(std::cerr, "  {} inspect <file> [--limit N]", program);
     print_line(std::cerr, "  {} filter  <file> --types <ABC> [--out <file.csv>]", program);
     print_line(std::cerr, "  {} convert <file> [--to csv] [--out <file.csv>]", program);
-    print_line(std::cerr, "Input may be a raw ITCH stream or a .pcap/.pcapng capture.");
+    print_line(std::cerr, "  {} index   <file> [--stride N] [--out <file.idx>]", program);
+    print_line(std::cerr, "Input may be a raw ITCH stream or a .pcap/.pcapng capture;");
+    print_line(std::cerr, "raw streams may be gzip- or zstd-compressed (except for index).");
     return 1;
 }
 
@@ -139,31 +215,47 @@ auto main(int argc, char* argv[]) -> int {
     const std::string& command = args[1];
     const std::string& path    = args[2];
 
-    std::string           out_path;
-    std::string           types;
-    std::uint64_t         limit = 20;
-    std::array<bool, 256> wanted {};
-    bool                  has_filter = false;
+    std::string             out_path;
+    std::uint64_t           limit  = 20;
+    std::uint64_t           stride = itch::SeekIndex::DEFAULT_STRIDE;
+    itch::MessageTypeFilter wanted = itch::MessageTypeFilter::all();
     for (std::size_t index = 3; index < args.size(); ++index) {
         if (args[index] == "--out" && index + 1 < args.size()) {
             out_path = args[++index];
         } else if (args[index] == "--types" && index + 1 < args.size()) {
-            types      = args[++index];
-            wanted     = parse_type_filter(types);
-            has_filter = true;
+            wanted = itch::MessageTypeFilter {args[++index]};
         } else if (args[index] == "--limit" && index + 1 < args.size()) {
             limit = std::stoull(args[++index]);
+        } else if (args[index] == "--stride" && index + 1 < args.size()) {
+            stride = std::stoull(args[++index]);
         } else if (args[index] == "--to" && index + 1 < args.size()) {
             ++index;  // Only csv is supported without the Arrow build option.
         }
     }
 
-    const std::vector<std::byte> data = read_file(path);
-    if (data.empty()) {
-        print_line(std::cerr, "Error: cannot read '{}' (missing or empty).", path);
+    // Every subcommand reads the input in place through a read-only mapping.
+    itch::io::MappedFile file;
+    try {
+        file = itch::io::MappedFile {path};
+    } catch (const std::system_error& error) {
+        print_line(std::cerr, "Error: cannot read '{}' ({}).", path, error.code().message());
+        return 1;
+    }
+    if (file.empty()) {
+        print_line(std::cerr, "Error: '{}' is empty.", path);
+        return 1;
+    }
+    const std::span<const std::byte> view = file.bytes();
+    const auto compression = itch::io::detect_compression(view);
+    if (!itch::io::compression_supported(compression)) {
+        print_line(
+            std::cerr,
+            "Error: '{}' is {}-compressed, which this build cannot read.",
+            path,
+            itch::io::to_string(compression)
+        );
         return 1;
     }
-    const std::span<const std::byte> view {data};
 
     if (command == "stats") {
         return cmd_stats(view);
@@ -172,10 +264,13 @@ auto main(int argc, char* argv[]) -> int {
         return cmd_inspect(view, limit);
     }
     if (command == "filter") {
-        return cmd_filter_or_convert(view, wanted, has_filter, out_path);
+        return cmd_filter_or_convert(view, wanted, out_path);
     }
     if (command == "convert") {
-        return cmd_filter_or_convert(view, wanted, has_filter, out_path);
+        return cmd_filter_or_convert(view, wanted, out_path);
+    }
+    if (command == "index") {
+        return cmd_index(view, path, stride, out_path);
     }
     return usage(argv[0]);
 }